@@ -76,6 +76,7 @@ static rt_err_t nu_uart_configure(struct rt_serial_device *serial, struct serial
 static rt_err_t nu_uart_control(struct rt_serial_device *serial, int cmd, void *arg);
 static int nu_uart_send(struct rt_serial_device *serial, char c);
 static int nu_uart_receive(struct rt_serial_device *serial);
+static rt_size_t nu_uart_receive_buf(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size);
 static void nu_uart_isr(nu_uart_t serial);
 
 #if defined(RT_SERIAL_USING_DMA)
@@ -95,10 +96,11 @@ static const struct rt_uart_ops nu_uart_ops =
     .putc = nu_uart_send,
     .getc = nu_uart_receive,
 #if defined(RT_SERIAL_USING_DMA)
-    .dma_transmit = nu_uart_dma_transmit
+    .dma_transmit = nu_uart_dma_transmit,
 #else
-    .dma_transmit = RT_NULL
+    .dma_transmit = RT_NULL,
 #endif
+    .getbuf = nu_uart_receive_buf
 };
 
 static const struct serial_configure nu_uart_default_config =
@@ -347,8 +349,12 @@ static void nu_uart_isr(nu_uart_t serial)
     }
 #endif
 
-    /* Handle RX event */
-    if (u32IntSts & (UART_INTSTS_RDAINT_Msk | UART_INTSTS_RXTOINT_Msk))
+    /* Handle RX event, the RX time-out means the line is idle */
+    if (u32IntSts & UART_INTSTS_RXTOINT_Msk)
+    {
+        rt_hw_serial_isr(&serial->dev, RT_SERIAL_EVENT_RX_TIMEOUT);
+    }
+    else if (u32IntSts & UART_INTSTS_RDAINT_Msk)
     {
         rt_hw_serial_isr(&serial->dev, RT_SERIAL_EVENT_RX_IND);
     }
@@ -770,6 +776,27 @@ static int nu_uart_receive(struct rt_serial_device *serial)
     return UART_READ(uart_base);
 }
 
+/**
+ * Receive all chars in RX-FIFO, up to size
+ */
+static rt_size_t nu_uart_receive_buf(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size)
+{
+    rt_size_t len = 0;
+
+    RT_ASSERT(serial);
+
+    /* Get base address of uart register */
+    UART_T *uart_base = ((nu_uart_t)serial)->uart_base;
+
+    /* Drain RX-FIFO */
+    while ((len < size) && !UART_GET_RX_EMPTY(uart_base))
+    {
+        buf[len++] = UART_READ(uart_base);
+    }
+
+    return len;
+}
+
 /**
  * Hardware UART Initialization
  */
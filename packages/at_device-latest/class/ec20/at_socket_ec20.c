@@ -805,8 +805,7 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
 {
     int device_socket = 0;
     rt_int32_t timeout;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
+    rt_size_t bfsz = 0;
     struct at_socket *socket = RT_NULL;
     struct at_device *device = RT_NULL;
     char *client_name = client->device->parent.name;
@@ -830,41 +829,13 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         return;
     }
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
-    if (recv_buf == RT_NULL)
-    {
-        LOG_E("no memory for URC receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
-        return;
-    }
-
-    /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
-    {
-        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
-        rt_free(recv_buf);
-        return;
-    }
-
     /* get at socket object by device socket descriptor */
     socket = &(device->sockets[device_socket]);
 
-    /* notice the receive buffer and buffer size */
-    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
+    /* receive the data into the socket receive buffer directly */
+    if (at_socket_recv_client(socket, client, bfsz, timeout) != bfsz)
     {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
     }
 }
 
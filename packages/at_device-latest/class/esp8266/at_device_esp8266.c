@@ -646,6 +646,10 @@ static void esp8266_init_thread_entry(void *parameter)
         }
 
         AT_SEND_CMD(client, resp, "AT+CIPMUX=1");
+#ifdef ESP8266_USING_RECV_PASSIVE
+        /* keep the socket data on the module until it is requested */
+        AT_SEND_CMD(client, resp, "AT+CIPRECVMODE=1");
+#endif
 
         /* initialize successfully  */
         result = RT_EOK;
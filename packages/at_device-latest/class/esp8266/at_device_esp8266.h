@@ -22,6 +22,13 @@ extern "C" {
 /* The maximum number of sockets supported by the esp8266 device */
 #define AT_DEVICE_ESP8266_SOCKETS_NUM  5
 
+/* The socket data is kept on the module and requested only when the AT socket
+ * receive buffer has space (AT+CIPRECVMODE=1), define AT_DEVICE_ESP8266_RECV_ACTIVE
+ * for the firmwares before AT 1.5, which push the data as it comes. */
+#if defined(AT_USING_SOCKET) && !defined(AT_DEVICE_ESP8266_RECV_ACTIVE)
+#define ESP8266_USING_RECV_PASSIVE
+#endif
+
 struct at_device_esp8266
 {
     char *device_name;
@@ -32,6 +39,13 @@ struct at_device_esp8266
     size_t recv_line_num;
     struct at_device device;
 
+#ifdef ESP8266_USING_RECV_PASSIVE
+    struct rt_work recv_work;
+    rt_uint32_t recv_ready;    /* the device sockets with data waiting on the module */
+    int recv_socket;           /* the device socket of the data requested */
+    size_t recv_len;           /* the size of the data requested received */
+#endif
+
     void *user_data;
 };
 
@@ -22,6 +22,7 @@
 
 #define ESP8266_MODULE_SERVER_SUPPORT_NUM 1
 #define ESP8266_MODULE_SEND_MAX_SIZE   2048
+#define ESP8266_MODULE_RECV_MAX_SIZE   2048
 /* set real event by current socket and current state */
 #define SET_EVENT(socket, event)       (((socket + 1) << 16) | (event))
 
@@ -48,6 +49,9 @@ static void urc_close_func(struct at_client *client, const char *data, rt_size_t
 static void urc_connected_func(struct at_client *client, const char *data, rt_size_t size);
 #endif
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size);
+#ifdef ESP8266_USING_RECV_PASSIVE
+static void urc_recv_data_func(struct at_client *client, const char *data, rt_size_t size);
+#endif
 
 static const struct at_urc urc_table[] =
 {
@@ -55,7 +59,12 @@ static const struct at_urc urc_table[] =
     {"SEND FAIL",        "\r\n",           urc_send_func},
     {"Recv",             "bytes\r\n",      urc_send_bfsz_func},
     {"",                 ",CLOSED\r\n",    urc_close_func},
+#ifdef ESP8266_USING_RECV_PASSIVE
+    {"+IPD",             "\r\n",           urc_recv_func},
+    {"+CIPRECVDATA,",    ":",              urc_recv_data_func},
+#else
     {"+IPD",             ":",              urc_recv_func},
+#endif
 };
 
 #ifdef AT_USING_SOCKET_SERVER
@@ -66,7 +75,12 @@ static const struct at_urc urc_table_with_server[] =
     {"Recv",             "bytes\r\n",      urc_send_bfsz_func},
     {"",                 ",CONNECT\r\n",   urc_connected_func},
     {"",                 ",CLOSED\r\n",    urc_close_func},
+#ifdef ESP8266_USING_RECV_PASSIVE
+    {"+IPD",             "\r\n",           urc_recv_func},
+    {"+CIPRECVDATA,",    ":",              urc_recv_data_func},
+#else
     {"+IPD",             ":",              urc_recv_func},
+#endif
 };
 #endif
 
@@ -119,6 +133,18 @@ static int esp8266_socket_close(struct at_socket *socket)
 
     result = at_obj_exec_cmd(device->client, resp, "AT+CIPCLOSE=%d", device_socket);
 
+#ifdef ESP8266_USING_RECV_PASSIVE
+    {
+        struct at_device_esp8266 *esp8266 = (struct at_device_esp8266 *) device->user_data;
+        rt_base_t level;
+
+        /* the data left on the module is dropped with the connection */
+        level = rt_hw_interrupt_disable();
+        esp8266->recv_ready &= ~(1U << device_socket);
+        rt_hw_interrupt_enable(level);
+    }
+#endif
+
     if (resp)
     {
         at_delete_resp(resp);
@@ -478,6 +504,108 @@ static void esp8266_socket_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
     }
 }
 
+#ifdef ESP8266_USING_RECV_PASSIVE
+/* the AT socket of a device socket, RT_NULL when it is not opened */
+static struct at_socket *esp8266_get_socket(struct at_device *device, int device_socket)
+{
+    struct at_socket *socket = RT_NULL;
+
+#ifdef AT_USING_SOCKET_SERVER
+    socket = at_get_base_socket(device_socket);
+#else
+    socket = &(device->sockets[device_socket]);
+#endif
+    if (socket == RT_NULL || socket->magic != AT_SOCKET_MAGIC || socket->state == AT_SOCKET_CLOSED)
+    {
+        return RT_NULL;
+    }
+
+    return socket;
+}
+
+/**
+ * request the socket data kept on the module, no more than the free space of
+ * the AT socket receive buffer. A socket without space is left until its
+ * buffer has space again, when esp8266_socket_recv_resume() runs this again.
+ */
+static void esp8266_socket_recv_work(struct rt_work *work, void *work_data)
+{
+    int device_socket;
+    size_t space;
+    rt_base_t level;
+    at_response_t resp = RT_NULL;
+    struct at_socket *socket = RT_NULL;
+    struct at_device *device = (struct at_device *) work_data;
+    struct at_device_esp8266 *esp8266 = (struct at_device_esp8266 *) device->user_data;
+    rt_mutex_t lock = device->client->lock;
+
+    resp = at_create_resp(64, 0, 5 * RT_TICK_PER_SECOND);
+    if (resp == RT_NULL)
+    {
+        LOG_E("no memory for resp create.");
+        return;
+    }
+
+    rt_mutex_take(lock, RT_WAITING_FOREVER);
+
+    for (device_socket = 0; device_socket < AT_DEVICE_ESP8266_SOCKETS_NUM; device_socket++)
+    {
+        while (esp8266->recv_ready & (1U << device_socket))
+        {
+            socket = esp8266_get_socket(device, device_socket);
+            space = socket ? at_socket_recv_space(socket) : 0;
+            if (socket && space == 0)
+            {
+                break;
+            }
+
+            level = rt_hw_interrupt_disable();
+            esp8266->recv_ready &= ~(1U << device_socket);
+            rt_hw_interrupt_enable(level);
+            if (socket == RT_NULL)
+            {
+                break;
+            }
+
+            if (space > ESP8266_MODULE_RECV_MAX_SIZE)
+            {
+                space = ESP8266_MODULE_RECV_MAX_SIZE;
+            }
+
+            /* the data is received by the "+CIPRECVDATA" URC */
+            esp8266->recv_socket = device_socket;
+            esp8266->recv_len = 0;
+            if (at_obj_exec_cmd(device->client, resp, "AT+CIPRECVDATA=%d,%d", device_socket, space) < 0)
+            {
+                LOG_E("%s device socket(%d) request data failed.", device->name, device_socket);
+                break;
+            }
+
+            /* a full request may leave more data on the module */
+            if (esp8266->recv_len == space)
+            {
+                level = rt_hw_interrupt_disable();
+                esp8266->recv_ready |= (1U << device_socket);
+                rt_hw_interrupt_enable(level);
+            }
+        }
+    }
+
+    rt_mutex_release(lock);
+
+    at_delete_resp(resp);
+}
+
+/* the receive buffer of the socket has space again, request the data left */
+static void esp8266_socket_recv_resume(struct at_socket *socket, size_t space)
+{
+    struct at_device *device = (struct at_device *) socket->device;
+    struct at_device_esp8266 *esp8266 = (struct at_device_esp8266 *) device->user_data;
+
+    rt_work_submit(&(esp8266->recv_work), 0);
+}
+#endif /* ESP8266_USING_RECV_PASSIVE */
+
 static const struct at_socket_ops esp8266_socket_ops =
 {
     esp8266_socket_connect,
@@ -490,6 +618,9 @@ static const struct at_socket_ops esp8266_socket_ops =
 #ifdef AT_USING_SOCKET_SERVER
     esp8266_socket_listen,
 #endif
+#ifdef ESP8266_USING_RECV_PASSIVE
+    esp8266_socket_recv_resume,
+#endif
 #endif
 };
 
@@ -589,14 +720,45 @@ static void urc_connected_func(struct at_client *client, const char *data, rt_si
 }
 #endif
 
+#ifdef ESP8266_USING_RECV_PASSIVE
 static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
 {
     int device_socket = 0;
+    rt_size_t bfsz = 0;
+    rt_base_t level;
+    struct at_device *device = RT_NULL;
+    struct at_device_esp8266 *esp8266 = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
+
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL)
+    {
+        LOG_E("get device(%s) failed.", client_name);
+        return;
+    }
+    esp8266 = (struct at_device_esp8266 *) device->user_data;
+
+    /* only the data size is told, the data is requested when there is space for it */
+    sscanf(data, "+IPD,%d,%d", &device_socket, (int *) &bfsz);
+
+    if (device_socket < 0 || device_socket >= AT_DEVICE_ESP8266_SOCKETS_NUM || bfsz == 0)
+        return;
+
+    level = rt_hw_interrupt_disable();
+    esp8266->recv_ready |= (1U << device_socket);
+    rt_hw_interrupt_enable(level);
+
+    rt_work_submit(&(esp8266->recv_work), 0);
+}
+
+static void urc_recv_data_func(struct at_client *client, const char *data, rt_size_t size)
+{
     rt_int32_t timeout = 0;
-    rt_size_t bfsz = 0, temp_size = 0;
-    char *recv_buf = RT_NULL, temp[8] = {0};
-    struct at_socket *socket = RT_NULL;
+    rt_size_t bfsz = 0;
     struct at_device *device = RT_NULL;
+    struct at_device_esp8266 *esp8266 = RT_NULL;
     char *client_name = client->device->parent.name;
 
     RT_ASSERT(data && size);
@@ -607,44 +769,53 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
         LOG_E("get device(%s) failed.", client_name);
         return;
     }
+    esp8266 = (struct at_device_esp8266 *) device->user_data;
 
-    /* get the at deveice socket and receive buffer size by receive data */
-    sscanf(data, "+IPD,%d,%d:", &device_socket, (int *) &bfsz);
+    /* the data requested by esp8266_socket_recv_work() */
+    sscanf(data, "+CIPRECVDATA,%d:", (int *) &bfsz);
 
     /* set receive timeout by receive buffer length, not less than 10ms */
     timeout = bfsz > 10 ? bfsz : 10;
 
-    if (device_socket < 0 || bfsz == 0)
+    if (bfsz == 0)
         return;
 
-    recv_buf = (char *) rt_calloc(1, bfsz);
-    if (recv_buf == RT_NULL)
+    /* a socket closed meanwhile is RT_NULL, the data is read out and dropped */
+    esp8266->recv_len = at_socket_recv_client(esp8266_get_socket(device, esp8266->recv_socket),
+                                              client, bfsz, timeout);
+    if (esp8266->recv_len != bfsz)
     {
-        LOG_E("no memory receive buffer(%d).", bfsz);
-        /* read and clean the coming data */
-        while (temp_size < bfsz)
-        {
-            if (bfsz - temp_size > sizeof(temp))
-            {
-                at_client_obj_recv(client, temp, sizeof(temp), timeout);
-            }
-            else
-            {
-                at_client_obj_recv(client, temp, bfsz - temp_size, timeout);
-            }
-            temp_size += sizeof(temp);
-        }
-        return;
+        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
     }
+}
+#else
+static void urc_recv_func(struct at_client *client, const char *data, rt_size_t size)
+{
+    int device_socket = 0;
+    rt_int32_t timeout = 0;
+    rt_size_t bfsz = 0;
+    struct at_socket *socket = RT_NULL;
+    struct at_device *device = RT_NULL;
+    char *client_name = client->device->parent.name;
+
+    RT_ASSERT(data && size);
 
-    /* sync receive data */
-    if (at_client_obj_recv(client, recv_buf, bfsz, timeout) != bfsz)
+    device = at_device_get_by_name(AT_DEVICE_NAMETYPE_CLIENT, client_name);
+    if (device == RT_NULL)
     {
-        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
-        rt_free(recv_buf);
+        LOG_E("get device(%s) failed.", client_name);
         return;
     }
 
+    /* get the at deveice socket and receive buffer size by receive data */
+    sscanf(data, "+IPD,%d,%d:", &device_socket, (int *) &bfsz);
+
+    /* set receive timeout by receive buffer length, not less than 10ms */
+    timeout = bfsz > 10 ? bfsz : 10;
+
+    if (device_socket < 0 || bfsz == 0)
+        return;
+
     /* get at socket object by device socket descriptor */
 #ifdef AT_USING_SOCKET_SERVER
     socket = at_get_base_socket(device_socket);
@@ -652,17 +823,27 @@ static void urc_recv_func(struct at_client *client, const char *data, rt_size_t
     socket = &(device->sockets[device_socket]);
 #endif
 
-    /* notice the receive buffer and buffer size */
-    if (at_evt_cb_set[AT_SOCKET_EVT_RECV])
+    /* receive the data into the socket receive buffer directly */
+    if (at_socket_recv_client(socket, client, bfsz, timeout) != bfsz)
     {
-        at_evt_cb_set[AT_SOCKET_EVT_RECV](socket, AT_SOCKET_EVT_RECV, recv_buf, bfsz);
+        LOG_E("%s device receive size(%d) data failed.", device->name, bfsz);
     }
 }
+#endif /* ESP8266_USING_RECV_PASSIVE */
 
 int esp8266_socket_init(struct at_device *device)
 {
     RT_ASSERT(device);
 
+#ifdef ESP8266_USING_RECV_PASSIVE
+    {
+        struct at_device_esp8266 *esp8266 = (struct at_device_esp8266 *) device->user_data;
+
+        esp8266->recv_ready = 0;
+        rt_work_init(&(esp8266->recv_work), esp8266_socket_recv_work, (void *) device);
+    }
+#endif
+
     /* register URC data execution function  */
     at_obj_set_urc_table(device->client, urc_table, sizeof(urc_table) / sizeof(urc_table[0]));
 
@@ -823,7 +823,7 @@ static const struct dfs_file_ops dfs_elm_fops =
 static const struct dfs_filesystem_ops dfs_elm =
 {
     "elm",
-    DFS_FS_FLAG_DEFAULT,
+    DFS_FS_FLAG_CACHE | DFS_FS_FLAG_NOCASE,
     &dfs_elm_fops,
 
     dfs_elm_mount,
@@ -54,106 +54,312 @@ int dfs_ramfs_statfs(struct dfs_filesystem *fs, struct statfs *buf)
     return RT_EOK;
 }
 
-int dfs_ramfs_ioctl(struct dfs_fd *file, int cmd, void *args)
+/*
+ * The files keep their data in chunks of RT_DFS_RAMFS_CHUNK_SIZE bytes,
+ * indexed by a table which grows by doubling, so that appending to a file does
+ * not copy its data and a chunk never written is a hole reading as zeros. The
+ * entries are linked in the directories for the listing, and hashed by the
+ * parent directory and the name for the lookup.
+ */
+
+#define RAMFS_CHUNK_INDEX(pos)  ((pos) / RT_DFS_RAMFS_CHUNK_SIZE)
+#define RAMFS_CHUNK_OFFSET(pos) ((pos) % RT_DFS_RAMFS_CHUNK_SIZE)
+
+static rt_uint32_t dfs_ramfs_hash(struct ramfs_dirent *parent,
+                                  const char          *name,
+                                  rt_size_t            length)
 {
-    return -EIO;
+    rt_uint32_t hash = (rt_uint32_t)(rt_ubase_t)parent;
+
+    while (length --)
+        hash = hash * 33 + (rt_uint8_t)*name++;
+
+    return hash % RT_DFS_RAMFS_HASH_SIZE;
+}
+
+static struct ramfs_dirent *dfs_ramfs_find(struct dfs_ramfs    *ramfs,
+                                           struct ramfs_dirent *parent,
+                                           const char          *name,
+                                           rt_size_t            length)
+{
+    rt_list_t *head, *node;
+    struct ramfs_dirent *dirent;
+
+    if (length >= RAMFS_NAME_MAX)
+        return NULL;
+
+    head = &(ramfs->hash[dfs_ramfs_hash(parent, name, length)]);
+    for (node = head->next; node != head; node = node->next)
+    {
+        dirent = rt_list_entry(node, struct ramfs_dirent, hlist);
+        if (dirent->parent == parent &&
+            rt_strncmp(dirent->name, name, length) == 0 &&
+            dirent->name[length] == '\0')
+        {
+            return dirent;
+        }
+    }
+
+    return NULL;
+}
+
+/* link an entry to its parent directory and the hash table */
+static void dfs_ramfs_link(struct ramfs_dirent *parent, struct ramfs_dirent *dirent)
+{
+    struct dfs_ramfs *ramfs = parent->fs;
+
+    dirent->parent = parent;
+    rt_list_insert_before(&(parent->children), &(dirent->list));
+    rt_list_insert_after(&(ramfs->hash[dfs_ramfs_hash(parent, dirent->name,
+                                                      rt_strlen(dirent->name))]),
+                         &(dirent->hlist));
+}
+
+static void dfs_ramfs_unlink_dirent(struct ramfs_dirent *dirent)
+{
+    rt_list_remove(&(dirent->list));
+    rt_list_remove(&(dirent->hlist));
+    dirent->parent = NULL;
+}
+
+/*
+ * Look up the parent directory of a path, and return the last name of the
+ * path in name and length. It returns NULL if a directory on the path does
+ * not exist.
+ */
+static struct ramfs_dirent *dfs_ramfs_parent(struct dfs_ramfs *ramfs,
+                                             const char       *path,
+                                             const char      **name,
+                                             rt_size_t        *length)
+{
+    struct ramfs_dirent *parent = &(ramfs->root);
+    const char *next;
+
+    while (*path == '/')
+        path ++;
+
+    while (1)
+    {
+        for (next = path; *next && *next != '/'; next ++);
+
+        *name = path;
+        *length = next - path;
+
+        while (*next == '/')
+            next ++;
+        if (*next == '\0')
+            return parent;
+
+        parent = dfs_ramfs_find(ramfs, parent, path, *length);
+        if (parent == NULL || parent->type != RAMFS_TYPE_DIR)
+            return NULL;
+
+        path = next;
+    }
 }
 
 struct ramfs_dirent *dfs_ramfs_lookup(struct dfs_ramfs *ramfs,
                                       const char       *path,
                                       rt_size_t        *size)
 {
-    const char *subpath;
+    const char *name;
+    rt_size_t length;
+    struct ramfs_dirent *parent;
     struct ramfs_dirent *dirent;
 
-    subpath = path;
-    while (*subpath == '/' && *subpath)
-        subpath ++;
-    if (! *subpath) /* is root directory */
+    parent = dfs_ramfs_parent(ramfs, path, &name, &length);
+    if (parent == NULL)
+        return NULL;
+
+    if (length == 0) /* is root directory */
     {
         *size = 0;
 
         return &(ramfs->root);
     }
 
-    for (dirent = rt_list_entry(ramfs->root.list.next, struct ramfs_dirent, list);
-         dirent != &(ramfs->root);
-         dirent = rt_list_entry(dirent->list.next, struct ramfs_dirent, list))
+    dirent = dfs_ramfs_find(ramfs, parent, name, length);
+    if (dirent != NULL)
+        *size = dirent->size;
+
+    return dirent;
+}
+
+static int dfs_ramfs_truncate(struct ramfs_dirent *dirent, rt_size_t length)
+{
+    rt_size_t index, count;
+
+    if (length < dirent->size)
     {
-        if (rt_strcmp(dirent->name, subpath) == 0)
+        /* free the chunks after the new end, and clear the end of the last one */
+        count = RAMFS_CHUNK_INDEX(length + RT_DFS_RAMFS_CHUNK_SIZE - 1);
+        for (index = count; index < dirent->chunk_max; index ++)
         {
-            *size = dirent->size;
+            if (dirent->chunks[index] != NULL)
+            {
+                rt_memheap_free(dirent->chunks[index]);
+                dirent->chunks[index] = NULL;
+            }
+        }
 
-            return dirent;
+        if (RAMFS_CHUNK_OFFSET(length) && count <= dirent->chunk_max &&
+            dirent->chunks[count - 1] != NULL)
+        {
+            rt_memset(dirent->chunks[count - 1] + RAMFS_CHUNK_OFFSET(length), 0,
+                      RT_DFS_RAMFS_CHUNK_SIZE - RAMFS_CHUNK_OFFSET(length));
+        }
+
+        if (count == 0 && dirent->chunks != NULL)
+        {
+            rt_memheap_free(dirent->chunks);
+            dirent->chunks = NULL;
+            dirent->chunk_max = 0;
         }
     }
 
-    /* not found */
-    return NULL;
+    /* a file growing is a hole until it is written */
+    dirent->size = length;
+
+    return RT_EOK;
+}
+
+/* get the chunk at the index, allocating it and the room in the chunk table */
+static rt_uint8_t *dfs_ramfs_chunk(struct ramfs_dirent *dirent, rt_size_t index)
+{
+    struct dfs_ramfs *ramfs = dirent->fs;
+    rt_uint8_t **chunks;
+    rt_size_t max;
+
+    if (index >= dirent->chunk_max)
+    {
+        max = dirent->chunk_max ? dirent->chunk_max : 4;
+        while (max <= index)
+            max *= 2;
+
+        chunks = (rt_uint8_t **)rt_memheap_realloc(&(ramfs->memheap), dirent->chunks,
+                                                   max * sizeof(rt_uint8_t *));
+        if (chunks == NULL)
+            return NULL;
+
+        rt_memset(chunks + dirent->chunk_max, 0,
+                  (max - dirent->chunk_max) * sizeof(rt_uint8_t *));
+        dirent->chunks = chunks;
+        dirent->chunk_max = max;
+    }
+
+    if (dirent->chunks[index] == NULL)
+    {
+        dirent->chunks[index] = (rt_uint8_t *)rt_memheap_alloc(&(ramfs->memheap),
+                                                                RT_DFS_RAMFS_CHUNK_SIZE);
+        if (dirent->chunks[index] != NULL)
+            rt_memset(dirent->chunks[index], 0, RT_DFS_RAMFS_CHUNK_SIZE);
+    }
+
+    return dirent->chunks[index];
+}
+
+int dfs_ramfs_ioctl(struct dfs_fd *file, int cmd, void *args)
+{
+    struct ramfs_dirent *dirent;
+
+    dirent = (struct ramfs_dirent *)file->data;
+    RT_ASSERT(dirent != NULL);
+
+    switch (cmd)
+    {
+    case RT_FIOFTRUNCATE:
+        if (dirent->type != RAMFS_TYPE_FILE)
+            return -EISDIR;
+
+        return dfs_ramfs_truncate(dirent, *(off_t *)args);
+    }
+
+    return -EIO;
 }
 
 int dfs_ramfs_read(struct dfs_fd *file, void *buf, size_t count)
 {
-    rt_size_t length;
+    rt_size_t length, offset, size;
+    rt_uint8_t *chunk;
     struct ramfs_dirent *dirent;
 
     dirent = (struct ramfs_dirent *)file->data;
     RT_ASSERT(dirent != NULL);
 
-    if (count < file->size - file->pos)
-        length = count;
-    else
-        length = file->size - file->pos;
+    /* the file may be changed through another descriptor */
+    file->size = dirent->size;
+    if ((rt_size_t)file->pos >= file->size)
+        return 0;
 
-    if (length > 0)
-        rt_memcpy(buf, &(dirent->data[file->pos]), length);
+    if (count > file->size - file->pos)
+        count = file->size - file->pos;
 
-    /* update file current position */
-    file->pos += length;
+    for (length = 0; length < count; length += size)
+    {
+        offset = RAMFS_CHUNK_OFFSET(file->pos);
+        size = RT_DFS_RAMFS_CHUNK_SIZE - offset;
+        if (size > count - length)
+            size = count - length;
+
+        chunk = NULL;
+        if (RAMFS_CHUNK_INDEX(file->pos) < dirent->chunk_max)
+            chunk = dirent->chunks[RAMFS_CHUNK_INDEX(file->pos)];
+
+        if (chunk != NULL)
+            rt_memcpy((rt_uint8_t *)buf + length, chunk + offset, size);
+        else
+            rt_memset((rt_uint8_t *)buf + length, 0, size);
+
+        /* update file current position */
+        file->pos += size;
+    }
 
     return length;
 }
 
 int dfs_ramfs_write(struct dfs_fd *fd, const void *buf, size_t count)
 {
+    rt_size_t length, offset, size;
+    rt_uint8_t *chunk;
     struct ramfs_dirent *dirent;
-    struct dfs_ramfs *ramfs;
 
     dirent = (struct ramfs_dirent *)fd->data;
     RT_ASSERT(dirent != NULL);
 
-    ramfs = dirent->fs;
-    RT_ASSERT(ramfs != NULL);
-
-    if (count + fd->pos > fd->size)
+    for (length = 0; length < count; length += size)
     {
-        rt_uint8_t *ptr;
-        ptr = rt_memheap_realloc(&(ramfs->memheap), dirent->data, fd->pos + count);
-        if (ptr == NULL)
+        offset = RAMFS_CHUNK_OFFSET(fd->pos);
+        size = RT_DFS_RAMFS_CHUNK_SIZE - offset;
+        if (size > count - length)
+            size = count - length;
+
+        chunk = dfs_ramfs_chunk(dirent, RAMFS_CHUNK_INDEX(fd->pos));
+        if (chunk == NULL)
         {
-            rt_set_errno(-ENOMEM);
+            if (length == 0)
+                rt_set_errno(-ENOMEM);
 
-            return 0;
+            break;
         }
 
-        /* update dirent and file size */
-        dirent->data = ptr;
-        dirent->size = fd->pos + count;
-        fd->size = dirent->size;
-    }
+        rt_memcpy(chunk + offset, (const rt_uint8_t *)buf + length, size);
 
-    if (count > 0)
-        rt_memcpy(dirent->data + fd->pos, buf, count);
+        /* update file current position */
+        fd->pos += size;
+        if ((rt_size_t)fd->pos > dirent->size)
+            dirent->size = fd->pos;
+    }
 
-    /* update file current position */
-    fd->pos += count;
+    /* update file size */
+    fd->size = dirent->size;
 
-    return count;
+    return length;
 }
 
 int dfs_ramfs_lseek(struct dfs_fd *file, off_t offset)
 {
-    if (offset <= (off_t)file->size)
+    /* seeking after the end leaves a hole when it is written */
+    if (offset >= 0)
     {
         file->pos = offset;
 
@@ -172,8 +378,10 @@ int dfs_ramfs_close(struct dfs_fd *file)
 
 int dfs_ramfs_open(struct dfs_fd *file)
 {
-    rt_size_t size;
+    const char *name;
+    rt_size_t length;
     struct dfs_ramfs *ramfs;
+    struct ramfs_dirent *parent;
     struct ramfs_dirent *dirent;
     struct dfs_filesystem *fs;
 
@@ -182,78 +390,76 @@ int dfs_ramfs_open(struct dfs_fd *file)
     ramfs = (struct dfs_ramfs *)fs->data;
     RT_ASSERT(ramfs != NULL);
 
+    parent = dfs_ramfs_parent(ramfs, file->path, &name, &length);
+    if (parent == NULL)
+        return -ENOENT;
+
+    if (length == 0) /* it's root directory */
+        dirent = &(ramfs->root);
+    else
+        dirent = dfs_ramfs_find(ramfs, parent, name, length);
+
     if (file->flags & O_DIRECTORY)
     {
         if (file->flags & O_CREAT)
         {
-            return -ENOSPC;
+            if (dirent != NULL)
+                return -EEXIST;
         }
-
-        /* open directory */
-        dirent = dfs_ramfs_lookup(ramfs, file->path, &size);
-        if (dirent == NULL)
-            return -ENOENT;
-        if (dirent == &(ramfs->root)) /* it's root directory */
+        else
         {
-            if (!(file->flags & O_DIRECTORY))
-            {
+            /* open directory */
+            if (dirent == NULL)
                 return -ENOENT;
-            }
+            if (dirent->type != RAMFS_TYPE_DIR)
+                return -ENOTDIR;
         }
     }
     else
     {
-        dirent = dfs_ramfs_lookup(ramfs, file->path, &size);
-        if (dirent == &(ramfs->root)) /* it's root directory */
+        if (dirent != NULL && dirent->type == RAMFS_TYPE_DIR)
         {
             return -ENOENT;
         }
 
-        if (dirent == NULL)
+        if (dirent == NULL && !(file->flags & O_CREAT || file->flags & O_WRONLY))
         {
-            if (file->flags & O_CREAT || file->flags & O_WRONLY)
-            {
-                char *name_ptr;
-
-                /* create a file entry */
-                dirent = (struct ramfs_dirent *)
-                         rt_memheap_alloc(&(ramfs->memheap),
-                                          sizeof(struct ramfs_dirent));
-                if (dirent == NULL)
-                {
-                    return -ENOMEM;
-                }
-
-                /* remove '/' separator */
-                name_ptr = file->path;
-                while (*name_ptr == '/' && *name_ptr)
-                    name_ptr ++;
-                strncpy(dirent->name, name_ptr, RAMFS_NAME_MAX);
-
-                rt_list_init(&(dirent->list));
-                dirent->data = NULL;
-                dirent->size = 0;
-                dirent->fs = ramfs;
-
-                /* add to the root directory */
-                rt_list_insert_after(&(ramfs->root.list), &(dirent->list));
-            }
-            else
-                return -ENOENT;
+            return -ENOENT;
         }
+    }
 
-        /* Creates a new file.
-         * If the file is existing, it is truncated and overwritten.
-         */
-        if (file->flags & O_TRUNC)
+    if (dirent == NULL)
+    {
+        if (length >= RAMFS_NAME_MAX)
+            return -ENAMETOOLONG;
+
+        /* create a file or directory entry */
+        dirent = (struct ramfs_dirent *)
+                 rt_memheap_alloc(&(ramfs->memheap),
+                                  sizeof(struct ramfs_dirent));
+        if (dirent == NULL)
         {
-            dirent->size = 0;
-            if (dirent->data != NULL)
-            {
-                rt_memheap_free(dirent->data);
-                dirent->data = NULL;
-            }
+            return -ENOMEM;
         }
+
+        rt_memset(dirent, 0x00, sizeof(struct ramfs_dirent));
+        rt_strncpy(dirent->name, name, length);
+        dirent->name[length] = '\0';
+
+        rt_list_init(&(dirent->children));
+        dirent->type = (file->flags & O_DIRECTORY) ? RAMFS_TYPE_DIR : RAMFS_TYPE_FILE;
+        dirent->fs = ramfs;
+
+        /* add to the parent directory */
+        dfs_ramfs_link(parent, dirent);
+    }
+
+    /* Creates a new file.
+     * If the file is existing, it is truncated and overwritten.
+     */
+    if ((file->flags & O_TRUNC) && dirent->type == RAMFS_TYPE_FILE)
+    {
+        dfs_ramfs_truncate(dirent, 0);
     }
 
     file->data = dirent;
@@ -281,8 +487,12 @@ int dfs_ramfs_stat(struct dfs_filesystem *fs,
         return -ENOENT;
 
     st->st_dev = 0;
-    st->st_mode = S_IFREG | S_IRUSR | S_IRGRP | S_IROTH |
+    st->st_mode = S_IRUSR | S_IRGRP | S_IROTH |
                   S_IWUSR | S_IWGRP | S_IWOTH;
+    if (dirent->type == RAMFS_TYPE_DIR)
+        st->st_mode |= S_IFDIR | S_IXUSR | S_IXGRP | S_IXOTH;
+    else
+        st->st_mode |= S_IFREG;
 
     st->st_size = dirent->size;
     st->st_mtime = 0;
@@ -295,16 +505,15 @@ int dfs_ramfs_getdents(struct dfs_fd *file,
                        uint32_t    count)
 {
     rt_size_t index, end;
+    rt_list_t *node;
     struct dirent *d;
     struct ramfs_dirent *dirent;
-    struct dfs_ramfs *ramfs;
+    struct ramfs_dirent *entry;
 
     dirent = (struct ramfs_dirent *)file->data;
+    RT_ASSERT(dirent != RT_NULL);
 
-    ramfs  = dirent->fs;
-    RT_ASSERT(ramfs != RT_NULL);
-
-    if (dirent != &(ramfs->root))
+    if (dirent->type != RAMFS_TYPE_DIR)
         return -EINVAL;
 
     /* make integer count */
@@ -315,17 +524,19 @@ int dfs_ramfs_getdents(struct dfs_fd *file,
     end = file->pos + count;
     index = 0;
     count = 0;
-    for (dirent = rt_list_entry(dirent->list.next, struct ramfs_dirent, list);
-         dirent != &(ramfs->root) && index < end;
-         dirent = rt_list_entry(dirent->list.next, struct ramfs_dirent, list))
+    for (node = dirent->children.next;
+         node != &(dirent->children) && index < end;
+         node = node->next)
     {
         if (index >= (rt_size_t)file->pos)
         {
+            entry = rt_list_entry(node, struct ramfs_dirent, list);
+
             d = dirp + count;
-            d->d_type = DT_REG;
+            d->d_type = (entry->type == RAMFS_TYPE_DIR) ? DT_DIR : DT_REG;
             d->d_namlen = RT_NAME_MAX;
             d->d_reclen = (rt_uint16_t)sizeof(struct dirent);
-            rt_strncpy(d->d_name, dirent->name, RAMFS_NAME_MAX);
+            rt_strncpy(d->d_name, entry->name, RAMFS_NAME_MAX);
 
             count += 1;
             file->pos += 1;
@@ -349,9 +560,14 @@ int dfs_ramfs_unlink(struct dfs_filesystem *fs, const char *path)
     if (dirent == NULL)
         return -ENOENT;
 
-    rt_list_remove(&(dirent->list));
-    if (dirent->data != NULL)
-        rt_memheap_free(dirent->data);
+    if (dirent == &(ramfs->root))
+        return -EBUSY;
+
+    if (dirent->type == RAMFS_TYPE_DIR && !rt_list_isempty(&(dirent->children)))
+        return -ENOTEMPTY;
+
+    dfs_ramfs_unlink_dirent(dirent);
+    dfs_ramfs_truncate(dirent, 0);
     rt_memheap_free(dirent);
 
     return RT_EOK;
@@ -362,7 +578,11 @@ int dfs_ramfs_rename(struct dfs_filesystem *fs,
                      const char            *newpath)
 {
     struct ramfs_dirent *dirent;
+    struct ramfs_dirent *parent;
+    struct ramfs_dirent *dir;
     struct dfs_ramfs *ramfs;
+    const char *name;
+    rt_size_t length;
     rt_size_t size;
 
     ramfs = (struct dfs_ramfs *)fs->data;
@@ -375,8 +595,26 @@ int dfs_ramfs_rename(struct dfs_filesystem *fs,
     dirent = dfs_ramfs_lookup(ramfs, oldpath, &size);
     if (dirent == NULL)
         return -ENOENT;
+    if (dirent == &(ramfs->root))
+        return -EBUSY;
+
+    parent = dfs_ramfs_parent(ramfs, newpath, &name, &length);
+    if (parent == NULL)
+        return -ENOENT;
+    if (length >= RAMFS_NAME_MAX)
+        return -ENAMETOOLONG;
 
-    strncpy(dirent->name, newpath, RAMFS_NAME_MAX);
+    /* a directory can not be moved into itself */
+    for (dir = parent; dir != NULL; dir = dir->parent)
+    {
+        if (dir == dirent)
+            return -EINVAL;
+    }
+
+    dfs_ramfs_unlink_dirent(dirent);
+    rt_strncpy(dirent->name, name, length);
+    dirent->name[length] = '\0';
+    dfs_ramfs_link(parent, dirent);
 
     return RT_EOK;
 }
@@ -396,7 +634,7 @@ static const struct dfs_file_ops _ram_fops =
 static const struct dfs_filesystem_ops _ramfs =
 {
     "ram",
-    DFS_FS_FLAG_DEFAULT,
+    DFS_FS_FLAG_CACHE,
     &_ram_fops,
 
     dfs_ramfs_mount,
@@ -423,6 +661,7 @@ struct dfs_ramfs *dfs_ramfs_create(rt_uint8_t *pool, rt_size_t size)
     struct dfs_ramfs *ramfs;
     rt_uint8_t *data_ptr;
     rt_err_t result;
+    int index;
 
     size  = RT_ALIGN_DOWN(size, RT_ALIGN_SIZE);
     ramfs = (struct dfs_ramfs *)pool;
@@ -444,10 +683,16 @@ struct dfs_ramfs *dfs_ramfs_create(rt_uint8_t *pool, rt_size_t size)
     /* initialize root directory */
     rt_memset(&(ramfs->root), 0x00, sizeof(ramfs->root));
     rt_list_init(&(ramfs->root.list));
+    rt_list_init(&(ramfs->root.hlist));
+    rt_list_init(&(ramfs->root.children));
     ramfs->root.size = 0;
+    ramfs->root.type = RAMFS_TYPE_DIR;
     strcpy(ramfs->root.name, ".");
     ramfs->root.fs = ramfs;
 
+    for (index = 0; index < RT_DFS_RAMFS_HASH_SIZE; index ++)
+        rt_list_init(&(ramfs->hash[index]));
+
     return ramfs;
 }
 
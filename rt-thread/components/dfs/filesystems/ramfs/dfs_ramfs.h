@@ -18,13 +18,38 @@
 #define RAMFS_NAME_MAX  32
 #define RAMFS_MAGIC     0x0A0A0A0A
 
+#ifndef RT_DFS_RAMFS_CHUNK_SIZE
+#define RT_DFS_RAMFS_CHUNK_SIZE     256
+#endif
+
+#ifndef RT_DFS_RAMFS_HASH_SIZE
+#define RT_DFS_RAMFS_HASH_SIZE      32
+#endif
+
+/* the file offsets and the name hashes are divided by them */
+#if RT_DFS_RAMFS_CHUNK_SIZE < 1
+#error "RT_DFS_RAMFS_CHUNK_SIZE must be at least 1"
+#endif
+#if RT_DFS_RAMFS_HASH_SIZE < 1
+#error "RT_DFS_RAMFS_HASH_SIZE must be at least 1"
+#endif
+
+#define RAMFS_TYPE_FILE 0
+#define RAMFS_TYPE_DIR  1
+
 struct ramfs_dirent
 {
-    rt_list_t list;
+    rt_list_t list;             /* node in the entries of the parent directory */
+    rt_list_t hlist;            /* node in the name hash table */
     struct dfs_ramfs *fs;       /* file system ref */
+    struct ramfs_dirent *parent;
+    rt_list_t children;         /* entries of a directory */
 
     char name[RAMFS_NAME_MAX];  /* dirent name */
-    rt_uint8_t *data;
+    rt_uint8_t type;
+
+    rt_uint8_t **chunks;        /* data chunks of a file, RT_NULL for a hole */
+    rt_size_t chunk_max;        /* number of slots in the chunk table */
 
     rt_size_t size;             /* file size */
 };
@@ -38,6 +63,8 @@ struct dfs_ramfs
 
     struct rt_memheap memheap;
     struct ramfs_dirent root;
+
+    rt_list_t hash[RT_DFS_RAMFS_HASH_SIZE];
 };
 
 int dfs_ramfs_init(void);
@@ -303,7 +303,7 @@ static const struct dfs_file_ops _rom_fops =
 static const struct dfs_filesystem_ops _romfs =
 {
     "rom",
-    DFS_FS_FLAG_DEFAULT,
+    DFS_FS_FLAG_CACHE,
     &_rom_fops,
 
     dfs_romfs_mount,
@@ -55,6 +55,8 @@ extern "C" {
 
 #define DFS_FS_FLAG_DEFAULT     0x00    /* default flag */
 #define DFS_FS_FLAG_FULLPATH    0x01    /* set full path to underlaying file system */
+#define DFS_FS_FLAG_CACHE       0x02    /* the lookups can be cached, the files only change through DFS */
+#define DFS_FS_FLAG_NOCASE      0x04    /* the file names are not case sensitive */
 
 /* File types */
 #define FT_REGULAR               0   /* regular file */
@@ -68,6 +68,8 @@ int dfs_file_stat(const char *path, struct stat *buf);
 int dfs_file_rename(const char *oldpath, const char *newpath);
 int dfs_file_ftruncate(struct dfs_fd *fd, off_t length);
 
+void dfs_file_close_sethook(void (*hook)(struct dfs_fd *fd));
+
 /* 0x5254 is just a magic number to make these relatively unique ("RT") */
 #define RT_FIOFTRUNCATE 0x52540000U
 
@@ -25,4 +25,18 @@ extern const struct dfs_mount_tbl mount_table[];
 
 extern char working_directory[];
 
+#ifdef DFS_USING_DENTRY_CACHE
+int dfs_dentry_lookup(struct dfs_filesystem *fs, const char *path, struct stat *buf);
+uint32_t dfs_dentry_generation(void);
+void dfs_dentry_insert(struct dfs_filesystem *fs, const char *path, const struct stat *buf, uint32_t generation);
+void dfs_dentry_invalidate(struct dfs_filesystem *fs, const char *path);
+void dfs_dentry_flush(void);
+#else
+#define dfs_dentry_lookup(fs, path, buf)                1
+#define dfs_dentry_generation()                         0
+#define dfs_dentry_insert(fs, path, buf, generation)    RT_UNUSED(generation)
+#define dfs_dentry_invalidate(fs, path)
+#define dfs_dentry_flush()
+#endif /* DFS_USING_DENTRY_CACHE */
+
 #endif
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <dfs.h>
+#include <dfs_fs.h>
+#include <dfs_private.h>
+
+/*
+ * A small cache of the results of stat(), the files found with their
+ * attributes and the files not found, so that opening or checking the same
+ * paths again does not walk the directories of the file system. The entries
+ * are keyed by the file system and the path given to it, and kept in the
+ * least recently used order.
+ *
+ * Only the file systems with DFS_FS_FLAG_CACHE are cached, which must not be
+ * changed but through DFS. An entry is dropped with the one of its parent
+ * directory when its file is created, written, truncated or closed. An unlink
+ * or a rename drops all the entries of the file system, as a directory or
+ * another name of the file can be affected, and a mount or an unmount drops
+ * all the entries.
+ *
+ * The file system is asked without the lock, so a change can be made while a
+ * result is on its way to the cache. Every drop increases the generation, and
+ * a result is only cached if the generation is still the one taken before the
+ * file system was asked.
+ */
+
+#ifdef DFS_USING_DENTRY_CACHE
+
+#ifndef DFS_DENTRY_CACHE_SIZE
+#define DFS_DENTRY_CACHE_SIZE   16
+#endif
+
+struct dfs_dentry
+{
+    rt_list_t list;                 /* node of the LRU list, the most recent first */
+    struct dfs_filesystem *fs;      /* RT_NULL if the entry is not used */
+    char *path;
+    uint32_t hash;
+    int result;                     /* 0 or -ENOENT */
+    struct stat st;
+};
+
+static struct dfs_dentry _dentry[DFS_DENTRY_CACHE_SIZE];
+static rt_list_t _dentry_lru = RT_LIST_OBJECT_INIT(_dentry_lru);
+static volatile uint32_t _dentry_generation;
+
+static rt_bool_t dfs_dentry_enabled(struct dfs_filesystem *fs)
+{
+    return fs != RT_NULL && fs->ops != RT_NULL && (fs->ops->flags & DFS_FS_FLAG_CACHE);
+}
+
+static char dfs_dentry_fold(struct dfs_filesystem *fs, char ch)
+{
+    if ((fs->ops->flags & DFS_FS_FLAG_NOCASE) && ch >= 'A' && ch <= 'Z')
+        return ch - 'A' + 'a';
+
+    return ch;
+}
+
+/* the hash of the first len characters of the path */
+static uint32_t dfs_dentry_hash(struct dfs_filesystem *fs, const char *path, size_t len)
+{
+    uint32_t hash = 5381;
+
+    while (len--)
+        hash = hash * 33 + (uint8_t)dfs_dentry_fold(fs, *path++);
+
+    return hash;
+}
+
+static int dfs_dentry_match(struct dfs_dentry *dentry, struct dfs_filesystem *fs,
+                            const char *path, size_t len, uint32_t hash)
+{
+    const char *s = dentry->path;
+
+    if (dentry->fs != fs || dentry->hash != hash)
+        return 0;
+
+    while (len && *s && dfs_dentry_fold(fs, *s) == dfs_dentry_fold(fs, *path))
+    {
+        s++;
+        path++;
+        len--;
+    }
+
+    return *s == '\0' && len == 0;
+}
+
+static struct dfs_dentry *dfs_dentry_find(struct dfs_filesystem *fs, const char *path, uint32_t hash)
+{
+    struct dfs_dentry *dentry;
+    size_t len = rt_strlen(path);
+
+    rt_list_for_each_entry(dentry, &_dentry_lru, list)
+    {
+        if (dentry->fs == RT_NULL)
+            break;
+
+        if (dfs_dentry_match(dentry, fs, path, len, hash))
+            return dentry;
+    }
+
+    return RT_NULL;
+}
+
+static void dfs_dentry_free(struct dfs_dentry *dentry)
+{
+    rt_free(dentry->path);
+    dentry->path = RT_NULL;
+    dentry->fs = RT_NULL;
+
+    /* the unused entries are at the tail */
+    rt_list_remove(&dentry->list);
+    rt_list_insert_before(&_dentry_lru, &dentry->list);
+}
+
+static void dfs_dentry_init(void)
+{
+    int index;
+
+    if (!rt_list_isempty(&_dentry_lru))
+        return;
+
+    for (index = 0; index < DFS_DENTRY_CACHE_SIZE; index ++)
+        rt_list_insert_before(&_dentry_lru, &_dentry[index].list);
+}
+
+/**
+ * this function will look up the cached result of a stat.
+ *
+ * @param fs the file system of the file.
+ * @param path the path of the file in the file system.
+ * @param buf the buffer to save the attributes of a file found.
+ *
+ * @return 0 if the file is found, -ENOENT if it is not, 1 if it is not cached.
+ */
+int dfs_dentry_lookup(struct dfs_filesystem *fs, const char *path, struct stat *buf)
+{
+    struct dfs_dentry *dentry;
+    int result = 1;
+
+    if (!dfs_dentry_enabled(fs))
+        return 1;
+
+    dfs_lock();
+    dentry = dfs_dentry_find(fs, path, dfs_dentry_hash(fs, path, rt_strlen(path)));
+    if (dentry)
+    {
+        result = dentry->result;
+        if (result == 0 && buf)
+            rt_memcpy(buf, &dentry->st, sizeof(struct stat));
+
+        rt_list_remove(&dentry->list);
+        rt_list_insert_after(&_dentry_lru, &dentry->list);
+    }
+    dfs_unlock();
+
+    return result;
+}
+
+/**
+ * this function will return the generation of the cache, which is to be taken
+ * before the file system is asked for the result to cache.
+ *
+ * @return the generation of the cache.
+ */
+uint32_t dfs_dentry_generation(void)
+{
+    return _dentry_generation;
+}
+
+/**
+ * this function will cache the result of a stat.
+ *
+ * @param fs the file system of the file.
+ * @param path the path of the file in the file system.
+ * @param buf the attributes of the file, RT_NULL if it is not found.
+ * @param generation the generation of the cache before the stat.
+ */
+void dfs_dentry_insert(struct dfs_filesystem *fs, const char *path, const struct stat *buf, uint32_t generation)
+{
+    struct dfs_dentry *dentry;
+    uint32_t hash;
+    char *dup;
+
+    if (!dfs_dentry_enabled(fs))
+        return;
+
+    dup = rt_strdup(path);
+    if (dup == RT_NULL)
+        return;
+
+    hash = dfs_dentry_hash(fs, path, rt_strlen(path));
+
+    dfs_lock();
+    /* the file may have been changed during the stat */
+    if (generation != _dentry_generation)
+    {
+        dfs_unlock();
+        rt_free(dup);
+        return;
+    }
+    dfs_dentry_init();
+
+    dentry = dfs_dentry_find(fs, path, hash);
+    if (dentry == RT_NULL)
+    {
+        /* take the least recently used entry */
+        dentry = rt_list_entry(_dentry_lru.prev, struct dfs_dentry, list);
+    }
+    rt_free(dentry->path);
+
+    dentry->fs = fs;
+    dentry->path = dup;
+    dentry->hash = hash;
+    dentry->result = buf ? 0 : -ENOENT;
+    if (buf)
+        rt_memcpy(&dentry->st, buf, sizeof(struct stat));
+
+    rt_list_remove(&dentry->list);
+    rt_list_insert_after(&_dentry_lru, &dentry->list);
+    dfs_unlock();
+}
+
+/**
+ * this function will drop the cached entries of a file system.
+ *
+ * @param fs the file system.
+ * @param path the path of the file in the file system, RT_NULL for all files.
+ *             The entry of its parent directory is dropped too.
+ */
+void dfs_dentry_invalidate(struct dfs_filesystem *fs, const char *path)
+{
+    struct dfs_dentry *dentry, *next;
+    uint32_t hash = 0, parent_hash = 0;
+    size_t len = 0, parent_len = 0;
+
+    if (!dfs_dentry_enabled(fs))
+        return;
+
+    if (path)
+    {
+        len = rt_strlen(path);
+        hash = dfs_dentry_hash(fs, path, len);
+
+        /* "/d/f" in "/d", "/f" in "/" */
+        for (parent_len = len; parent_len > 0 && path[parent_len - 1] != '/'; parent_len --);
+        if (parent_len > 1)
+            parent_len --;
+        parent_hash = dfs_dentry_hash(fs, path, parent_len);
+    }
+
+    dfs_lock();
+    _dentry_generation ++;
+    rt_list_for_each_entry_safe(dentry, next, &_dentry_lru, list)
+    {
+        if (dentry->fs == RT_NULL)
+            break;
+
+        if (dentry->fs == fs && (path == RT_NULL
+                                 || dfs_dentry_match(dentry, fs, path, len, hash)
+                                 || (parent_len && dfs_dentry_match(dentry, fs, path, parent_len, parent_hash))))
+            dfs_dentry_free(dentry);
+    }
+    dfs_unlock();
+}
+
+/**
+ * this function will drop all the cached entries.
+ */
+void dfs_dentry_flush(void)
+{
+    struct dfs_dentry *dentry, *next;
+
+    dfs_lock();
+    _dentry_generation ++;
+    rt_list_for_each_entry_safe(dentry, next, &_dentry_lru, list)
+    {
+        if (dentry->fs == RT_NULL)
+            break;
+
+        dfs_dentry_free(dentry);
+    }
+    dfs_unlock();
+}
+
+#endif /* DFS_USING_DENTRY_CACHE */
@@ -21,6 +21,38 @@
 
 /*@{*/
 
+static void (*dfs_file_close_hook)(struct dfs_fd *fd);
+
+/**
+ * This function will set a hook function, which will be invoked before a file
+ * descriptor is closed, so that the modules holding the file can detach it.
+ *
+ * @param hook the hook function.
+ */
+void dfs_file_close_sethook(void (*hook)(struct dfs_fd *fd))
+{
+    dfs_file_close_hook = hook;
+}
+
+/* the path of the file given to its file system */
+static const char *dfs_file_fspath(struct dfs_filesystem *fs, const char *fullpath)
+{
+    if (fs->ops->flags & DFS_FS_FLAG_FULLPATH)
+        return fullpath;
+
+    if (dfs_subdir(fs->path, fullpath) == NULL)
+        return "/";
+
+    return dfs_subdir(fs->path, fullpath);
+}
+
+/* drop the cached attributes of a file which may be changed through the fd */
+static void dfs_file_invalidate(struct dfs_fd *fd)
+{
+    if (fd->fs && fd->path && (fd->flags & O_ACCMODE) != O_RDONLY)
+        dfs_dentry_invalidate(fd->fs, fd->path);
+}
+
 /**
  * this function will open a file which specified by path with specified flags.
  *
@@ -33,6 +65,7 @@
 int dfs_file_open(struct dfs_fd *fd, const char *path, int flags)
 {
     struct dfs_filesystem *fs;
+    uint32_t generation;
     char *fullpath;
     int result;
 
@@ -58,6 +91,14 @@ int dfs_file_open(struct dfs_fd *fd, const char *path, int flags)
         return -ENOENT;
     }
 
+    /* a file known to be missing */
+    if (!(flags & O_CREAT) && dfs_dentry_lookup(fs, dfs_file_fspath(fs, fullpath), NULL) == -ENOENT)
+    {
+        rt_free(fullpath);
+
+        return -ENOENT;
+    }
+
     LOG_D("open in filesystem:%s", fs->ops->name);
     fd->fs    = fs;             /* set file system */
     fd->fops  = fs->ops->fops;  /* set file ops */
@@ -93,7 +134,14 @@ int dfs_file_open(struct dfs_fd *fd, const char *path, int flags)
         return -ENOSYS;
     }
 
-    if ((result = fd->fops->open(fd)) < 0)
+    generation = dfs_dentry_generation();
+    result = fd->fops->open(fd);
+    if (flags & (O_CREAT | O_TRUNC))
+        dfs_dentry_invalidate(fs, fd->path);
+    else if (result == -ENOENT)
+        dfs_dentry_insert(fs, fd->path, NULL, generation);
+
+    if (result < 0)
     {
         /* clear fd */
         rt_free(fd->path);
@@ -129,6 +177,9 @@ int dfs_file_close(struct dfs_fd *fd)
     if (fd == NULL)
         return -ENXIO;
 
+    if (dfs_file_close_hook != NULL)
+        dfs_file_close_hook(fd);
+
     if (fd->fops->close != NULL)
         result = fd->fops->close(fd);
 
@@ -136,6 +187,7 @@ int dfs_file_close(struct dfs_fd *fd)
     if (result < 0)
         return result;
 
+    dfs_file_invalidate(fd);
     rt_free(fd->path);
     fd->path = NULL;
 
@@ -274,6 +326,9 @@ int dfs_file_unlink(const char *path)
         }
         else
             result = fs->ops->unlink(fs, fullpath);
+
+        /* a directory or another name of the file may be cached */
+        dfs_dentry_invalidate(fs, NULL);
     }
     else result = -ENOSYS;
 
@@ -293,13 +348,18 @@ __exit:
  */
 int dfs_file_write(struct dfs_fd *fd, const void *buf, size_t len)
 {
+    int result;
+
     if (fd == NULL)
         return -EINVAL;
 
     if (fd->fops->write == NULL)
         return -ENOSYS;
 
-    return fd->fops->write(fd, buf, len);
+    result = fd->fops->write(fd, buf, len);
+    dfs_file_invalidate(fd);
+
+    return result;
 }
 
 /**
@@ -311,13 +371,18 @@ int dfs_file_write(struct dfs_fd *fd, const void *buf, size_t len)
  */
 int dfs_file_flush(struct dfs_fd *fd)
 {
+    int result;
+
     if (fd == NULL)
         return -EINVAL;
 
     if (fd->fops->flush == NULL)
         return -ENOSYS;
 
-    return fd->fops->flush(fd);
+    result = fd->fops->flush(fd);
+    dfs_file_invalidate(fd);
+
+    return result;
 }
 
 /**
@@ -360,6 +425,7 @@ int dfs_file_stat(const char *path, struct stat *buf)
     int result;
     char *fullpath;
     struct dfs_filesystem *fs;
+    uint32_t generation;
 
     fullpath = dfs_normalize_path(NULL, path);
     if (fullpath == NULL)
@@ -404,10 +470,16 @@ int dfs_file_stat(const char *path, struct stat *buf)
         }
 
         /* get the real file path and get file stat */
-        if (fs->ops->flags & DFS_FS_FLAG_FULLPATH)
-            result = fs->ops->stat(fs, fullpath, buf);
-        else
-            result = fs->ops->stat(fs, dfs_subdir(fs->path, fullpath), buf);
+        result = dfs_dentry_lookup(fs, dfs_file_fspath(fs, fullpath), buf);
+        if (result > 0)
+        {
+            generation = dfs_dentry_generation();
+            result = fs->ops->stat(fs, dfs_file_fspath(fs, fullpath), buf);
+            if (result == 0)
+                dfs_dentry_insert(fs, dfs_file_fspath(fs, fullpath), buf, generation);
+            else if (result == -ENOENT)
+                dfs_dentry_insert(fs, dfs_file_fspath(fs, fullpath), NULL, generation);
+        }
     }
 
     rt_free(fullpath);
@@ -465,6 +537,9 @@ int dfs_file_rename(const char *oldpath, const char *newpath)
                 result = oldfs->ops->rename(oldfs,
                                             dfs_subdir(oldfs->path, oldfullpath),
                                             dfs_subdir(newfs->path, newfullpath));
+
+            /* the entries under a directory move with it */
+            dfs_dentry_invalidate(oldfs, NULL);
         }
     }
     else
@@ -501,6 +576,7 @@ int dfs_file_ftruncate(struct dfs_fd *fd, off_t length)
         return -ENOSYS;
 
     result = fd->fops->ioctl(fd, RT_FIOFTRUNCATE, (void*)&length);
+    dfs_file_invalidate(fd);
 
     /* update current size */
     if (result == 0)
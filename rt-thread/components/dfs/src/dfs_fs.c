@@ -16,6 +16,103 @@
 #include <dfs_file.h>
 #include "dfs_private.h"
 
+/*
+ * The mount points are kept in a tree of their path names, so the file system
+ * of a path is found by walking its names once, whatever the number of mounted
+ * file systems. The tree is protected by the DFS lock.
+ */
+struct dfs_mnt_node
+{
+    struct dfs_mnt_node *child;
+    struct dfs_mnt_node *sibling;
+    struct dfs_filesystem *fs;      /* the file system mounted here, NULL if none */
+    size_t len;
+    char name[1];
+};
+
+static struct dfs_mnt_node mnt_root;
+
+/* the next name of a path and its length, NULL at the end */
+static const char *dfs_mnt_next(const char *path, size_t *len)
+{
+    while (*path == '/')
+        path++;
+
+    for (*len = 0; path[*len] != '\0' && path[*len] != '/'; (*len)++);
+
+    return *len ? path : NULL;
+}
+
+static struct dfs_mnt_node *dfs_mnt_child(struct dfs_mnt_node *node, const char *name, size_t len)
+{
+    for (node = node->child; node; node = node->sibling)
+    {
+        if (node->len == len && strncmp(node->name, name, len) == 0)
+            break;
+    }
+
+    return node;
+}
+
+static int dfs_mnt_insert(struct dfs_filesystem *fs)
+{
+    struct dfs_mnt_node *node = &mnt_root, *child;
+    const char *name = fs->path;
+    size_t len;
+
+    while ((name = dfs_mnt_next(name, &len)) != NULL)
+    {
+        child = dfs_mnt_child(node, name, len);
+        if (child == NULL)
+        {
+            child = (struct dfs_mnt_node *)rt_calloc(1, sizeof(struct dfs_mnt_node) + len);
+            if (child == NULL)
+                return -ENOMEM;
+
+            rt_memcpy(child->name, name, len);
+            child->len = len;
+            child->sibling = node->child;
+            node->child = child;
+        }
+
+        node = child;
+        name += len;
+    }
+
+    node->fs = fs;
+
+    return 0;
+}
+
+/* remove the file system from the sub tree, and the nodes left empty */
+static void dfs_mnt_remove(struct dfs_mnt_node *node, struct dfs_filesystem *fs, const char *name)
+{
+    struct dfs_mnt_node **iter, *child;
+    size_t len;
+
+    name = dfs_mnt_next(name, &len);
+    if (name == NULL)
+    {
+        if (node->fs == fs)
+            node->fs = NULL;
+        return;
+    }
+
+    for (iter = &node->child; (child = *iter) != NULL; iter = &child->sibling)
+    {
+        if (child->len == len && strncmp(child->name, name, len) == 0)
+        {
+            dfs_mnt_remove(child, fs, name + len);
+            if (child->fs == NULL && child->child == NULL)
+            {
+                *iter = child->sibling;
+                rt_free(child);
+            }
+            break;
+        }
+    }
+}
+
 /**
  * @addtogroup FsApi
  */
@@ -77,35 +174,30 @@ int dfs_register(const struct dfs_filesystem_ops *ops)
  */
 struct dfs_filesystem *dfs_filesystem_lookup(const char *path)
 {
-    struct dfs_filesystem *iter;
-    struct dfs_filesystem *fs = NULL;
-    uint32_t fspath, prefixlen;
-
-    prefixlen = 0;
+    struct dfs_mnt_node *node = &mnt_root;
+    struct dfs_filesystem *fs;
+    size_t len;
 
     RT_ASSERT(path);
 
+    /* only an absolute path is mounted */
+    if (path[0] != '/')
+        return NULL;
+
     /* lock filesystem */
     dfs_lock();
 
-    /* lookup it in the filesystem table */
-    for (iter = &filesystem_table[0];
-            iter < &filesystem_table[DFS_FILESYSTEMS_MAX]; iter++)
+    /* the deepest mount point on the path */
+    fs = node->fs;
+    while ((path = dfs_mnt_next(path, &len)) != NULL)
     {
-        if ((iter->path == NULL) || (iter->ops == NULL))
-            continue;
-
-        fspath = strlen(iter->path);
-        if ((fspath < prefixlen)
-            || (strncmp(iter->path, path, fspath) != 0))
-            continue;
-
-        /* check next path separator */
-        if (fspath > 1 && (strlen(path) > fspath) && (path[fspath] != '/'))
-            continue;
+        node = dfs_mnt_child(node, path, len);
+        if (node == NULL)
+            break;
 
-        fs = iter;
-        prefixlen = fspath;
+        if (node->fs != NULL)
+            fs = node->fs;
+        path += len;
     }
 
     dfs_unlock();
@@ -312,6 +404,15 @@ int dfs_mount(const char   *device_name,
     fs->path   = fullpath;
     fs->ops    = *ops;
     fs->dev_id = dev_id;
+    if (dfs_mnt_insert(fs) < 0)
+    {
+        dfs_mnt_remove(&mnt_root, fs, fullpath);
+        rt_memset(fs, 0, sizeof(struct dfs_filesystem));
+        rt_set_errno(-ENOMEM);
+        goto err1;
+    }
+    /* the paths under the mount point are now in the new file system */
+    dfs_dentry_flush();
     /* release filesystem_table lock */
     dfs_unlock();
 
@@ -323,6 +424,7 @@ int dfs_mount(const char   *device_name,
         {
             /* The underlying device has error, clear the entry. */
             dfs_lock();
+            dfs_mnt_remove(&mnt_root, fs, fullpath);
             rt_memset(fs, 0, sizeof(struct dfs_filesystem));
 
             goto err1;
@@ -339,6 +441,7 @@ int dfs_mount(const char   *device_name,
         /* mount failed */
         dfs_lock();
         /* clear filesystem table entry */
+        dfs_mnt_remove(&mnt_root, fs, fullpath);
         rt_memset(fs, 0, sizeof(struct dfs_filesystem));
 
         goto err1;
@@ -400,7 +503,11 @@ int dfs_unmount(const char *specialfile)
         rt_device_close(fs->dev_id);
 
     if (fs->path != NULL)
+    {
+        dfs_mnt_remove(&mnt_root, fs, fs->path);
         rt_free(fs->path);
+    }
+    dfs_dentry_flush();
 
     /* clear this filesystem table entry */
     rt_memset(fs, 0, sizeof(struct dfs_filesystem));
@@ -587,7 +694,11 @@ int dfs_unmount_device(rt_device_t dev)
         rt_device_close(fs->dev_id);
 
     if (fs->path != NULL)
+    {
+        dfs_mnt_remove(&mnt_root, fs, fs->path);
         rt_free(fs->path);
+    }
+    dfs_dentry_flush();
 
     /* clear this filesystem table entry */
     rt_memset(fs, 0, sizeof(struct dfs_filesystem));
@@ -0,0 +1,655 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <string.h>
+
+#define DBG_TAG    "blk.cache"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+/*
+ * A block device which caches the sectors of another one, the file systems
+ * mounted on it share the cached sectors.
+ *
+ * The sectors are kept in the least recently used order. A read of missed
+ * sectors is done by one device request, which also reads the next
+ * RT_BLK_CACHE_READ_AHEAD sectors when the request follows the previous one.
+ * The written sectors are kept dirty and written back RT_BLK_CACHE_WRITE_DELAY
+ * ms later, on RT_DEVICE_CTRL_BLK_SYNC or on close, the adjacent ones by one
+ * device request. A delayed write back which fails is tried again after the
+ * same delay. The requests of half the cache or more go to the device.
+ */
+
+#ifndef RT_BLK_CACHE_SECTORS
+#define RT_BLK_CACHE_SECTORS        32
+#endif
+#ifndef RT_BLK_CACHE_READ_AHEAD
+#define RT_BLK_CACHE_READ_AHEAD     8
+#endif
+#ifndef RT_BLK_CACHE_WRITE_DELAY
+#define RT_BLK_CACHE_WRITE_DELAY    1000
+#endif
+
+#if RT_BLK_CACHE_SECTORS < 4
+#error "RT_BLK_CACHE_SECTORS must be at least 4"
+#endif
+
+#if defined(RT_USING_SYSTEM_WORKQUEUE) && (RT_BLK_CACHE_WRITE_DELAY > 0)
+#define BLK_CACHE_USING_DELAYED_WRITE
+#endif
+
+#define BLK_CACHE_NONE              0xFFFFFFFF
+/* the requests of this size or more bypass the cache */
+#define BLK_CACHE_BYPASS_SECTORS    (RT_BLK_CACHE_SECTORS / 2)
+/* the sectors of a device request from the cache */
+#define BLK_CACHE_IO_SECTORS        (RT_BLK_CACHE_READ_AHEAD + 1 < BLK_CACHE_BYPASS_SECTORS ? \
+                                     RT_BLK_CACHE_READ_AHEAD + 1 : BLK_CACHE_BYPASS_SECTORS)
+
+struct blk_cache_buf
+{
+    rt_list_t lru;                  /* node of the LRU list, the most recent first */
+    rt_list_t hash;                 /* node of the hash list of the sector */
+    rt_uint32_t sector;             /* BLK_CACHE_NONE if unused */
+    rt_bool_t dirty;
+    rt_uint8_t *data;
+};
+
+struct rt_blk_cache
+{
+    struct rt_device parent;
+    rt_device_t dev;
+    struct rt_device_blk_geometry geometry;
+    struct rt_mutex lock;
+
+    struct blk_cache_buf bufs[RT_BLK_CACHE_SECTORS];
+    rt_list_t lru;
+    rt_list_t hash[RT_BLK_CACHE_SECTORS];
+    rt_uint32_t dirty_count;
+    rt_uint32_t seq_next;           /* the sector after the last read */
+    rt_uint8_t *io_buf;             /* BLK_CACHE_IO_SECTORS sectors */
+
+    struct rt_blk_cache_stat stat;
+#ifdef BLK_CACHE_USING_DELAYED_WRITE
+    struct rt_work flush_work;
+    rt_bool_t flush_pending;
+#endif
+};
+
+static struct blk_cache_buf *blk_cache_find(struct rt_blk_cache *cache, rt_uint32_t sector)
+{
+    struct blk_cache_buf *buf;
+
+    rt_list_for_each_entry(buf, &cache->hash[sector % RT_BLK_CACHE_SECTORS], hash)
+    {
+        if (buf->sector == sector)
+            return buf;
+    }
+
+    return RT_NULL;
+}
+
+static void blk_cache_touch(struct rt_blk_cache *cache, struct blk_cache_buf *buf)
+{
+    rt_list_remove(&buf->lru);
+    rt_list_insert_after(&cache->lru, &buf->lru);
+}
+
+static void blk_cache_drop(struct rt_blk_cache *cache, struct blk_cache_buf *buf)
+{
+    if (buf->dirty)
+    {
+        buf->dirty = RT_FALSE;
+        cache->dirty_count--;
+    }
+
+    rt_list_remove(&buf->hash);
+    rt_list_init(&buf->hash);
+    buf->sector = BLK_CACHE_NONE;
+
+    /* reused first */
+    rt_list_remove(&buf->lru);
+    rt_list_insert_before(&cache->lru, &buf->lru);
+}
+
+/* write back the dirty sectors in the order of the device, the adjacent ones by one request */
+static rt_err_t blk_cache_flush(struct rt_blk_cache *cache)
+{
+    struct blk_cache_buf *buf, *first;
+    rt_uint32_t ss = cache->geometry.bytes_per_sector;
+    rt_size_t count, index;
+
+    while (cache->dirty_count)
+    {
+        first = RT_NULL;
+        for (index = 0; index < RT_BLK_CACHE_SECTORS; index++)
+        {
+            buf = &cache->bufs[index];
+            if (buf->dirty && (first == RT_NULL || buf->sector < first->sector))
+                first = buf;
+        }
+
+        buf = first;
+        count = 0;
+        do
+        {
+            rt_memcpy(cache->io_buf + count * ss, buf->data, ss);
+            count++;
+            buf = blk_cache_find(cache, first->sector + count);
+        } while (count < BLK_CACHE_IO_SECTORS && buf && buf->dirty);
+
+        cache->stat.dev_write++;
+        if (rt_device_write(cache->dev, first->sector, cache->io_buf, count) != count)
+        {
+            LOG_E("write back the sectors %d-%d failed.", first->sector, first->sector + count - 1);
+            return -RT_EIO;
+        }
+
+        for (index = 0; index < count; index++)
+        {
+            buf = blk_cache_find(cache, first->sector + index);
+            buf->dirty = RT_FALSE;
+        }
+        cache->dirty_count -= count;
+        cache->stat.write_back += count;
+    }
+
+    return RT_EOK;
+}
+
+/* take the least recently used buffer for the sector, its data are to be filled */
+static struct blk_cache_buf *blk_cache_alloc(struct rt_blk_cache *cache, rt_uint32_t sector)
+{
+    struct blk_cache_buf *buf;
+
+    buf = rt_list_entry(cache->lru.prev, struct blk_cache_buf, lru);
+    if (buf->dirty && blk_cache_flush(cache) != RT_EOK)
+        return RT_NULL;
+
+    rt_list_remove(&buf->hash);
+    buf->sector = sector;
+    rt_list_insert_after(&cache->hash[sector % RT_BLK_CACHE_SECTORS], &buf->hash);
+    blk_cache_touch(cache, buf);
+
+    return buf;
+}
+
+#ifdef BLK_CACHE_USING_DELAYED_WRITE
+static void blk_cache_flush_work(struct rt_work *work, void *work_data)
+{
+    struct rt_blk_cache *cache = (struct rt_blk_cache *)work_data;
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    cache->flush_pending = RT_FALSE;
+    if (blk_cache_flush(cache) != RT_EOK)
+    {
+        /* the sectors not written stay dirty, try again later */
+        cache->flush_pending = RT_TRUE;
+        rt_work_submit(&cache->flush_work, rt_tick_from_millisecond(RT_BLK_CACHE_WRITE_DELAY));
+    }
+    rt_mutex_release(&cache->lock);
+}
+#endif
+
+/* read the missed sectors from pos, and the ones ahead, then copy the wanted ones */
+static rt_size_t blk_cache_fill(struct rt_blk_cache *cache, rt_uint32_t pos, rt_uint8_t *ptr,
+                                rt_size_t count, rt_size_t ahead)
+{
+    struct blk_cache_buf *run[BLK_CACHE_IO_SECTORS];
+    rt_uint32_t ss = cache->geometry.bytes_per_sector;
+    rt_size_t index, total = count + ahead;
+
+    /* the buffers are taken first, as a write back uses the I/O buffer */
+    for (index = 0; index < total; index++)
+    {
+        run[index] = blk_cache_alloc(cache, pos + index);
+        if (run[index] == RT_NULL)
+            break;
+    }
+
+    cache->stat.dev_read++;
+    if (index < total || rt_device_read(cache->dev, pos, cache->io_buf, total) != total)
+    {
+        while (index--)
+            blk_cache_drop(cache, run[index]);
+        return 0;
+    }
+
+    for (index = 0; index < total; index++)
+        rt_memcpy(run[index]->data, cache->io_buf + index * ss, ss);
+    rt_memcpy(ptr, cache->io_buf, count * ss);
+
+    cache->stat.read_miss += count;
+    cache->stat.read_ahead += ahead;
+
+    return count;
+}
+
+static rt_err_t blk_cache_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    struct rt_blk_cache *cache = (struct rt_blk_cache *)dev;
+
+    /* the device is opened once for all the users of the cache */
+    if (dev->open_flag & RT_DEVICE_OFLAG_OPEN)
+        return RT_EOK;
+
+    return rt_device_open(cache->dev, oflag);
+}
+
+static rt_err_t blk_cache_close(rt_device_t dev)
+{
+    struct rt_blk_cache *cache = (struct rt_blk_cache *)dev;
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    blk_cache_flush(cache);
+    rt_mutex_release(&cache->lock);
+
+    return rt_device_close(cache->dev);
+}
+
+static rt_size_t blk_cache_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    struct rt_blk_cache *cache = (struct rt_blk_cache *)dev;
+    rt_uint32_t ss = cache->geometry.bytes_per_sector;
+    rt_uint8_t *ptr = (rt_uint8_t *)buffer;
+    struct blk_cache_buf *buf;
+    rt_size_t done = 0, count, ahead, index;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+
+    if (size >= BLK_CACHE_BYPASS_SECTORS)
+    {
+        cache->stat.dev_read++;
+        if (rt_device_read(cache->dev, pos, buffer, size) == size)
+        {
+            /* the dirty sectors are newer than the device */
+            for (index = 0; index < RT_BLK_CACHE_SECTORS; index++)
+            {
+                buf = &cache->bufs[index];
+                if (buf->dirty && buf->sector >= pos && buf->sector < pos + size)
+                    rt_memcpy(ptr + (buf->sector - pos) * ss, buf->data, ss);
+            }
+            cache->stat.read_miss += size;
+            done = size;
+        }
+    }
+
+    while (done < size)
+    {
+        buf = blk_cache_find(cache, pos + done);
+        if (buf)
+        {
+            rt_memcpy(ptr + done * ss, buf->data, ss);
+            blk_cache_touch(cache, buf);
+            cache->stat.read_hit++;
+            done++;
+            continue;
+        }
+
+        /* the run of the missed sectors */
+        for (count = 1; done + count < size && count < BLK_CACHE_IO_SECTORS; count++)
+        {
+            if (blk_cache_find(cache, pos + done + count))
+                break;
+        }
+
+        /* read ahead when the run ends the request which follows the previous one */
+        ahead = 0;
+        if (done + count == size && pos == cache->seq_next)
+        {
+            while (count + ahead < BLK_CACHE_IO_SECTORS && ahead < RT_BLK_CACHE_READ_AHEAD
+                    && pos + size + ahead < cache->geometry.sector_count
+                    && blk_cache_find(cache, pos + size + ahead) == RT_NULL)
+            {
+                ahead++;
+            }
+        }
+
+        if (blk_cache_fill(cache, pos + done, ptr + done * ss, count, ahead) != count)
+            break;
+        done += count;
+    }
+
+    cache->seq_next = pos + done;
+    rt_mutex_release(&cache->lock);
+
+    return done;
+}
+
+static rt_size_t blk_cache_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    struct rt_blk_cache *cache = (struct rt_blk_cache *)dev;
+    rt_uint32_t ss = cache->geometry.bytes_per_sector;
+    const rt_uint8_t *ptr = (const rt_uint8_t *)buffer;
+    struct blk_cache_buf *buf;
+    rt_size_t done = 0, index;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+
+    if (size >= BLK_CACHE_BYPASS_SECTORS)
+    {
+        cache->stat.dev_write++;
+        done = rt_device_write(cache->dev, pos, buffer, size);
+
+        /* the cached sectors take the written data */
+        for (index = 0; index < RT_BLK_CACHE_SECTORS; index++)
+        {
+            buf = &cache->bufs[index];
+            if (buf->sector != BLK_CACHE_NONE && buf->sector >= pos && buf->sector < pos + done)
+            {
+                rt_memcpy(buf->data, ptr + (buf->sector - pos) * ss, ss);
+                if (buf->dirty)
+                {
+                    buf->dirty = RT_FALSE;
+                    cache->dirty_count--;
+                }
+            }
+        }
+        cache->stat.write_miss += done;
+    }
+    else
+    {
+        for (; done < size; done++)
+        {
+            buf = blk_cache_find(cache, pos + done);
+            if (buf)
+            {
+                blk_cache_touch(cache, buf);
+                cache->stat.write_hit++;
+            }
+            else
+            {
+                buf = blk_cache_alloc(cache, pos + done);
+                if (buf == RT_NULL)
+                    break;
+                cache->stat.write_miss++;
+            }
+
+            rt_memcpy(buf->data, ptr + done * ss, ss);
+            if (!buf->dirty)
+            {
+                buf->dirty = RT_TRUE;
+                cache->dirty_count++;
+            }
+        }
+    }
+
+#ifdef BLK_CACHE_USING_DELAYED_WRITE
+    /* leave the clean buffers for the reads */
+    if (cache->dirty_count > RT_BLK_CACHE_SECTORS * 3 / 4)
+    {
+        blk_cache_flush(cache);
+    }
+    else if (cache->dirty_count && !cache->flush_pending)
+    {
+        cache->flush_pending = RT_TRUE;
+        rt_work_submit(&cache->flush_work, rt_tick_from_millisecond(RT_BLK_CACHE_WRITE_DELAY));
+    }
+#else
+    blk_cache_flush(cache);
+#endif
+
+    rt_mutex_release(&cache->lock);
+
+    return done;
+}
+
+static rt_err_t blk_cache_control(rt_device_t dev, int cmd, void *args)
+{
+    struct rt_blk_cache *cache = (struct rt_blk_cache *)dev;
+    rt_err_t result;
+
+    RT_ASSERT(cache != RT_NULL);
+
+    if (cmd == RT_DEVICE_CTRL_BLK_GETGEOME)
+    {
+        if (args == RT_NULL)
+            return -RT_ERROR;
+
+        rt_memcpy(args, &cache->geometry, sizeof(struct rt_device_blk_geometry));
+        return RT_EOK;
+    }
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    if (cmd == RT_DEVICE_CTRL_BLK_SYNC)
+    {
+        result = blk_cache_flush(cache);
+        if (result != RT_EOK)
+        {
+            rt_mutex_release(&cache->lock);
+            return result;
+        }
+    }
+    else if (cmd == RT_DEVICE_CTRL_BLK_ERASE && args != RT_NULL)
+    {
+        rt_uint32_t *addrs = (rt_uint32_t *)args, index;
+        struct blk_cache_buf *buf;
+
+        /* the erased sectors are read again from the device */
+        for (index = 0; index < RT_BLK_CACHE_SECTORS; index++)
+        {
+            buf = &cache->bufs[index];
+            if (buf->sector != BLK_CACHE_NONE && buf->sector >= addrs[0] && buf->sector <= addrs[1])
+                blk_cache_drop(cache, buf);
+        }
+    }
+    result = rt_device_control(cache->dev, cmd, args);
+    rt_mutex_release(&cache->lock);
+
+    return result;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops blk_cache_ops =
+{
+    RT_NULL,
+    blk_cache_open,
+    blk_cache_close,
+    blk_cache_read,
+    blk_cache_write,
+    blk_cache_control
+};
+#endif
+
+/**
+ * This function will register a block device which caches another one.
+ *
+ * @param name the name of the cache device.
+ * @param blk_name the name of the block device to cache.
+ *
+ * @return RT_EOK on successful, the error code on failed.
+ */
+rt_err_t rt_blk_cache_register(const char *name, const char *blk_name)
+{
+    struct rt_blk_cache *cache;
+    rt_device_t dev;
+    rt_uint8_t *data;
+    rt_size_t index;
+    rt_err_t result;
+
+    dev = rt_device_find(blk_name);
+    if (dev == RT_NULL || dev->type != RT_Device_Class_Block)
+    {
+        LOG_E("block device %s not found.", blk_name);
+        return -RT_ENOSYS;
+    }
+
+    cache = (struct rt_blk_cache *)rt_calloc(1, sizeof(struct rt_blk_cache));
+    if (cache == RT_NULL)
+        return -RT_ENOMEM;
+
+    if (rt_device_control(dev, RT_DEVICE_CTRL_BLK_GETGEOME, &cache->geometry) != RT_EOK
+            || cache->geometry.bytes_per_sector == 0)
+    {
+        LOG_E("get the geometry of %s failed.", blk_name);
+        rt_free(cache);
+        return -RT_EIO;
+    }
+
+    data = (rt_uint8_t *)rt_malloc(RT_BLK_CACHE_SECTORS * cache->geometry.bytes_per_sector);
+    cache->io_buf = (rt_uint8_t *)rt_malloc(BLK_CACHE_IO_SECTORS * cache->geometry.bytes_per_sector);
+    if (data == RT_NULL || cache->io_buf == RT_NULL)
+    {
+        rt_free(data);
+        rt_free(cache->io_buf);
+        rt_free(cache);
+        return -RT_ENOMEM;
+    }
+
+    cache->dev = dev;
+    cache->seq_next = BLK_CACHE_NONE;
+    rt_list_init(&cache->lru);
+    for (index = 0; index < RT_BLK_CACHE_SECTORS; index++)
+    {
+        rt_list_init(&cache->hash[index]);
+        rt_list_init(&cache->bufs[index].hash);
+        cache->bufs[index].sector = BLK_CACHE_NONE;
+        cache->bufs[index].data = data + index * cache->geometry.bytes_per_sector;
+        rt_list_insert_before(&cache->lru, &cache->bufs[index].lru);
+    }
+
+    rt_mutex_init(&cache->lock, name, RT_IPC_FLAG_PRIO);
+#ifdef BLK_CACHE_USING_DELAYED_WRITE
+    rt_work_init(&cache->flush_work, blk_cache_flush_work, cache);
+#endif
+
+    cache->parent.type = RT_Device_Class_Block;
+#ifdef RT_USING_DEVICE_OPS
+    cache->parent.ops = &blk_cache_ops;
+#else
+    cache->parent.init = RT_NULL;
+    cache->parent.open = blk_cache_open;
+    cache->parent.close = blk_cache_close;
+    cache->parent.read = blk_cache_read;
+    cache->parent.write = blk_cache_write;
+    cache->parent.control = blk_cache_control;
+#endif
+
+    result = rt_device_register(&cache->parent, name, RT_DEVICE_FLAG_RDWR);
+    if (result != RT_EOK)
+    {
+        rt_mutex_detach(&cache->lock);
+        rt_free(data);
+        rt_free(cache->io_buf);
+        rt_free(cache);
+    }
+
+    return result;
+}
+RTM_EXPORT(rt_blk_cache_register);
+
+/**
+ * This function will unregister a cache device, after its dirty sectors are
+ * written back. The cached block device is left registered.
+ *
+ * @param name the name of the cache device.
+ *
+ * @return RT_EOK on successful, -RT_EINVAL if the device is not a cache device,
+ *         -RT_EBUSY if it is opened, the error code of the write back on failed.
+ */
+rt_err_t rt_blk_cache_unregister(const char *name)
+{
+    struct rt_blk_cache *cache;
+    rt_device_t dev;
+    rt_err_t result;
+
+    dev = rt_device_find(name);
+#ifdef RT_USING_DEVICE_OPS
+    if (dev == RT_NULL || dev->ops != &blk_cache_ops)
+#else
+    if (dev == RT_NULL || dev->read != blk_cache_read)
+#endif
+        return -RT_EINVAL;
+
+    cache = (struct rt_blk_cache *)dev;
+    if (dev->ref_count)
+        return -RT_EBUSY;
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    result = blk_cache_flush(cache);
+    if (result == RT_EOK)
+        rt_device_unregister(dev);
+    rt_mutex_release(&cache->lock);
+
+    if (result != RT_EOK)
+        return result;
+
+#ifdef BLK_CACHE_USING_DELAYED_WRITE
+    /* a running write back finds nothing dirty and does not submit again */
+    while (rt_work_cancel(&cache->flush_work) == -RT_EBUSY)
+        rt_thread_mdelay(1);
+#endif
+
+    rt_mutex_detach(&cache->lock);
+    rt_free(cache->bufs[0].data);
+    rt_free(cache->io_buf);
+    rt_free(cache);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_blk_cache_unregister);
+
+/**
+ * This function will get the statistics of a cache device.
+ *
+ * @param dev the cache device.
+ * @param stat the buffer to save the statistics.
+ *
+ * @return RT_EOK on successful, -RT_EINVAL if the device is not a cache device.
+ */
+rt_err_t rt_blk_cache_get_stat(rt_device_t dev, struct rt_blk_cache_stat *stat)
+{
+    struct rt_blk_cache *cache = (struct rt_blk_cache *)dev;
+
+#ifdef RT_USING_DEVICE_OPS
+    if (dev == RT_NULL || dev->ops != &blk_cache_ops)
+#else
+    if (dev == RT_NULL || dev->read != blk_cache_read)
+#endif
+        return -RT_EINVAL;
+
+    rt_mutex_take(&cache->lock, RT_WAITING_FOREVER);
+    rt_memcpy(stat, &cache->stat, sizeof(struct rt_blk_cache_stat));
+    rt_mutex_release(&cache->lock);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_blk_cache_get_stat);
+
+#ifdef RT_USING_FINSH
+static int blk_cache(int argc, char **argv)
+{
+    struct rt_blk_cache_stat stat;
+
+    if (argc != 2)
+    {
+        rt_kprintf("Usage: blk_cache <cache_device>\n");
+        return -RT_EINVAL;
+    }
+
+    if (rt_blk_cache_get_stat(rt_device_find(argv[1]), &stat) != RT_EOK)
+    {
+        rt_kprintf("%s is not a block cache device.\n", argv[1]);
+        return -RT_EINVAL;
+    }
+
+    rt_kprintf("read  hit: %d | miss: %d | ahead: %d |\n", stat.read_hit, stat.read_miss, stat.read_ahead);
+    rt_kprintf("write hit: %d | miss: %d | back: %d |\n", stat.write_hit, stat.write_miss, stat.write_back);
+    rt_kprintf("device read: %d | write: %d |\n", stat.dev_read, stat.dev_write);
+
+    return RT_EOK;
+}
+MSH_CMD_EXPORT(blk_cache, show the statistics of a block cache device);
+#endif /* RT_USING_FINSH */
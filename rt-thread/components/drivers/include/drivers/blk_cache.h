@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#ifndef __BLK_CACHE_H__
+#define __BLK_CACHE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct rt_blk_cache_stat
+{
+    rt_uint32_t read_hit;           /* sectors read from the cache */
+    rt_uint32_t read_miss;          /* sectors read from the device for a request */
+    rt_uint32_t read_ahead;         /* sectors read from the device ahead of the requests */
+    rt_uint32_t write_hit;          /* sectors written over a cached sector */
+    rt_uint32_t write_miss;
+    rt_uint32_t write_back;         /* dirty sectors written to the device */
+    rt_uint32_t dev_read;           /* read requests to the device */
+    rt_uint32_t dev_write;          /* write requests to the device */
+};
+
+rt_err_t rt_blk_cache_register(const char *name, const char *blk_name);
+rt_err_t rt_blk_cache_unregister(const char *name);
+rt_err_t rt_blk_cache_get_stat(rt_device_t dev, struct rt_blk_cache_stat *stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BLK_CACHE_H__ */
@@ -165,6 +165,9 @@ struct rt_uart_ops
     int (*getc)(struct rt_serial_device *serial);
 
     rt_size_t (*dma_transmit)(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size, int direction);
+
+    /* optional, read at most size bytes from the hardware rx fifo and return the count */
+    rt_size_t (*getbuf)(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size);
 };
 
 void rt_hw_serial_isr(struct rt_serial_device *serial, int event);
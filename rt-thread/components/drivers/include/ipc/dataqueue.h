@@ -15,8 +15,13 @@
 #define RT_DATAQUEUE_EVENT_POP       0x01
 #define RT_DATAQUEUE_EVENT_PUSH      0x02
 #define RT_DATAQUEUE_EVENT_LWM       0x03
+#define RT_DATAQUEUE_EVENT_HWM       0x04
 
-struct rt_data_item;
+struct rt_data_item
+{
+    const void *data_ptr;
+    rt_size_t data_size;
+};
 
 /* data queue implementation */
 struct rt_data_queue
@@ -25,6 +30,7 @@ struct rt_data_queue
 
     rt_uint16_t size;
     rt_uint16_t lwm;
+    rt_uint16_t hwm;
 
     rt_uint16_t get_index : 15;
     rt_uint16_t is_empty  : 1;
@@ -55,6 +61,17 @@ rt_err_t rt_data_queue_pop(struct rt_data_queue *queue,
                            const void          **data_ptr,
                            rt_size_t            *size,
                            rt_int32_t            timeout);
+rt_size_t rt_data_queue_push_batch(struct rt_data_queue    *queue,
+                                   const struct rt_data_item *items,
+                                   rt_size_t                 count,
+                                   rt_int32_t                timeout);
+rt_size_t rt_data_queue_pop_batch(struct rt_data_queue *queue,
+                                  struct rt_data_item  *items,
+                                  rt_size_t             count,
+                                  rt_int32_t            timeout);
+void rt_data_queue_set_watermark(struct rt_data_queue *queue,
+                                 rt_uint16_t           lwm,
+                                 rt_uint16_t           hwm);
 rt_err_t rt_data_queue_peek(struct rt_data_queue *queue,
                             const void          **data_ptr,
                             rt_size_t            *size);
@@ -38,4 +38,15 @@ typedef struct rt_pipe_device rt_pipe_t;
 rt_pipe_t *rt_pipe_create(const char *name, int bufsz);
 int rt_pipe_delete(const char *name);
 
+#if defined(RT_USING_POSIX_DEVIO) && defined(RT_USING_POSIX_PIPE)
+struct dfs_fd;
+
+/* moves data in place in the pipe buffer, returns the length moved or a negative error code */
+typedef int (*rt_pipe_xfer_t)(void *arg, void *buf, rt_size_t len);
+
+rt_pipe_t *rt_pipe_from_fd(struct dfs_fd *fd);
+int rt_pipe_splice_read(struct dfs_fd *fd, rt_size_t count, rt_pipe_xfer_t sink, void *arg, int nonblock);
+int rt_pipe_splice_write(struct dfs_fd *fd, rt_size_t count, rt_pipe_xfer_t source, void *arg, int nonblock);
+#endif
+
 #endif /* PIPE_H__ */
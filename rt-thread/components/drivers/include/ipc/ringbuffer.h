@@ -41,16 +41,21 @@ struct rt_ringbuffer
      * The tradeoff is we could only use 32KiB of buffer for 16 bit of index.
      * But it should be enough for most of the cases.
      *
-     * Ref: http://en.wikipedia.org/wiki/Circular_buffer#Mirroring */
-    rt_uint16_t read_mirror : 1;
-    rt_uint16_t read_index : 15;
-    rt_uint16_t write_mirror : 1;
-    rt_uint16_t write_index : 15;
+     * Ref: http://en.wikipedia.org/wiki/Circular_buffer#Mirroring
+     *
+     * The mirror bit and the index are kept in one plain 16 bit position,
+     * which the lock-free reserve/commit and peek/consume interface loads
+     * and stores at once. Use RT_RINGBUFFER_INDEX() to get the index. */
+    rt_uint16_t read_pos;
+    rt_uint16_t write_pos;
     /* as we use msb of index as mirror bit, the size should be signed and
      * could only be positive. */
     rt_int16_t buffer_size;
 };
 
+#define RT_RINGBUFFER_MIRROR        0x8000U
+#define RT_RINGBUFFER_INDEX(pos)    ((rt_uint16_t)((pos) & (RT_RINGBUFFER_MIRROR - 1)))
+
 enum rt_ringbuffer_state
 {
     RT_RINGBUFFER_EMPTY,
@@ -76,6 +81,12 @@ rt_size_t rt_ringbuffer_peek(struct rt_ringbuffer *rb, rt_uint8_t **ptr);
 rt_size_t rt_ringbuffer_getchar(struct rt_ringbuffer *rb, rt_uint8_t *ch);
 rt_size_t rt_ringbuffer_data_len(struct rt_ringbuffer *rb);
 
+/* zero-copy interface, lock-free for a single producer and a single consumer */
+rt_size_t rt_ringbuffer_reserve(struct rt_ringbuffer *rb, rt_uint8_t **ptr, rt_uint16_t length);
+rt_size_t rt_ringbuffer_commit(struct rt_ringbuffer *rb, rt_uint16_t length);
+rt_size_t rt_ringbuffer_peek_contiguous(struct rt_ringbuffer *rb, rt_uint8_t **ptr);
+rt_size_t rt_ringbuffer_consume(struct rt_ringbuffer *rb, rt_uint16_t length);
+
 #ifdef RT_USING_HEAP
 struct rt_ringbuffer* rt_ringbuffer_create(rt_uint16_t length);
 void rt_ringbuffer_destroy(struct rt_ringbuffer *rb);
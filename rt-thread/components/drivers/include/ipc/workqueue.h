@@ -31,15 +31,43 @@ enum
     RT_WORK_TYPE_DELAYED     = 0x0001,
 };
 
+struct rt_work;
+struct rt_workqueue;
+
+/* worker thread of a workqueue */
+struct rt_workqueue_worker
+{
+    rt_thread_t    thread;
+    struct rt_work *work_current; /* current work */
+    rt_bool_t      urgent;        /* current work is taken from the urgent lane */
+    struct rt_workqueue *queue;
+};
+
+/* statistics of a workqueue, in OS ticks */
+struct rt_workqueue_stat
+{
+    rt_uint32_t    done;          /* number of executed work items */
+    rt_uint32_t    urgent_done;   /* number of executed urgent work items */
+    rt_tick_t      latency_max;   /* max time from being queued to being executed */
+    rt_uint64_t    latency_sum;
+    rt_tick_t      run_max;       /* max time of executing a work item */
+    rt_uint64_t    run_sum;
+};
+
 /* workqueue implementation */
 struct rt_workqueue
 {
-    rt_list_t      work_list;
+    rt_list_t      work_list;     /* normal lane */
+    rt_list_t      urgent_list;   /* urgent lane, taken before the normal lane */
     rt_list_t      delayed_list;
-    struct rt_work *work_current; /* current work */
 
     struct rt_semaphore sem;
-    rt_thread_t    work_thread;
+    rt_uint16_t    worker_num;
+    rt_uint16_t    max_active;    /* max workers executing normal work items */
+    rt_uint16_t    active;        /* workers executing normal work items */
+    struct rt_workqueue_worker *workers;
+
+    struct rt_workqueue_stat stat;
 };
 
 struct rt_work
@@ -52,6 +80,7 @@ struct rt_work
     rt_uint16_t type;
     struct rt_timer timer;
     struct rt_workqueue *workqueue;
+    rt_tick_t queued_tick;        /* when the work item is put into a lane */
 };
 
 #ifdef RT_USING_HEAP
@@ -60,6 +89,8 @@ struct rt_work
  */
 void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data), void *work_data);
 struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority);
+struct rt_workqueue *rt_workqueue_create_pool(const char *name, rt_uint16_t stack_size, rt_uint8_t priority,
+                                              rt_uint16_t worker_num, rt_uint16_t max_active);
 rt_err_t rt_workqueue_destroy(struct rt_workqueue *queue);
 rt_err_t rt_workqueue_dowork(struct rt_workqueue *queue, struct rt_work *work);
 rt_err_t rt_workqueue_submit_work(struct rt_workqueue *queue, struct rt_work *work, rt_tick_t ticks);
@@ -67,6 +98,8 @@ rt_err_t rt_workqueue_cancel_work(struct rt_workqueue *queue, struct rt_work *wo
 rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_work *work);
 rt_err_t rt_workqueue_cancel_all_work(struct rt_workqueue *queue);
 rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *work);
+rt_err_t rt_workqueue_get_stat(struct rt_workqueue *queue, struct rt_workqueue_stat *stat);
+void rt_workqueue_reset_stat(struct rt_workqueue *queue);
 
 #ifdef RT_USING_SYSTEM_WORKQUEUE
 rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t ticks);
@@ -48,6 +48,10 @@ extern "C" {
 #include "drivers/mtd_nand.h"
 #endif /* RT_USING_MTD_NAND */
 
+#ifdef RT_USING_BLK_CACHE
+#include "drivers/blk_cache.h"
+#endif /* RT_USING_BLK_CACHE */
+
 #ifdef RT_USING_USB_DEVICE
 #include "drivers/usb_device.h"
 #endif /* RT_USING_USB_DEVICE */
@@ -15,11 +15,63 @@
 
 #define DATAQUEUE_MAGIC  0xbead0e0e
 
-struct rt_data_item
+/* the number of data in the data queue, called with interrupt disabled */
+static rt_uint16_t _data_queue_len(struct rt_data_queue *queue)
 {
-    const void *data_ptr;
-    rt_size_t data_size;
-};
+    if (queue->is_empty)
+        return 0;
+
+    if (queue->put_index > queue->get_index)
+        return queue->put_index - queue->get_index;
+
+    return queue->size + queue->put_index - queue->get_index;
+}
+
+/* suspend the current thread on a wait list, called and returns with interrupt disabled */
+static rt_err_t _data_queue_suspend(rt_list_t *list, rt_int32_t timeout, rt_base_t *level)
+{
+    rt_thread_t thread = rt_thread_self();
+
+    /* reset thread error number */
+    thread->error = RT_EOK;
+
+    rt_thread_suspend(thread);
+    rt_list_insert_before(list, &(thread->tlist));
+    /* start timer */
+    if (timeout > 0)
+    {
+        /* reset the timeout of thread timer and start it */
+        rt_timer_control(&(thread->thread_timer),
+                         RT_TIMER_CTRL_SET_TIME,
+                         &timeout);
+        rt_timer_start(&(thread->thread_timer));
+    }
+
+    rt_hw_interrupt_enable(*level);
+
+    /* do schedule */
+    rt_schedule();
+
+    *level = rt_hw_interrupt_disable();
+
+    return thread->error;
+}
+
+/* resume up to count threads of a wait list, called with interrupt disabled */
+static rt_size_t _data_queue_resume(rt_list_t *list, rt_size_t count)
+{
+    rt_thread_t thread;
+    rt_size_t resumed = 0;
+
+    while (resumed < count && !rt_list_isempty(list))
+    {
+        thread = rt_list_entry(list->next, struct rt_thread, tlist);
+        rt_thread_resume(thread);
+        resumed ++;
+    }
+
+    return resumed;
+}
 
 /**
  * @brief    This function will initialize the data queue. Calling this function will
@@ -52,6 +104,7 @@ rt_data_queue_init(struct rt_data_queue *queue,
     queue->magic = DATAQUEUE_MAGIC;
     queue->size = size;
     queue->lwm = lwm;
+    queue->hwm = size;
 
     queue->get_index = 0;
     queue->put_index = 0;
@@ -94,6 +147,7 @@ rt_err_t rt_data_queue_push(struct rt_data_queue *queue,
     rt_base_t level;
     rt_thread_t thread;
     rt_err_t    result;
+    rt_bool_t   hwm = RT_FALSE;
 
     RT_ASSERT(queue != RT_NULL);
     RT_ASSERT(queue->magic == DATAQUEUE_MAGIC);
@@ -155,6 +209,7 @@ rt_err_t rt_data_queue_push(struct rt_data_queue *queue,
     {
         queue->is_full = 1;
     }
+    hwm = (_data_queue_len(queue) == queue->hwm);
 
     /* there is at least one thread in suspended list */
     if (!rt_list_isempty(&(queue->suspended_pop_list)))
@@ -171,6 +226,9 @@ rt_err_t rt_data_queue_push(struct rt_data_queue *queue,
         /* perform a schedule */
         rt_schedule();
 
+        if (hwm && queue->evt_notify != RT_NULL)
+            queue->evt_notify(queue, RT_DATAQUEUE_EVENT_HWM);
+
         return result;
     }
 
@@ -179,6 +237,8 @@ __exit:
     if ((result == RT_EOK) && queue->evt_notify != RT_NULL)
     {
         queue->evt_notify(queue, RT_DATAQUEUE_EVENT_PUSH);
+        if (hwm)
+            queue->evt_notify(queue, RT_DATAQUEUE_EVENT_HWM);
     }
 
     return result;
@@ -314,6 +374,242 @@ __exit:
 }
 RTM_EXPORT(rt_data_queue_pop);
 
+/**
+ * @brief    This function will write a batch of data to the data queue. The data are written under
+ *           one critical section, and the threads waiting for data are woken up at once.
+ *           If the data queue is full, the thread will suspend for the specified amount of time.
+ *
+ * @note     When the number of data in the data queue reaches hwm(high water mark), the notification
+ *           callback function is called with RT_DATAQUEUE_EVENT_HWM.
+ *
+ * @param    queue is a pointer to the data queue object.
+ *
+ * @param    items is the array of the data to be written.
+ *
+ * @param    count is the number of the data in the array.
+ *
+ * @param    timeout is the waiting time.
+ *
+ * @return   Return the number of the data written, which is less than count when the data queue
+ *           has less free space. When the return value is 0, it means the specified time out or
+ *           the data queue is reset.
+ */
+rt_size_t rt_data_queue_push_batch(struct rt_data_queue *queue,
+                                   const struct rt_data_item *items,
+                                   rt_size_t count,
+                                   rt_int32_t timeout)
+{
+    rt_base_t level;
+    rt_tick_t start;
+    rt_uint16_t len;
+    rt_size_t index, resumed;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(queue->magic == DATAQUEUE_MAGIC);
+    RT_ASSERT(items != RT_NULL || count == 0);
+
+    if (count == 0)
+        return 0;
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    start = rt_tick_get();
+
+    level = rt_hw_interrupt_disable();
+    while (queue->is_full)
+    {
+        /* queue is full */
+        if (timeout == 0 ||
+            _data_queue_suspend(&(queue->suspended_push_list), timeout, &level) != RT_EOK)
+        {
+            rt_hw_interrupt_enable(level);
+            return 0;
+        }
+
+        /* the remaining waiting time */
+        if (timeout > 0)
+        {
+            timeout -= rt_tick_get() - start;
+            start = rt_tick_get();
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    len = _data_queue_len(queue);
+    if (count > (rt_size_t)(queue->size - len))
+        count = queue->size - len;
+
+    for (index = 0; index < count; index ++)
+    {
+        queue->queue[queue->put_index] = items[index];
+        queue->put_index += 1;
+        if (queue->put_index == queue->size)
+        {
+            queue->put_index = 0;
+        }
+    }
+    queue->is_empty = 0;
+    if (queue->put_index == queue->get_index)
+    {
+        queue->is_full = 1;
+    }
+
+    resumed = _data_queue_resume(&(queue->suspended_pop_list), count);
+    rt_hw_interrupt_enable(level);
+
+    if (resumed)
+    {
+        /* perform a schedule */
+        rt_schedule();
+    }
+
+    if (queue->evt_notify != RT_NULL)
+    {
+        queue->evt_notify(queue, RT_DATAQUEUE_EVENT_PUSH);
+        if (len < queue->hwm && len + count >= queue->hwm)
+            queue->evt_notify(queue, RT_DATAQUEUE_EVENT_HWM);
+    }
+
+    return count;
+}
+RTM_EXPORT(rt_data_queue_push_batch);
+
+/**
+ * @brief    This function will pop a batch of data from the data queue. The data are fetched under
+ *           one critical section, and the threads waiting for space are woken up at once.
+ *           If the data queue is empty, the thread will suspend for the specified amount of time.
+ *
+ * @note     When the number of data in the data queue is less than lwm(low water mark), will
+ *           wake up the threads waiting for write data.
+ *
+ * @param    queue is a pointer to the data queue object.
+ *
+ * @param    items is the array to store the data fetched.
+ *
+ * @param    count is the size of the array.
+ *
+ * @param    timeout is the waiting time.
+ *
+ * @return   Return the number of the data fetched, which is less than count when the data queue
+ *           has less data. When the return value is 0, it means the specified time out or the
+ *           data queue is reset.
+ */
+rt_size_t rt_data_queue_pop_batch(struct rt_data_queue *queue,
+                                  struct rt_data_item *items,
+                                  rt_size_t count,
+                                  rt_int32_t timeout)
+{
+    rt_base_t level;
+    rt_tick_t start;
+    rt_uint16_t len;
+    rt_size_t index, resumed = 0;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(queue->magic == DATAQUEUE_MAGIC);
+    RT_ASSERT(items != RT_NULL || count == 0);
+
+    if (count == 0)
+        return 0;
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    start = rt_tick_get();
+
+    level = rt_hw_interrupt_disable();
+    while (queue->is_empty)
+    {
+        /* queue is empty */
+        if (timeout == 0 ||
+            _data_queue_suspend(&(queue->suspended_pop_list), timeout, &level) != RT_EOK)
+        {
+            rt_hw_interrupt_enable(level);
+            return 0;
+        }
+
+        /* the remaining waiting time */
+        if (timeout > 0)
+        {
+            timeout -= rt_tick_get() - start;
+            start = rt_tick_get();
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    len = _data_queue_len(queue);
+    if (count > len)
+        count = len;
+
+    for (index = 0; index < count; index ++)
+    {
+        items[index] = queue->queue[queue->get_index];
+        queue->get_index += 1;
+        if (queue->get_index == queue->size)
+        {
+            queue->get_index = 0;
+        }
+    }
+    queue->is_full = 0;
+    if (queue->put_index == queue->get_index)
+    {
+        queue->is_empty = 1;
+    }
+
+    len -= count;
+    if (len <= queue->lwm)
+    {
+        resumed = _data_queue_resume(&(queue->suspended_push_list), count);
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (resumed)
+    {
+        /* perform a schedule */
+        rt_schedule();
+    }
+
+    if (queue->evt_notify != RT_NULL)
+    {
+        queue->evt_notify(queue, len <= queue->lwm ? RT_DATAQUEUE_EVENT_LWM : RT_DATAQUEUE_EVENT_POP);
+    }
+
+    return count;
+}
+RTM_EXPORT(rt_data_queue_pop_batch);
+
+/**
+ * @brief    This function will set the water marks of the data queue.
+ *
+ * @param    queue is a pointer to the data queue object.
+ *
+ * @param    lwm is low water mark.
+ *           When the number of data in the data queue is less than this value, the pop functions
+ *           wake up the threads waiting for write data, and notify RT_DATAQUEUE_EVENT_LWM.
+ *
+ * @param    hwm is high water mark.
+ *           When the number of data in the data queue reaches this value, the push functions
+ *           notify RT_DATAQUEUE_EVENT_HWM. It is the size of the data queue by default.
+ */
+void rt_data_queue_set_watermark(struct rt_data_queue *queue,
+                                 rt_uint16_t lwm,
+                                 rt_uint16_t hwm)
+{
+    rt_base_t level;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(queue->magic == DATAQUEUE_MAGIC);
+    RT_ASSERT(lwm <= hwm && hwm <= queue->size);
+
+    level = rt_hw_interrupt_disable();
+    queue->lwm = lwm;
+    queue->hwm = hwm;
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_data_queue_set_watermark);
+
 /**
  * @brief    This function will fetch but retaining data in the data queue.
  *
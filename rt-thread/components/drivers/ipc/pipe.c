@@ -396,6 +396,192 @@ static const struct dfs_file_ops pipe_fops =
     RT_NULL,
     pipe_fops_poll,
 };
+
+/**
+ * @brief    This function will get the pipe behind a file descriptor.
+ *
+ * @param    fd is the file descriptor.
+ *
+ * @return   Return the pipe device, or RT_NULL if the file descriptor is not a pipe.
+ */
+rt_pipe_t *rt_pipe_from_fd(struct dfs_fd *fd)
+{
+    if (fd == RT_NULL || fd->fops != &pipe_fops)
+        return RT_NULL;
+
+    return (rt_pipe_t *)fd->data;
+}
+
+/**
+ * @brief    This function will move data out of a pipe without an intermediate buffer.
+ *           The sink is handed the data in place in the pipe buffer, and what it takes is consumed.
+ *
+ * @param    fd is the file descriptor of the pipe.
+ *
+ * @param    count is the maximum length of data to move.
+ *
+ * @param    sink is called with the data, it returns the length it took or a negative error code.
+ *
+ * @param    arg is the argument of the sink.
+ *
+ * @param    nonblock is not zero to return -EAGAIN instead of waiting for data.
+ *
+ * @return   Return the length of data moved.
+ *           When the return value is 0, it means there is no thread that has the pipe open for writing.
+ *           When the return value is negative, it is the error code of the sink, or -EAGAIN.
+ */
+int rt_pipe_splice_read(struct dfs_fd *fd, rt_size_t count, rt_pipe_xfer_t sink, void *arg, int nonblock)
+{
+    rt_pipe_t *pipe;
+    rt_uint8_t *ptr;
+    rt_size_t len;
+    int ret = 0;
+    int moved;
+
+    pipe = (rt_pipe_t *)fd->data;
+    nonblock = nonblock || (fd->flags & O_NONBLOCK);
+
+    rt_mutex_take(&(pipe->lock), RT_WAITING_FOREVER);
+
+    while (rt_ringbuffer_data_len(pipe->fifo) == 0)
+    {
+        if (pipe->writers == 0)
+            goto out;
+
+        if (nonblock)
+        {
+            ret = -EAGAIN;
+            goto out;
+        }
+
+        rt_mutex_release(&pipe->lock);
+        rt_wqueue_wakeup(&(pipe->writer_queue), (void *)POLLOUT);
+        rt_wqueue_wait(&(pipe->reader_queue), 0, -1);
+        rt_mutex_take(&(pipe->lock), RT_WAITING_FOREVER);
+    }
+
+    /* the data may wrap around the end of the buffer */
+    while ((rt_size_t)ret < count)
+    {
+        len = rt_ringbuffer_peek_contiguous(pipe->fifo, &ptr);
+        if (len == 0)
+            break;
+        if (len > count - ret)
+            len = count - ret;
+
+        moved = sink(arg, ptr, len);
+        if (moved <= 0)
+        {
+            if (ret == 0)
+                ret = moved;
+            break;
+        }
+
+        rt_ringbuffer_consume(pipe->fifo, moved);
+        ret += moved;
+        if ((rt_size_t)moved < len)
+            break;
+    }
+
+    if (ret > 0)
+    {
+        /* wakeup writer */
+        rt_wqueue_wakeup(&(pipe->writer_queue), (void *)POLLOUT);
+    }
+
+out:
+    rt_mutex_release(&pipe->lock);
+    return ret;
+}
+
+/**
+ * @brief    This function will move data into a pipe without an intermediate buffer.
+ *           The source fills the free space of the pipe buffer in place, and what it gives is committed.
+ *
+ * @param    fd is the file descriptor of the pipe.
+ *
+ * @param    count is the maximum length of data to move.
+ *
+ * @param    source is called with the free space, it returns the length it gave, 0 at end-of-file
+ *           or a negative error code.
+ *
+ * @param    arg is the argument of the source.
+ *
+ * @param    nonblock is not zero to return -EAGAIN instead of waiting for space.
+ *
+ * @return   Return the length of data moved.
+ *           When the return value is negative, it is the error code of the source, -EPIPE or -EAGAIN.
+ */
+int rt_pipe_splice_write(struct dfs_fd *fd, rt_size_t count, rt_pipe_xfer_t source, void *arg, int nonblock)
+{
+    rt_pipe_t *pipe;
+    rt_uint8_t *ptr;
+    rt_size_t len;
+    int ret = 0;
+    int moved;
+
+    pipe = (rt_pipe_t *)fd->data;
+    nonblock = nonblock || (fd->flags & O_NONBLOCK);
+
+    if (count > pipe->bufsz)
+        count = pipe->bufsz;
+
+    rt_mutex_take(&pipe->lock, RT_WAITING_FOREVER);
+
+    while (1)
+    {
+        if (pipe->readers == 0)
+        {
+            ret = -EPIPE;
+            goto out;
+        }
+
+        if (rt_ringbuffer_space_len(pipe->fifo) != 0)
+            break;
+
+        if (nonblock)
+        {
+            ret = -EAGAIN;
+            goto out;
+        }
+
+        rt_mutex_release(&pipe->lock);
+        rt_wqueue_wakeup(&(pipe->reader_queue), (void *)POLLIN);
+        /* pipe full, waiting on suspended write list */
+        rt_wqueue_wait(&(pipe->writer_queue), 0, -1);
+        rt_mutex_take(&pipe->lock, RT_WAITING_FOREVER);
+    }
+
+    /* the free space may wrap around the end of the buffer */
+    while ((rt_size_t)ret < count)
+    {
+        len = rt_ringbuffer_reserve(pipe->fifo, &ptr, count - ret);
+        if (len == 0)
+            break;
+
+        moved = source(arg, ptr, len);
+        if (moved <= 0)
+        {
+            if (ret == 0)
+                ret = moved;
+            break;
+        }
+
+        rt_ringbuffer_commit(pipe->fifo, moved);
+        ret += moved;
+        if ((rt_size_t)moved < len)
+            break;
+    }
+
+    if (ret > 0)
+    {
+        rt_wqueue_wakeup(&(pipe->reader_queue), (void *)POLLIN);
+    }
+
+out:
+    rt_mutex_release(&pipe->lock);
+    return ret;
+}
 #endif /* defined(RT_USING_POSIX_DEVIO) && defined(RT_USING_POSIX_PIPE) */
 
 /**
@@ -12,15 +12,52 @@
  * 2021-08-14     Jackistang   add comments for function interface.
  */
 
+#include <rthw.h>
 #include <rtthread.h>
 #include <rtdevice.h>
 #include <string.h>
 
+/*
+ * The {read,write}_pos keep the mirror bit in RT_RINGBUFFER_MIRROR and the
+ * index in the other bits. The lock-free calls below load the position of
+ * the other side and publish their own with one 16 bit access, so the other
+ * side never sees a mirror bit and an index from different updates.
+ */
+#define _RB_LOAD(pos)           (*(volatile rt_uint16_t *)&(pos))
+#define _RB_STORE(pos, value)   (*(volatile rt_uint16_t *)&(pos) = (value))
+
+rt_inline rt_uint16_t _rb_used(struct rt_ringbuffer *rb, rt_uint16_t r, rt_uint16_t w)
+{
+    rt_uint16_t ri = RT_RINGBUFFER_INDEX(r), wi = RT_RINGBUFFER_INDEX(w);
+
+    if (ri == wi)
+        return (r == w) ? 0 : rb->buffer_size;
+
+    if (wi > ri)
+        return wi - ri;
+
+    return rb->buffer_size - (ri - wi);
+}
+
+rt_inline rt_uint16_t _rb_advance(struct rt_ringbuffer *rb, rt_uint16_t pos, rt_uint16_t length)
+{
+    rt_uint16_t index = RT_RINGBUFFER_INDEX(pos) + length;
+
+    if (index >= rb->buffer_size)
+    {
+        /* we are going into the other side of the mirror */
+        pos ^= RT_RINGBUFFER_MIRROR;
+        index -= rb->buffer_size;
+    }
+
+    return (pos & RT_RINGBUFFER_MIRROR) | index;
+}
+
 rt_inline enum rt_ringbuffer_state rt_ringbuffer_status(struct rt_ringbuffer *rb)
 {
-    if (rb->read_index == rb->write_index)
+    if (RT_RINGBUFFER_INDEX(rb->read_pos) == RT_RINGBUFFER_INDEX(rb->write_pos))
     {
-        if (rb->read_mirror == rb->write_mirror)
+        if (rb->read_pos == rb->write_pos)
             return RT_RINGBUFFER_EMPTY;
         else
             return RT_RINGBUFFER_FULL;
@@ -43,8 +80,8 @@ void rt_ringbuffer_init(struct rt_ringbuffer *rb,
     RT_ASSERT(size > 0);
 
     /* initialize read and write index */
-    rb->read_mirror = rb->read_index = 0;
-    rb->write_mirror = rb->write_index = 0;
+    rb->read_pos = 0;
+    rb->write_pos = 0;
 
     /* set buffer pool and size */
     rb->buffer_ptr = pool;
@@ -65,7 +102,7 @@ rt_size_t rt_ringbuffer_put(struct rt_ringbuffer *rb,
                             const rt_uint8_t     *ptr,
                             rt_uint16_t           length)
 {
-    rt_uint16_t size;
+    rt_uint16_t size, write_index;
 
     RT_ASSERT(rb != RT_NULL);
 
@@ -80,26 +117,23 @@ rt_size_t rt_ringbuffer_put(struct rt_ringbuffer *rb,
     if (size < length)
         length = size;
 
-    if (rb->buffer_size - rb->write_index > length)
+    write_index = RT_RINGBUFFER_INDEX(rb->write_pos);
+    if (rb->buffer_size - write_index > length)
     {
         /* read_index - write_index = empty space */
-        rt_memcpy(&rb->buffer_ptr[rb->write_index], ptr, length);
-        /* this should not cause overflow because there is enough space for
-         * length of data in current mirror */
-        rb->write_index += length;
-        return length;
+        rt_memcpy(&rb->buffer_ptr[write_index], ptr, length);
+    }
+    else
+    {
+        rt_memcpy(&rb->buffer_ptr[write_index],
+                  &ptr[0],
+                  rb->buffer_size - write_index);
+        rt_memcpy(&rb->buffer_ptr[0],
+                  &ptr[rb->buffer_size - write_index],
+                  length - (rb->buffer_size - write_index));
     }
 
-    rt_memcpy(&rb->buffer_ptr[rb->write_index],
-              &ptr[0],
-              rb->buffer_size - rb->write_index);
-    rt_memcpy(&rb->buffer_ptr[0],
-              &ptr[rb->buffer_size - rb->write_index],
-              length - (rb->buffer_size - rb->write_index));
-
-    /* we are going into the other side of the mirror */
-    rb->write_mirror = ~rb->write_mirror;
-    rb->write_index = length - (rb->buffer_size - rb->write_index);
+    rb->write_pos = _rb_advance(rb, rb->write_pos, length);
 
     return length;
 }
@@ -118,7 +152,7 @@ rt_size_t rt_ringbuffer_put_force(struct rt_ringbuffer *rb,
                                   const rt_uint8_t     *ptr,
                                   rt_uint16_t           length)
 {
-    rt_uint16_t space_length;
+    rt_uint16_t space_length, write_index;
 
     RT_ASSERT(rb != RT_NULL);
 
@@ -130,37 +164,27 @@ rt_size_t rt_ringbuffer_put_force(struct rt_ringbuffer *rb,
         length = rb->buffer_size;
     }
 
-    if (rb->buffer_size - rb->write_index > length)
+    write_index = RT_RINGBUFFER_INDEX(rb->write_pos);
+    if (rb->buffer_size - write_index > length)
     {
         /* read_index - write_index = empty space */
-        rt_memcpy(&rb->buffer_ptr[rb->write_index], ptr, length);
-        /* this should not cause overflow because there is enough space for
-         * length of data in current mirror */
-        rb->write_index += length;
-
-        if (length > space_length)
-            rb->read_index = rb->write_index;
-
-        return length;
+        rt_memcpy(&rb->buffer_ptr[write_index], ptr, length);
+    }
+    else
+    {
+        rt_memcpy(&rb->buffer_ptr[write_index],
+                  &ptr[0],
+                  rb->buffer_size - write_index);
+        rt_memcpy(&rb->buffer_ptr[0],
+                  &ptr[rb->buffer_size - write_index],
+                  length - (rb->buffer_size - write_index));
     }
 
-    rt_memcpy(&rb->buffer_ptr[rb->write_index],
-              &ptr[0],
-              rb->buffer_size - rb->write_index);
-    rt_memcpy(&rb->buffer_ptr[0],
-              &ptr[rb->buffer_size - rb->write_index],
-              length - (rb->buffer_size - rb->write_index));
-
-    /* we are going into the other side of the mirror */
-    rb->write_mirror = ~rb->write_mirror;
-    rb->write_index = length - (rb->buffer_size - rb->write_index);
+    rb->write_pos = _rb_advance(rb, rb->write_pos, length);
 
+    /* the oldest data is overwritten, the ring buffer is full */
     if (length > space_length)
-    {
-        if (rb->write_index <= rb->read_index)
-            rb->read_mirror = ~rb->read_mirror;
-        rb->read_index = rb->write_index;
-    }
+        rb->read_pos = rb->write_pos ^ RT_RINGBUFFER_MIRROR;
 
     return length;
 }
@@ -180,6 +204,7 @@ rt_size_t rt_ringbuffer_get(struct rt_ringbuffer *rb,
                             rt_uint16_t           length)
 {
     rt_size_t size;
+    rt_uint16_t read_index;
 
     RT_ASSERT(rb != RT_NULL);
 
@@ -194,26 +219,23 @@ rt_size_t rt_ringbuffer_get(struct rt_ringbuffer *rb,
     if (size < length)
         length = (rt_uint16_t)size;
 
-    if (rb->buffer_size - rb->read_index > length)
+    read_index = RT_RINGBUFFER_INDEX(rb->read_pos);
+    if (rb->buffer_size - read_index > length)
     {
         /* copy all of data */
-        rt_memcpy(ptr, &rb->buffer_ptr[rb->read_index], length);
-        /* this should not cause overflow because there is enough space for
-         * length of data in current mirror */
-        rb->read_index += length;
-        return length;
+        rt_memcpy(ptr, &rb->buffer_ptr[read_index], length);
+    }
+    else
+    {
+        rt_memcpy(&ptr[0],
+                  &rb->buffer_ptr[read_index],
+                  rb->buffer_size - read_index);
+        rt_memcpy(&ptr[rb->buffer_size - read_index],
+                  &rb->buffer_ptr[0],
+                  length - (rb->buffer_size - read_index));
     }
 
-    rt_memcpy(&ptr[0],
-              &rb->buffer_ptr[rb->read_index],
-              rb->buffer_size - rb->read_index);
-    rt_memcpy(&ptr[rb->buffer_size - rb->read_index],
-              &rb->buffer_ptr[0],
-              length - (rb->buffer_size - rb->read_index));
-
-    /* we are going into the other side of the mirror */
-    rb->read_mirror = ~rb->read_mirror;
-    rb->read_index = length - (rb->buffer_size - rb->read_index);
+    rb->read_pos = _rb_advance(rb, rb->read_pos, length);
 
     return length;
 }
@@ -244,19 +266,13 @@ rt_size_t rt_ringbuffer_peek(struct rt_ringbuffer *rb, rt_uint8_t **ptr)
     if (size == 0)
         return 0;
 
-    *ptr = &rb->buffer_ptr[rb->read_index];
-
-    if ((rt_size_t)(rb->buffer_size - rb->read_index) > size)
-    {
-        rb->read_index += (rt_uint16_t)size;
-        return size;
-    }
+    *ptr = &rb->buffer_ptr[RT_RINGBUFFER_INDEX(rb->read_pos)];
 
-    size = rb->buffer_size - rb->read_index;
+    /* the data up to the end of the buffer */
+    if ((rt_size_t)(rb->buffer_size - RT_RINGBUFFER_INDEX(rb->read_pos)) < size)
+        size = rb->buffer_size - RT_RINGBUFFER_INDEX(rb->read_pos);
 
-    /* we are going into the other side of the mirror */
-    rb->read_mirror = ~rb->read_mirror;
-    rb->read_index = 0;
+    rb->read_pos = _rb_advance(rb, rb->read_pos, (rt_uint16_t)size);
 
     return size;
 }
@@ -278,18 +294,8 @@ rt_size_t rt_ringbuffer_putchar(struct rt_ringbuffer *rb, const rt_uint8_t ch)
     if (!rt_ringbuffer_space_len(rb))
         return 0;
 
-    rb->buffer_ptr[rb->write_index] = ch;
-
-    /* flip mirror */
-    if (rb->write_index == rb->buffer_size - 1)
-    {
-        rb->write_mirror = ~rb->write_mirror;
-        rb->write_index = 0;
-    }
-    else
-    {
-        rb->write_index++;
-    }
+    rb->buffer_ptr[RT_RINGBUFFER_INDEX(rb->write_pos)] = ch;
+    rb->write_pos = _rb_advance(rb, rb->write_pos, 1);
 
     return 1;
 }
@@ -311,25 +317,12 @@ rt_size_t rt_ringbuffer_putchar_force(struct rt_ringbuffer *rb, const rt_uint8_t
 
     old_state = rt_ringbuffer_status(rb);
 
-    rb->buffer_ptr[rb->write_index] = ch;
+    rb->buffer_ptr[RT_RINGBUFFER_INDEX(rb->write_pos)] = ch;
+    rb->write_pos = _rb_advance(rb, rb->write_pos, 1);
 
-    /* flip mirror */
-    if (rb->write_index == rb->buffer_size - 1)
-    {
-        rb->write_mirror = ~rb->write_mirror;
-        rb->write_index = 0;
-        if (old_state == RT_RINGBUFFER_FULL)
-        {
-            rb->read_mirror = ~rb->read_mirror;
-            rb->read_index = rb->write_index;
-        }
-    }
-    else
-    {
-        rb->write_index++;
-        if (old_state == RT_RINGBUFFER_FULL)
-            rb->read_index = rb->write_index;
-    }
+    /* the oldest byte is overwritten, the ring buffer stays full */
+    if (old_state == RT_RINGBUFFER_FULL)
+        rb->read_pos = rb->write_pos ^ RT_RINGBUFFER_MIRROR;
 
     return 1;
 }
@@ -353,17 +346,8 @@ rt_size_t rt_ringbuffer_getchar(struct rt_ringbuffer *rb, rt_uint8_t *ch)
         return 0;
 
     /* put byte */
-    *ch = rb->buffer_ptr[rb->read_index];
-
-    if (rb->read_index == rb->buffer_size - 1)
-    {
-        rb->read_mirror = ~rb->read_mirror;
-        rb->read_index = 0;
-    }
-    else
-    {
-        rb->read_index++;
-    }
+    *ch = rb->buffer_ptr[RT_RINGBUFFER_INDEX(rb->read_pos)];
+    rb->read_pos = _rb_advance(rb, rb->read_pos, 1);
 
     return 1;
 }
@@ -378,26 +362,140 @@ RTM_EXPORT(rt_ringbuffer_getchar);
  */
 rt_size_t rt_ringbuffer_data_len(struct rt_ringbuffer *rb)
 {
-    switch (rt_ringbuffer_status(rb))
-    {
-    case RT_RINGBUFFER_EMPTY:
-        return 0;
-    case RT_RINGBUFFER_FULL:
-        return rb->buffer_size;
-    case RT_RINGBUFFER_HALFFULL:
-    default:
-    {
-        rt_size_t wi = rb->write_index, ri = rb->read_index;
-
-        if (wi > ri)
-            return wi - ri;
-        else
-            return rb->buffer_size - (ri - wi);
-    }
-    }
+    return _rb_used(rb, rb->read_pos, rb->write_pos);
 }
 RTM_EXPORT(rt_ringbuffer_data_len);
 
+/**
+ * @brief Reserve contiguous free space at the write position of the ring buffer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param ptr       When this function return, *ptr is a pointer to the reserved space, or RT_NULL if the ring buffer is full.
+ * @param length    The size of the space we want to write in bytes.
+ *
+ * @note This function and rt_ringbuffer_commit() belong to the producer, rt_ringbuffer_peek_contiguous() and
+ *       rt_ringbuffer_consume() belong to the consumer. With one producer and one consumer, such as an ISR
+ *       or DMA callback and a thread, they need no lock and no interrupt masking.
+ *       The reserved space ends at the end of the buffer, a second call gets the part after the wrap.
+ *
+ * @return Return the size of the reserved space, which may be less than length.
+ */
+rt_size_t rt_ringbuffer_reserve(struct rt_ringbuffer *rb, rt_uint8_t **ptr, rt_uint16_t length)
+{
+    rt_uint16_t r, w, size;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(ptr != RT_NULL);
+
+    r = _RB_LOAD(rb->read_pos);
+    w = rb->write_pos;
+    /* the consumer is done with the space before it is written again */
+    rt_hw_dmb();
+
+    size = rb->buffer_size - _rb_used(rb, r, w);
+    if (size > rb->buffer_size - RT_RINGBUFFER_INDEX(w))
+        size = rb->buffer_size - RT_RINGBUFFER_INDEX(w);
+    if (size > length)
+        size = length;
+
+    *ptr = size ? &rb->buffer_ptr[RT_RINGBUFFER_INDEX(w)] : RT_NULL;
+
+    return size;
+}
+RTM_EXPORT(rt_ringbuffer_reserve);
+
+/**
+ * @brief Make the data written into the reserved space visible to the consumer.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param length    The size of data written in bytes.
+ *
+ * @return Return the size of data committed, which is limited by the free space.
+ */
+rt_size_t rt_ringbuffer_commit(struct rt_ringbuffer *rb, rt_uint16_t length)
+{
+    rt_uint16_t r, w, size;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    r = _RB_LOAD(rb->read_pos);
+    w = rb->write_pos;
+
+    size = rb->buffer_size - _rb_used(rb, r, w);
+    if (length > size)
+        length = size;
+
+    /* the data must be visible before the position which publishes it */
+    rt_hw_dmb();
+    /* publish mirror and index in one store */
+    _RB_STORE(rb->write_pos, _rb_advance(rb, w, length));
+
+    return length;
+}
+RTM_EXPORT(rt_ringbuffer_commit);
+
+/**
+ * @brief Get the contiguous readable data at the read position of the ring buffer without removing it.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param ptr       When this function return, *ptr is a pointer to the first readable byte, or RT_NULL if the ring buffer is empty.
+ *
+ * @note Unlike rt_ringbuffer_peek(), the data stays in the ring buffer until rt_ringbuffer_consume() is called.
+ *
+ * @return Return the size of the contiguous readable data.
+ */
+rt_size_t rt_ringbuffer_peek_contiguous(struct rt_ringbuffer *rb, rt_uint8_t **ptr)
+{
+    rt_uint16_t r, w, size;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(ptr != RT_NULL);
+
+    r = rb->read_pos;
+    w = _RB_LOAD(rb->write_pos);
+    /* read the data only after the position which published it */
+    rt_hw_dmb();
+
+    size = _rb_used(rb, r, w);
+    if (size > rb->buffer_size - RT_RINGBUFFER_INDEX(r))
+        size = rb->buffer_size - RT_RINGBUFFER_INDEX(r);
+
+    *ptr = size ? &rb->buffer_ptr[RT_RINGBUFFER_INDEX(r)] : RT_NULL;
+
+    return size;
+}
+RTM_EXPORT(rt_ringbuffer_peek_contiguous);
+
+/**
+ * @brief Remove data from the read position of the ring buffer, which has been handled in place.
+ *
+ * @param rb        A pointer to the ring buffer object.
+ * @param length    The size of data to remove in bytes.
+ *
+ * @return Return the size of data removed, which is limited by the data in the ring buffer.
+ */
+rt_size_t rt_ringbuffer_consume(struct rt_ringbuffer *rb, rt_uint16_t length)
+{
+    rt_uint16_t r, w, size;
+
+    RT_ASSERT(rb != RT_NULL);
+
+    r = rb->read_pos;
+    w = _RB_LOAD(rb->write_pos);
+
+    size = _rb_used(rb, r, w);
+    if (length > size)
+        length = size;
+
+    /* finish reading the data before the producer may overwrite it */
+    rt_hw_dmb();
+    /* publish mirror and index in one store */
+    _RB_STORE(rb->read_pos, _rb_advance(rb, r, length));
+
+    return length;
+}
+RTM_EXPORT(rt_ringbuffer_consume);
+
 /**
  * @brief Reset the ring buffer object, and clear all contents in the buffer.
  *
@@ -407,10 +505,8 @@ void rt_ringbuffer_reset(struct rt_ringbuffer *rb)
 {
     RT_ASSERT(rb != RT_NULL);
 
-    rb->read_mirror = 0;
-    rb->read_index = 0;
-    rb->write_mirror = 0;
-    rb->write_index = 0;
+    rb->read_pos = 0;
+    rb->write_pos = 0;
 }
 RTM_EXPORT(rt_ringbuffer_reset);
 
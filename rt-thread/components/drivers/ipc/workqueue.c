@@ -50,39 +50,136 @@ rt_inline rt_err_t _workqueue_work_completion(struct rt_workqueue *queue)
     return result;
 }
 
+/* whether the work item is executing on one of the workers */
+rt_inline rt_bool_t _workqueue_work_running(struct rt_workqueue *queue, struct rt_work *work)
+{
+    rt_uint16_t index;
+
+    for (index = 0; index < queue->worker_num; index ++)
+    {
+        if (queue->workers[index].work_current == work)
+            return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/* put the work item into a lane, must be called with interrupt disabled */
+rt_inline void _workqueue_queue_work(struct rt_workqueue *queue, rt_list_t *lane, struct rt_work *work)
+{
+    rt_list_insert_after(lane->prev, &(work->list));
+    work->flags |= RT_WORK_STATE_PENDING;
+    work->workqueue = queue;
+    work->queued_tick = rt_tick_get();
+}
+
+/*
+ * Resume one idle worker if there is a work item it can take, must be called
+ * with interrupt disabled. Return RT_TRUE if a worker is resumed.
+ */
+static rt_bool_t _workqueue_wakeup(struct rt_workqueue *queue)
+{
+    struct rt_workqueue_worker *worker;
+    rt_uint16_t index;
+
+    if (rt_list_isempty(&(queue->urgent_list)) &&
+            (rt_list_isempty(&(queue->work_list)) || queue->active >= queue->max_active))
+    {
+        return RT_FALSE;
+    }
+
+    for (index = 0; index < queue->worker_num; index ++)
+    {
+        worker = &(queue->workers[index]);
+        if (worker->work_current == RT_NULL &&
+                ((worker->thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND))
+        {
+            rt_thread_resume(worker->thread);
+            return RT_TRUE;
+        }
+    }
+
+    return RT_FALSE;
+}
+
+/* take the next work item for the worker, must be called with interrupt disabled */
+static struct rt_work *_workqueue_fetch_work(struct rt_workqueue *queue, struct rt_workqueue_worker *worker)
+{
+    struct rt_work *work;
+    rt_tick_t latency;
+
+    if (!rt_list_isempty(&(queue->urgent_list)))
+    {
+        work = rt_list_first_entry(&(queue->urgent_list), struct rt_work, list);
+        worker->urgent = RT_TRUE;
+    }
+    else if (!rt_list_isempty(&(queue->work_list)) && queue->active < queue->max_active)
+    {
+        work = rt_list_first_entry(&(queue->work_list), struct rt_work, list);
+        worker->urgent = RT_FALSE;
+        queue->active ++;
+    }
+    else
+    {
+        return RT_NULL;
+    }
+
+    rt_list_remove(&(work->list));
+    worker->work_current = work;
+    work->flags &= ~RT_WORK_STATE_PENDING;
+    work->workqueue = RT_NULL;
+
+    latency = rt_tick_get() - work->queued_tick;
+    queue->stat.latency_sum += latency;
+    if (latency > queue->stat.latency_max)
+        queue->stat.latency_max = latency;
+
+    return work;
+}
+
 static void _workqueue_thread_entry(void *parameter)
 {
     rt_base_t level;
+    rt_tick_t tick;
     struct rt_work *work;
     struct rt_workqueue *queue;
+    struct rt_workqueue_worker *worker;
 
-    queue = (struct rt_workqueue *) parameter;
-    RT_ASSERT(queue != RT_NULL);
+    worker = (struct rt_workqueue_worker *) parameter;
+    RT_ASSERT(worker != RT_NULL);
+    queue = worker->queue;
 
     while (1)
     {
         level = rt_hw_interrupt_disable();
-        if (rt_list_isempty(&(queue->work_list)))
+        work = _workqueue_fetch_work(queue, worker);
+        if (work == RT_NULL)
         {
-            /* no software timer exist, suspend self. */
+            /* no work for this worker, suspend self. */
             rt_thread_suspend(rt_thread_self());
             rt_hw_interrupt_enable(level);
             rt_schedule();
             continue;
         }
-
-        /* we have work to do with. */
-        work = rt_list_entry(queue->work_list.next, struct rt_work, list);
-        rt_list_remove(&(work->list));
-        queue->work_current = work;
-        work->flags &= ~RT_WORK_STATE_PENDING;
-        work->workqueue = RT_NULL;
         rt_hw_interrupt_enable(level);
 
         /* do work */
+        tick = rt_tick_get();
         work->work_func(work, work->work_data);
+        tick = rt_tick_get() - tick;
+
         /* clean current work */
-        queue->work_current = RT_NULL;
+        level = rt_hw_interrupt_disable();
+        worker->work_current = RT_NULL;
+        if (worker->urgent)
+            queue->stat.urgent_done ++;
+        else
+            queue->active --;
+        queue->stat.done ++;
+        queue->stat.run_sum += tick;
+        if (tick > queue->stat.run_max)
+            queue->stat.run_max = tick;
+        rt_hw_interrupt_enable(level);
 
         /* ack work completion */
         _workqueue_work_completion(queue);
@@ -102,11 +199,9 @@ static rt_err_t _workqueue_submit_work(struct rt_workqueue *queue,
 
     if (ticks == 0)
     {
-        if (queue->work_current != work)
+        if (!_workqueue_work_running(queue, work))
         {
-            rt_list_insert_after(queue->work_list.prev, &(work->list));
-            work->flags |= RT_WORK_STATE_PENDING;
-            work->workqueue = queue;
+            _workqueue_queue_work(queue, &(queue->work_list), work);
             err = RT_EOK;
         }
         else
@@ -114,12 +209,9 @@ static rt_err_t _workqueue_submit_work(struct rt_workqueue *queue,
             err = -RT_EBUSY;
         }
 
-        /* whether the workqueue is doing work */
-        if (queue->work_current == RT_NULL &&
-                ((queue->work_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND))
+        /* whether there is an idle worker */
+        if (_workqueue_wakeup(queue))
         {
-            /* resume work thread */
-            rt_thread_resume(queue->work_thread);
             rt_hw_interrupt_enable(level);
             rt_schedule();
         }
@@ -169,7 +261,7 @@ static rt_err_t _workqueue_cancel_work(struct rt_workqueue *queue, struct rt_wor
         rt_timer_detach(&(work->timer));
         work->flags &= ~RT_WORK_STATE_SUBMITTING;
     }
-    err = queue->work_current != work ? RT_EOK : -RT_EBUSY;
+    err = _workqueue_work_running(queue, work) ? -RT_EBUSY : RT_EOK;
     work->workqueue = RT_NULL;
     rt_hw_interrupt_enable(level);
     return err;
@@ -191,17 +283,13 @@ static void _delayed_work_timeout_handler(void *parameter)
     /* remove delay list */
     rt_list_remove(&(work->list));
     /* insert work queue */
-    if (queue->work_current != work)
+    if (!_workqueue_work_running(queue, work))
     {
-        rt_list_insert_after(queue->work_list.prev, &(work->list));
-        work->flags |= RT_WORK_STATE_PENDING;
+        _workqueue_queue_work(queue, &(queue->work_list), work);
     }
-    /* whether the workqueue is doing work */
-    if (queue->work_current == RT_NULL &&
-            ((queue->work_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND))
+    /* whether there is an idle worker */
+    if (_workqueue_wakeup(queue))
     {
-        /* resume work thread */
-        rt_thread_resume(queue->work_thread);
         rt_hw_interrupt_enable(level);
         rt_schedule();
     }
@@ -247,27 +335,76 @@ void rt_work_init(struct rt_work *work,
  * @return Return a pointer to the workqueue object. It will return RT_NULL if failed.
  */
 struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_size, rt_uint8_t priority)
+{
+    return rt_workqueue_create_pool(name, stack_size, priority, 1, 1);
+}
+
+/**
+ * @brief Create a work queue served by a pool of worker threads.
+ *
+ * @note  Every idle worker takes the next work item of the queue, urgent work items first,
+ *        so a slow work item only holds its own worker. A work item never runs on two
+ *        workers at the same time. Keep max_active below worker_num to leave workers
+ *        for the urgent work items.
+ *
+ * @param name is a name of the work queue threads.
+ *
+ * @param stack_size is stack size of each work queue thread.
+ *
+ * @param priority is a priority of the work queue threads.
+ *
+ * @param worker_num is the number of work queue threads.
+ *
+ * @param max_active is the max number of threads executing normal work items at the same time,
+ *                   0 means worker_num.
+ *
+ * @return Return a pointer to the workqueue object. It will return RT_NULL if failed.
+ */
+struct rt_workqueue *rt_workqueue_create_pool(const char *name, rt_uint16_t stack_size, rt_uint8_t priority,
+                                              rt_uint16_t worker_num, rt_uint16_t max_active)
 {
     struct rt_workqueue *queue = RT_NULL;
+    struct rt_workqueue_worker *worker;
+    rt_uint16_t index;
 
-    queue = (struct rt_workqueue *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue));
+    RT_ASSERT(worker_num > 0);
+
+    if (max_active == 0 || max_active > worker_num)
+        max_active = worker_num;
+
+    queue = (struct rt_workqueue *)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue) +
+                                                    worker_num * sizeof(struct rt_workqueue_worker));
     if (queue != RT_NULL)
     {
+        rt_memset(queue, 0x0, sizeof(struct rt_workqueue) + worker_num * sizeof(struct rt_workqueue_worker));
+
         /* initialize work list */
         rt_list_init(&(queue->work_list));
+        rt_list_init(&(queue->urgent_list));
         rt_list_init(&(queue->delayed_list));
-        queue->work_current = RT_NULL;
         rt_sem_init(&(queue->sem), "wqueue", 0, RT_IPC_FLAG_FIFO);
+        queue->worker_num = worker_num;
+        queue->max_active = max_active;
+        queue->workers = (struct rt_workqueue_worker *)(queue + 1);
 
-        /* create the work thread */
-        queue->work_thread = rt_thread_create(name, _workqueue_thread_entry, queue, stack_size, priority, 10);
-        if (queue->work_thread == RT_NULL)
+        /* create the work threads */
+        for (index = 0; index < worker_num; index ++)
         {
-            RT_KERNEL_FREE(queue);
-            return RT_NULL;
+            worker = &(queue->workers[index]);
+            worker->queue = queue;
+            worker->thread = rt_thread_create(name, _workqueue_thread_entry, worker, stack_size, priority, 10);
+            if (worker->thread == RT_NULL)
+            {
+                while (index --)
+                    rt_thread_delete(queue->workers[index].thread);
+                rt_sem_detach(&(queue->sem));
+                RT_KERNEL_FREE(queue);
+                return RT_NULL;
+            }
         }
 
-        rt_thread_startup(queue->work_thread);
+        for (index = 0; index < worker_num; index ++)
+            rt_thread_startup(queue->workers[index].thread);
     }
 
     return queue;
@@ -282,10 +419,13 @@ struct rt_workqueue *rt_workqueue_create(const char *name, rt_uint16_t stack_siz
  */
 rt_err_t rt_workqueue_destroy(struct rt_workqueue *queue)
 {
+    rt_uint16_t index;
+
     RT_ASSERT(queue != RT_NULL);
 
     rt_workqueue_cancel_all_work(queue);
-    rt_thread_delete(queue->work_thread);
+    for (index = 0; index < queue->worker_num; index ++)
+        rt_thread_delete(queue->workers[index].thread);
     rt_sem_detach(&(queue->sem));
     RT_KERNEL_FREE(queue);
 
@@ -341,11 +481,13 @@ rt_err_t rt_workqueue_submit_work(struct rt_workqueue *queue, struct rt_work *wo
  *
  * @param work is a pointer to the work item object.
  *
- * @return RT_EOK   Success.
+ * @return RT_EOK       Success.
+ *         -RT_EBUSY    This work item is executing.
  */
 rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *work)
 {
     rt_base_t level;
+    rt_err_t err = RT_EOK;
 
     RT_ASSERT(queue != RT_NULL);
     RT_ASSERT(work != RT_NULL);
@@ -353,13 +495,27 @@ rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *wo
     level = rt_hw_interrupt_disable();
     /* NOTE: the work MUST be initialized firstly */
     rt_list_remove(&(work->list));
-    rt_list_insert_after(&queue->work_list, &(work->list));
-    /* whether the workqueue is doing work */
-    if (queue->work_current == RT_NULL &&
-            ((queue->work_thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND))
+    work->flags &= ~RT_WORK_STATE_PENDING;
+    /* Timer started */
+    if (work->flags & RT_WORK_STATE_SUBMITTING)
+    {
+        rt_timer_stop(&(work->timer));
+        rt_timer_detach(&(work->timer));
+        work->flags &= ~RT_WORK_STATE_SUBMITTING;
+    }
+
+    if (!_workqueue_work_running(queue, work))
+    {
+        _workqueue_queue_work(queue, &(queue->urgent_list), work);
+    }
+    else
+    {
+        err = -RT_EBUSY;
+    }
+
+    /* whether there is an idle worker */
+    if (_workqueue_wakeup(queue))
     {
-        /* resume work thread */
-        rt_thread_resume(queue->work_thread);
         rt_hw_interrupt_enable(level);
         rt_schedule();
     }
@@ -368,7 +524,7 @@ rt_err_t rt_workqueue_urgent_work(struct rt_workqueue *queue, struct rt_work *wo
         rt_hw_interrupt_enable(level);
     }
 
-    return RT_EOK;
+    return err;
 }
 
 /**
@@ -403,10 +559,13 @@ rt_err_t rt_workqueue_cancel_work_sync(struct rt_workqueue *queue, struct rt_wor
     RT_ASSERT(queue != RT_NULL);
     RT_ASSERT(work != RT_NULL);
 
-    if (queue->work_current == work) /* it's current work in the queue */
+    if (_workqueue_work_running(queue, work)) /* it's current work of a worker */
     {
         /* wait for work completion */
-        rt_sem_take(&(queue->sem), RT_WAITING_FOREVER);
+        while (_workqueue_work_running(queue, work))
+        {
+            rt_sem_take(&(queue->sem), RT_WAITING_FOREVER);
+        }
     }
     else
     {
@@ -436,6 +595,11 @@ rt_err_t rt_workqueue_cancel_all_work(struct rt_workqueue *queue)
         work = rt_list_first_entry(&queue->work_list, struct rt_work, list);
         _workqueue_cancel_work(queue, work);
     }
+    while (rt_list_isempty(&queue->urgent_list) == RT_FALSE)
+    {
+        work = rt_list_first_entry(&queue->urgent_list, struct rt_work, list);
+        _workqueue_cancel_work(queue, work);
+    }
     /* cancel delay work */
     while (rt_list_isempty(&queue->delayed_list) == RT_FALSE)
     {
@@ -447,8 +611,51 @@ rt_err_t rt_workqueue_cancel_all_work(struct rt_workqueue *queue)
     return RT_EOK;
 }
 
+/**
+ * @brief Get the statistics of a work queue.
+ *
+ * @param queue is a pointer to the workqueue object.
+ *
+ * @param stat is the buffer to save the statistics.
+ *
+ * @return RT_EOK       Success.
+ */
+rt_err_t rt_workqueue_get_stat(struct rt_workqueue *queue, struct rt_workqueue_stat *stat)
+{
+    rt_base_t level;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    *stat = queue->stat;
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief Clear the statistics of a work queue.
+ *
+ * @param queue is a pointer to the workqueue object.
+ */
+void rt_workqueue_reset_stat(struct rt_workqueue *queue)
+{
+    rt_base_t level;
+
+    RT_ASSERT(queue != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    rt_memset(&(queue->stat), 0x0, sizeof(queue->stat));
+    rt_hw_interrupt_enable(level);
+}
+
 #ifdef RT_USING_SYSTEM_WORKQUEUE
 
+#ifndef RT_SYSTEM_WORKQUEUE_WORKERS
+#define RT_SYSTEM_WORKQUEUE_WORKERS 1
+#endif
+
 static struct rt_workqueue *sys_workq; /* system work queue */
 
 /**
@@ -499,8 +706,10 @@ static int rt_work_sys_workqueue_init(void)
     if (sys_workq != RT_NULL)
         return RT_EOK;
 
-    sys_workq = rt_workqueue_create("sys workq", RT_SYSTEM_WORKQUEUE_STACKSIZE,
-                                    RT_SYSTEM_WORKQUEUE_PRIORITY);
+    /* keep one worker for the urgent work items if there are more than one */
+    sys_workq = rt_workqueue_create_pool("sys workq", RT_SYSTEM_WORKQUEUE_STACKSIZE,
+                                         RT_SYSTEM_WORKQUEUE_PRIORITY, RT_SYSTEM_WORKQUEUE_WORKERS,
+                                         RT_SYSTEM_WORKQUEUE_WORKERS > 1 ? RT_SYSTEM_WORKQUEUE_WORKERS - 1 : 1);
     RT_ASSERT(sys_workq != RT_NULL);
 
     return RT_EOK;
@@ -32,6 +32,10 @@
 #include <rtthread.h>
 #include <rtdevice.h>
 
+#ifndef RT_SERIAL_RX_INDICATE_THRESHOLD
+#define RT_SERIAL_RX_INDICATE_THRESHOLD     1
+#endif
+
 #define DBG_TAG    "UART"
 #define DBG_LVL    DBG_INFO
 #include <rtdbg.h>
@@ -371,6 +375,40 @@ static void _serial_check_buffer_size(void)
     }
 }
 
+/*
+ * Move the whole hardware rx fifo into the rx fifo by ops->getbuf, which is
+ * called with interrupt disabled. Like the byte path, the oldest data are
+ * overwritten when the rx fifo is full.
+ */
+static void _serial_rx_burst(struct rt_serial_device *serial, struct rt_serial_rx_fifo *rx_fifo)
+{
+    rt_size_t length, space, used;
+
+    used = (rx_fifo->put_index >= rx_fifo->get_index)? (rx_fifo->put_index - rx_fifo->get_index):
+        (serial->config.bufsz - (rx_fifo->get_index - rx_fifo->put_index));
+
+    do
+    {
+        /* fill the space up to the end of buffer, then wrap around */
+        space = serial->config.bufsz - rx_fifo->put_index;
+        length = serial->ops->getbuf(serial, rx_fifo->buffer + rx_fifo->put_index, space);
+
+        rx_fifo->put_index += length;
+        if (rx_fifo->put_index >= serial->config.bufsz) rx_fifo->put_index = 0;
+        used += length;
+    } while (length == space);
+
+    /* keep the latest (bufsz - 1) bytes, discard the others */
+    if (used >= serial->config.bufsz)
+    {
+        rx_fifo->get_index = rx_fifo->put_index + 1;
+        rx_fifo->is_full = RT_TRUE;
+        if (rx_fifo->get_index >= serial->config.bufsz) rx_fifo->get_index = 0;
+
+        _serial_check_buffer_size();
+    }
+}
+
 #if defined(RT_USING_POSIX_STDIO) || defined(RT_SERIAL_USING_DMA)
 static rt_size_t _serial_fifo_calc_recved_len(struct rt_serial_device *serial)
 {
@@ -1293,6 +1331,7 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
     switch (event & 0xff)
     {
         case RT_SERIAL_EVENT_RX_IND:
+        case RT_SERIAL_EVENT_RX_TIMEOUT:
         {
             int ch = -1;
             rt_base_t level;
@@ -1302,31 +1341,43 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
             rx_fifo = (struct rt_serial_rx_fifo*)serial->serial_rx;
             RT_ASSERT(rx_fifo != RT_NULL);
 
-            while (1)
+            if (serial->ops->getbuf != RT_NULL)
             {
-                ch = serial->ops->getc(serial);
-                if (ch == -1) break;
-
-
                 /* disable interrupt */
                 level = rt_hw_interrupt_disable();
+                /* receive the whole hardware fifo at once */
+                _serial_rx_burst(serial, rx_fifo);
+                /* enable interrupt */
+                rt_hw_interrupt_enable(level);
+            }
+            else
+            {
+                while (1)
+                {
+                    ch = serial->ops->getc(serial);
+                    if (ch == -1) break;
 
-                rx_fifo->buffer[rx_fifo->put_index] = ch;
-                rx_fifo->put_index += 1;
-                if (rx_fifo->put_index >= serial->config.bufsz) rx_fifo->put_index = 0;
 
-                /* if the next position is read index, discard this 'read char' */
-                if (rx_fifo->put_index == rx_fifo->get_index)
-                {
-                    rx_fifo->get_index += 1;
-                    rx_fifo->is_full = RT_TRUE;
-                    if (rx_fifo->get_index >= serial->config.bufsz) rx_fifo->get_index = 0;
+                    /* disable interrupt */
+                    level = rt_hw_interrupt_disable();
 
-                    _serial_check_buffer_size();
-                }
+                    rx_fifo->buffer[rx_fifo->put_index] = ch;
+                    rx_fifo->put_index += 1;
+                    if (rx_fifo->put_index >= serial->config.bufsz) rx_fifo->put_index = 0;
 
-                /* enable interrupt */
-                rt_hw_interrupt_enable(level);
+                    /* if the next position is read index, discard this 'read char' */
+                    if (rx_fifo->put_index == rx_fifo->get_index)
+                    {
+                        rx_fifo->get_index += 1;
+                        rx_fifo->is_full = RT_TRUE;
+                        if (rx_fifo->get_index >= serial->config.bufsz) rx_fifo->get_index = 0;
+
+                        _serial_check_buffer_size();
+                    }
+
+                    /* enable interrupt */
+                    rt_hw_interrupt_enable(level);
+                }
             }
 
             /* invoke callback */
@@ -1340,7 +1391,9 @@ void rt_hw_serial_isr(struct rt_serial_device *serial, int event)
                     (serial->config.bufsz - (rx_fifo->get_index - rx_fifo->put_index));
                 rt_hw_interrupt_enable(level);
 
-                if (rx_length)
+                /* coalesce the indications until the threshold or the line is idle */
+                if (rx_length >= RT_SERIAL_RX_INDICATE_THRESHOLD ||
+                    (rx_length && (event & 0xff) == RT_SERIAL_EVENT_RX_TIMEOUT))
                 {
                     serial->parent.rx_indicate(&serial->parent, rx_length);
                 }
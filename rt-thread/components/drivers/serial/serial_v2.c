@@ -210,14 +210,14 @@ static rt_size_t rt_serial_get_linear_buffer(struct rt_ringbuffer       *rb,
     if (size == 0)
         return 0;
 
-    *ptr = &rb->buffer_ptr[rb->read_index];
+    *ptr = &rb->buffer_ptr[RT_RINGBUFFER_INDEX(rb->read_pos)];
 
-    if(rb->buffer_size - rb->read_index > size)
+    if(rb->buffer_size - RT_RINGBUFFER_INDEX(rb->read_pos) > size)
     {
         return size;
     }
 
-    return rb->buffer_size - rb->read_index;
+    return rb->buffer_size - RT_RINGBUFFER_INDEX(rb->read_pos);
 }
 
 static rt_size_t rt_serial_update_read_index(struct rt_ringbuffer    *rb,
@@ -238,17 +238,11 @@ static rt_size_t rt_serial_update_read_index(struct rt_ringbuffer    *rb,
     if(size < read_index)
         read_index = size;
 
-    if(rb->buffer_size - rb->read_index > read_index)
-    {
-        rb->read_index += read_index;
-        return read_index;
-    }
-
-    read_index = rb->buffer_size - rb->read_index;
+    /* the data up to the end of the buffer */
+    if(rb->buffer_size - RT_RINGBUFFER_INDEX(rb->read_pos) < read_index)
+        read_index = rb->buffer_size - RT_RINGBUFFER_INDEX(rb->read_pos);
 
-    /* we are going into the other side of the mirror */
-    rb->read_mirror = ~rb->read_mirror;
-    rb->read_index = 0;
+    rt_ringbuffer_consume(rb, read_index);
 
     return read_index;
 }
@@ -271,17 +265,7 @@ static rt_size_t rt_serial_update_write_index(struct rt_ringbuffer  *rb,
 #endif
     }
 
-    if (rb->buffer_size - rb->write_index > write_size)
-    {
-        /* this should not cause overflow because there is enough space for
-         * length of data in current mirror */
-        rb->write_index += write_size;
-        return write_size;
-    }
-
-    /* we are going into the other side of the mirror */
-    rb->write_mirror = ~rb->write_mirror;
-    rb->write_index = write_size - (rb->buffer_size - rb->write_index);
+    rt_ringbuffer_commit(rb, write_size);
 
     return write_size;
 }
@@ -143,6 +143,18 @@ struct rt_device *fal_blk_device_create(const char *parition_name);
 struct rt_device *fal_mtd_nor_device_create(const char *parition_name);
 #endif /* defined(RT_USING_MTD_NOR) */
 
+#if defined(FAL_USING_FTL)
+/**
+ * create RT-Thread block device with a wear-levelling flash translation layer by specified partition
+ *
+ * @param parition_name partition name
+ *
+ * @return != NULL: created block device
+ *            NULL: created failed
+ */
+struct rt_device *fal_ftl_device_create(const char *parition_name);
+#endif /* defined(FAL_USING_FTL) */
+
 /**
  * create RT-Thread char device by specified partition
  *
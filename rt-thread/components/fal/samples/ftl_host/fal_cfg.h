@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#ifndef _FAL_CFG_H_
+#define _FAL_CFG_H_
+
+#include <rtconfig.h>
+
+#define RAM_FLASH_BLK_SIZE      4096
+#define RAM_FLASH_SIZE          (64 * RAM_FLASH_BLK_SIZE)
+
+extern const struct fal_flash_dev ram_flash;
+
+/* ===================== Flash device Configuration ========================= */
+#define FAL_FLASH_DEV_TABLE                                          \
+{                                                                    \
+    &ram_flash,                                                      \
+}
+
+/* ====================== Partition Configuration ============================ */
+#define FAL_PART_TABLE                                               \
+{                                                                    \
+    {FAL_PART_MAGIC_WORD, "ftl", "ram", 0, RAM_FLASH_SIZE, 0},       \
+}
+
+#endif /* _FAL_CFG_H_ */
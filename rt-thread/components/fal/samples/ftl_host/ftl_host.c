@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+/*
+ * Run the FAL FTL on the host, over a flash device in RAM, and report the
+ * write amplification, the erase counts and the throughput of a few write
+ * patterns. The device is created again after each pattern, as after a
+ * restart, and its data is checked against a copy, the erased sectors must
+ * stay erased. See README.md for the build.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <fal.h>
+#include <rtdevice.h>
+
+#define SECTOR_SIZE             FAL_FTL_SECTOR_SIZE
+#define RAM_FLASH_BLOCKS        (RAM_FLASH_SIZE / RAM_FLASH_BLK_SIZE)
+
+static uint8_t flash_mem[RAM_FLASH_SIZE];
+static uint32_t flash_program;           /* bytes programmed */
+static uint32_t flash_erase[RAM_FLASH_BLOCKS];
+
+/* ========================== RAM flash device ======================== */
+static int ram_read(long offset, uint8_t *buf, size_t size)
+{
+    memcpy(buf, flash_mem + offset, size);
+    return size;
+}
+
+/* the bits are only cleared, as on a NOR flash */
+static int ram_write(long offset, const uint8_t *buf, size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        flash_mem[offset + i] &= buf[i];
+    }
+    flash_program += size;
+
+    return size;
+}
+
+static int ram_erase(long offset, size_t size)
+{
+    long block;
+
+    for (block = offset / RAM_FLASH_BLK_SIZE; block * RAM_FLASH_BLK_SIZE < offset + (long) size; block++)
+    {
+        flash_erase[block]++;
+    }
+    memset(flash_mem + offset, 0xFF, size);
+
+    return size;
+}
+
+const struct fal_flash_dev ram_flash =
+{
+    .name       = "ram",
+    .addr       = 0,
+    .len        = RAM_FLASH_SIZE,
+    .blk_size   = RAM_FLASH_BLK_SIZE,
+    .ops        = {NULL, ram_read, ram_write, ram_erase},
+    .write_gran = 1
+};
+
+/* ========================== kernel stubs ======================== */
+static struct rt_device *device;
+static struct rt_work *gc_work;
+
+void *rt_malloc(rt_size_t size)
+{
+    return malloc(size);
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    return calloc(count, size);
+}
+
+void rt_free(void *ptr)
+{
+    free(ptr);
+}
+
+int rt_kprintf(const char *fmt, ...)
+{
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = vprintf(fmt, args);
+    va_end(args);
+
+    return len;
+}
+
+rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
+{
+    return RT_EOK;
+}
+
+rt_err_t rt_mutex_release(rt_mutex_t mutex)
+{
+    return RT_EOK;
+}
+
+void rt_work_init(struct rt_work *work, void (*work_func)(struct rt_work *work, void *work_data), void *work_data)
+{
+    work->work_func = work_func;
+    work->work_data = work_data;
+}
+
+/* the work runs after the current write, as on an idle workqueue */
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t time)
+{
+    gc_work = work;
+    return RT_EOK;
+}
+
+/* a device created again replaces the old one, which is left as after a restart */
+rt_err_t rt_device_register(rt_device_t dev, const char *name, rt_uint16_t flags)
+{
+    device = dev;
+    return RT_EOK;
+}
+
+rt_device_t rt_device_find(const char *name)
+{
+    return device;
+}
+
+/* ========================== harness ======================== */
+static uint8_t *shadow;
+static rt_uint32_t sectors;
+
+static void ftl_write(rt_uint32_t lsn, rt_uint32_t seq)
+{
+    uint8_t *data = shadow + lsn * SECTOR_SIZE;
+
+    memset(data, (uint8_t) (seq * 31 + lsn), SECTOR_SIZE);
+    memcpy(data, &lsn, sizeof(lsn));
+    memcpy(data + sizeof(lsn), &seq, sizeof(seq));
+    if (device->write(device, lsn, data, 1) != 1)
+    {
+        printf("write of sector %u failed\n", lsn);
+        exit(1);
+    }
+
+    if (gc_work)
+    {
+        struct rt_work *work = gc_work;
+
+        gc_work = NULL;
+        work->work_func(work, work->work_data);
+    }
+}
+
+static void ftl_trim(rt_uint32_t start, rt_uint32_t end)
+{
+    rt_uint32_t addrs[2] = {start, end};
+
+    if (device->control(device, RT_DEVICE_CTRL_BLK_ERASE, addrs) != RT_EOK)
+    {
+        printf("erase of sectors %u..%u failed\n", start, end);
+        exit(1);
+    }
+    memset(shadow + start * SECTOR_SIZE, 0xFF, (end - start) * SECTOR_SIZE);
+}
+
+/* create the device again and compare it with the copy */
+static int ftl_check(void)
+{
+    uint8_t buf[SECTOR_SIZE];
+    rt_uint32_t lsn;
+    int bad = 0;
+
+    if (fal_ftl_device_create("ftl") == NULL)
+    {
+        printf("mount failed\n");
+        exit(1);
+    }
+
+    for (lsn = 0; lsn < sectors; lsn++)
+    {
+        if (device->read(device, lsn, buf, 1) != 1 || memcmp(buf, shadow + lsn * SECTOR_SIZE, SECTOR_SIZE))
+        {
+            bad++;
+        }
+    }
+
+    return bad;
+}
+
+static rt_uint32_t pattern_seq(rt_uint32_t seq)
+{
+    return seq % sectors;
+}
+
+static rt_uint32_t pattern_random(rt_uint32_t seq)
+{
+    return rand() % sectors;
+}
+
+/* 80% of the writes to 20% of the sectors */
+static rt_uint32_t pattern_hot(rt_uint32_t seq)
+{
+    return rand() % 5 ? rand() % (sectors / 5) : rand() % sectors;
+}
+
+/* random writes, a range of 16 sectors is erased every 64 writes */
+static rt_uint32_t pattern_trim(rt_uint32_t seq)
+{
+    rt_uint32_t start;
+
+    if (seq % 64 == 63)
+    {
+        start = rand() % (sectors - 16);
+        ftl_trim(start, start + 16);
+    }
+
+    return rand() % sectors;
+}
+
+static void run(const char *name, rt_uint32_t (*pattern)(rt_uint32_t seq), rt_uint32_t passes)
+{
+    struct rt_device_blk_geometry geometry;
+    rt_uint32_t seq, writes, block, min_erase = 0xFFFFFFFF, max_erase = 0, erases = 0;
+    clock_t start;
+    double seconds;
+    int bad;
+
+    memset(flash_mem, 0xFF, sizeof(flash_mem));
+    memset(flash_erase, 0, sizeof(flash_erase));
+    if (fal_ftl_device_create("ftl") == NULL)
+    {
+        printf("format failed\n");
+        exit(1);
+    }
+    device->control(device, RT_DEVICE_CTRL_BLK_GETGEOME, &geometry);
+    sectors = geometry.sector_count;
+
+    /* start full, the collector has to move data */
+    memset(shadow, 0xFF, sectors * SECTOR_SIZE);
+    for (seq = 0; seq < sectors; seq++)
+    {
+        ftl_write(seq, 0);
+    }
+
+    flash_program = 0;
+    memset(flash_erase, 0, sizeof(flash_erase));
+    writes = passes * sectors;
+    start = clock();
+    for (seq = 1; seq <= writes; seq++)
+    {
+        ftl_write(pattern(seq), seq);
+    }
+    seconds = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+    for (block = 0; block < RAM_FLASH_BLOCKS; block++)
+    {
+        erases += flash_erase[block];
+        min_erase = flash_erase[block] < min_erase ? flash_erase[block] : min_erase;
+        max_erase = flash_erase[block] > max_erase ? flash_erase[block] : max_erase;
+    }
+    bad = ftl_check();
+
+    printf("%-8s %8u writes | WA %5.2f | erases %6u, per block %4u..%-4u | %7.2f MB/s | bad %d\n",
+           name, writes, (double) flash_program / ((double) writes * SECTOR_SIZE), erases, min_erase, max_erase,
+           seconds > 0 ? writes * (double) SECTOR_SIZE / seconds / (1024 * 1024) : 0.0, bad);
+    if (bad)
+    {
+        exit(1);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    rt_uint32_t passes = argc > 1 ? atoi(argv[1]) : 20;
+
+    srand(1);
+    fal_init();
+    shadow = malloc(RAM_FLASH_SIZE);
+    if (shadow == NULL)
+    {
+        return 1;
+    }
+
+    printf("flash %d blocks of %d bytes, sectors of %d bytes, %d spare blocks\n", RAM_FLASH_BLOCKS,
+           RAM_FLASH_BLK_SIZE, SECTOR_SIZE, FAL_FTL_SPARE_BLOCKS);
+    run("seq", pattern_seq, passes);
+    run("random", pattern_random, passes);
+    run("hot", pattern_hot, passes);
+    run("trim", pattern_trim, passes);
+
+    free(shadow);
+
+    return 0;
+}
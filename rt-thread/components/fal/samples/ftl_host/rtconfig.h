@@ -0,0 +1,29 @@
+#ifndef RT_CONFIG_H__
+#define RT_CONFIG_H__
+
+/* the configuration of the FTL host harness */
+
+#define RT_NAME_MAX 8
+#define RT_ALIGN_SIZE 4
+#define RT_THREAD_PRIORITY_32
+#define RT_THREAD_PRIORITY_MAX 32
+#define RT_TICK_PER_SECOND 1000
+#define RT_USING_SEMAPHORE
+#define RT_USING_MUTEX
+#define RT_USING_HEAP
+#define RT_USING_DEVICE
+#define RT_USING_CONSOLE
+#define RT_USING_DEVICE_IPC
+#define RT_USING_SYSTEM_WORKQUEUE
+#define RT_VER_NUM 0x50000
+
+#define RT_USING_FAL
+#define FAL_DEBUG 0
+#define FAL_PART_HAS_TABLE_CFG
+#define FAL_USING_FTL
+#define FAL_FTL_SECTOR_SIZE 512
+#define FAL_FTL_SPARE_BLOCKS 4
+#define FAL_FTL_GC_FREE_BLOCKS 3
+#define FAL_FTL_WEAR_LEVEL_DELTA 32
+
+#endif
@@ -0,0 +1,767 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <fal.h>
+
+#if defined(RT_VER_NUM) && defined(FAL_USING_FTL)
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <stddef.h>
+#include <string.h>
+
+/*
+ * A log-structured flash translation layer. The sectors are never rewritten in
+ * place, every write appends the data and a tag to the active erase block, and
+ * the logical to physical map in RAM is rebuilt from the tags when the device
+ * is created, the tag with the highest version wins.
+ *
+ * Layout of an erase block, the first sectors hold the metadata:
+ *
+ *   | header | tag 0 | tag 1 | ... | tag n-1 | sector 0 | ... | sector n-1 |
+ *
+ * The header is programmed just after the block is erased, its sequence word
+ * when the block is allocated. The tag of a sector is programmed after its
+ * data, so a sector is only used once it is complete. An erased sector gets a
+ * tombstone, a tag without data, so that its older versions stay dropped after
+ * a restart. The tombstones are kept in the map and moved like the data.
+ *
+ * The garbage collector moves the valid sectors of the block with the fewest of
+ * them, then erases it. It runs in the write path when a single free block is
+ * left, and on the system workqueue below FAL_FTL_GC_FREE_BLOCKS free blocks.
+ * The free blocks are allocated by their erase count, and the least erased
+ * block is collected instead when the erase counts drift apart by more than
+ * FAL_FTL_WEAR_LEVEL_DELTA, which moves its cold data to a worn block.
+ */
+
+#ifndef FAL_FTL_SECTOR_SIZE
+#define FAL_FTL_SECTOR_SIZE            512
+#endif
+#ifndef FAL_FTL_GC_FREE_BLOCKS
+#define FAL_FTL_GC_FREE_BLOCKS         3
+#endif
+#ifndef FAL_FTL_WEAR_LEVEL_DELTA
+#define FAL_FTL_WEAR_LEVEL_DELTA       32
+#endif
+/* the blocks kept beyond the logical capacity, the more the fewer sectors are moved */
+#ifndef FAL_FTL_SPARE_BLOCKS
+#define FAL_FTL_SPARE_BLOCKS           4
+#endif
+
+/* at least the active block and the one left to the collector */
+#if FAL_FTL_SPARE_BLOCKS < 2
+#error "FAL_FTL_SPARE_BLOCKS must be at least 2"
+#endif
+
+#define FTL_MAGIC                      0x4C544641  /* "AFTL" */
+#define FTL_NONE                       0xFFFFFFFF
+/* set in the map for the sectors erased by a tombstone */
+#define FTL_TRIM                       0x80000000
+#define FTL_PHYS(entry)                ((entry) & ~FTL_TRIM)
+
+#define FTL_BLOCK_FREE                 0
+#define FTL_BLOCK_USED                 1
+#define FTL_BLOCK_BAD                  2
+
+/* the words are programmed by pairs, for the flash which programs by double words */
+struct ftl_header
+{
+    rt_uint32_t magic;
+    rt_uint32_t erase_count;
+    rt_uint32_t seq;                   /* FTL_NONE while the block is free */
+    rt_uint32_t reserved;
+};
+
+struct ftl_tag
+{
+    rt_uint32_t lsn;                   /* logical sector number, FTL_NONE if the sector is free */
+    rt_uint32_t version;
+    rt_uint32_t check;                 /* detects a tag torn by a power failure */
+    rt_uint32_t trim;                  /* FTL_TRIM for a tombstone, FTL_NONE for data */
+};
+
+struct fal_ftl_stat
+{
+    rt_uint32_t host_write;            /* sectors written by the device users */
+    rt_uint32_t flash_write;           /* sectors programmed, including the moved ones */
+    rt_uint32_t erase;
+    rt_uint32_t gc;
+};
+
+struct fal_ftl_device
+{
+    struct rt_device                parent;
+    struct rt_device_blk_geometry   geometry;
+    const struct fal_partition     *fal_part;
+    struct rt_mutex                 lock;
+
+    rt_uint32_t                     block_size;
+    rt_uint32_t                     block_count;
+    rt_uint32_t                     slots;         /* sectors per erase block */
+    rt_uint32_t                     meta_slots;    /* sectors holding the header and the tags */
+    rt_uint32_t                     meta_size;
+
+    rt_uint32_t                    *map;           /* logical to physical sector, FTL_NONE if unmapped, FTL_TRIM if erased */
+    rt_uint32_t                    *erase_count;
+    rt_uint16_t                    *valid;         /* valid sectors of each block */
+    rt_uint8_t                     *state;
+
+    rt_uint32_t                     free_count;
+    rt_uint32_t                     active;        /* block written to, FTL_NONE if none */
+    rt_uint32_t                     active_slot;
+    rt_uint32_t                     version;
+    rt_uint32_t                     seq;
+
+    rt_uint8_t                     *meta;          /* the metadata of a block */
+    rt_uint8_t                     *buf;           /* a sector being moved */
+    struct fal_ftl_stat             stat;
+
+#ifdef RT_USING_SYSTEM_WORKQUEUE
+    struct rt_work                  gc_work;
+    rt_bool_t                       gc_pending;
+#endif
+};
+
+#define FTL_TAG_OFFSET(ftl, block, slot)  ((block) * (ftl)->block_size + sizeof(struct ftl_header) \
+                                           + ((slot) - (ftl)->meta_slots) * sizeof(struct ftl_tag))
+#define FTL_DATA_OFFSET(ftl, phys)        ((phys) * FAL_FTL_SECTOR_SIZE)
+
+static rt_uint32_t ftl_tag_check(rt_uint32_t lsn, rt_uint32_t version, rt_uint32_t trim)
+{
+    return lsn ^ version ^ ~trim ^ FTL_MAGIC;
+}
+
+/* erase the block and program its header, the block is then free */
+static rt_err_t ftl_block_format(struct fal_ftl_device *ftl, rt_uint32_t block, rt_uint32_t erase_count)
+{
+    struct ftl_header header;
+
+    header.magic = FTL_MAGIC;
+    header.erase_count = erase_count;
+
+    ftl->stat.erase++;
+    if (fal_partition_erase(ftl->fal_part, block * ftl->block_size, ftl->block_size) < 0
+            || fal_partition_write(ftl->fal_part, block * ftl->block_size, (rt_uint8_t *) &header, 8) < 0)
+    {
+        log_e("Error: format the block %d of the FTL device (%s) failed.", block, ftl->fal_part->name);
+        ftl->state[block] = FTL_BLOCK_BAD;
+        return -RT_EIO;
+    }
+
+    ftl->erase_count[block] = erase_count;
+    ftl->valid[block] = 0;
+    ftl->state[block] = FTL_BLOCK_FREE;
+    ftl->free_count++;
+
+    return RT_EOK;
+}
+
+/* take the free block with the lowest erase count */
+static rt_err_t ftl_block_alloc(struct fal_ftl_device *ftl)
+{
+    rt_uint32_t i, block = FTL_NONE, word[2];
+
+    for (i = 0; i < ftl->block_count; i++)
+    {
+        if (ftl->state[i] == FTL_BLOCK_FREE
+                && (block == FTL_NONE || ftl->erase_count[i] < ftl->erase_count[block]))
+        {
+            block = i;
+        }
+    }
+
+    if (block == FTL_NONE)
+    {
+        return -RT_EFULL;
+    }
+
+    word[0] = ftl->seq++;
+    word[1] = FTL_NONE;
+    ftl->state[block] = FTL_BLOCK_USED;
+    ftl->free_count--;
+    if (fal_partition_write(ftl->fal_part, block * ftl->block_size + offsetof(struct ftl_header, seq),
+                            (rt_uint8_t *) word, sizeof(word)) < 0)
+    {
+        return -RT_EIO;
+    }
+
+    ftl->active = block;
+    ftl->active_slot = ftl->meta_slots;
+
+    return RT_EOK;
+}
+
+static void ftl_unmap(struct fal_ftl_device *ftl, rt_uint32_t lsn)
+{
+    rt_uint32_t phys = ftl->map[lsn];
+
+    if (phys != FTL_NONE)
+    {
+        ftl->valid[FTL_PHYS(phys) / ftl->slots]--;
+        ftl->map[lsn] = FTL_NONE;
+    }
+}
+
+static rt_err_t ftl_gc(struct fal_ftl_device *ftl, rt_bool_t background);
+
+/* append a new version of the logical sector to the active block, a tombstone if buf is RT_NULL */
+static rt_err_t ftl_append(struct fal_ftl_device *ftl, rt_uint32_t lsn, const rt_uint8_t *buf, rt_bool_t gc)
+{
+    struct ftl_tag tag;
+    rt_uint32_t phys;
+    rt_err_t result;
+
+    while (ftl->active == FTL_NONE || ftl->active_slot == ftl->slots)
+    {
+        ftl->active = FTL_NONE;
+
+        /* the last free block is left to the collector, which may also open a new active block */
+        if (gc || ftl->free_count > 1)
+        {
+            result = ftl_block_alloc(ftl);
+        }
+        else
+        {
+            result = ftl_gc(ftl, RT_FALSE);
+        }
+
+        if (result != RT_EOK)
+        {
+            return result;
+        }
+    }
+
+    phys = ftl->active * ftl->slots + ftl->active_slot;
+    tag.lsn = lsn;
+    tag.version = ++ftl->version;
+    tag.trim = buf ? FTL_NONE : FTL_TRIM;
+    tag.check = ftl_tag_check(lsn, tag.version, tag.trim);
+
+    /* the slot is used even if the programming fails */
+    ftl->active_slot++;
+    if (buf)
+    {
+        ftl->stat.flash_write++;
+        if (fal_partition_write(ftl->fal_part, FTL_DATA_OFFSET(ftl, phys), buf, FAL_FTL_SECTOR_SIZE) < 0)
+        {
+            return -RT_EIO;
+        }
+    }
+    if (fal_partition_write(ftl->fal_part, FTL_TAG_OFFSET(ftl, ftl->active, phys % ftl->slots),
+                            (rt_uint8_t *) &tag, sizeof(tag)) < 0)
+    {
+        return -RT_EIO;
+    }
+
+    ftl_unmap(ftl, lsn);
+    ftl->map[lsn] = buf ? phys : phys | FTL_TRIM;
+    ftl->valid[ftl->active]++;
+
+    return RT_EOK;
+}
+
+static rt_uint32_t ftl_gc_victim(struct fal_ftl_device *ftl, rt_bool_t background)
+{
+    rt_uint32_t i, victim = FTL_NONE, coldest = FTL_NONE, max_erase = 0, room;
+
+    for (i = 0; i < ftl->block_count; i++)
+    {
+        if (ftl->erase_count[i] > max_erase)
+        {
+            max_erase = ftl->erase_count[i];
+        }
+
+        if (ftl->state[i] != FTL_BLOCK_USED || i == ftl->active)
+        {
+            continue;
+        }
+
+        if (victim == FTL_NONE || ftl->valid[i] < ftl->valid[victim])
+        {
+            victim = i;
+        }
+        if (coldest == FTL_NONE || ftl->erase_count[i] < ftl->erase_count[coldest])
+        {
+            coldest = i;
+        }
+    }
+
+    if (victim == FTL_NONE)
+    {
+        return FTL_NONE;
+    }
+
+    /* the free sectors the valid ones of the victim can be moved to */
+    room = ftl->free_count * (ftl->slots - ftl->meta_slots);
+    if (ftl->active != FTL_NONE)
+    {
+        room += ftl->slots - ftl->active_slot;
+    }
+
+    /* the cold data is moved to a worn block, so that its block gets used */
+    if (max_erase - ftl->erase_count[coldest] > FAL_FTL_WEAR_LEVEL_DELTA && ftl->valid[coldest] <= room)
+    {
+        return coldest;
+    }
+
+    /* the background collection leaves the blocks which are mostly valid */
+    if (ftl->valid[victim] == ftl->slots - ftl->meta_slots || ftl->valid[victim] > room
+            || (background && ftl->valid[victim] > (ftl->slots - ftl->meta_slots) / 2))
+    {
+        return FTL_NONE;
+    }
+
+    return victim;
+}
+
+/* collect one block, it is called with the lock held */
+static rt_err_t ftl_gc(struct fal_ftl_device *ftl, rt_bool_t background)
+{
+    const struct ftl_tag *tag;
+    rt_uint32_t victim, slot, phys;
+
+    victim = ftl_gc_victim(ftl, background);
+    if (victim == FTL_NONE)
+    {
+        return -RT_EFULL;
+    }
+
+    ftl->stat.gc++;
+    if (ftl->valid[victim])
+    {
+        if (fal_partition_read(ftl->fal_part, victim * ftl->block_size, ftl->meta, ftl->meta_size) < 0)
+        {
+            return -RT_EIO;
+        }
+
+        for (slot = ftl->meta_slots; slot < ftl->slots; slot++)
+        {
+            tag = (const struct ftl_tag *) (ftl->meta + sizeof(struct ftl_header)
+                                            + (slot - ftl->meta_slots) * sizeof(struct ftl_tag));
+            phys = victim * ftl->slots + slot;
+            if (tag->lsn >= ftl->geometry.sector_count || FTL_PHYS(ftl->map[tag->lsn]) != phys)
+            {
+                continue;
+            }
+
+            /* the tombstone still hides the older versions of the sector */
+            if (ftl->map[tag->lsn] & FTL_TRIM)
+            {
+                if (ftl_append(ftl, tag->lsn, RT_NULL, RT_TRUE) != RT_EOK)
+                {
+                    return -RT_EIO;
+                }
+            }
+            else if (fal_partition_read(ftl->fal_part, FTL_DATA_OFFSET(ftl, phys), ftl->buf, FAL_FTL_SECTOR_SIZE) < 0
+                    || ftl_append(ftl, tag->lsn, ftl->buf, RT_TRUE) != RT_EOK)
+            {
+                return -RT_EIO;
+            }
+        }
+    }
+
+    return ftl_block_format(ftl, victim, ftl->erase_count[victim] + 1);
+}
+
+#ifdef RT_USING_SYSTEM_WORKQUEUE
+static void ftl_gc_work(struct rt_work *work, void *work_data)
+{
+    struct fal_ftl_device *ftl = (struct fal_ftl_device *) work_data;
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    ftl->gc_pending = RT_FALSE;
+    while (ftl->free_count < FAL_FTL_GC_FREE_BLOCKS && ftl_gc(ftl, RT_TRUE) == RT_EOK);
+    rt_mutex_release(&ftl->lock);
+}
+#endif
+
+/* collect the garbage on the system workqueue when few free blocks are left */
+static void ftl_gc_later(struct fal_ftl_device *ftl)
+{
+#ifdef RT_USING_SYSTEM_WORKQUEUE
+    if (ftl->free_count < FAL_FTL_GC_FREE_BLOCKS && !ftl->gc_pending)
+    {
+        ftl->gc_pending = RT_TRUE;
+        rt_work_submit(&ftl->gc_work, 0);
+    }
+#endif
+}
+
+/* rebuild the map from the tags, the blocks not formatted are formatted */
+static rt_err_t ftl_mount(struct fal_ftl_device *ftl)
+{
+    const struct ftl_header *header = (const struct ftl_header *) ftl->meta;
+    const struct ftl_tag *tag;
+    rt_uint32_t *version, block, slot, max_erase = 0, formatted = 0;
+
+    version = (rt_uint32_t *) rt_calloc(ftl->geometry.sector_count, sizeof(rt_uint32_t));
+    if (version == RT_NULL)
+    {
+        return -RT_ENOMEM;
+    }
+
+    for (block = 0; block < ftl->block_count; block++)
+    {
+        if (fal_partition_read(ftl->fal_part, block * ftl->block_size, ftl->meta, ftl->meta_size) < 0
+                || header->magic != FTL_MAGIC)
+        {
+            ftl->state[block] = FTL_BLOCK_BAD;
+            continue;
+        }
+
+        ftl->erase_count[block] = header->erase_count;
+        if (header->erase_count > max_erase)
+        {
+            max_erase = header->erase_count;
+        }
+
+        if (header->seq == FTL_NONE)
+        {
+            ftl->state[block] = FTL_BLOCK_FREE;
+            ftl->free_count++;
+            continue;
+        }
+
+        ftl->state[block] = FTL_BLOCK_USED;
+        if (header->seq >= ftl->seq)
+        {
+            ftl->seq = header->seq + 1;
+        }
+
+        for (slot = ftl->meta_slots; slot < ftl->slots; slot++)
+        {
+            tag = (const struct ftl_tag *) (ftl->meta + sizeof(struct ftl_header)
+                                            + (slot - ftl->meta_slots) * sizeof(struct ftl_tag));
+            if (tag->lsn >= ftl->geometry.sector_count
+                    || tag->check != ftl_tag_check(tag->lsn, tag->version, tag->trim))
+            {
+                continue;
+            }
+
+            /* the versions start from 1 */
+            if (tag->version > version[tag->lsn])
+            {
+                ftl->map[tag->lsn] = block * ftl->slots + slot;
+                if (tag->trim == FTL_TRIM)
+                {
+                    ftl->map[tag->lsn] |= FTL_TRIM;
+                }
+                version[tag->lsn] = tag->version;
+            }
+            if (tag->version > ftl->version)
+            {
+                ftl->version = tag->version;
+            }
+        }
+    }
+
+    for (slot = 0; slot < ftl->geometry.sector_count; slot++)
+    {
+        if (ftl->map[slot] != FTL_NONE)
+        {
+            ftl->valid[FTL_PHYS(ftl->map[slot]) / ftl->slots]++;
+        }
+    }
+    rt_free(version);
+
+    /* a new partition, or an erase interrupted by a power failure */
+    for (block = 0; block < ftl->block_count; block++)
+    {
+        if (ftl->state[block] == FTL_BLOCK_BAD)
+        {
+            ftl_block_format(ftl, block, max_erase);
+            formatted++;
+        }
+    }
+
+    if (formatted)
+    {
+        log_i("The FTL device (%s) formatted %d blocks.", ftl->fal_part->name, formatted);
+    }
+
+    return ftl->free_count >= 1 ? RT_EOK : -RT_EIO;
+}
+
+static rt_err_t ftl_dev_control(rt_device_t dev, int cmd, void *args)
+{
+    struct fal_ftl_device *ftl = (struct fal_ftl_device *) dev;
+
+    assert(ftl != RT_NULL);
+
+    if (cmd == RT_DEVICE_CTRL_BLK_GETGEOME)
+    {
+        struct rt_device_blk_geometry *geometry = (struct rt_device_blk_geometry *) args;
+
+        if (geometry == RT_NULL)
+        {
+            return -RT_ERROR;
+        }
+
+        memcpy(geometry, &ftl->geometry, sizeof(struct rt_device_blk_geometry));
+    }
+    else if (cmd == RT_DEVICE_CTRL_BLK_ERASE)
+    {
+        rt_uint32_t *addrs = (rt_uint32_t *) args, lsn;
+        rt_err_t result = RT_EOK;
+
+        if (addrs == RT_NULL || addrs[0] > addrs[1] || addrs[1] > ftl->geometry.sector_count)
+        {
+            return -RT_ERROR;
+        }
+
+        /* the sectors which have data get a tombstone, the others have nothing to come back */
+        rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+        for (lsn = addrs[0]; lsn < addrs[1] && result == RT_EOK; lsn++)
+        {
+            if (ftl->map[lsn] != FTL_NONE && !(ftl->map[lsn] & FTL_TRIM))
+            {
+                result = ftl_append(ftl, lsn, RT_NULL, RT_FALSE);
+            }
+        }
+        ftl_gc_later(ftl);
+        rt_mutex_release(&ftl->lock);
+
+        return result;
+    }
+
+    return RT_EOK;
+}
+
+static rt_size_t ftl_dev_read(rt_device_t dev, rt_off_t pos, void* buffer, rt_size_t size)
+{
+    struct fal_ftl_device *ftl = (struct fal_ftl_device *) dev;
+    rt_uint8_t *ptr = (rt_uint8_t *) buffer;
+    rt_uint32_t phys;
+    rt_size_t i;
+
+    assert(ftl != RT_NULL);
+
+    if (pos + size > ftl->geometry.sector_count)
+    {
+        return 0;
+    }
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    for (i = 0; i < size; i++, ptr += FAL_FTL_SECTOR_SIZE)
+    {
+        phys = ftl->map[pos + i];
+        if (phys == FTL_NONE || (phys & FTL_TRIM))
+        {
+            memset(ptr, 0xFF, FAL_FTL_SECTOR_SIZE);
+        }
+        else if (fal_partition_read(ftl->fal_part, FTL_DATA_OFFSET(ftl, phys), ptr, FAL_FTL_SECTOR_SIZE) < 0)
+        {
+            break;
+        }
+    }
+    rt_mutex_release(&ftl->lock);
+
+    return i;
+}
+
+static rt_size_t ftl_dev_write(rt_device_t dev, rt_off_t pos, const void* buffer, rt_size_t size)
+{
+    struct fal_ftl_device *ftl = (struct fal_ftl_device *) dev;
+    const rt_uint8_t *ptr = (const rt_uint8_t *) buffer;
+    rt_size_t i;
+
+    assert(ftl != RT_NULL);
+
+    if (pos + size > ftl->geometry.sector_count)
+    {
+        return 0;
+    }
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    for (i = 0; i < size; i++, ptr += FAL_FTL_SECTOR_SIZE)
+    {
+        if (ftl_append(ftl, pos + i, ptr, RT_FALSE) != RT_EOK)
+        {
+            break;
+        }
+        ftl->stat.host_write++;
+    }
+
+    ftl_gc_later(ftl);
+    rt_mutex_release(&ftl->lock);
+
+    return i;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops ftl_dev_ops =
+{
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    ftl_dev_read,
+    ftl_dev_write,
+    ftl_dev_control
+};
+#endif
+
+static void ftl_dev_free(struct fal_ftl_device *ftl)
+{
+    rt_free(ftl->map);
+    rt_free(ftl->erase_count);
+    rt_free(ftl->valid);
+    rt_free(ftl->state);
+    rt_free(ftl->meta);
+    rt_free(ftl->buf);
+    rt_free(ftl);
+}
+
+/**
+ * create RT-Thread block device with a flash translation layer by specified partition
+ *
+ * @param parition_name partition name
+ *
+ * @return != NULL: created block device
+ *            NULL: created failed
+ */
+struct rt_device *fal_ftl_device_create(const char *parition_name)
+{
+    struct fal_ftl_device *ftl;
+    const struct fal_partition *fal_part = fal_partition_find(parition_name);
+    const struct fal_flash_dev *fal_flash = NULL;
+    rt_uint32_t meta_slots;
+
+    if (!fal_part)
+    {
+        log_e("Error: the partition name (%s) is not found.", parition_name);
+        return NULL;
+    }
+
+    if ((fal_flash = fal_flash_device_find(fal_part->flash_name)) == NULL)
+    {
+        log_e("Error: the flash device name (%s) is not found.", fal_part->flash_name);
+        return NULL;
+    }
+
+    if (fal_flash->blk_size % FAL_FTL_SECTOR_SIZE || fal_flash->blk_size < 2 * FAL_FTL_SECTOR_SIZE
+            || fal_part->len / fal_flash->blk_size <= FAL_FTL_SPARE_BLOCKS)
+    {
+        log_e("Error: the partition (%s) is too small for the FTL device.", parition_name);
+        return NULL;
+    }
+
+    ftl = (struct fal_ftl_device *) rt_calloc(1, sizeof(struct fal_ftl_device));
+    if (ftl == RT_NULL)
+    {
+        log_e("Error: no memory for create FAL FTL device");
+        return NULL;
+    }
+
+    ftl->fal_part = fal_part;
+    ftl->block_size = fal_flash->blk_size;
+    ftl->block_count = fal_part->len / fal_flash->blk_size;
+    ftl->slots = fal_flash->blk_size / FAL_FTL_SECTOR_SIZE;
+
+    /* the fewest sectors which hold the header and the tags of the other ones */
+    for (meta_slots = 1; sizeof(struct ftl_header) + (ftl->slots - meta_slots) * sizeof(struct ftl_tag)
+            > meta_slots * FAL_FTL_SECTOR_SIZE; meta_slots++);
+    ftl->meta_slots = meta_slots;
+    ftl->meta_size = sizeof(struct ftl_header) + (ftl->slots - meta_slots) * sizeof(struct ftl_tag);
+    ftl->active = FTL_NONE;
+
+    ftl->geometry.bytes_per_sector = FAL_FTL_SECTOR_SIZE;
+    ftl->geometry.block_size = fal_flash->blk_size;
+    ftl->geometry.sector_count = (ftl->block_count - FAL_FTL_SPARE_BLOCKS) * (ftl->slots - meta_slots);
+
+    ftl->map = (rt_uint32_t *) rt_malloc(ftl->geometry.sector_count * sizeof(rt_uint32_t));
+    ftl->erase_count = (rt_uint32_t *) rt_calloc(ftl->block_count, sizeof(rt_uint32_t));
+    ftl->valid = (rt_uint16_t *) rt_calloc(ftl->block_count, sizeof(rt_uint16_t));
+    ftl->state = (rt_uint8_t *) rt_calloc(ftl->block_count, sizeof(rt_uint8_t));
+    ftl->meta = (rt_uint8_t *) rt_malloc(ftl->meta_size);
+    ftl->buf = (rt_uint8_t *) rt_malloc(FAL_FTL_SECTOR_SIZE);
+    if (!ftl->map || !ftl->erase_count || !ftl->valid || !ftl->state || !ftl->meta || !ftl->buf)
+    {
+        log_e("Error: no memory for create FAL FTL device");
+        ftl_dev_free(ftl);
+        return NULL;
+    }
+    memset(ftl->map, 0xFF, ftl->geometry.sector_count * sizeof(rt_uint32_t));
+
+    if (ftl_mount(ftl) != RT_EOK)
+    {
+        log_e("Error: mount the FTL device (%s) failed.", parition_name);
+        ftl_dev_free(ftl);
+        return NULL;
+    }
+
+    rt_mutex_init(&ftl->lock, fal_part->name, RT_IPC_FLAG_PRIO);
+#ifdef RT_USING_SYSTEM_WORKQUEUE
+    rt_work_init(&ftl->gc_work, ftl_gc_work, ftl);
+#endif
+
+    /* register device */
+    ftl->parent.type = RT_Device_Class_Block;
+
+#ifdef RT_USING_DEVICE_OPS
+    ftl->parent.ops  = &ftl_dev_ops;
+#else
+    ftl->parent.init = NULL;
+    ftl->parent.open = NULL;
+    ftl->parent.close = NULL;
+    ftl->parent.read = ftl_dev_read;
+    ftl->parent.write = ftl_dev_write;
+    ftl->parent.control = ftl_dev_control;
+#endif
+
+    /* no private */
+    ftl->parent.user_data = RT_NULL;
+
+    log_i("The FAL FTL device (%s) created successfully", fal_part->name);
+    rt_device_register(RT_DEVICE(ftl), fal_part->name, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_STANDALONE);
+
+    return RT_DEVICE(ftl);
+}
+
+#if defined(RT_USING_FINSH) && defined(FINSH_USING_MSH)
+static void fal_ftl(int argc, char **argv)
+{
+    struct fal_ftl_device *ftl;
+    rt_device_t dev;
+    rt_uint32_t i, min_erase = FTL_NONE, max_erase = 0;
+
+    if (argc < 2)
+    {
+        rt_kprintf("Usage: fal_ftl <device_name> - show the statistics of a FAL FTL device\n");
+        return;
+    }
+
+    dev = rt_device_find(argv[1]);
+#ifdef RT_USING_DEVICE_OPS
+    if (dev == RT_NULL || dev->ops != &ftl_dev_ops)
+#else
+    if (dev == RT_NULL || dev->read != ftl_dev_read)
+#endif
+    {
+        rt_kprintf("FTL device %s NOT found.\n", argv[1]);
+        return;
+    }
+    ftl = (struct fal_ftl_device *) dev;
+
+    rt_mutex_take(&ftl->lock, RT_WAITING_FOREVER);
+    for (i = 0; i < ftl->block_count; i++)
+    {
+        min_erase = ftl->erase_count[i] < min_erase ? ftl->erase_count[i] : min_erase;
+        max_erase = ftl->erase_count[i] > max_erase ? ftl->erase_count[i] : max_erase;
+    }
+    rt_kprintf("FTL of %s | sectors: %d | blocks: %d | free blocks: %d |\n", argv[1],
+               ftl->geometry.sector_count, ftl->block_count, ftl->free_count);
+    rt_kprintf("host write: %d | flash write: %d | erase: %d | gc: %d |\n", ftl->stat.host_write,
+               ftl->stat.flash_write, ftl->stat.erase, ftl->stat.gc);
+    rt_kprintf("erase count min: %d | max: %d |\n", min_erase, max_erase);
+    rt_mutex_release(&ftl->lock);
+}
+MSH_CMD_EXPORT(fal_ftl, show the statistics of a FAL FTL device);
+#endif /* defined(RT_USING_FINSH) && defined(FINSH_USING_MSH) */
+
+#endif /* defined(RT_VER_NUM) && defined(FAL_USING_FTL) */
@@ -17,13 +17,241 @@
 #include <string.h>
 
 /* ========================== block device ======================== */
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+/*
+ * The block device exposes sectors of FAL_BLK_CACHE_SECTOR_SIZE bytes and keeps
+ * the last written erase blocks in RAM. The sector writes are merged in these
+ * blocks, which are erased and programmed once when they are evicted, synced,
+ * closed, or FAL_BLK_CACHE_FLUSH_MS after they got dirty.
+ */
+#ifndef FAL_BLK_CACHE_SECTOR_SIZE
+#define FAL_BLK_CACHE_SECTOR_SIZE      512
+#endif
+#ifndef FAL_BLK_CACHE_BLOCKS
+#define FAL_BLK_CACHE_BLOCKS           2
+#endif
+#ifndef FAL_BLK_CACHE_FLUSH_MS
+#define FAL_BLK_CACHE_FLUSH_MS         1000
+#endif
+
+#if defined(RT_USING_SYSTEM_WORKQUEUE) && (FAL_BLK_CACHE_FLUSH_MS > 0)
+#define FAL_BLK_CACHE_USING_TIMED_FLUSH
+#endif
+
+#define FAL_BLK_CACHE_NONE             0xFFFFFFFF
+
+struct fal_blk_cache
+{
+    rt_uint32_t                     block;         /* cached erase block, FAL_BLK_CACHE_NONE if none */
+    rt_uint32_t                     used;          /* for the least recently used replacement */
+    rt_bool_t                       dirty;
+    rt_uint8_t                     *buf;
+};
+
+struct fal_blk_cache_stat
+{
+    rt_uint32_t                     read_hit;
+    rt_uint32_t                     read_miss;
+    rt_uint32_t                     write_hit;
+    rt_uint32_t                     write_miss;
+    rt_uint32_t                     flush;
+};
+#endif /* FAL_BLK_DEVICE_USING_CACHE */
+
 struct fal_blk_device
 {
     struct rt_device                parent;
     struct rt_device_blk_geometry   geometry;
     const struct fal_partition     *fal_part;
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+    struct rt_mutex                 lock;
+    rt_uint32_t                     sectors_per_block;
+    rt_uint32_t                     used;
+    struct fal_blk_cache            cache[FAL_BLK_CACHE_BLOCKS];
+    struct fal_blk_cache_stat       stat;
+#ifdef FAL_BLK_CACHE_USING_TIMED_FLUSH
+    struct rt_work                  flush_work;
+    rt_bool_t                       flush_pending;
+#endif
+#endif /* FAL_BLK_DEVICE_USING_CACHE */
 };
 
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+static int blk_cache_flush_block(struct fal_blk_device *part, struct fal_blk_cache *cache)
+{
+    rt_uint32_t addr, size = part->geometry.block_size;
+
+    if (!cache->dirty)
+    {
+        return RT_EOK;
+    }
+
+    addr = cache->block * size;
+    if (fal_partition_erase(part->fal_part, addr, size) != (int) size
+            || fal_partition_write(part->fal_part, addr, cache->buf, size) != (int) size)
+    {
+        log_e("Error: write back the block %d of the partition (%s) failed.", cache->block, part->fal_part->name);
+        return -RT_EIO;
+    }
+
+    cache->dirty = RT_FALSE;
+    part->stat.flush++;
+
+    return RT_EOK;
+}
+
+static rt_err_t blk_cache_flush(struct fal_blk_device *part)
+{
+    rt_err_t result = RT_EOK;
+    size_t i;
+
+    for (i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+    {
+        if (blk_cache_flush_block(part, &part->cache[i]) != RT_EOK)
+        {
+            result = -RT_EIO;
+        }
+    }
+
+    return result;
+}
+
+static struct fal_blk_cache *blk_cache_find(struct fal_blk_device *part, rt_uint32_t block)
+{
+    size_t i;
+
+    for (i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+    {
+        if (part->cache[i].block == block)
+        {
+            part->cache[i].used = ++part->used;
+            return &part->cache[i];
+        }
+    }
+
+    return RT_NULL;
+}
+
+/* replace the least recently used cache block, the flash is not read when the block is overwritten */
+static struct fal_blk_cache *blk_cache_load(struct fal_blk_device *part, rt_uint32_t block, rt_bool_t overwrite)
+{
+    struct fal_blk_cache *cache = &part->cache[0];
+    rt_uint32_t size = part->geometry.block_size;
+    size_t i;
+
+    for (i = 1; i < FAL_BLK_CACHE_BLOCKS && cache->block != FAL_BLK_CACHE_NONE; i++)
+    {
+        if (part->cache[i].block == FAL_BLK_CACHE_NONE || part->cache[i].used < cache->used)
+        {
+            cache = &part->cache[i];
+        }
+    }
+
+    if (blk_cache_flush_block(part, cache) != RT_EOK)
+    {
+        return RT_NULL;
+    }
+
+    cache->block = FAL_BLK_CACHE_NONE;
+    if (!overwrite && fal_partition_read(part->fal_part, block * size, cache->buf, size) != (int) size)
+    {
+        return RT_NULL;
+    }
+
+    cache->block = block;
+    cache->used = ++part->used;
+
+    return cache;
+}
+
+/* write back the dirty blocks FAL_BLK_CACHE_FLUSH_MS later */
+static void blk_cache_flush_later(struct fal_blk_device *part)
+{
+#ifdef FAL_BLK_CACHE_USING_TIMED_FLUSH
+    if (!part->flush_pending)
+    {
+        part->flush_pending = RT_TRUE;
+        rt_work_submit(&part->flush_work, rt_tick_from_millisecond(FAL_BLK_CACHE_FLUSH_MS));
+    }
+#endif
+}
+
+/*
+ * The whole erase blocks in the range are erased on the flash and their cached
+ * copies are dropped without being written back. The sectors at the ends of the
+ * range share their erase blocks with sectors out of it, they are erased in the
+ * cache, so only the sectors out of the range are written back with them.
+ */
+static rt_err_t blk_cache_erase(struct fal_blk_device *part, rt_uint32_t start, rt_uint32_t end)
+{
+    rt_uint32_t spb = part->sectors_per_block, size = part->geometry.block_size;
+    rt_uint32_t first = (start + spb - 1) / spb, last = end / spb, block, from, to;
+    struct fal_blk_cache *cache;
+    size_t i;
+
+    if (first < last)
+    {
+        for (i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+        {
+            block = part->cache[i].block;
+            if (block != FAL_BLK_CACHE_NONE && block >= first && block < last)
+            {
+                part->cache[i].block = FAL_BLK_CACHE_NONE;
+                part->cache[i].dirty = RT_FALSE;
+            }
+        }
+
+        if (fal_partition_erase(part->fal_part, first * size, (last - first) * size) < 0)
+        {
+            return -RT_ERROR;
+        }
+    }
+
+    while (start < end)
+    {
+        block = start / spb;
+        from = start % spb;
+        to = end - block * spb < spb ? end - block * spb : spb;
+        if (from == 0 && to == spb)
+        {
+            /* erased above */
+            start = last * spb;
+            continue;
+        }
+
+        cache = blk_cache_find(part, block);
+        if (cache == RT_NULL)
+        {
+            cache = blk_cache_load(part, block, RT_FALSE);
+            if (cache == RT_NULL)
+            {
+                return -RT_EIO;
+            }
+        }
+
+        memset(cache->buf + from * part->geometry.bytes_per_sector, 0xFF, (to - from) * part->geometry.bytes_per_sector);
+        cache->dirty = RT_TRUE;
+        blk_cache_flush_later(part);
+
+        start = block * spb + to;
+    }
+
+    return RT_EOK;
+}
+
+#ifdef FAL_BLK_CACHE_USING_TIMED_FLUSH
+static void blk_cache_flush_work(struct rt_work *work, void *work_data)
+{
+    struct fal_blk_device *part = (struct fal_blk_device *) work_data;
+
+    rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+    part->flush_pending = RT_FALSE;
+    blk_cache_flush(part);
+    rt_mutex_release(&part->lock);
+}
+#endif
+#endif /* FAL_BLK_DEVICE_USING_CACHE */
+
 /* RT-Thread device interface */
 #if RTTHREAD_VERSION >= 30000
 static rt_err_t blk_dev_control(rt_device_t dev, int cmd, void *args)
@@ -49,8 +277,7 @@ static rt_err_t blk_dev_control(rt_device_t dev, rt_uint8_t cmd, void *args)
     }
     else if (cmd == RT_DEVICE_CTRL_BLK_ERASE)
     {
-        rt_uint32_t *addrs = (rt_uint32_t *) args, start_addr = addrs[0], end_addr = addrs[1], phy_start_addr;
-        rt_size_t phy_size;
+        rt_uint32_t *addrs = (rt_uint32_t *) args, start_addr = addrs[0], end_addr = addrs[1];
 
         if (addrs == RT_NULL || start_addr > end_addr)
         {
@@ -62,18 +289,156 @@ static rt_err_t blk_dev_control(rt_device_t dev, rt_uint8_t cmd, void *args)
             end_addr++;
         }
 
-        phy_start_addr = start_addr * part->geometry.bytes_per_sector;
-        phy_size = (end_addr - start_addr) * part->geometry.bytes_per_sector;
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+        {
+            rt_err_t result;
+
+            rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+            result = blk_cache_erase(part, start_addr, end_addr);
+            rt_mutex_release(&part->lock);
 
-        if (fal_partition_erase(part->fal_part, phy_start_addr, phy_size) < 0)
+            return result;
+        }
+#else
+        if (fal_partition_erase(part->fal_part, start_addr * part->geometry.bytes_per_sector,
+                (end_addr - start_addr) * part->geometry.bytes_per_sector) < 0)
         {
             return -RT_ERROR;
         }
+#endif
     }
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+    else if (cmd == RT_DEVICE_CTRL_BLK_SYNC)
+    {
+        rt_err_t result;
+
+        rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+        result = blk_cache_flush(part);
+        rt_mutex_release(&part->lock);
+
+        return result;
+    }
+#endif
 
     return RT_EOK;
 }
 
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+static rt_err_t blk_dev_close(rt_device_t dev)
+{
+    struct fal_blk_device *part = (struct fal_blk_device*) dev;
+    rt_err_t result;
+
+    assert(part != RT_NULL);
+
+    rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+    result = blk_cache_flush(part);
+    rt_mutex_release(&part->lock);
+
+    return result;
+}
+
+static rt_size_t blk_dev_read(rt_device_t dev, rt_off_t pos, void* buffer, rt_size_t size)
+{
+    struct fal_blk_device *part = (struct fal_blk_device*) dev;
+    rt_uint32_t sector_size, block, offset, count;
+    struct fal_blk_cache *cache;
+    rt_uint8_t *ptr = (rt_uint8_t *) buffer;
+    rt_size_t done = 0;
+
+    assert(part != RT_NULL);
+
+    sector_size = part->geometry.bytes_per_sector;
+
+    rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+    while (done < size)
+    {
+        block = (pos + done) / part->sectors_per_block;
+        offset = (pos + done) % part->sectors_per_block;
+        count = part->sectors_per_block - offset;
+        if (count > size - done)
+        {
+            count = size - done;
+        }
+
+        cache = blk_cache_find(part, block);
+        if (cache)
+        {
+            part->stat.read_hit++;
+            memcpy(ptr, cache->buf + offset * sector_size, count * sector_size);
+        }
+        else
+        {
+            part->stat.read_miss++;
+            if (fal_partition_read(part->fal_part, (pos + done) * sector_size, ptr, count * sector_size)
+                    != (int) (count * sector_size))
+            {
+                break;
+            }
+        }
+
+        ptr += count * sector_size;
+        done += count;
+    }
+    rt_mutex_release(&part->lock);
+
+    return done;
+}
+
+static rt_size_t blk_dev_write(rt_device_t dev, rt_off_t pos, const void* buffer, rt_size_t size)
+{
+    struct fal_blk_device *part = (struct fal_blk_device*) dev;
+    rt_uint32_t sector_size, block, offset, count;
+    struct fal_blk_cache *cache;
+    const rt_uint8_t *ptr = (const rt_uint8_t *) buffer;
+    rt_size_t done = 0;
+
+    assert(part != RT_NULL);
+
+    sector_size = part->geometry.bytes_per_sector;
+
+    rt_mutex_take(&part->lock, RT_WAITING_FOREVER);
+    while (done < size)
+    {
+        block = (pos + done) / part->sectors_per_block;
+        offset = (pos + done) % part->sectors_per_block;
+        count = part->sectors_per_block - offset;
+        if (count > size - done)
+        {
+            count = size - done;
+        }
+
+        cache = blk_cache_find(part, block);
+        if (cache)
+        {
+            part->stat.write_hit++;
+        }
+        else
+        {
+            part->stat.write_miss++;
+            cache = blk_cache_load(part, block, count == part->sectors_per_block);
+            if (cache == RT_NULL)
+            {
+                break;
+            }
+        }
+
+        memcpy(cache->buf + offset * sector_size, ptr, count * sector_size);
+        cache->dirty = RT_TRUE;
+
+        ptr += count * sector_size;
+        done += count;
+    }
+
+    if (done)
+    {
+        blk_cache_flush_later(part);
+    }
+    rt_mutex_release(&part->lock);
+
+    return done;
+}
+#else
 static rt_size_t blk_dev_read(rt_device_t dev, rt_off_t pos, void* buffer, rt_size_t size)
 {
     int ret = 0;
@@ -127,19 +492,49 @@ static rt_size_t blk_dev_write(rt_device_t dev, rt_off_t pos, const void* buffer
 
     return ret;
 }
+#endif /* FAL_BLK_DEVICE_USING_CACHE */
+
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+#define blk_dev_close_ops   blk_dev_close
+#else
+#define blk_dev_close_ops   RT_NULL
+#endif
 
 #ifdef RT_USING_DEVICE_OPS
 const static struct rt_device_ops blk_dev_ops =
 {
     RT_NULL,
     RT_NULL,
-    RT_NULL,
+    blk_dev_close_ops,
     blk_dev_read,
     blk_dev_write,
     blk_dev_control
 };
 #endif
 
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+static struct fal_blk_device *fal_blk_device_find(const char *name)
+{
+    rt_device_t dev = rt_device_find(name);
+
+    if (dev == RT_NULL || dev->type != RT_Device_Class_Block)
+    {
+        return RT_NULL;
+    }
+
+#ifdef RT_USING_DEVICE_OPS
+    if (dev->ops != &blk_dev_ops)
+#else
+    if (dev->read != blk_dev_read)
+#endif
+    {
+        return RT_NULL;
+    }
+
+    return (struct fal_blk_device *) dev;
+}
+#endif /* FAL_BLK_DEVICE_USING_CACHE */
+
 /**
  * create RT-Thread block device by specified partition
  *
@@ -174,6 +569,46 @@ struct rt_device *fal_blk_device_create(const char *parition_name)
         blk_dev->geometry.block_size = fal_flash->blk_size;
         blk_dev->geometry.sector_count = fal_part->len / fal_flash->blk_size;
 
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+        {
+            size_t i;
+
+            /* smaller sectors only when they split the erase block evenly */
+            if (fal_flash->blk_size % FAL_BLK_CACHE_SECTOR_SIZE == 0)
+            {
+                blk_dev->geometry.bytes_per_sector = FAL_BLK_CACHE_SECTOR_SIZE;
+                blk_dev->geometry.sector_count = fal_part->len / FAL_BLK_CACHE_SECTOR_SIZE;
+            }
+            blk_dev->sectors_per_block = fal_flash->blk_size / blk_dev->geometry.bytes_per_sector;
+            blk_dev->used = 0;
+            memset(&blk_dev->stat, 0, sizeof(blk_dev->stat));
+
+            for (i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+            {
+                blk_dev->cache[i].block = FAL_BLK_CACHE_NONE;
+                blk_dev->cache[i].used = 0;
+                blk_dev->cache[i].dirty = RT_FALSE;
+                blk_dev->cache[i].buf = (rt_uint8_t *) rt_malloc(fal_flash->blk_size);
+                if (blk_dev->cache[i].buf == RT_NULL)
+                {
+                    log_e("Error: no memory for the cache of FAL block device");
+                    while (i--)
+                    {
+                        rt_free(blk_dev->cache[i].buf);
+                    }
+                    rt_free(blk_dev);
+                    return NULL;
+                }
+            }
+
+            rt_mutex_init(&blk_dev->lock, fal_part->name, RT_IPC_FLAG_PRIO);
+#ifdef FAL_BLK_CACHE_USING_TIMED_FLUSH
+            rt_work_init(&blk_dev->flush_work, blk_cache_flush_work, blk_dev);
+            blk_dev->flush_pending = RT_FALSE;
+#endif
+        }
+#endif /* FAL_BLK_DEVICE_USING_CACHE */
+
         /* register device */
         blk_dev->parent.type = RT_Device_Class_Block;
 
@@ -182,7 +617,7 @@ struct rt_device *fal_blk_device_create(const char *parition_name)
 #else
         blk_dev->parent.init = NULL;
         blk_dev->parent.open = NULL;
-        blk_dev->parent.close = NULL;
+        blk_dev->parent.close = blk_dev_close_ops;
         blk_dev->parent.read = blk_dev_read;
         blk_dev->parent.write = blk_dev_write;
         blk_dev->parent.control = blk_dev_control;
@@ -555,6 +990,7 @@ static void fal(uint8_t argc, char **argv) {
 #define CMD_WRITE_INDEX               2
 #define CMD_ERASE_INDEX               3
 #define CMD_BENCH_INDEX               4
+#define CMD_CACHE_INDEX               5
 
     int result = 0;
     static const struct fal_flash_dev *flash_dev = NULL;
@@ -568,6 +1004,9 @@ static void fal(uint8_t argc, char **argv) {
             [CMD_WRITE_INDEX]     = "fal write addr data1 ... dataN   - write some bytes 'data' starting at 'addr'",
             [CMD_ERASE_INDEX]     = "fal erase addr size              - erase 'size' bytes starting at 'addr'",
             [CMD_BENCH_INDEX]     = "fal bench <blk_size>             - benchmark test with per block size",
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+            [CMD_CACHE_INDEX]     = "fal cache part_name              - show the cache statistics of a block device",
+#endif
     };
 
     if (fal_init_check() != 1)
@@ -628,6 +1067,37 @@ static void fal(uint8_t argc, char **argv) {
                 fal_show_part_table();
             }
         }
+#ifdef FAL_BLK_DEVICE_USING_CACHE
+        else if (!strcmp(operator, "cache"))
+        {
+            struct fal_blk_device *blk_dev;
+            size_t dirty = 0;
+
+            if (argc < 3)
+            {
+                rt_kprintf("Usage: %s.\n", help_info[CMD_CACHE_INDEX]);
+                return;
+            }
+
+            if ((blk_dev = fal_blk_device_find(argv[2])) == NULL)
+            {
+                rt_kprintf("Block device %s NOT found.\n", argv[2]);
+                return;
+            }
+
+            rt_mutex_take(&blk_dev->lock, RT_WAITING_FOREVER);
+            for (i = 0; i < FAL_BLK_CACHE_BLOCKS; i++)
+            {
+                dirty += blk_dev->cache[i].dirty ? 1 : 0;
+            }
+            rt_kprintf("Cache of %s | sector: %d | block: %d | blocks: %d | dirty: %d |\n", argv[2],
+                    blk_dev->geometry.bytes_per_sector, blk_dev->geometry.block_size, FAL_BLK_CACHE_BLOCKS, dirty);
+            rt_kprintf("read  hit: %d | miss: %d |\n", blk_dev->stat.read_hit, blk_dev->stat.read_miss);
+            rt_kprintf("write hit: %d | miss: %d | flush: %d |\n", blk_dev->stat.write_hit,
+                    blk_dev->stat.write_miss, blk_dev->stat.flush);
+            rt_mutex_release(&blk_dev->lock);
+        }
+#endif
         else
         {
             if (!flash_dev && !part_dev)
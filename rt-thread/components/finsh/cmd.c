@@ -39,6 +39,11 @@
 #ifdef RT_USING_FINSH
 #include <finsh.h>
 
+#ifdef RT_USING_THREAD_STAT
+#include <stdlib.h>
+#include <rtdevice.h>
+#endif /* RT_USING_THREAD_STAT */
+
 #define LIST_FIND_OBJ_NR 8
 
 static long clear(void)
@@ -248,6 +253,214 @@ long list_thread(void)
     return 0;
 }
 
+#ifdef RT_USING_THREAD_STAT
+#define TOP_THREAD_NR 32
+
+struct top_sample
+{
+    struct rt_thread *thread;                   /* only compared, never dereferenced after sampling */
+    rt_uint32_t id;
+    rt_uint64_t run_time;
+    char name[RT_NAME_MAX];
+};
+
+/* sample the run time of threads, returns the number of threads */
+static int top_sample(struct top_sample *sample, int nr)
+{
+    list_get_next_t find_arg;
+    rt_list_t *obj_list[LIST_FIND_OBJ_NR];
+    rt_list_t *next = (rt_list_t *)RT_NULL;
+    struct rt_thread_stat stat;
+    rt_base_t level;
+    int count = 0;
+
+    list_find_init(&find_arg, RT_Object_Class_Thread, obj_list, sizeof(obj_list) / sizeof(obj_list[0]));
+
+    do
+    {
+        int i;
+
+        next = list_get_next(next, &find_arg);
+        for (i = 0; i < find_arg.nr_out && count < nr; i++)
+        {
+            struct rt_object *obj = rt_list_entry(obj_list[i], struct rt_object, list);
+
+            level = rt_hw_interrupt_disable();
+            if ((obj->type & ~RT_Object_Class_Static) != find_arg.type)
+            {
+                rt_hw_interrupt_enable(level);
+                continue;
+            }
+            rt_thread_stat_get((rt_thread_t)obj, &stat);
+            sample[count].thread = (rt_thread_t)obj;
+            sample[count].id = stat.id;
+            sample[count].run_time = stat.run_time;
+            rt_strncpy(sample[count].name, obj->name, RT_NAME_MAX);
+            rt_hw_interrupt_enable(level);
+
+            count ++;
+        }
+    }
+    while (next != (rt_list_t *)RT_NULL && count < nr);
+
+    return count;
+}
+
+static rt_uint32_t top_us(rt_uint64_t count)
+{
+    rt_uint64_t us = count * clock_cpu_getres() / 1000;
+
+    return us > 0xffffffffUL ? 0xffffffffUL : (rt_uint32_t)us;
+}
+
+/* find the sampled thread if it is still alive, and get its statistics */
+static rt_bool_t top_lookup(const struct top_sample *sample, struct rt_thread_stat *stat, rt_uint8_t *priority)
+{
+    struct rt_object_information *info;
+    struct rt_list_node *node;
+    rt_bool_t found = RT_FALSE;
+    rt_base_t level;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+
+    level = rt_hw_interrupt_disable();
+    rt_list_for_each(node, &(info->object_list))
+    {
+        rt_thread_t thread = (rt_thread_t)rt_list_entry(node, struct rt_object, list);
+
+        if (thread == sample->thread && thread->sched_stat.id == sample->id)
+        {
+            rt_thread_stat_get(thread, stat);
+            *priority = thread->current_priority;
+            found = RT_TRUE;
+            break;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+
+    return found;
+}
+
+static void top_hist(const char *name)
+{
+    struct rt_thread_stat stat;
+    rt_thread_t thread;
+    int i;
+
+    thread = rt_thread_find((char *)name);
+    if (thread == RT_NULL)
+    {
+        rt_kprintf("thread %s not found\n", name);
+        return;
+    }
+
+    rt_thread_stat_get(thread, &stat);
+    rt_kprintf("%-*.*s ready-to-run latency, %d samples\n", RT_NAME_MAX, RT_NAME_MAX, thread->name,
+               stat.latency_count);
+    rt_kprintf("  from(us)      to(us)  count\n");
+    rt_kprintf("---------- ----------- ------\n");
+    for (i = 0; i < RT_THREAD_STAT_HIST_NUM; i++)
+    {
+        if (stat.latency_hist[i] == 0)
+            continue;
+        /* the last bucket has no upper bound */
+        if (i == RT_THREAD_STAT_HIST_NUM - 1)
+            rt_kprintf("%10d %11s %6d\n", top_us(1ULL << i), "-", stat.latency_hist[i]);
+        else
+            rt_kprintf("%10d %11d %6d\n", top_us(1ULL << i), top_us(1ULL << (i + 1)), stat.latency_hist[i]);
+    }
+}
+
+static int cmd_top(int argc, char **argv)
+{
+    struct top_sample last[TOP_THREAD_NR], now[TOP_THREAD_NR];
+    struct rt_thread_stat stat;
+    rt_uint64_t start, elapsed;
+    rt_int32_t interval = 1000;
+    int last_nr, now_nr, i, j;
+    const char *item_title = "thread";
+
+    if (argc == 2 && !rt_strcmp(argv[1], "reset"))
+    {
+        rt_thread_stat_reset(RT_NULL);
+        return 0;
+    }
+    else if (argc == 3 && !rt_strcmp(argv[1], "hist"))
+    {
+        top_hist(argv[2]);
+        return 0;
+    }
+    else if (argc == 2)
+    {
+        interval = atoi(argv[1]);
+    }
+
+    if (interval <= 0 || argc > 3)
+    {
+        rt_kprintf("Usage: top [interval ms] | top reset | top hist <thread>\n");
+        return -RT_EINVAL;
+    }
+
+    start = clock_cpu_gettime();
+    last_nr = top_sample(last, TOP_THREAD_NR);
+    rt_thread_mdelay(interval);
+    now_nr = top_sample(now, TOP_THREAD_NR);
+    elapsed = clock_cpu_gettime() - start;
+    if (elapsed == 0)
+    {
+        rt_kprintf("no cputime clock\n");
+        return -RT_ERROR;
+    }
+
+    /* run time in this interval, sorted by usage */
+    for (i = 0; i < now_nr; i++)
+    {
+        for (j = 0; j < last_nr; j++)
+        {
+            if (last[j].thread == now[i].thread && last[j].id == now[i].id)
+            {
+                now[i].run_time -= last[j].run_time;
+                break;
+            }
+        }
+    }
+    for (i = 0; i < now_nr; i++)
+    {
+        for (j = i + 1; j < now_nr; j++)
+        {
+            if (now[j].run_time > now[i].run_time)
+            {
+                struct top_sample tmp = now[i];
+                now[i] = now[j];
+                now[j] = tmp;
+            }
+        }
+    }
+
+    rt_kprintf("%-*.s pri   cpu%%   run(ms)   switch lat avg(us) lat max(us)\n", RT_NAME_MAX, item_title);
+    object_split(RT_NAME_MAX);
+    rt_kprintf(" --- ------ --------- -------- ---------- ----------\n");
+    for (i = 0; i < now_nr; i++)
+    {
+        rt_uint32_t usage = (rt_uint32_t)(now[i].run_time * 1000 / elapsed);
+        rt_uint8_t priority;
+
+        /* the thread has exited during sampling */
+        if (!top_lookup(&now[i], &stat, &priority))
+            continue;
+
+        rt_kprintf("%-*.*s %3d %3d.%d%% %9d %8d %10d %10d\n", RT_NAME_MAX, RT_NAME_MAX, now[i].name,
+                   priority, usage / 10, usage % 10,
+                   top_us(stat.run_time) / 1000, stat.run_count,
+                   stat.latency_count ? top_us(stat.latency_sum / stat.latency_count) : 0,
+                   top_us(stat.latency_max));
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT_ALIAS(cmd_top, top, show thread cpu usage and scheduling latency);
+#endif /* RT_USING_THREAD_STAT */
+
 static void show_wait_queue(struct rt_list_node *list)
 {
     struct rt_thread *thread;
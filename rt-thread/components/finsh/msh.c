@@ -84,7 +84,30 @@ int cmd_free(int argc, char **argv)
     rt_kprintf("used     : %d\n", used);
     rt_kprintf("maximum  : %d\n", max_used);
     rt_kprintf("available: %d\n", total - used);
+#ifdef RT_USING_TLSF_AS_HEAP
+    {
+        rt_size_t free_blocks = 0, max_free = 0;
+
+        rt_memory_frag_info(&free_blocks, &max_free);
+        rt_kprintf("free blks: %d\n", free_blocks);
+        rt_kprintf("max free : %d\n", max_free);
+        if (total > used)
+            rt_kprintf("fragment : %d%%\n", (int)((total - used - max_free) * 100 / (total - used)));
+    }
+#endif /* RT_USING_TLSF_AS_HEAP */
 #endif
+#ifdef RT_USING_HEAP_CACHE
+    {
+        rt_uint32_t index, hit, miss;
+        rt_size_t size, cached;
+
+        rt_kprintf("cache size cached   hit        miss\n");
+        for (index = 0; rt_heap_cache_info(index, &size, &cached, &hit, &miss) == RT_EOK; index++)
+        {
+            rt_kprintf("      %-4d %-8d %-10d %-10d\n", size, cached, hit, miss);
+        }
+    }
+#endif /* RT_USING_HEAP_CACHE */
     return 0;
 }
 MSH_CMD_EXPORT_ALIAS(cmd_free, free, Show the memory usage in the system.);
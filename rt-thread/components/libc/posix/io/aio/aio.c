@@ -16,7 +16,225 @@
 #include <sys/errno.h>
 #include "aio.h"
 
-struct rt_workqueue* aio_queue = NULL;
+/*
+ * The requests are queued in submission order and run by the aio thread. The
+ * writes queued back to back on the same file and covering adjacent ranges, as
+ * appended log records do, are merged into a single write() of at most
+ * AIO_WRITE_MERGE_SIZE bytes.
+ */
+
+#ifndef AIO_WRITE_MERGE_SIZE
+#define AIO_WRITE_MERGE_SIZE    4096
+#endif
+
+#ifndef AIO_NOTIFY_THREAD_STACK_SIZE
+#define AIO_NOTIFY_THREAD_STACK_SIZE    2048
+#endif
+
+#define AIO_OP_FSYNC            (LIO_NOP + 1)
+/* the longest timeout of aio_suspend(), in ticks */
+#define AIO_SUSPEND_TICK_MAX    (RT_TICK_MAX / 2 - 1)
+
+struct aio_listio
+{
+    int pending;                    /* protected by interrupt lock */
+    int error;
+    struct rt_semaphore *done;      /* released for LIO_WAIT */
+    struct sigevent sig;            /* sent for LIO_NOWAIT */
+    rt_thread_t thread;
+};
+
+struct aio_waiter
+{
+    rt_list_t node;
+    struct rt_semaphore sem;
+};
+
+static struct rt_semaphore aio_sem;
+static rt_list_t aio_pending = RT_LIST_OBJECT_INIT(aio_pending);
+static rt_list_t aio_running = RT_LIST_OBJECT_INIT(aio_running);
+static rt_list_t aio_waiters = RT_LIST_OBJECT_INIT(aio_waiters);
+
+struct aio_notify_thread
+{
+    void (*function)(union sigval);
+    union sigval value;
+};
+
+#ifdef RT_USING_SIGNALS
+/* the thread which submitted the request may have exited since then */
+static void aio_notify_signal(rt_thread_t thread, int signo)
+{
+    struct rt_object_information *info;
+    struct rt_list_node *node;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+
+    /* no thread is deleted while the scheduler is locked */
+    rt_enter_critical();
+    rt_list_for_each(node, &(info->object_list))
+    {
+        if (rt_list_entry(node, struct rt_object, list) != (struct rt_object *)thread)
+            continue;
+
+        if ((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+            rt_thread_kill(thread, signo);
+        break;
+    }
+    rt_exit_critical();
+}
+#endif
+
+static void aio_notify_entry(void *parameter)
+{
+    struct aio_notify_thread *notify = (struct aio_notify_thread *)parameter;
+
+    notify->function(notify->value);
+    rt_free(notify);
+}
+
+static void aio_notify(const struct sigevent *sig, rt_thread_t thread)
+{
+    struct aio_notify_thread *notify;
+    rt_thread_t tid = RT_NULL;
+
+    switch (sig->sigev_notify)
+    {
+    case SIGEV_SIGNAL:
+#ifdef RT_USING_SIGNALS
+        if (thread)
+            aio_notify_signal(thread, sig->sigev_signo);
+#endif
+        break;
+
+    case SIGEV_THREAD:
+        /* run on a new thread, sigev_notify_attributes is ignored */
+        if (sig->sigev_notify_function == RT_NULL)
+            break;
+
+        notify = (struct aio_notify_thread *)rt_malloc(sizeof(struct aio_notify_thread));
+        if (notify)
+        {
+            notify->function = sig->sigev_notify_function;
+            notify->value = sig->sigev_value;
+            tid = rt_thread_create("aion", aio_notify_entry, notify, AIO_NOTIFY_THREAD_STACK_SIZE,
+                                   RT_THREAD_PRIORITY_MAX/2, 10);
+        }
+
+        if (tid)
+        {
+            rt_thread_startup(tid);
+        }
+        else
+        {
+            /* no memory for the thread, call it here rather than lose it */
+            rt_free(notify);
+            sig->sigev_notify_function(sig->sigev_value);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void aio_listio_done(struct aio_listio *lio, int result)
+{
+    rt_base_t level;
+    int pending;
+
+    level = rt_hw_interrupt_disable();
+    if (result < 0)
+        lio->error = 1;
+    pending = --lio->pending;
+    rt_hw_interrupt_enable(level);
+
+    if (pending)
+        return;
+
+    if (lio->done)
+    {
+        rt_sem_release(lio->done);
+    }
+    else
+    {
+        aio_notify(&lio->sig, lio->thread);
+        rt_free(lio);
+    }
+}
+
+static void aio_complete(struct aiocb *cb, int result)
+{
+    struct sigevent sig = cb->aio_sigevent;
+    struct aio_listio *lio = cb->aio_lio;
+    rt_thread_t thread = cb->aio_thread;
+    struct aio_waiter *waiter;
+    rt_base_t level;
+
+    /* the control block may be reused as soon as the result is set */
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&(cb->aio_node));
+    cb->aio_result = result;
+    rt_list_for_each_entry(waiter, &aio_waiters, node)
+    {
+        rt_sem_release(&(waiter->sem));
+    }
+    rt_hw_interrupt_enable(level);
+
+    aio_notify(&sig, thread);
+    if (lio)
+        aio_listio_done(lio, result);
+}
+
+static int aio_check(struct aiocb *cb, int op)
+{
+    int oflags;
+
+    if (!cb) return -EINVAL;
+
+    if (op == LIO_READ || op == LIO_WRITE)
+    {
+        if (cb->aio_buf == NULL) return -EINVAL;
+        if (cb->aio_offset < 0) return -EINVAL;
+
+        /* check access mode */
+        oflags = fcntl(cb->aio_fildes, F_GETFL, 0);
+        if (oflags < 0) return -EBADF;
+        if (op == LIO_READ && (oflags & O_ACCMODE) == O_WRONLY)
+            return -EBADF;
+        if (op == LIO_WRITE && (oflags & O_ACCMODE) == O_RDONLY)
+            return -EBADF;
+    }
+
+    return 0;
+}
+
+static void aio_enqueue(struct aiocb *cb, int op, struct aio_listio *lio)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    cb->aio_result = -EINPROGRESS;
+    cb->aio_op = op;
+    cb->aio_lio = lio;
+    cb->aio_thread = rt_thread_self();
+    rt_list_insert_before(&aio_pending, &(cb->aio_node));
+    rt_hw_interrupt_enable(level);
+}
+
+static int aio_submit(struct aiocb *cb, int op)
+{
+    int result;
+
+    result = aio_check(cb, op);
+    if (result < 0)
+        return result;
+
+    aio_enqueue(cb, op, RT_NULL);
+    rt_sem_release(&aio_sem);
+
+    return 0;
+}
 
 /**
  * The aio_cancel() function shall attempt to cancel one or more asynchronous I/O
@@ -42,19 +260,41 @@ struct rt_workqueue* aio_queue = NULL;
  */
 int aio_cancel(int fd, struct aiocb *cb)
 {
-    rt_err_t ret;
+    struct aiocb *entry, *next;
+    rt_list_t canceled;
+    rt_base_t level;
+    int result = AIO_ALLDONE;
 
-    if (!cb) return -EINVAL;
-    if (cb->aio_fildes != fd) return -EINVAL;
+    if (cb && cb->aio_fildes != fd) return -EINVAL;
+
+    rt_list_init(&canceled);
 
-    ret = rt_workqueue_cancel_work_sync(aio_queue, &(cb->aio_work));
-    if (ret == RT_EOK)
+    level = rt_hw_interrupt_disable();
+    rt_list_for_each_entry_safe(entry, next, &aio_pending, aio_node)
+    {
+        if (cb ? entry == cb : entry->aio_fildes == fd)
+        {
+            rt_list_remove(&(entry->aio_node));
+            rt_list_insert_before(&canceled, &(entry->aio_node));
+            result = AIO_CANCELED;
+        }
+    }
+    rt_list_for_each_entry(entry, &aio_running, aio_node)
     {
-        errno = -ECANCELED;
-        return -1;
+        if (cb ? entry == cb : entry->aio_fildes == fd)
+        {
+            result = AIO_NOTCANCELED;
+        }
     }
+    rt_hw_interrupt_enable(level);
 
-    return 0;
+    while (!rt_list_isempty(&canceled))
+    {
+        entry = rt_list_first_entry(&canceled, struct aiocb, aio_node);
+        aio_complete(entry, -ECANCELED);
+    }
+
+    return result;
 }
 
 /**
@@ -114,63 +354,9 @@ int aio_error (const struct aiocb *cb)
  * If the aio_fsync() function fails or aiocbp indicates an error condition,
  * data is not guaranteed to have been successfully transferred.
  */
-static void aio_fync_work(struct rt_work* work, void* work_data)
-{
-    int result;
-    rt_base_t level;
-    struct aiocb *cb = (struct aiocb*)work_data;
-
-    RT_ASSERT(cb != RT_NULL);
-
-    result = fsync(cb->aio_fildes);
-    /* modify result */
-    level = rt_hw_interrupt_disable();
-    if (result < 0)
-        cb->aio_result = errno;
-    else
-        cb->aio_result = 0;
-    rt_hw_interrupt_enable(level);
-
-    return ;
-}
-
 int aio_fsync(int op, struct aiocb *cb)
 {
-    rt_base_t level;
-    if (!cb) return -EINVAL;
-
-    level = rt_hw_interrupt_disable();
-    cb->aio_result = -EINPROGRESS;
-    rt_hw_interrupt_enable(level);
-
-    rt_work_init(&(cb->aio_work), aio_fync_work, cb);
-    rt_workqueue_dowork(aio_queue, &(cb->aio_work));
-
-    return 0;
-}
-
-static void aio_read_work(struct rt_work* work, void* work_data)
-{
-    int len;
-    rt_base_t level;
-    uint8_t *buf_ptr;
-    struct aiocb *cb = (struct aiocb*)work_data;
-
-    buf_ptr = (uint8_t*)cb->aio_buf;
-
-    /* seek to offset */
-    lseek(cb->aio_fildes, cb->aio_offset, SEEK_SET);
-    len = read(cb->aio_fildes, &buf_ptr[cb->aio_offset], cb->aio_nbytes);
-
-    /* modify result */
-    level = rt_hw_interrupt_disable();
-    if (len <= 0)
-        cb->aio_result = errno;
-    else
-        cb->aio_result = len;
-    rt_hw_interrupt_enable(level);
-
-    return ;
+    return aio_submit(cb, AIO_OP_FSYNC);
 }
 
 /**
@@ -222,20 +408,7 @@ static void aio_read_work(struct rt_work* work, void* work_data)
  */
 int aio_read(struct aiocb *cb)
 {
-    rt_base_t level;
-
-    if (!cb) return -EINVAL;
-    if (cb->aio_offset < 0) return -EINVAL;
-
-    level = rt_hw_interrupt_disable();
-    cb->aio_result = -EINPROGRESS;
-    rt_hw_interrupt_enable(level);
-
-    /* en-queue read work */
-    rt_work_init(&(cb->aio_work), aio_read_work, cb);
-    rt_workqueue_dowork(aio_queue, &(cb->aio_work));
-
-    return 0;
+    return aio_submit(cb, LIO_READ);
 }
 
 /**
@@ -264,6 +437,19 @@ ssize_t  aio_return(struct aiocb *cb)
     return -EINVAL;
 }
 
+static int aio_any_done(const struct aiocb *const list[], int nent)
+{
+    int index;
+
+    for (index = 0; index < nent; index ++)
+    {
+        if (list[index] && list[index]->aio_result != -EINPROGRESS)
+            return 1;
+    }
+
+    return 0;
+}
+
 /**
  * The aio_suspend() function shall suspend the calling thread until at least
  * one of the asynchronous I/O operations referenced by the list argument has
@@ -287,37 +473,63 @@ ssize_t  aio_return(struct aiocb *cb)
 int aio_suspend(const struct aiocb *const list[], int nent,
              const struct timespec *timeout)
 {
-    return -ENOSYS;
-}
-
-static void aio_write_work(struct rt_work* work, void* work_data)
-{
+    struct aio_waiter waiter;
+    rt_int32_t ticks = RT_WAITING_FOREVER;
+    rt_tick_t start;
     rt_base_t level;
-    int len, oflags;
-    uint8_t *buf_ptr;
-    struct aiocb *cb = (struct aiocb*)work_data;
+    rt_err_t err = RT_EOK;
+    int done;
 
-    buf_ptr = (uint8_t*)cb->aio_buf;
+    if (!list || nent <= 0) return -EINVAL;
 
-    /* whether seek offset */
-    oflags = fcntl(cb->aio_fildes, F_GETFL, 0);
-    if ((oflags & O_APPEND) == 0)
+    if (timeout)
     {
-        lseek(cb->aio_fildes, SEEK_SET, cb->aio_offset);
+        if (timeout->tv_sec < 0 || timeout->tv_nsec < 0 || timeout->tv_nsec >= 1000000000)
+            return -EINVAL;
+
+        if (timeout->tv_sec >= AIO_SUSPEND_TICK_MAX / RT_TICK_PER_SECOND)
+            ticks = AIO_SUSPEND_TICK_MAX;
+        else
+            ticks = timeout->tv_sec * RT_TICK_PER_SECOND
+                    + rt_tick_from_millisecond(timeout->tv_nsec / 1000000);
     }
+    start = rt_tick_get();
 
-    /* write data */
-    len = write(cb->aio_fildes, buf_ptr, cb->aio_nbytes);
+    rt_sem_init(&(waiter.sem), "aio", 0, RT_IPC_FLAG_PRIO);
 
-    /* modify result */
     level = rt_hw_interrupt_disable();
-    if (len <= 0)
-        cb->aio_result = errno;
-    else
-        cb->aio_result = len;
+    rt_list_insert_before(&aio_waiters, &(waiter.node));
+    while (!(done = aio_any_done(list, nent)) && ticks != 0)
+    {
+        rt_hw_interrupt_enable(level);
+
+        err = rt_sem_take(&(waiter.sem), ticks);
+        if (err == -RT_ETIMEOUT)
+        {
+            ticks = 0;
+        }
+        else if (ticks != RT_WAITING_FOREVER)
+        {
+            ticks -= rt_tick_get() - start;
+            start = rt_tick_get();
+            if (ticks < 0) ticks = 0;
+        }
+
+        level = rt_hw_interrupt_disable();
+        if (err != RT_EOK && err != -RT_ETIMEOUT)
+        {
+            done = aio_any_done(list, nent);
+            break;
+        }
+    }
+    rt_list_remove(&(waiter.node));
     rt_hw_interrupt_enable(level);
 
-    return;
+    rt_sem_detach(&(waiter.sem));
+
+    if (done) return 0;
+
+    return (err == RT_EOK || err == -RT_ETIMEOUT) ? -EAGAIN : -EINTR;
 }
 
 /**
@@ -361,25 +573,7 @@ static void aio_write_work(struct rt_work* work, void* work_data)
  */
 int aio_write(struct aiocb *cb)
 {
-    int oflags;
-    rt_base_t level;
-
-    if (!cb || (cb->aio_buf == NULL)) return -EINVAL;
-
-    /* check access mode */
-    oflags = fcntl(cb->aio_fildes, F_GETFL, 0);
-    if ((oflags & O_ACCMODE) != O_WRONLY ||
-        (oflags & O_ACCMODE) != O_RDWR)
-        return -EINVAL;
-
-    level = rt_hw_interrupt_disable();
-    cb->aio_result = -EINPROGRESS;
-    rt_hw_interrupt_enable(level);
-
-    rt_work_init(&(cb->aio_work), aio_write_work, cb);
-    rt_workqueue_dowork(aio_queue, &(cb->aio_work));
-
-    return 0;
+    return aio_submit(cb, LIO_WRITE);
 }
 
 /**
@@ -450,13 +644,249 @@ int aio_write(struct aiocb *cb)
 int lio_listio(int mode, struct aiocb * const list[], int nent,
             struct sigevent *sig)
 {
-    return -ENOSYS;
+    struct rt_semaphore done;
+    struct aio_listio stack_lio;
+    struct aio_listio *lio = RT_NULL;
+    rt_base_t level;
+    int index, op, result;
+    int error = 0;
+
+    if (mode != LIO_WAIT && mode != LIO_NOWAIT) return -EINVAL;
+    if (!list || nent <= 0 || nent > AIO_LISTIO_MAX) return -EINVAL;
+
+    if (mode == LIO_WAIT)
+    {
+        rt_memset(&stack_lio, 0, sizeof(stack_lio));
+        rt_sem_init(&done, "lio", 0, RT_IPC_FLAG_PRIO);
+        stack_lio.done = &done;
+        lio = &stack_lio;
+    }
+    else if (sig && sig->sigev_notify != SIGEV_NONE)
+    {
+        lio = (struct aio_listio *)rt_calloc(1, sizeof(struct aio_listio));
+        if (lio == RT_NULL) return -EAGAIN;
+
+        lio->sig = *sig;
+        lio->thread = rt_thread_self();
+    }
+
+    /* held until all the requests are queued */
+    if (lio) lio->pending = 1;
+
+    for (index = 0; index < nent; index ++)
+    {
+        if (list[index] == RT_NULL) continue;
+
+        op = list[index]->aio_lio_opcode;
+        if (op == LIO_NOP) continue;
+
+        result = (op == LIO_READ || op == LIO_WRITE) ? aio_check(list[index], op) : -EINVAL;
+        if (result < 0)
+        {
+            list[index]->aio_result = result;
+            error = 1;
+            continue;
+        }
+
+        if (lio)
+        {
+            level = rt_hw_interrupt_disable();
+            lio->pending ++;
+            rt_hw_interrupt_enable(level);
+        }
+        aio_enqueue(list[index], op, lio);
+    }
+
+    /* wake the aio thread once, so the adjacent writes of the list are merged */
+    rt_sem_release(&aio_sem);
+
+    if (lio)
+        aio_listio_done(lio, 0);
+
+    if (mode == LIO_WAIT)
+    {
+        rt_sem_take(&done, RT_WAITING_FOREVER);
+        rt_sem_detach(&done);
+        if (stack_lio.error) error = 1;
+    }
+
+    return error ? -EIO : 0;
+}
+
+static void aio_do_read(struct aiocb *cb)
+{
+    int len;
+
+    /* seek to offset */
+    lseek(cb->aio_fildes, cb->aio_offset, SEEK_SET);
+    len = read(cb->aio_fildes, (void *)cb->aio_buf, cb->aio_nbytes);
+
+    aio_complete(cb, len < 0 ? errno : len);
+}
+
+/* write the requests of the running list, which cover adjacent ranges */
+static void aio_do_write(size_t total, int oflags)
+{
+    struct aiocb *cb;
+    uint8_t *buf_ptr = RT_NULL;
+    size_t offset = 0;
+    int fd, len, n, err = 0;
+
+    cb = rt_list_first_entry(&aio_running, struct aiocb, aio_node);
+    fd = cb->aio_fildes;
+
+    /* whether seek offset */
+    if ((oflags & O_APPEND) == 0)
+    {
+        lseek(fd, cb->aio_offset, SEEK_SET);
+    }
+
+    if (total > cb->aio_nbytes)
+    {
+        buf_ptr = (uint8_t *)rt_malloc(total);
+    }
+
+    if (buf_ptr)
+    {
+        rt_list_for_each_entry(cb, &aio_running, aio_node)
+        {
+            rt_memcpy(buf_ptr + offset, (const void *)cb->aio_buf, cb->aio_nbytes);
+            offset += cb->aio_nbytes;
+        }
+
+        len = write(fd, buf_ptr, total);
+        if (len < 0) err = errno;
+        rt_free(buf_ptr);
+    }
+    else
+    {
+        /* no merge buffer, write the requests one by one */
+        len = 0;
+        rt_list_for_each_entry(cb, &aio_running, aio_node)
+        {
+            n = write(fd, (const void *)cb->aio_buf, cb->aio_nbytes);
+            if (n < 0)
+            {
+                if (len == 0)
+                {
+                    len = -1;
+                    err = errno;
+                }
+                break;
+            }
+
+            len += n;
+            if ((size_t)n < cb->aio_nbytes)
+                break;
+        }
+    }
+
+    /* share the written bytes out in order */
+    while (!rt_list_isempty(&aio_running))
+    {
+        cb = rt_list_first_entry(&aio_running, struct aiocb, aio_node);
+        if (len < 0)
+        {
+            aio_complete(cb, err);
+        }
+        else
+        {
+            offset = (size_t)len < cb->aio_nbytes ? (size_t)len : cb->aio_nbytes;
+            len -= offset;
+            aio_complete(cb, (offset == 0 && cb->aio_nbytes) ? -EIO : (int)offset);
+        }
+    }
+}
+
+static void aio_do_fsync(struct aiocb *cb)
+{
+    int result;
+
+    result = fsync(cb->aio_fildes);
+
+    aio_complete(cb, result < 0 ? errno : 0);
+}
+
+/* run the oldest pending request and the writes merged with it */
+static rt_bool_t aio_do_next(void)
+{
+    struct aiocb *cb, *next;
+    rt_base_t level;
+    size_t total;
+    off_t end;
+    int oflags = 0;
+
+    level = rt_hw_interrupt_disable();
+    if (rt_list_isempty(&aio_pending))
+    {
+        rt_hw_interrupt_enable(level);
+        return RT_FALSE;
+    }
+
+    cb = rt_list_first_entry(&aio_pending, struct aiocb, aio_node);
+    rt_list_remove(&(cb->aio_node));
+    rt_list_insert_before(&aio_running, &(cb->aio_node));
+    rt_hw_interrupt_enable(level);
+
+    switch (cb->aio_op)
+    {
+    case LIO_READ:
+        aio_do_read(cb);
+        break;
+
+    case LIO_WRITE:
+        oflags = fcntl(cb->aio_fildes, F_GETFL, 0);
+        total = cb->aio_nbytes;
+        end = cb->aio_offset + cb->aio_nbytes;
+
+        level = rt_hw_interrupt_disable();
+        while (!rt_list_isempty(&aio_pending))
+        {
+            next = rt_list_first_entry(&aio_pending, struct aiocb, aio_node);
+            if (next->aio_op != LIO_WRITE || next->aio_fildes != cb->aio_fildes)
+                break;
+            if ((oflags & O_APPEND) == 0 && next->aio_offset != end)
+                break;
+            if (total + next->aio_nbytes > AIO_WRITE_MERGE_SIZE)
+                break;
+
+            rt_list_remove(&(next->aio_node));
+            rt_list_insert_before(&aio_running, &(next->aio_node));
+            total += next->aio_nbytes;
+            end += next->aio_nbytes;
+        }
+        rt_hw_interrupt_enable(level);
+
+        aio_do_write(total, oflags);
+        break;
+
+    default:
+        aio_do_fsync(cb);
+        break;
+    }
+
+    return RT_TRUE;
+}
+
+static void aio_thread_entry(void *parameter)
+{
+    while (1)
+    {
+        rt_sem_take(&aio_sem, RT_WAITING_FOREVER);
+
+        while (aio_do_next());
+    }
 }
 
 int aio_system_init(void)
 {
-    aio_queue = rt_workqueue_create("aio", 2048, RT_THREAD_PRIORITY_MAX/2);
-    RT_ASSERT(aio_queue != NULL);
+    rt_thread_t tid;
+
+    rt_sem_init(&aio_sem, "aio", 0, RT_IPC_FLAG_PRIO);
+
+    tid = rt_thread_create("aio", aio_thread_entry, RT_NULL, 2048, RT_THREAD_PRIORITY_MAX/2, 10);
+    RT_ASSERT(tid != NULL);
+    rt_thread_startup(tid);
 
     return 0;
 }
@@ -15,6 +15,23 @@
 #include <sys/signal.h>
 #include <rtdevice.h>
 
+#define AIO_CANCELED    0
+#define AIO_NOTCANCELED 1
+#define AIO_ALLDONE     2
+
+#define LIO_READ        0
+#define LIO_WRITE       1
+#define LIO_NOP         2
+
+#define LIO_WAIT        0
+#define LIO_NOWAIT      1
+
+#ifndef AIO_LISTIO_MAX
+#define AIO_LISTIO_MAX  32
+#endif
+
+struct aio_listio;
+
 struct aiocb
 {
     int aio_fildes;         /* File descriptor. */
@@ -27,7 +44,10 @@ struct aiocb
     int aio_lio_opcode;     /* Operation to be performed. */
 
     int aio_result;
-    struct rt_work aio_work;
+    int aio_op;
+    rt_list_t aio_node;
+    rt_thread_t aio_thread;
+    struct aio_listio *aio_lio;
 };
 
 int aio_cancel(int fd, struct aiocb *cb);
@@ -0,0 +1,619 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <stdint.h>
+#include <rthw.h>
+#include <rtthread.h>
+#include <dfs_file.h>
+#include <sys/errno.h>
+#include "sys/epoll.h"
+
+/*
+ * Unlike poll(), which hooks on the wait queue of every file for each call,
+ * an epoll instance hooks on them once when the file is added. The wake up
+ * callbacks never resume a thread themselves, they only move the item to the
+ * ready list, so epoll_wait() only polls again the files which have been
+ * signaled since the last call.
+ *
+ * A file closed without EPOLL_CTL_DEL is detached from all the instances by
+ * the close hook of DFS, before its wait queues go away.
+ */
+
+#define EPOLL_EVENT_FLAGS   (EPOLLET | EPOLLONESHOT)
+
+struct rt_epoll_item;
+
+struct rt_eventpoll
+{
+    rt_list_t list;                 /* node of the instance list */
+    struct rt_mutex lock;           /* protects the interest list */
+    struct rt_semaphore notice;     /* released when an item gets ready */
+    rt_list_t items;                /* the interest list */
+    rt_list_t ready;                /* the ready list, protected by interrupt lock */
+};
+
+struct rt_epoll_node
+{
+    struct rt_wqueue_node wqn;
+    struct rt_epoll_item *item;
+    struct rt_epoll_node *next;
+};
+
+struct rt_epoll_item
+{
+    rt_list_t list;                 /* node of the interest list */
+    rt_list_t rdlink;               /* node of the ready list */
+    rt_pollreq_t req;
+    struct rt_eventpoll *ep;
+    struct dfs_fd *file;
+    int fd;
+    struct epoll_event event;
+    struct rt_epoll_node *nodes;    /* the wait queue hooks */
+    rt_bool_t nomem;                /* a wait queue hook failed to be allocated */
+};
+
+static struct rt_mutex _epoll_lock;    /* protects the instance list */
+static rt_list_t _epoll_list = RT_LIST_OBJECT_INIT(_epoll_list);
+
+/* the semaphore only tells the waiters to look at the ready list again */
+static void epoll_notify(struct rt_eventpoll *ep)
+{
+    if (ep->notice.value == 0)
+    {
+        rt_sem_release(&ep->notice);
+    }
+}
+
+static void epoll_item_ready(struct rt_epoll_item *item)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (rt_list_isempty(&item->rdlink))
+    {
+        rt_list_insert_before(&item->ep->ready, &item->rdlink);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+static int __wqueue_epollwake(struct rt_wqueue_node *wait, void *key)
+{
+    struct rt_epoll_item *item;
+
+    if (key && !((rt_ubase_t)key & wait->key))
+        return -1;
+
+    item = rt_container_of(wait, struct rt_epoll_node, wqn)->item;
+
+    /* disabled by EPOLLONESHOT */
+    if ((item->event.events & ~EPOLL_EVENT_FLAGS) == 0)
+        return -1;
+
+    if (rt_list_isempty(&item->rdlink))
+    {
+        rt_list_insert_before(&item->ep->ready, &item->rdlink);
+        epoll_notify(item->ep);
+    }
+
+    /* keep the node on the wait queue and go on with the other ones */
+    return -1;
+}
+
+static void _epoll_add(rt_wqueue_t *wq, rt_pollreq_t *req)
+{
+    struct rt_epoll_item *item;
+    struct rt_epoll_node *node;
+
+    item = rt_container_of(req, struct rt_epoll_item, req);
+
+    node = (struct rt_epoll_node *)rt_malloc(sizeof(struct rt_epoll_node));
+    if (node == RT_NULL)
+    {
+        /* the file would never wake the item, EPOLL_CTL_ADD fails */
+        item->nomem = RT_TRUE;
+        return;
+    }
+
+    node->wqn.key = req->_key;
+    rt_list_init(&(node->wqn.list));
+    node->wqn.polling_thread = RT_NULL;
+    node->wqn.wakeup = __wqueue_epollwake;
+    node->next = item->nodes;
+    node->item = item;
+    item->nodes = node;
+    rt_wqueue_add(wq, &node->wqn);
+}
+
+static int epoll_item_poll(struct rt_epoll_item *item, rt_pollreq_t *req)
+{
+    int mask = POLLMASK_DEFAULT;
+    rt_uint32_t events = item->event.events | POLLERR | POLLHUP;
+
+    if (item->file->fops->poll)
+    {
+        req->_key = events;
+        mask = item->file->fops->poll(item->file, req);
+        if (mask < 0)
+            return POLLERR;
+    }
+
+    return mask & events & ~EPOLL_EVENT_FLAGS;
+}
+
+static void epoll_item_free(struct rt_epoll_item *item)
+{
+    struct rt_epoll_node *node, *next;
+    rt_base_t level;
+
+    next = item->nodes;
+    while (next)
+    {
+        node = next;
+        rt_wqueue_remove(&node->wqn);
+        next = node->next;
+        rt_free(node);
+    }
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&item->rdlink);
+    rt_hw_interrupt_enable(level);
+
+    rt_list_remove(&item->list);
+    fd_put(item->file);
+    rt_free(item);
+}
+
+static struct rt_epoll_item *epoll_item_find(struct rt_eventpoll *ep, int fd)
+{
+    struct rt_epoll_item *item;
+
+    rt_list_for_each_entry(item, &ep->items, list)
+    {
+        if (item->fd == fd)
+            return item;
+    }
+
+    return RT_NULL;
+}
+
+static int epoll_item_add(struct rt_eventpoll *ep, int fd, struct epoll_event *event)
+{
+    struct rt_epoll_item *item;
+    struct dfs_fd *file;
+    int mask;
+
+    file = fd_get(fd);
+    if (file == RT_NULL)
+        return -EBADF;
+
+    item = (struct rt_epoll_item *)rt_calloc(1, sizeof(struct rt_epoll_item));
+    if (item == RT_NULL)
+    {
+        fd_put(file);
+        return -ENOMEM;
+    }
+
+    rt_list_init(&item->rdlink);
+    item->ep = ep;
+    item->file = file;
+    item->fd = fd;
+    item->event = *event;
+    item->req._proc = _epoll_add;
+    rt_list_insert_before(&ep->items, &item->list);
+
+    /* hook on the wait queues of the file once for all */
+    mask = epoll_item_poll(item, &item->req);
+    item->req._proc = RT_NULL;
+    if (item->nomem)
+    {
+        epoll_item_free(item);
+        return -ENOMEM;
+    }
+
+    if (mask)
+    {
+        epoll_item_ready(item);
+        epoll_notify(ep);
+    }
+
+    return 0;
+}
+
+static int epoll_item_modify(struct rt_epoll_item *item, struct epoll_event *event)
+{
+    struct rt_epoll_node *node;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    item->event = *event;
+    for (node = item->nodes; node; node = node->next)
+    {
+        node->wqn.key = event->events | POLLERR | POLLHUP;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (epoll_item_poll(item, &item->req))
+    {
+        epoll_item_ready(item);
+        epoll_notify(item->ep);
+    }
+
+    return 0;
+}
+
+/* move the items of the list src to the head of the list dst */
+static void epoll_list_splice(rt_list_t *src, rt_list_t *dst)
+{
+    if (!rt_list_isempty(src))
+    {
+        src->next->prev = dst;
+        src->prev->next = dst->next;
+        dst->next->prev = src->prev;
+        dst->next = src->next;
+        rt_list_init(src);
+    }
+}
+
+static int epoll_do(struct rt_eventpoll *ep, struct epoll_event *events, int maxevents)
+{
+    struct rt_epoll_item *item;
+    rt_list_t txlist;
+    rt_pollreq_t req;
+    rt_base_t level;
+    int count = 0;
+    int mask;
+
+    req._proc = RT_NULL;
+    rt_list_init(&txlist);
+
+    level = rt_hw_interrupt_disable();
+    epoll_list_splice(&ep->ready, &txlist);
+    rt_hw_interrupt_enable(level);
+
+    while (count < maxevents)
+    {
+        level = rt_hw_interrupt_disable();
+        if (rt_list_isempty(&txlist))
+        {
+            rt_hw_interrupt_enable(level);
+            break;
+        }
+        item = rt_list_first_entry(&txlist, struct rt_epoll_item, rdlink);
+        /* a wake up from now on queues the item again */
+        rt_list_remove(&item->rdlink);
+        rt_hw_interrupt_enable(level);
+
+        mask = epoll_item_poll(item, &req);
+        if (mask == 0)
+            continue;
+
+        events[count].events = mask;
+        events[count].data = item->event.data;
+        count ++;
+
+        if (item->event.events & EPOLLONESHOT)
+        {
+            item->event.events &= EPOLL_EVENT_FLAGS;
+        }
+        else if (!(item->event.events & EPOLLET))
+        {
+            /* level triggered items stay ready until they are polled empty */
+            epoll_item_ready(item);
+        }
+    }
+
+    /* the items not polled yet are kept ahead for the next call */
+    level = rt_hw_interrupt_disable();
+    epoll_list_splice(&txlist, &ep->ready);
+    rt_hw_interrupt_enable(level);
+
+    return count;
+}
+
+/* detach a file from all the epoll instances before it is closed */
+static void epoll_file_close(struct dfs_fd *file)
+{
+    struct rt_eventpoll *ep;
+    struct rt_epoll_item *item, *next;
+
+    rt_mutex_take(&_epoll_lock, RT_WAITING_FOREVER);
+    rt_list_for_each_entry(ep, &_epoll_list, list)
+    {
+        rt_mutex_take(&ep->lock, RT_WAITING_FOREVER);
+        rt_list_for_each_entry_safe(item, next, &ep->items, list)
+        {
+            if (item->file == file)
+                epoll_item_free(item);
+        }
+        rt_mutex_release(&ep->lock);
+    }
+    rt_mutex_release(&_epoll_lock);
+}
+
+static int epoll_close(struct dfs_fd *file)
+{
+    struct rt_eventpoll *ep = (struct rt_eventpoll *)file->data;
+    struct rt_epoll_item *item;
+
+    if (ep)
+    {
+        rt_mutex_take(&_epoll_lock, RT_WAITING_FOREVER);
+        rt_list_remove(&ep->list);
+        rt_mutex_release(&_epoll_lock);
+
+        while (!rt_list_isempty(&ep->items))
+        {
+            item = rt_list_first_entry(&ep->items, struct rt_epoll_item, list);
+            epoll_item_free(item);
+        }
+
+        rt_sem_detach(&ep->notice);
+        rt_mutex_detach(&ep->lock);
+        rt_free(ep);
+        file->data = RT_NULL;
+    }
+
+    return 0;
+}
+
+static const struct dfs_file_ops epoll_fops =
+{
+    RT_NULL,
+    epoll_close,
+};
+
+static struct rt_eventpoll *epoll_get(int epfd, struct dfs_fd **file)
+{
+    struct dfs_fd *d;
+
+    d = fd_get(epfd);
+    if (d == RT_NULL)
+        return RT_NULL;
+
+    if (d->fops != &epoll_fops || d->data == RT_NULL)
+    {
+        fd_put(d);
+        return RT_NULL;
+    }
+
+    *file = d;
+    return (struct rt_eventpoll *)d->data;
+}
+
+/**
+ * This function will create an epoll instance.
+ *
+ * @param flags 0 or EPOLL_CLOEXEC, which is ignored.
+ *
+ * @return the file descriptor of the instance, -1 on failed.
+ */
+int epoll_create1(int flags)
+{
+    struct rt_eventpoll *ep;
+    struct dfs_fd *d;
+    int fd;
+
+    if (flags & ~EPOLL_CLOEXEC)
+    {
+        rt_set_errno(-EINVAL);
+        return -1;
+    }
+
+    ep = (struct rt_eventpoll *)rt_calloc(1, sizeof(struct rt_eventpoll));
+    if (ep == RT_NULL)
+    {
+        rt_set_errno(-ENOMEM);
+        return -1;
+    }
+
+    fd = fd_new();
+    if (fd < 0)
+    {
+        rt_free(ep);
+        rt_set_errno(-ENOMEM);
+        return -1;
+    }
+
+    rt_mutex_init(&ep->lock, "epoll", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&ep->notice, "epoll", 0, RT_IPC_FLAG_PRIO);
+    rt_list_init(&ep->items);
+    rt_list_init(&ep->ready);
+
+    rt_mutex_take(&_epoll_lock, RT_WAITING_FOREVER);
+    rt_list_insert_before(&_epoll_list, &ep->list);
+    rt_mutex_release(&_epoll_lock);
+
+    d = fd_get(fd);
+    d->type = FT_USER;
+    d->path = NULL;
+    d->fops = &epoll_fops;
+    d->flags = O_RDWR;
+    d->size = 0;
+    d->pos = 0;
+    d->data = ep;
+
+    /* release the ref-count of fd */
+    fd_put(d);
+
+    return fd;
+}
+RTM_EXPORT(epoll_create1);
+
+/**
+ * This function will create an epoll instance.
+ *
+ * @param size must be greater than zero, it is not used otherwise.
+ *
+ * @return the file descriptor of the instance, -1 on failed.
+ */
+int epoll_create(int size)
+{
+    if (size <= 0)
+    {
+        rt_set_errno(-EINVAL);
+        return -1;
+    }
+
+    return epoll_create1(0);
+}
+RTM_EXPORT(epoll_create);
+
+/**
+ * This function will add, modify or remove a file descriptor in the interest
+ * list of an epoll instance.
+ *
+ * @param epfd the file descriptor of the epoll instance.
+ * @param op EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL.
+ * @param fd the target file descriptor.
+ * @param event the events to wait for, with EPOLLET or EPOLLONESHOT, and the
+ *        data reported with them. It is ignored by EPOLL_CTL_DEL.
+ *
+ * @return 0 on successful, -1 on failed.
+ */
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+    struct rt_eventpoll *ep;
+    struct rt_epoll_item *item;
+    struct dfs_fd *d;
+    int result;
+
+    ep = epoll_get(epfd, &d);
+    if (ep == RT_NULL)
+    {
+        rt_set_errno(-EBADF);
+        return -1;
+    }
+
+    if (fd == epfd || (op != EPOLL_CTL_DEL && event == RT_NULL))
+    {
+        fd_put(d);
+        rt_set_errno(-EINVAL);
+        return -1;
+    }
+
+    rt_mutex_take(&ep->lock, RT_WAITING_FOREVER);
+
+    item = epoll_item_find(ep, fd);
+    switch (op)
+    {
+    case EPOLL_CTL_ADD:
+        result = item ? -EEXIST : epoll_item_add(ep, fd, event);
+        break;
+
+    case EPOLL_CTL_MOD:
+        result = item ? epoll_item_modify(item, event) : -ENOENT;
+        break;
+
+    case EPOLL_CTL_DEL:
+        result = -ENOENT;
+        if (item)
+        {
+            epoll_item_free(item);
+            result = 0;
+        }
+        break;
+
+    default:
+        result = -EINVAL;
+        break;
+    }
+
+    rt_mutex_release(&ep->lock);
+    fd_put(d);
+
+    if (result < 0)
+    {
+        rt_set_errno(result);
+        return -1;
+    }
+
+    return 0;
+}
+RTM_EXPORT(epoll_ctl);
+
+/**
+ * This function will wait for events on an epoll instance.
+ *
+ * @param epfd the file descriptor of the epoll instance.
+ * @param events the buffer of the ready events.
+ * @param maxevents the size of the buffer.
+ * @param timeout the timeout in milliseconds, -1 to wait forever.
+ *
+ * @return the number of ready events, 0 on timeout, -1 on failed.
+ */
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout)
+{
+    struct rt_eventpoll *ep;
+    struct dfs_fd *d;
+    rt_int32_t ticks;
+    rt_tick_t start;
+    rt_err_t err;
+    int count;
+
+    if (events == RT_NULL || maxevents <= 0)
+    {
+        rt_set_errno(-EINVAL);
+        return -1;
+    }
+
+    ep = epoll_get(epfd, &d);
+    if (ep == RT_NULL)
+    {
+        rt_set_errno(-EBADF);
+        return -1;
+    }
+
+    ticks = timeout < 0 ? RT_WAITING_FOREVER : rt_tick_from_millisecond(timeout);
+    start = rt_tick_get();
+
+    while (1)
+    {
+        rt_mutex_take(&ep->lock, RT_WAITING_FOREVER);
+        count = epoll_do(ep, events, maxevents);
+        rt_mutex_release(&ep->lock);
+
+        if (count || ticks == 0)
+            break;
+
+        if (ticks != RT_WAITING_FOREVER)
+        {
+            ticks -= rt_tick_get() - start;
+            start = rt_tick_get();
+            if (ticks <= 0)
+                break;
+        }
+
+        err = rt_sem_take(&ep->notice, ticks);
+        if (err == -RT_ETIMEOUT)
+        {
+            ticks = 0;
+        }
+        else if (err != RT_EOK)
+        {
+            fd_put(d);
+            rt_set_errno(-EINTR);
+            return -1;
+        }
+    }
+
+    fd_put(d);
+
+    return count;
+}
+RTM_EXPORT(epoll_wait);
+
+static int epoll_system_init(void)
+{
+    rt_mutex_init(&_epoll_lock, "epoll", RT_IPC_FLAG_PRIO);
+    dfs_file_close_sethook(epoll_file_close);
+
+    return 0;
+}
+INIT_COMPONENT_EXPORT(epoll_system_init);
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#ifndef __SYS_EPOLL_H__
+#define __SYS_EPOLL_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <poll.h>
+
+#define EPOLL_CTL_ADD   1
+#define EPOLL_CTL_DEL   2
+#define EPOLL_CTL_MOD   3
+
+#define EPOLL_CLOEXEC   02000000
+
+#define EPOLLIN         POLLIN
+#define EPOLLPRI        POLLPRI
+#define EPOLLOUT        POLLOUT
+#define EPOLLRDNORM     POLLRDNORM
+#define EPOLLRDBAND     POLLRDBAND
+#define EPOLLWRNORM     POLLWRNORM
+#define EPOLLWRBAND     POLLWRBAND
+#define EPOLLERR        POLLERR
+#define EPOLLHUP        POLLHUP
+
+#define EPOLLONESHOT    (1U << 30)
+#define EPOLLET         (1U << 31)
+
+typedef union epoll_data
+{
+    void *ptr;
+    int fd;
+    uint32_t u32;
+    uint64_t u64;
+} epoll_data_t;
+
+struct epoll_event
+{
+    uint32_t events;
+    epoll_data_t data;
+};
+
+/*
+ * The interest set keeps a reference to the registered file descriptors and
+ * stays hooked on their wait queues, so a file descriptor must be removed by
+ * EPOLL_CTL_DEL before it is closed.
+ */
+int epoll_create(int size);
+int epoll_create1(int flags);
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYS_EPOLL_H__ */
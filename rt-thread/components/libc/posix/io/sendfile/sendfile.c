@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <fcntl.h>
+#include <dfs_file.h>
+#include <sys/errno.h>
+#include "sys/sendfile.h"
+
+/*
+ * When one end is a pipe, the data is moved in place between the ring buffer
+ * of the pipe and the other file, which is read into or written from the
+ * ring buffer directly. Between two other files, sendfile() copies through a
+ * kernel buffer of SENDFILE_CHUNK_SIZE bytes, which saves the calls and the
+ * user buffer of a read()/write() loop.
+ */
+
+#ifndef SENDFILE_CHUNK_SIZE
+#define SENDFILE_CHUNK_SIZE     1024
+#endif
+
+/* a socket returns -1 and leaves the error in errno, the other files return it */
+static int splice_result(struct dfs_fd *fd, int result)
+{
+    rt_err_t error;
+
+    if (result != -1 || fd->type != FT_SOCKET)
+        return result;
+
+    /* the socket implementations set errno with either sign */
+    error = rt_get_errno();
+    if (error > 0)
+        return -error;
+
+    return error < 0 ? error : -EIO;
+}
+
+static int splice_read(struct dfs_fd *fd, void *buf, rt_size_t len)
+{
+    return splice_result(fd, dfs_file_read(fd, buf, len));
+}
+
+static int splice_write(struct dfs_fd *fd, const void *buf, rt_size_t len)
+{
+    return splice_result(fd, dfs_file_write(fd, buf, len));
+}
+
+#if defined(RT_USING_POSIX_DEVIO) && defined(RT_USING_POSIX_PIPE)
+static int splice_sink(void *arg, void *buf, rt_size_t len)
+{
+    return splice_write((struct dfs_fd *)arg, buf, len);
+}
+
+static int splice_source(void *arg, void *buf, rt_size_t len)
+{
+    return splice_read((struct dfs_fd *)arg, buf, len);
+}
+#endif
+
+static int splice_copy(struct dfs_fd *in, struct dfs_fd *out, size_t count)
+{
+    rt_uint8_t *buf;
+    size_t chunk;
+    int moved = 0;
+    int len, written, n;
+
+    chunk = count < SENDFILE_CHUNK_SIZE ? count : SENDFILE_CHUNK_SIZE;
+    if (chunk == 0)
+        return 0;
+
+    buf = (rt_uint8_t *)rt_malloc(chunk);
+    if (buf == RT_NULL)
+        return -ENOMEM;
+
+    while ((size_t)moved < count)
+    {
+        len = splice_read(in, buf, (count - moved) < chunk ? (count - moved) : chunk);
+        if (len <= 0)
+        {
+            if (moved == 0)
+                moved = len;
+            break;
+        }
+
+        for (written = 0; written < len; written += n)
+        {
+            n = splice_write(out, buf + written, len - written);
+            if (n <= 0)
+                break;
+        }
+        moved += written;
+
+        if (written < len)
+        {
+            /* give the data not sent back to the input, when it can seek */
+            dfs_file_lseek(in, in->pos - (len - written));
+            if (moved == 0)
+                moved = n < 0 ? n : -EIO;
+            break;
+        }
+    }
+
+    rt_free(buf);
+
+    return moved;
+}
+
+static int do_splice(struct dfs_fd *in, off_t *off_in, struct dfs_fd *out, off_t *off_out,
+                     size_t count, int nonblock, int pipe_only)
+{
+    off_t in_pos = 0, out_pos = 0;
+    int result;
+
+    if ((in->flags & O_ACCMODE) == O_WRONLY || (out->flags & O_ACCMODE) == O_RDONLY)
+        return -EBADF;
+
+    /* an explicit offset leaves the file position alone */
+    if (off_in)
+    {
+        in_pos = in->pos;
+        if (*off_in < 0 || dfs_file_lseek(in, *off_in) < 0)
+            return -ESPIPE;
+    }
+    if (off_out)
+    {
+        out_pos = out->pos;
+        if (*off_out < 0 || dfs_file_lseek(out, *off_out) < 0)
+        {
+            if (off_in)
+                dfs_file_lseek(in, in_pos);
+            return -ESPIPE;
+        }
+    }
+
+#if defined(RT_USING_POSIX_DEVIO) && defined(RT_USING_POSIX_PIPE)
+    if (rt_pipe_from_fd(in))
+    {
+        if (rt_pipe_from_fd(in) == rt_pipe_from_fd(out))
+            result = -EINVAL;
+        else
+            result = rt_pipe_splice_read(in, count, splice_sink, out, nonblock);
+    }
+    else if (rt_pipe_from_fd(out))
+    {
+        result = rt_pipe_splice_write(out, count, splice_source, in, nonblock);
+    }
+    else
+#endif
+    {
+        result = pipe_only ? -EINVAL : splice_copy(in, out, count);
+    }
+
+    if (off_in)
+    {
+        *off_in = in->pos;
+        dfs_file_lseek(in, in_pos);
+    }
+    if (off_out)
+    {
+        *off_out = out->pos;
+        dfs_file_lseek(out, out_pos);
+    }
+
+    return result;
+}
+
+/**
+ * this function will copy data from a file descriptor to another one without
+ * going through a user buffer.
+ *
+ * @param out_fd the file descriptor to write to.
+ * @param in_fd the file descriptor to read from.
+ * @param offset the offset to read from, which is updated, and the file
+ *        position of in_fd is left alone. RT_NULL to read from the file position.
+ * @param count the maximum length to copy.
+ *
+ * @return the length copied, -1 on failed.
+ */
+ssize_t sendfile(int out_fd, int in_fd, off_t *offset, size_t count)
+{
+    struct dfs_fd *in, *out;
+    int result;
+
+    in = fd_get(in_fd);
+    if (in == NULL)
+    {
+        rt_set_errno(-EBADF);
+        return -1;
+    }
+
+    out = fd_get(out_fd);
+    if (out == NULL)
+    {
+        fd_put(in);
+        rt_set_errno(-EBADF);
+        return -1;
+    }
+
+    result = do_splice(in, offset, out, RT_NULL, count, 0, 0);
+
+    fd_put(out);
+    fd_put(in);
+
+    if (result < 0)
+    {
+        rt_set_errno(result);
+        return -1;
+    }
+
+    return result;
+}
+RTM_EXPORT(sendfile);
+
+/**
+ * this function will move data between a pipe and another file descriptor
+ * without going through a user buffer.
+ *
+ * @param fd_in the file descriptor to read from.
+ * @param off_in the offset to read from, which must be RT_NULL for a pipe.
+ * @param fd_out the file descriptor to write to.
+ * @param off_out the offset to write to, which must be RT_NULL for a pipe.
+ * @param len the maximum length to move.
+ * @param flags SPLICE_F_NONBLOCK not to wait on the pipe, the other flags are ignored.
+ *
+ * @return the length moved, 0 at end-of-file, -1 on failed.
+ */
+ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out, size_t len, unsigned int flags)
+{
+    struct dfs_fd *in, *out;
+    int result;
+
+    in = fd_get(fd_in);
+    if (in == NULL)
+    {
+        rt_set_errno(-EBADF);
+        return -1;
+    }
+
+    out = fd_get(fd_out);
+    if (out == NULL)
+    {
+        fd_put(in);
+        rt_set_errno(-EBADF);
+        return -1;
+    }
+
+    result = do_splice(in, off_in, out, off_out, len, flags & SPLICE_F_NONBLOCK, 1);
+
+    fd_put(out);
+    fd_put(in);
+
+    if (result < 0)
+    {
+        rt_set_errno(result);
+        return -1;
+    }
+
+    return result;
+}
+RTM_EXPORT(splice);
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#ifndef __SYS_SENDFILE_H__
+#define __SYS_SENDFILE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <sys/types.h>
+
+#ifndef SPLICE_F_MOVE
+#define SPLICE_F_MOVE       0x01
+#define SPLICE_F_NONBLOCK   0x02
+#define SPLICE_F_MORE       0x04
+#define SPLICE_F_GIFT       0x08
+#endif
+
+ssize_t sendfile(int out_fd, int in_fd, off_t *offset, size_t count);
+ssize_t splice(int fd_in, off_t *off_in, int fd_out, off_t *off_out, size_t len, unsigned int flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYS_SENDFILE_H__ */
@@ -113,125 +113,192 @@ struct at_socket *at_get_base_socket(int base_socket)
 }
 #endif
 
-/* get a block to the AT socket receive list*/
-static rt_err_t at_recvpkt_put(rt_slist_t *rlist, const char *ptr, size_t length)
+/*
+ * The data received when the ring buffer is full is queued behind it in
+ * allocated pieces, up to AT_SOCKET_RECV_OVERFLOW_MAX bytes, the data beyond
+ * it is dropped and counted. The AT client parser only writes the ring buffer
+ * while the queue is empty, and readers take the ring buffer before the
+ * queue, which keeps the receiving order. A device driver which requests no
+ * more data than at_socket_recv_space() never fills the queue.
+ */
+struct at_recv_overflow
+{
+    rt_slist_t list;
+    size_t len;
+    size_t pos;
+};
+
+#define AT_RECV_OVERFLOW_DATA(ovf)      ((char *)((ovf) + 1))
+
+static struct at_recv_overflow *at_recvbuff_overflow_alloc(size_t length)
 {
-    at_recv_pkt_t pkt = RT_NULL;
+    struct at_recv_overflow *ovf;
 
-    pkt = (at_recv_pkt_t) rt_calloc(1, sizeof(struct at_recv_pkt));
-    if (pkt == RT_NULL)
+    ovf = (struct at_recv_overflow *) rt_malloc(sizeof(struct at_recv_overflow) + length);
+    if (ovf)
     {
-        LOG_E("No memory for receive packet table!");
-        return -RT_ENOMEM;
+        rt_slist_init(&ovf->list);
+        ovf->len = length;
+        ovf->pos = 0;
     }
 
-    pkt->bfsz_totle = length;
-    pkt->bfsz_index = 0;
-    pkt->buff = (char *) ptr;
+    return ovf;
+}
 
-    rt_slist_append(rlist, &pkt->list);
+/* the size of the data which can still be queued behind the ring buffer */
+static size_t at_recvbuff_overflow_room(struct at_socket *sock)
+{
+    size_t queued = sock->recv_overflow_len;
 
-    return RT_EOK;
+    return queued < AT_SOCKET_RECV_OVERFLOW_MAX ? AT_SOCKET_RECV_OVERFLOW_MAX - queued : 0;
 }
 
-/* delete and free all receive buffer list */
-static int at_recvpkt_all_delete(rt_slist_t *rlist)
+/* queue a piece of data behind the ring buffer, only called by the AT client parser */
+static void at_recvbuff_overflow_queue(struct at_socket *sock, struct at_recv_overflow *ovf)
 {
-    at_recv_pkt_t pkt = RT_NULL;
-    rt_slist_t *node = RT_NULL;
+    rt_base_t level;
 
-    if (rt_slist_isempty(rlist))
+    level = rt_hw_interrupt_disable();
+    rt_slist_append(&sock->recv_overflow, &ovf->list);
+    sock->recv_overflow_len += ovf->len;
+    rt_hw_interrupt_enable(level);
+}
+
+/* put data to the AT socket receive buffer, only called by the AT client parser */
+static size_t at_recvbuff_put(struct at_socket *sock, const char *ptr, size_t length)
+{
+    struct at_recv_overflow *ovf;
+    rt_uint8_t *space = RT_NULL;
+    size_t pos = 0, size;
+
+    /* once data is queued, the later data must be queued behind it */
+    while (pos < length && rt_slist_isempty(&sock->recv_overflow)
+            && (size = rt_ringbuffer_reserve(sock->recv_buff, &space, length - pos)) > 0)
     {
-        return 0;
+        rt_memcpy(space, ptr + pos, size);
+        rt_ringbuffer_commit(sock->recv_buff, size);
+        pos += size;
+    }
+
+    size = at_recvbuff_overflow_room(sock);
+    if (size > length - pos)
+    {
+        size = length - pos;
+    }
+    if (size > 0 && (ovf = at_recvbuff_overflow_alloc(size)) != RT_NULL)
+    {
+        rt_memcpy(AT_RECV_OVERFLOW_DATA(ovf), ptr + pos, size);
+        at_recvbuff_overflow_queue(sock, ovf);
+        pos += size;
     }
 
-    for(node = rt_slist_first(rlist); node;)
+    return pos;
+}
+
+/* get data from the AT socket receive buffer, called with the recv_lock held */
+static size_t at_recvbuff_get(struct at_socket *sock, char *mem, size_t len)
+{
+    struct at_recv_overflow *ovf;
+    rt_uint8_t *data = RT_NULL;
+    size_t pos = 0, size;
+    rt_base_t level;
+
+    while (pos < len)
     {
-        pkt = rt_slist_entry(node, struct at_recv_pkt, list);
-        node = rt_slist_next(node);
-        if (pkt->buff)
+        size = rt_ringbuffer_peek_contiguous(sock->recv_buff, &data);
+        if (size > 0)
         {
-            rt_free(pkt->buff);
+            if (size > len - pos)
+            {
+                size = len - pos;
+            }
+            rt_memcpy(mem + pos, data, size);
+            rt_ringbuffer_consume(sock->recv_buff, size);
+            pos += size;
+            continue;
+        }
+
+        if (rt_slist_isempty(&sock->recv_overflow))
+        {
+            break;
         }
-        if (pkt)
+        /* the ring buffer may be filled up just before the first piece is queued */
+        if (rt_ringbuffer_data_len(sock->recv_buff) > 0)
         {
-            rt_free(pkt);
-            pkt = RT_NULL;
+            continue;
+        }
+
+        ovf = rt_slist_first_entry(&sock->recv_overflow, struct at_recv_overflow, list);
+        size = ovf->len - ovf->pos;
+        if (size > len - pos)
+        {
+            size = len - pos;
+        }
+        rt_memcpy(mem + pos, AT_RECV_OVERFLOW_DATA(ovf) + ovf->pos, size);
+        ovf->pos += size;
+        pos += size;
+
+        level = rt_hw_interrupt_disable();
+        sock->recv_overflow_len -= size;
+        if (ovf->pos == ovf->len)
+        {
+            rt_slist_remove(&sock->recv_overflow, &ovf->list);
+        }
+        rt_hw_interrupt_enable(level);
+
+        if (ovf->pos == ovf->len)
+        {
+            rt_free(ovf);
         }
     }
 
-    return 0;
+    return pos;
 }
 
-/* delete and free specified list block */
-static int at_recvpkt_node_delete(rt_slist_t *rlist, rt_slist_t *node)
+/* the size of the data waiting to be read */
+static size_t at_recvbuff_len(struct at_socket *sock)
 {
-    at_recv_pkt_t pkt = RT_NULL;
-
-    if (rt_slist_isempty(rlist))
-    {
-        return 0;
-    }
+    return rt_ringbuffer_data_len(sock->recv_buff) + sock->recv_overflow_len;
+}
 
-    rt_slist_remove(rlist, node);
+static void at_recvbuff_free(struct at_socket *sock)
+{
+    struct at_recv_overflow *ovf;
 
-    pkt = rt_slist_entry(node, struct at_recv_pkt, list);
-    if (pkt->buff)
+    while (!rt_slist_isempty(&sock->recv_overflow))
     {
-        rt_free(pkt->buff);
-    }
-    if (pkt)
-    {
-        rt_free(pkt);
-        pkt = RT_NULL;
+        ovf = rt_slist_first_entry(&sock->recv_overflow, struct at_recv_overflow, list);
+        rt_slist_remove(&sock->recv_overflow, &ovf->list);
+        rt_free(ovf);
     }
+    sock->recv_overflow_len = 0;
 
-    return 0;
+    rt_ringbuffer_destroy(sock->recv_buff);
+    sock->recv_buff = RT_NULL;
 }
 
-/* get a block from AT socket receive buffer list */
-static size_t at_recvpkt_get(rt_slist_t *rlist, char *mem, size_t len)
+/* tell the device the receive buffer has space again when it was full */
+static void at_recvbuff_resume(struct at_socket *sock)
 {
-    rt_slist_t *node = RT_NULL;
-    rt_slist_t *free_node = RT_NULL;
-    at_recv_pkt_t pkt = RT_NULL;
-    size_t content_pos = 0, page_pos = 0;
+    size_t space;
 
-    if (rt_slist_isempty(rlist))
+    if (sock->recv_full == RT_FALSE || !rt_slist_isempty(&sock->recv_overflow))
     {
-        return 0;
+        return;
     }
 
-    for (node = rt_slist_first(rlist); node;)
+    /* wait for half of the buffer to avoid resuming for a few bytes */
+    space = rt_ringbuffer_space_len(sock->recv_buff);
+    if (space < rt_ringbuffer_get_size(sock->recv_buff) / 2)
     {
-        pkt = rt_slist_entry(node, struct at_recv_pkt, list);
-
-        free_node = node;
-        node = rt_slist_next(node);
-
-        page_pos = pkt->bfsz_totle - pkt->bfsz_index;
-
-        if (page_pos >= len - content_pos)
-        {
-            rt_memcpy((char *) mem + content_pos, pkt->buff + pkt->bfsz_index, len - content_pos);
-            pkt->bfsz_index += len - content_pos;
-            if (pkt->bfsz_index == pkt->bfsz_totle)
-            {
-                at_recvpkt_node_delete(rlist, free_node);
-            }
-            content_pos = len;
-            break;
-        }
-        else
-        {
-            rt_memcpy((char *) mem + content_pos, pkt->buff + pkt->bfsz_index, page_pos);
-            content_pos += page_pos;
-            pkt->bfsz_index += page_pos;
-            at_recvpkt_node_delete(rlist, free_node);
-        }
+        return;
     }
 
-    return content_pos;
+    sock->recv_full = RT_FALSE;
+    if (sock->ops->at_recv_resume)
+    {
+        sock->ops->at_recv_resume(sock, space);
+    }
 }
 
 static void at_do_event_changes(struct at_socket *sock, at_event_t event, rt_bool_t is_plus)
@@ -392,7 +459,10 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
     sock->rcvevent = RT_NULL;
     sock->sendevent = RT_NULL;
     sock->errevent = RT_NULL;
-    rt_slist_init(&sock->recvpkt_list);
+    sock->recv_full = RT_FALSE;
+    rt_slist_init(&sock->recv_overflow);
+    sock->recv_overflow_len = 0;
+    sock->recv_drop = 0;
 #ifdef SAL_USING_POSIX
     rt_wqueue_init(&sock->wait_head);
 #endif
@@ -414,6 +484,15 @@ static struct at_socket *alloc_socket_by_device(struct at_device *device, enum a
         goto __err;
     }
 
+    /* create AT socket receive ring buffer */
+    if ((sock->recv_buff = rt_ringbuffer_create(AT_SOCKET_RECV_BFSZ)) == RT_NULL)
+    {
+        LOG_E("No memory for socket receive buffer create.");
+        rt_sem_delete(sock->recv_notice);
+        rt_mutex_delete(sock->recv_lock);
+        goto __err;
+    }
+
     rt_mutex_release(at_slock);
     return sock;
 
@@ -511,9 +590,9 @@ static int free_socket(struct at_socket *sock)
         rt_mutex_delete(sock->recv_lock);
     }
 
-    if (!rt_slist_isempty(&sock->recvpkt_list))
+    if (sock->recv_buff)
     {
-        at_recvpkt_all_delete(&sock->recvpkt_list);
+        at_recvbuff_free(sock);
     }
 
     /* delect socket from socket list */
@@ -729,7 +808,8 @@ static void at_connect_notice_cb(struct at_socket *sock, at_socket_evt_t event,
     rt_base_t level;
     rt_slist_t *node = RT_NULL;
     struct at_socket *at_sock = RT_NULL;
-    char *socket_info = RT_NULL;
+    char socket_info[AT_SOCKET_INFO_LEN];
+    struct at_recv_overflow *ovf = RT_NULL;
     int base_socket = 0;
 
     if (netdev_default && netdev_is_up(netdev_default) &&
@@ -774,7 +854,6 @@ static void at_connect_notice_cb(struct at_socket *sock, at_socket_evt_t event,
     sscanf(buff, "SOCKET:%d", &base_socket);
     LOG_D("ACCEPT BASE SOCKET: %d", base_socket);
     new_sock->user_data = (void *)base_socket;
-    socket_info = rt_malloc(AT_SOCKET_INFO_LEN);
     rt_memset(socket_info, 0, AT_SOCKET_INFO_LEN);
     rt_sprintf(socket_info, "SOCKET:%d", new_sock->socket);
 
@@ -796,46 +875,206 @@ static void at_connect_notice_cb(struct at_socket *sock, at_socket_evt_t event,
         return;
     }
 
-    /* wakeup the "accept" function */
-    rt_mutex_take(at_sock->recv_lock, RT_WAITING_FOREVER);
-    if (at_recvpkt_put(&(at_sock->recvpkt_list), socket_info, AT_SOCKET_INFO_LEN) != RT_EOK)
+    /* the record is put as a whole, accept() can not read a torn one */
+    if (rt_slist_isempty(&at_sock->recv_overflow)
+            && rt_ringbuffer_space_len(at_sock->recv_buff) >= AT_SOCKET_INFO_LEN)
+    {
+        at_recvbuff_put(at_sock, socket_info, AT_SOCKET_INFO_LEN);
+    }
+    else if ((ovf = at_recvbuff_overflow_alloc(AT_SOCKET_INFO_LEN)) != RT_NULL)
     {
-        rt_free((void *)buff);
-        rt_mutex_release(at_sock->recv_lock);
+        rt_memcpy(AT_RECV_OVERFLOW_DATA(ovf), socket_info, AT_SOCKET_INFO_LEN);
+        at_recvbuff_overflow_queue(at_sock, ovf);
+    }
+    else
+    {
+        LOG_E("No memory for listen socket receive record!");
         return;
     }
-    rt_mutex_release(at_sock->recv_lock);
+
+    /* wakeup the "accept" function */
     rt_sem_release(at_sock->recv_notice);
 
     at_do_event_changes(at_sock, AT_EVENT_RECV, RT_TRUE);
 }
 #endif
 
-static void at_recv_notice_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
+/**
+ * get the free space of the AT socket receive buffer, the device driver
+ * can use it for the flow control of the socket data.
+ *
+ * @param sock AT socket object
+ *
+ * @return the free space size
+ */
+size_t at_socket_recv_space(struct at_socket *sock)
 {
+    RT_ASSERT(sock);
+
+    /* no space while data is queued behind the receive buffer */
+    if (sock->magic != AT_SOCKET_MAGIC || sock->recv_buff == RT_NULL
+            || !rt_slist_isempty(&sock->recv_overflow))
+    {
+        return 0;
+    }
+
+    return rt_ringbuffer_space_len(sock->recv_buff);
+}
+
+/**
+ * put the data received by the device to the AT socket, it must be called
+ * on the AT client parser thread. The data out of the receive buffer space
+ * is queued until it is read, up to AT_SOCKET_RECV_OVERFLOW_MAX bytes, the
+ * rest is dropped.
+ *
+ * @param sock AT socket object
+ * @param buff received data
+ * @param bfsz received data size
+ *
+ * @return the size put to the socket, less than bfsz when data is dropped
+ */
+size_t at_socket_recv_data(struct at_socket *sock, const char *buff, size_t bfsz)
+{
+    size_t size;
+
+    RT_ASSERT(sock);
     RT_ASSERT(buff);
-    RT_ASSERT(event == AT_SOCKET_EVT_RECV);
 
     /* check the socket object status */
     if (sock->magic != AT_SOCKET_MAGIC || sock->state == AT_SOCKET_CLOSED)
     {
-        rt_free((void *)buff);
-        return;
+        return 0;
     }
 
-    /* put receive buffer to receiver packet list */
-    rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
-    if (at_recvpkt_put(&(sock->recvpkt_list), buff, bfsz) != RT_EOK)
+    size = at_recvbuff_put(sock, buff, bfsz);
+    if (size < bfsz)
     {
-        rt_free((void *)buff);
-        rt_mutex_release(sock->recv_lock);
-        return;
+        sock->recv_drop += bfsz - size;
+        LOG_W("socket(%d) receive buffer is full, drop %d bytes.", sock->socket, bfsz - size);
+    }
+    if (!rt_slist_isempty(&sock->recv_overflow) || rt_ringbuffer_space_len(sock->recv_buff) == 0)
+    {
+        sock->recv_full = RT_TRUE;
     }
-    rt_mutex_release(sock->recv_lock);
 
-    rt_sem_release(sock->recv_notice);
+    if (size > 0)
+    {
+        rt_sem_release(sock->recv_notice);
+        at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
+    }
 
-    at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
+    return size;
+}
+
+/**
+ * receive the socket data from the AT client into the receive buffer, it must
+ * be called by the URC function of the socket data. The data is read into the
+ * free space of the receive buffer directly, only the data out of the space
+ * is queued in allocated memory until it is read, up to
+ * AT_SOCKET_RECV_OVERFLOW_MAX bytes, the rest is read out and dropped.
+ *
+ * @param sock AT socket object, the data is read out and dropped when it is RT_NULL
+ * @param client current AT client object
+ * @param bfsz the size of the socket data to receive
+ * @param timeout receive data timeout (ms)
+ *
+ * @return the size received from the AT client
+ */
+size_t at_socket_recv_client(struct at_socket *sock, struct at_client *client, size_t bfsz, rt_int32_t timeout)
+{
+    struct at_recv_overflow *ovf;
+    rt_uint8_t *space = RT_NULL;
+    size_t recv_len = 0, store_len = 0, size;
+    rt_bool_t alive;
+    char temp[16];
+
+    RT_ASSERT(client);
+
+    alive = (sock && sock->magic == AT_SOCKET_MAGIC && sock->state != AT_SOCKET_CLOSED);
+
+    /* receive into the free space of the ring buffer directly, unless data is queued before */
+    while (alive && recv_len < bfsz && rt_slist_isempty(&sock->recv_overflow)
+            && (size = rt_ringbuffer_reserve(sock->recv_buff, &space, bfsz - recv_len)) > 0)
+    {
+        size = at_client_obj_recv(client, (char *) space, size, timeout);
+        if (size == 0)
+        {
+            break;
+        }
+        rt_ringbuffer_commit(sock->recv_buff, size);
+        recv_len += size;
+        store_len += size;
+    }
+
+    /* queue the data out of the ring buffer space, as much as allowed */
+    size = alive ? at_recvbuff_overflow_room(sock) : 0;
+    if (size > bfsz - recv_len)
+    {
+        size = bfsz - recv_len;
+    }
+    if (size > 0)
+    {
+        ovf = at_recvbuff_overflow_alloc(size);
+        if (ovf)
+        {
+            ovf->len = at_client_obj_recv(client, AT_RECV_OVERFLOW_DATA(ovf), size, timeout);
+            recv_len += ovf->len;
+            store_len += ovf->len;
+            if (ovf->len > 0)
+            {
+                at_recvbuff_overflow_queue(sock, ovf);
+            }
+            else
+            {
+                rt_free(ovf);
+            }
+        }
+    }
+
+    /* the rest must be read out from the AT client anyway */
+    while (recv_len < bfsz)
+    {
+        size = bfsz - recv_len > sizeof(temp) ? sizeof(temp) : bfsz - recv_len;
+        size = at_client_obj_recv(client, temp, size, timeout);
+        if (size == 0)
+        {
+            break;
+        }
+        recv_len += size;
+    }
+
+    if (!alive)
+    {
+        return recv_len;
+    }
+
+    if (store_len < recv_len)
+    {
+        sock->recv_drop += recv_len - store_len;
+        LOG_W("socket(%d) receive buffer is full, drop %d bytes.", sock->socket, recv_len - store_len);
+    }
+    if (!rt_slist_isempty(&sock->recv_overflow) || rt_ringbuffer_space_len(sock->recv_buff) == 0)
+    {
+        sock->recv_full = RT_TRUE;
+    }
+
+    if (store_len > 0)
+    {
+        rt_sem_release(sock->recv_notice);
+        at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
+    }
+
+    return recv_len;
+}
+
+static void at_recv_notice_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
+{
+    RT_ASSERT(buff);
+    RT_ASSERT(event == AT_SOCKET_EVT_RECV);
+
+    /* the buffer is allocated by the device, copy it to the receive buffer */
+    at_socket_recv_data(sock, buff, bfsz);
+    rt_free((void *)buff);
 }
 
 static void at_closed_notice_cb(struct at_socket *sock, at_socket_evt_t event, const char *buff, size_t bfsz)
@@ -986,7 +1225,7 @@ int at_accept(int socket, struct sockaddr *name, socklen_t *namelen)
     {
         /* get receive buffer to receiver ring buffer */
         rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
-        at_recvpkt_get(&(sock->recvpkt_list), (char *) &receive_buff, AT_SOCKET_INFO_LEN);
+        at_recvbuff_get(sock, (char *) &receive_buff, AT_SOCKET_INFO_LEN);
         rt_mutex_release(sock->recv_lock);
     }
 
@@ -1052,9 +1291,9 @@ int at_recvfrom(int socket, void *mem, size_t len, int flags, struct sockaddr *f
         sock->state = AT_SOCKET_CONNECT;
     }
 
-    /* receive packet list last transmission of remaining data */
+    /* receive buffer last transmission of remaining data */
     rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
-    if((recv_len = at_recvpkt_get(&(sock->recvpkt_list), (char *)mem, len)) > 0)
+    if((recv_len = at_recvbuff_get(sock, (char *)mem, len)) > 0)
     {
         rt_mutex_release(sock->recv_lock);
         goto __exit;
@@ -1105,12 +1344,17 @@ int at_recvfrom(int socket, void *mem, size_t len, int flags, struct sockaddr *f
 
             /* get receive buffer to receiver ring buffer */
             rt_mutex_take(sock->recv_lock, RT_WAITING_FOREVER);
-            recv_len = at_recvpkt_get(&(sock->recvpkt_list), (char *) mem, len);
+            recv_len = at_recvbuff_get(sock, (char *) mem, len);
             rt_mutex_release(sock->recv_lock);
             if (recv_len > 0)
             {
                 break;
             }
+            else if (sock->state != AT_SOCKET_CLOSED)
+            {
+                /* the data of this notice has been taken by a previous receive */
+                continue;
+            }
             else
             {
                 /* we have no data to receive but are woken up,
@@ -1131,7 +1375,7 @@ __exit:
             result = recv_len;
             at_do_event_changes(sock, AT_EVENT_RECV, RT_FALSE);
             errno = 0;
-            if (!rt_slist_isempty(&sock->recvpkt_list))
+            if (at_recvbuff_len(sock) > 0)
             {
                 at_do_event_changes(sock, AT_EVENT_RECV, RT_TRUE);
             }
@@ -1139,6 +1383,7 @@ __exit:
             {
                 at_do_event_clean(sock, AT_EVENT_RECV);
             }
+            at_recvbuff_resume(sock);
         }
         else
         {
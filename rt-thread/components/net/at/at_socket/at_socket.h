@@ -23,10 +23,16 @@
 extern "C" {
 #endif
 
+/* the size of the socket receive buffer, allocated for each socket */
 #ifndef AT_SOCKET_RECV_BFSZ
 #define AT_SOCKET_RECV_BFSZ            512
 #endif
 
+/* the maximum size of the data queued beyond the receive buffer of a socket */
+#ifndef AT_SOCKET_RECV_OVERFLOW_MAX
+#define AT_SOCKET_RECV_OVERFLOW_MAX    1024
+#endif
+
 #define AT_DEFAULT_RECVMBOX_SIZE       10
 #define AT_DEFAULT_ACCEPTMBOX_SIZE     10
 
@@ -65,6 +71,7 @@ typedef enum
 
 struct at_socket;
 struct at_device;
+struct at_client;
 
 typedef void (*at_evt_cb_t)(struct at_socket *socket, at_socket_evt_t event, const char *buff, size_t bfsz);
 
@@ -83,18 +90,10 @@ struct at_socket_ops
 #ifdef AT_USING_SOCKET_SERVER
     int (*at_listen)(struct at_socket *socket, int backlog);
 #endif
+    /* optional, the receive buffer has space again after it was full */
+    void (*at_recv_resume)(struct at_socket *socket, size_t space);
 };
 
-/* AT receive package list structure */
-struct at_recv_pkt
-{
-    rt_slist_t list;
-    size_t bfsz_totle;
-    size_t bfsz_index;
-    char *buff;
-};
-typedef struct at_recv_pkt *at_recv_pkt_t;
-
 #ifdef AT_USING_SOCKET_SERVER
 struct at_listen_state
 {
@@ -124,7 +123,15 @@ struct at_socket
     /* receive semaphore, received data release semaphore */
     rt_sem_t recv_notice;
     rt_mutex_t recv_lock;
-    rt_slist_t recvpkt_list;
+    /* receive buffer, written by the AT client parser and read under recv_lock */
+    struct rt_ringbuffer *recv_buff;
+    /* the data received when the receive buffer is full, read after it */
+    rt_slist_t recv_overflow;
+    size_t recv_overflow_len;
+    /* the size of the received data dropped beyond the overflow limit */
+    size_t recv_drop;
+    /* the receive buffer was full, the device waits for space */
+    rt_bool_t recv_full;
 
     /* timeout to wait for send or received data in milliseconds */
     int32_t recv_timeout;
@@ -170,6 +177,11 @@ int at_getaddrinfo(const char *nodename, const char *servname, const struct addr
 void at_freeaddrinfo(struct addrinfo *ai);
 
 struct at_socket *at_get_socket(int socket);
+
+/* for the AT device drivers, receive socket data */
+size_t at_socket_recv_space(struct at_socket *sock);
+size_t at_socket_recv_data(struct at_socket *sock, const char *buff, size_t bfsz);
+size_t at_socket_recv_client(struct at_socket *sock, struct at_client *client, size_t bfsz, rt_int32_t timeout);
 #ifdef AT_USING_SOCKET_SERVER
 struct at_socket *at_get_base_socket(int base_socket);
 #endif
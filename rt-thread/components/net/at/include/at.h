@@ -50,6 +50,16 @@ extern "C" {
 #define AT_CLIENT_NUM_MAX              1
 #endif
 
+/* the size of the data read ahead by the AT client line parser */
+#ifndef AT_CLIENT_RECV_AHEAD_LEN
+#define AT_CLIENT_RECV_AHEAD_LEN       64
+#endif
+
+/* the maximum number of batch commands waiting for the response */
+#ifndef AT_CLIENT_BATCH_MAX
+#define AT_CLIENT_BATCH_MAX            4
+#endif
+
 #define AT_CMD_EXPORT(_name_, _args_expr_, _test_, _query_, _setup_, _exec_)   \
     RT_USED static const struct at_cmd __at_cmd_##_test_##_query_##_setup_##_exec_ RT_SECTION("RtAtCmdTab") = \
     {                                                                          \
@@ -159,6 +169,12 @@ struct at_urc_table
 };
 typedef struct at_urc *at_urc_table_t;
 
+/* URC tables compiled for the line parser */
+struct at_urc_matcher;
+
+/* the response callback of an asynchronous command, it runs on the client parser thread */
+typedef void (*at_resp_cb_t)(struct at_client *client, at_response_t resp, at_resp_status_t status, void *user_data);
+
 struct at_client
 {
     rt_device_t device;
@@ -172,6 +188,10 @@ struct at_client
     rt_size_t recv_line_len;
     /* The maximum supported receive data length */
     rt_size_t recv_bufsz;
+    /* the data read from device ahead of the line parser */
+    char recv_ahead[AT_CLIENT_RECV_AHEAD_LEN];
+    rt_size_t recv_ahead_pos;
+    rt_size_t recv_ahead_len;
     rt_sem_t rx_notice;
     rt_mutex_t lock;
 
@@ -181,6 +201,14 @@ struct at_client
 
     struct at_urc_table *urc_table;
     rt_size_t urc_table_size;
+    /* the matcher used by the line parser, and the one to replace it */
+    struct at_urc_matcher *urc_matcher;
+    struct at_urc_matcher *urc_matcher_new;
+
+    /* the asynchronous commands waiting for the response, in the sending order */
+    rt_list_t req_list;
+    rt_size_t req_count;
+    rt_sem_t req_notice;
 
     rt_thread_t parser;
 };
@@ -229,6 +257,10 @@ int at_obj_set_urc_table(at_client_t client, const struct at_urc * table, rt_siz
 /* AT client send commands to AT server and waiter response */
 int at_obj_exec_cmd(at_client_t client, at_response_t resp, const char *cmd_expr, ...);
 
+/* AT client send commands to AT server and get the response by callback */
+int at_obj_exec_cmd_async(at_client_t client, at_response_t resp, at_resp_cb_t cb, void *user_data, const char *cmd_expr, ...);
+int at_obj_exec_cmd_batch(at_client_t client, at_response_t resp, at_resp_cb_t cb, void *user_data, const char *cmd_expr, ...);
+
 /* AT response object create and delete */
 at_response_t at_create_resp(rt_size_t buf_size, rt_size_t line_num, rt_int32_t timeout);
 void at_delete_resp(at_response_t resp);
@@ -248,6 +280,8 @@ int at_resp_parse_line_args_by_kw(at_response_t resp, const char *keyword, const
  */
 
 #define at_exec_cmd(resp, ...)                   at_obj_exec_cmd(at_client_get_first(), resp, __VA_ARGS__)
+#define at_exec_cmd_async(resp, cb, user_data, ...) at_obj_exec_cmd_async(at_client_get_first(), resp, cb, user_data, __VA_ARGS__)
+#define at_exec_cmd_batch(resp, cb, user_data, ...) at_obj_exec_cmd_batch(at_client_get_first(), resp, cb, user_data, __VA_ARGS__)
 #define at_client_wait_connect(timeout)          at_client_obj_wait_connect(at_client_get_first(), timeout)
 #define at_client_send(buf, size)                at_client_obj_send(at_client_get_first(), buf, size)
 #define at_client_recv(buf, size, timeout)       at_client_obj_recv(at_client_get_first(), buf, size, timeout)
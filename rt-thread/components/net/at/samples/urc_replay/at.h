@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+/*
+ * The part of at.h and rtthread.h used by src/at_urc.c, so that the URC
+ * matcher builds on the host for urc_replay.c.
+ */
+
+#ifndef __AT_H__
+#define __AT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define AT_USING_CLIENT
+
+#define RT_NULL                        0
+#define RT_TRUE                        1
+#define RT_FALSE                       0
+
+typedef int                            rt_bool_t;
+typedef uint8_t                        rt_uint8_t;
+typedef uint16_t                       rt_uint16_t;
+typedef size_t                         rt_size_t;
+
+void *rt_malloc(rt_size_t size);
+void *rt_calloc(rt_size_t count, rt_size_t size);
+void rt_free(void *ptr);
+rt_size_t rt_strlen(const char *s);
+
+struct at_client;
+
+struct at_urc
+{
+    const char *cmd_prefix;
+    const char *cmd_suffix;
+    void (*func)(struct at_client *client, const char *data, rt_size_t size);
+};
+
+struct at_urc_table
+{
+    size_t urc_size;
+    const struct at_urc *urc;
+};
+
+struct at_urc_matcher;
+
+struct at_urc_matcher *at_urc_matcher_create(const struct at_urc_table *table, rt_size_t table_size);
+void at_urc_matcher_delete(struct at_urc_matcher *matcher);
+void at_urc_matcher_reset(struct at_urc_matcher *matcher);
+const struct at_urc *at_urc_matcher_feed(struct at_urc_matcher *matcher, char ch, rt_size_t line_len);
+
+#endif /* __AT_H__ */
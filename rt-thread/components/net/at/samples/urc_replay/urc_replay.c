@@ -0,0 +1,310 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+/*
+ * Replay a captured modem byte stream through the URC matcher of the AT
+ * client and through the table scan it replaced (get_urc_obj() before the
+ * matcher), check that both find the same URC at every byte, and report
+ * the parse time per byte of each.
+ *
+ * The lines are split like at_recv_readline() does: at "\r\n", or as soon
+ * as a URC matches. The URC table is the one of a typical cellular/wifi
+ * module, optionally padded with unused URCs to show how the two scale.
+ *
+ * build and run on the host, from this directory:
+ *
+ *   gcc -O2 -I. -o urc_replay urc_replay.c ../../src/at_urc.c
+ *   ./urc_replay [-n extra_urcs] [-r rounds] [trace.txt]
+ *
+ * The trace defaults to sample_trace.txt. Its lines end with "\r\n" after
+ * reading, whatever the line ending of the file.
+ */
+
+#include <at.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define REPLAY_LINE_MAX         256
+
+void *rt_malloc(rt_size_t size)
+{
+    return malloc(size);
+}
+
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    return calloc(count, size);
+}
+
+void rt_free(void *ptr)
+{
+    free(ptr);
+}
+
+rt_size_t rt_strlen(const char *s)
+{
+    return strlen(s);
+}
+
+static const struct at_urc _module_urc[] =
+{
+    {"RING",            "\r\n",     RT_NULL},
+    {"+CREG:",          "\r\n",     RT_NULL},
+    {"+CGREG:",         "\r\n",     RT_NULL},
+    {"+CEREG:",         "\r\n",     RT_NULL},
+    {"+CMTI:",          "\r\n",     RT_NULL},
+    {"+CSQ:",           "\r\n",     RT_NULL},
+    {"+QIURC:",         "\r\n",     RT_NULL},
+    {"+QIOPEN:",        "\r\n",     RT_NULL},
+    {"+IPD",            ":",        RT_NULL},
+    {"",                ",CONNECT OK\r\n", RT_NULL},
+    {"",                ",CLOSED\r\n", RT_NULL},
+    {"",                ",SEND OK\r\n", RT_NULL},
+    {"",                ",SEND FAIL\r\n", RT_NULL},
+    {"WIFI CONNECTED",  "\r\n",     RT_NULL},
+    {"WIFI DISCONNECT", "\r\n",     RT_NULL},
+    {"busy p",          "\r\n",     RT_NULL},
+};
+
+/* the URC lookup of the AT client before the matcher, run after every byte */
+static const struct at_urc *get_urc_obj(const struct at_urc_table *table, rt_size_t table_size,
+                                        const char *buffer, rt_size_t bufsz)
+{
+    rt_size_t i, j, prefix_len, suffix_len;
+    const struct at_urc *urc;
+
+    for (i = 0; i < table_size; i++)
+    {
+        for (j = 0; j < table[i].urc_size; j++)
+        {
+            urc = table[i].urc + j;
+
+            prefix_len = strlen(urc->cmd_prefix);
+            suffix_len = strlen(urc->cmd_suffix);
+            if (bufsz < prefix_len + suffix_len)
+            {
+                continue;
+            }
+            if ((prefix_len ? !strncmp(buffer, urc->cmd_prefix, prefix_len) : 1)
+                    && (suffix_len ? !strncmp(buffer + bufsz - suffix_len, urc->cmd_suffix, suffix_len) : 1))
+            {
+                return urc;
+            }
+        }
+    }
+
+    return RT_NULL;
+}
+
+static char *replay_load(const char *path, size_t *size)
+{
+    char line[REPLAY_LINE_MAX], *data = RT_NULL;
+    size_t len, used = 0, room = 0;
+    FILE *fp;
+
+    fp = fopen(path, "r");
+    if (fp == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    while (fgets(line, sizeof(line) - 2, fp))
+    {
+        len = strcspn(line, "\r\n");
+        strcpy(line + len, "\r\n");
+        len += 2;
+
+        if (used + len > room)
+        {
+            room = (room + len) * 2;
+            data = realloc(data, room);
+        }
+        memcpy(data + used, line, len);
+        used += len;
+    }
+    fclose(fp);
+
+    *size = used;
+    return data;
+}
+
+static double replay_now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* parse the stream like the line parser, returns the number of URC lines */
+static long replay_matcher(struct at_urc_matcher *matcher, const char *data, size_t size)
+{
+    const struct at_urc *urc = RT_NULL;
+    rt_size_t line_len = 0;
+    long found = 0;
+    size_t pos;
+
+    at_urc_matcher_reset(matcher);
+    for (pos = 0; pos < size; pos++)
+    {
+        line_len++;
+        urc = at_urc_matcher_feed(matcher, data[pos], line_len);
+        if (urc || (data[pos] == '\n' && line_len > 1 && data[pos - 1] == '\r') || line_len == REPLAY_LINE_MAX)
+        {
+            found += (urc != RT_NULL);
+            line_len = 0;
+            at_urc_matcher_reset(matcher);
+        }
+    }
+
+    return found;
+}
+
+static long replay_scan(const struct at_urc_table *table, rt_size_t table_size, const char *data, size_t size)
+{
+    const struct at_urc *urc;
+    rt_size_t line_len = 0;
+    long found = 0;
+    size_t pos;
+
+    for (pos = 0; pos < size; pos++)
+    {
+        line_len++;
+        urc = get_urc_obj(table, table_size, data + pos + 1 - line_len, line_len);
+        if (urc || (data[pos] == '\n' && line_len > 1 && data[pos - 1] == '\r') || line_len == REPLAY_LINE_MAX)
+        {
+            found += (urc != RT_NULL);
+            line_len = 0;
+        }
+    }
+
+    return found;
+}
+
+/* feed both lookups byte by byte, returns the offset of the first difference or -1 */
+static long replay_compare(struct at_urc_matcher *matcher, const struct at_urc_table *table,
+                           rt_size_t table_size, const char *data, size_t size)
+{
+    const struct at_urc *urc, *expect;
+    rt_size_t line_len = 0;
+    size_t pos;
+
+    at_urc_matcher_reset(matcher);
+    for (pos = 0; pos < size; pos++)
+    {
+        line_len++;
+        urc = at_urc_matcher_feed(matcher, data[pos], line_len);
+        expect = get_urc_obj(table, table_size, data + pos + 1 - line_len, line_len);
+        if (urc != expect)
+        {
+            return (long)pos;
+        }
+        if (urc || (data[pos] == '\n' && line_len > 1 && data[pos - 1] == '\r') || line_len == REPLAY_LINE_MAX)
+        {
+            line_len = 0;
+            at_urc_matcher_reset(matcher);
+        }
+    }
+
+    return -1;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = "sample_trace.txt";
+    struct at_urc_table table[2];
+    struct at_urc_matcher *matcher;
+    struct at_urc *extra = RT_NULL;
+    int extra_num = 0, rounds = 200, round, i;
+    long matched = 0, scanned = 0, diff;
+    double start, matcher_time, scan_time;
+    size_t size;
+    char *data;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "-n") && i + 1 < argc)
+            extra_num = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+            rounds = atoi(argv[++i]);
+        else
+            path = argv[i];
+    }
+
+    if (rounds < 1)
+        rounds = 1;
+
+    data = replay_load(path, &size);
+    if (data == RT_NULL || size == 0)
+    {
+        fprintf(stderr, "can not read the trace %s\n", path);
+        return 1;
+    }
+
+    /* the module table, then the padding as a second table */
+    table[0].urc = _module_urc;
+    table[0].urc_size = sizeof(_module_urc) / sizeof(_module_urc[0]);
+    table[1].urc_size = extra_num;
+    if (extra_num > 0)
+    {
+        extra = calloc(extra_num, sizeof(struct at_urc));
+        for (i = 0; i < extra_num; i++)
+        {
+            char *prefix = malloc(24);
+
+            snprintf(prefix, 24, "+XURC%d:", i);
+            extra[i].cmd_prefix = prefix;
+            extra[i].cmd_suffix = "\r\n";
+        }
+    }
+    table[1].urc = extra;
+
+    matcher = at_urc_matcher_create(table, extra_num > 0 ? 2 : 1);
+    if (matcher == RT_NULL)
+    {
+        fprintf(stderr, "can not create the matcher\n");
+        return 1;
+    }
+
+    diff = replay_compare(matcher, table, extra_num > 0 ? 2 : 1, data, size);
+    if (diff >= 0)
+    {
+        fprintf(stderr, "the lookups differ at byte %ld of the trace\n", diff);
+        return 1;
+    }
+
+    start = replay_now();
+    for (round = 0; round < rounds; round++)
+        matched = replay_matcher(matcher, data, size);
+    matcher_time = replay_now() - start;
+
+    start = replay_now();
+    for (round = 0; round < rounds; round++)
+        scanned = replay_scan(table, extra_num > 0 ? 2 : 1, data, size);
+    scan_time = replay_now() - start;
+
+    if (matched != scanned)
+    {
+        fprintf(stderr, "the lookups found %ld and %ld URCs\n", matched, scanned);
+        return 1;
+    }
+
+    printf("trace %s: %zu bytes, %ld URC lines, %d URCs in table\n", path, size, matched,
+           (int)(table[0].urc_size + table[1].urc_size));
+    printf("matcher : %8.2f ns/byte\n", matcher_time * 1e9 / rounds / size);
+    printf("scan    : %8.2f ns/byte\n", scan_time * 1e9 / rounds / size);
+    printf("speedup : %8.2fx\n", scan_time / matcher_time);
+
+    at_urc_matcher_delete(matcher);
+    free(data);
+    return 0;
+}
@@ -13,6 +13,7 @@
  */
 
 #include <at.h>
+#include <rthw.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -29,6 +30,20 @@
 
 static struct at_client at_client_table[AT_CLIENT_NUM_MAX] = { 0 };
 
+/* asynchronous command object */
+struct at_request
+{
+    rt_list_t list;
+
+    at_response_t resp;
+    at_resp_status_t status;
+    at_resp_cb_t cb;
+    void *user_data;
+
+    rt_bool_t batch;
+    rt_tick_t start_tick;
+};
+
 extern rt_size_t at_utils_send(rt_device_t dev,
                                rt_off_t    pos,
                                const void *buffer,
@@ -36,6 +51,10 @@ extern rt_size_t at_utils_send(rt_device_t dev,
 extern rt_size_t at_vprintfln(rt_device_t device, const char *format, va_list args);
 extern void at_print_raw_cmd(const char *type, const char *cmd, rt_size_t size);
 extern const char *at_get_last_cmd(rt_size_t *cmd_size);
+extern struct at_urc_matcher *at_urc_matcher_create(const struct at_urc_table *table, rt_size_t table_size);
+extern void at_urc_matcher_delete(struct at_urc_matcher *matcher);
+extern void at_urc_matcher_reset(struct at_urc_matcher *matcher);
+extern const struct at_urc *at_urc_matcher_feed(struct at_urc_matcher *matcher, char ch, rt_size_t line_len);
 
 /**
  * Create response object.
@@ -274,6 +293,125 @@ int at_resp_parse_line_args_by_kw(at_response_t resp, const char *keyword, const
     return resp_args_num;
 }
 
+/* finish the oldest asynchronous command and call its response callback */
+static void client_req_done(at_client_t client, struct at_request *req, at_resp_status_t status)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    rt_list_remove(&req->list);
+    client->req_count--;
+    rt_hw_interrupt_enable(level);
+
+    if (req->cb != RT_NULL)
+    {
+        req->cb(client, req->resp, status, req->user_data);
+    }
+    rt_free(req);
+
+    rt_sem_release(client->req_notice);
+}
+
+/* get the ticks before the oldest asynchronous command timeout, no more than the timeout */
+static rt_int32_t client_req_wait_tick(at_client_t client, rt_int32_t timeout)
+{
+    struct at_request *req;
+    rt_int32_t left;
+
+    if (rt_list_isempty(&client->req_list))
+    {
+        return timeout;
+    }
+
+    req = rt_list_first_entry(&client->req_list, struct at_request, list);
+    if (req->resp->timeout < 0)
+    {
+        return timeout;
+    }
+
+    left = req->resp->timeout - (rt_int32_t)(rt_tick_get() - req->start_tick);
+    if (left < 0)
+    {
+        left = 0;
+    }
+
+    return (timeout < 0 || left < timeout) ? left : timeout;
+}
+
+/* finish the oldest asynchronous command when it is timeout, return RT_TRUE if it is */
+static rt_bool_t client_req_check_timeout(at_client_t client)
+{
+    struct at_request *req;
+
+    if (rt_list_isempty(&client->req_list))
+    {
+        return RT_FALSE;
+    }
+
+    req = rt_list_first_entry(&client->req_list, struct at_request, list);
+    if (req->resp->timeout < 0 || (rt_int32_t)(rt_tick_get() - req->start_tick) < req->resp->timeout)
+    {
+        return RT_FALSE;
+    }
+
+    LOG_W("execute asynchronous command timeout (%d ticks)!", req->resp->timeout);
+    client_req_done(client, req, AT_RESP_TIMEOUT);
+
+    return RT_TRUE;
+}
+
+/**
+ * Wait for the asynchronous commands until a new command can be sent.
+ * A batch command can be sent while less than AT_CLIENT_BATCH_MAX batch commands
+ * are waiting for the response, other commands are sent when none is waiting.
+ */
+static rt_err_t client_req_wait(at_client_t client, rt_bool_t batch, rt_int32_t timeout)
+{
+    struct at_request *last;
+    rt_tick_t start_tick = rt_tick_get();
+    rt_int32_t left = timeout;
+    rt_base_t level;
+    rt_size_t count;
+    rt_bool_t last_batch;
+
+    while (1)
+    {
+        rt_sem_control(client->req_notice, RT_IPC_CMD_RESET, RT_NULL);
+
+        /* the parser thread may finish and free the last request meanwhile */
+        level = rt_hw_interrupt_disable();
+        count = client->req_count;
+        last_batch = RT_FALSE;
+        if (count > 0)
+        {
+            last = rt_list_entry(client->req_list.prev, struct at_request, list);
+            last_batch = last->batch;
+        }
+        rt_hw_interrupt_enable(level);
+
+        if (count == 0 || (batch && count < AT_CLIENT_BATCH_MAX && last_batch))
+        {
+            break;
+        }
+
+        if (timeout >= 0)
+        {
+            left = timeout - (rt_int32_t)(rt_tick_get() - start_tick);
+            if (left <= 0)
+            {
+                return -RT_ETIMEOUT;
+            }
+        }
+
+        if (rt_sem_take(client->req_notice, left) != RT_EOK)
+        {
+            return -RT_ETIMEOUT;
+        }
+    }
+
+    return RT_EOK;
+}
+
 /**
  * Send commands to AT server and wait response.
  *
@@ -311,6 +449,15 @@ int at_obj_exec_cmd(at_client_t client, at_response_t resp, const char *cmd_expr
 
     client->resp_status = AT_RESP_OK;
 
+    /* the response must not be taken as the one of an asynchronous command */
+    if (client_req_wait(client, RT_FALSE, resp ? resp->timeout : RT_WAITING_FOREVER) != RT_EOK)
+    {
+        LOG_W("execute command timeout, the asynchronous commands are not finished!");
+        client->resp_status = AT_RESP_TIMEOUT;
+        result = -RT_ETIMEOUT;
+        goto __exit;
+    }
+
     if (resp != RT_NULL)
     {
         resp->buf_len = 0;
@@ -351,6 +498,128 @@ __exit:
     return result;
 }
 
+static int at_obj_submit_cmd(at_client_t client, at_response_t resp, rt_bool_t batch,
+                             at_resp_cb_t cb, void *user_data, const char *cmd_expr, va_list args)
+{
+    struct at_request *req;
+    rt_base_t level;
+
+    RT_ASSERT(resp);
+    RT_ASSERT(cmd_expr);
+
+    if (client == RT_NULL)
+    {
+        LOG_E("input AT Client object is NULL, please create or get AT Client object!");
+        return -RT_ERROR;
+    }
+
+    /* check AT CLI mode */
+    if (client->status == AT_STATUS_CLI)
+    {
+        return -RT_EBUSY;
+    }
+
+    req = (struct at_request *) rt_calloc(1, sizeof(struct at_request));
+    if (req == RT_NULL)
+    {
+        LOG_E("AT submit command failed! No memory for request object!");
+        return -RT_ENOMEM;
+    }
+
+    req->resp = resp;
+    req->status = AT_RESP_OK;
+    req->cb = cb;
+    req->user_data = user_data;
+    req->batch = batch;
+
+    resp->buf_len = 0;
+    resp->line_counts = 0;
+
+    rt_mutex_take(client->lock, RT_WAITING_FOREVER);
+
+    if (client_req_wait(client, batch, resp->timeout) != RT_EOK)
+    {
+        rt_mutex_release(client->lock);
+        rt_free(req);
+        LOG_W("submit command timeout, the previous commands are not finished!");
+        return -RT_ETIMEOUT;
+    }
+
+    /* queue the command before sending, its response may come at any time */
+    req->start_tick = rt_tick_get();
+    level = rt_hw_interrupt_disable();
+    rt_list_insert_before(&client->req_list, &req->list);
+    client->req_count++;
+    rt_hw_interrupt_enable(level);
+
+    at_vprintfln(client->device, cmd_expr, args);
+
+    rt_mutex_release(client->lock);
+
+    /* wake up the parser to wait for the timeout of the command */
+    rt_sem_release(client->rx_notice);
+
+    return RT_EOK;
+}
+
+/**
+ * Send commands to AT server without waiting response. The command is sent
+ * when the previous commands have finished, then the response is reported by
+ * the callback on the client parser thread, which must not block.
+ *
+ * @param client current AT client object
+ * @param resp AT response object, it must be kept until the callback
+ * @param cb response callback, using RT_NULL when you don't care the result
+ * @param user_data the parameter of the callback
+ * @param cmd_expr AT commands expression
+ *
+ * @return 0 : success
+ *        -2 : wait previous commands timeout
+ *        -5 : no memory
+ *        -7 : enter AT CLI mode
+ */
+int at_obj_exec_cmd_async(at_client_t client, at_response_t resp, at_resp_cb_t cb, void *user_data, const char *cmd_expr, ...)
+{
+    va_list args;
+    int result;
+
+    va_start(args, cmd_expr);
+    result = at_obj_submit_cmd(client, resp, RT_FALSE, cb, user_data, cmd_expr, args);
+    va_end(args);
+
+    return result;
+}
+
+/**
+ * Send batch commands to AT server without waiting response. Unlike
+ * at_obj_exec_cmd_async(), the command is sent while up to AT_CLIENT_BATCH_MAX
+ * previous batch commands are waiting for the response, so it can only be used
+ * for the commands the AT server accepts back to back, and whose response lines
+ * can not be taken as URC.
+ *
+ * @param client current AT client object
+ * @param resp AT response object, it must be kept until the callback
+ * @param cb response callback, using RT_NULL when you don't care the result
+ * @param user_data the parameter of the callback
+ * @param cmd_expr AT commands expression
+ *
+ * @return 0 : success
+ *        -2 : wait previous commands timeout
+ *        -5 : no memory
+ *        -7 : enter AT CLI mode
+ */
+int at_obj_exec_cmd_batch(at_client_t client, at_response_t resp, at_resp_cb_t cb, void *user_data, const char *cmd_expr, ...)
+{
+    va_list args;
+    int result;
+
+    va_start(args, cmd_expr);
+    result = at_obj_submit_cmd(client, resp, RT_TRUE, cb, user_data, cmd_expr, args);
+    va_end(args);
+
+    return result;
+}
+
 /**
  * Waiting for connection to external devices.
  *
@@ -456,10 +725,19 @@ static rt_err_t at_client_getchar(at_client_t client, char *ch, rt_int32_t timeo
 {
     rt_err_t result = RT_EOK;
 
-    while (rt_device_read(client->device, 0, ch, 1) == 0)
+    /* read the device in bulk, the line parser consumes it byte by byte */
+    while (client->recv_ahead_pos >= client->recv_ahead_len)
     {
-        result = rt_sem_take(client->rx_notice, rt_tick_from_millisecond(timeout));
-        if (result != RT_EOK)
+        client->recv_ahead_pos = 0;
+        client->recv_ahead_len = rt_device_read(client->device, 0, client->recv_ahead, AT_CLIENT_RECV_AHEAD_LEN);
+        if (client->recv_ahead_len > 0)
+        {
+            break;
+        }
+
+        /* wake up for the timeout of the asynchronous commands as well */
+        result = rt_sem_take(client->rx_notice, client_req_wait_tick(client, rt_tick_from_millisecond(timeout)));
+        if (result != RT_EOK && client_req_check_timeout(client) == RT_FALSE)
         {
             return result;
         }
@@ -467,6 +745,8 @@ static rt_err_t at_client_getchar(at_client_t client, char *ch, rt_int32_t timeo
         rt_sem_control(client->rx_notice, RT_IPC_CMD_RESET, RT_NULL);
     }
 
+    *ch = client->recv_ahead[client->recv_ahead_pos++];
+
     return RT_EOK;
 }
 
@@ -495,7 +775,17 @@ rt_size_t at_client_obj_recv(at_client_t client, char *buf, rt_size_t size, rt_i
         return 0;
     }
 
-    while (1)
+    /* take the data read ahead by the line parser first */
+    len = client->recv_ahead_len - client->recv_ahead_pos;
+    if (len > size)
+    {
+        len = size;
+    }
+    rt_memcpy(buf, client->recv_ahead + client->recv_ahead_pos, len);
+    client->recv_ahead_pos += len;
+    size -= len;
+
+    while (size > 0)
     {
         rt_size_t read_len;
 
@@ -506,9 +796,6 @@ rt_size_t at_client_obj_recv(at_client_t client, char *buf, rt_size_t size, rt_i
         {
             len += read_len;
             size -= read_len;
-            if(size == 0)
-                break;
-
             continue;
         }
 
@@ -550,6 +837,7 @@ void at_obj_set_end_sign(at_client_t client, char ch)
 int at_obj_set_urc_table(at_client_t client, const struct at_urc *urc_table, rt_size_t table_sz)
 {
     rt_size_t idx;
+    struct at_urc_matcher *matcher, *old_matcher;
 
     if (client == RT_NULL)
     {
@@ -592,6 +880,31 @@ int at_obj_set_urc_table(at_client_t client, const struct at_urc *urc_table, rt_
 
     }
 
+    /* recompile all the URC tables */
+    matcher = at_urc_matcher_create(client->urc_table, client->urc_table_size);
+    if (matcher == RT_NULL)
+    {
+        LOG_E("AT client set URC table failed! No memory for URC matcher.");
+        client->urc_table_size--;
+        if (client->urc_table_size == 0)
+        {
+            rt_free(client->urc_table);
+            client->urc_table = RT_NULL;
+        }
+        return -RT_ENOMEM;
+    }
+
+    /* the parser thread takes the new matcher at the start of the next line */
+    rt_enter_critical();
+    old_matcher = client->urc_matcher_new;
+    client->urc_matcher_new = matcher;
+    rt_exit_critical();
+
+    if (old_matcher)
+    {
+        at_urc_matcher_delete(old_matcher);
+    }
+
     return RT_EOK;
 }
 
@@ -634,55 +947,45 @@ at_client_t at_client_get_first(void)
     return &at_client_table[0];
 }
 
-static const struct at_urc *get_urc_obj(at_client_t client)
+static struct at_urc_matcher *get_urc_matcher(at_client_t client)
 {
-    rt_size_t i, j, prefix_len, suffix_len;
-    rt_size_t bufsz;
-    char *buffer = RT_NULL;
-    const struct at_urc *urc = RT_NULL;
-    struct at_urc_table *urc_table = RT_NULL;
+    struct at_urc_matcher *old_matcher = RT_NULL;
 
-    if (client->urc_table == RT_NULL)
+    if (client->urc_matcher_new)
     {
-        return RT_NULL;
+        rt_enter_critical();
+        old_matcher = client->urc_matcher;
+        client->urc_matcher = client->urc_matcher_new;
+        client->urc_matcher_new = RT_NULL;
+        rt_exit_critical();
     }
 
-    buffer = client->recv_line_buf;
-    bufsz = client->recv_line_len;
-
-    for (i = 0; i < client->urc_table_size; i++)
+    if (old_matcher)
     {
-        for (j = 0; j < client->urc_table[i].urc_size; j++)
-        {
-            urc_table = client->urc_table + i;
-            urc = urc_table->urc + j;
-
-            prefix_len = rt_strlen(urc->cmd_prefix);
-            suffix_len = rt_strlen(urc->cmd_suffix);
-            if (bufsz < prefix_len + suffix_len)
-            {
-                continue;
-            }
-            if ((prefix_len ? !rt_strncmp(buffer, urc->cmd_prefix, prefix_len) : 1)
-                    && (suffix_len ? !rt_strncmp(buffer + bufsz - suffix_len, urc->cmd_suffix, suffix_len) : 1))
-            {
-                return urc;
-            }
-        }
+        at_urc_matcher_delete(old_matcher);
     }
 
-    return RT_NULL;
+    return client->urc_matcher;
 }
 
-static int at_recv_readline(at_client_t client)
+static int at_recv_readline(at_client_t client, const struct at_urc **urc)
 {
     rt_size_t read_len = 0;
     char ch = 0, last_ch = 0;
     rt_bool_t is_full = RT_FALSE;
+    struct at_urc_matcher *matcher;
 
-    rt_memset(client->recv_line_buf, 0x00, client->recv_bufsz);
+    /* the buffer after the line is always zeroed */
+    rt_memset(client->recv_line_buf, 0x00, client->recv_line_len);
     client->recv_line_len = 0;
 
+    *urc = RT_NULL;
+    matcher = get_urc_matcher(client);
+    if (matcher)
+    {
+        at_urc_matcher_reset(matcher);
+    }
+
     while (1)
     {
         at_client_getchar(client, &ch, RT_WAITING_FOREVER);
@@ -691,6 +994,11 @@ static int at_recv_readline(at_client_t client)
         {
             client->recv_line_buf[read_len++] = ch;
             client->recv_line_len = read_len;
+
+            if (matcher)
+            {
+                *urc = at_urc_matcher_feed(matcher, ch, read_len);
+            }
         }
         else
         {
@@ -699,7 +1007,7 @@ static int at_recv_readline(at_client_t client)
 
         /* is newline or URC data */
         if ((ch == '\n' && last_ch == '\r') || (client->end_sign != 0 && ch == client->end_sign)
-                || get_urc_obj(client))
+                || *urc)
         {
             if (is_full)
             {
@@ -720,15 +1028,66 @@ static int at_recv_readline(at_client_t client)
     return read_len;
 }
 
+/* store a received line to the response, return RT_TRUE when the response ends */
+static rt_bool_t client_resp_line(at_client_t client, at_response_t resp, at_resp_status_t *status)
+{
+    char end_ch = client->recv_line_buf[client->recv_line_len - 1];
+
+    /* current receive is response */
+    client->recv_line_buf[client->recv_line_len - 1] = '\0';
+    if (resp->buf_len + client->recv_line_len < resp->buf_size)
+    {
+        /* copy response lines, separated by '\0' */
+        rt_memcpy(resp->buf + resp->buf_len, client->recv_line_buf, client->recv_line_len);
+
+        /* update the current response information */
+        resp->buf_len += client->recv_line_len;
+        resp->line_counts++;
+    }
+    else
+    {
+        *status = AT_RESP_BUFF_FULL;
+        LOG_E("Read response buffer failed. The Response buffer size is out of buffer size(%d)!", resp->buf_size);
+    }
+    /* check response result */
+    if ((client->end_sign != 0) && (end_ch == client->end_sign) && (resp->line_num == 0))
+    {
+        /* get the end sign, return response state END_OK.*/
+        *status = AT_RESP_OK;
+    }
+    else if (rt_memcmp(client->recv_line_buf, AT_RESP_END_OK, rt_strlen(AT_RESP_END_OK)) == 0
+            && resp->line_num == 0)
+    {
+        /* get the end data by response result, return response state END_OK. */
+        *status = AT_RESP_OK;
+    }
+    else if (rt_strstr(client->recv_line_buf, AT_RESP_END_ERROR)
+            || (rt_memcmp(client->recv_line_buf, AT_RESP_END_FAIL, rt_strlen(AT_RESP_END_FAIL)) == 0))
+    {
+        *status = AT_RESP_ERROR;
+    }
+    else if (resp->line_counts == resp->line_num && resp->line_num)
+    {
+        /* get the end data by response line, return response state END_OK.*/
+        *status = AT_RESP_OK;
+    }
+    else
+    {
+        return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
 static void client_parser(at_client_t client)
 {
     const struct at_urc *urc;
 
     while(1)
     {
-        if (at_recv_readline(client) > 0)
+        if (at_recv_readline(client, &urc) > 0)
         {
-            if ((urc = get_urc_obj(client)) != RT_NULL)
+            if (urc != RT_NULL)
             {
                 /* current receive is request, try to execute related operations */
                 if (urc->func != RT_NULL)
@@ -736,57 +1095,23 @@ static void client_parser(at_client_t client)
                     urc->func(client, client->recv_line_buf, client->recv_line_len);
                 }
             }
-            else if (client->resp != RT_NULL)
+            else if (!rt_list_isempty(&client->req_list))
             {
-                at_response_t resp = client->resp;
-
-                char end_ch = client->recv_line_buf[client->recv_line_len - 1];
+                struct at_request *req = rt_list_first_entry(&client->req_list, struct at_request, list);
 
-                /* current receive is response */
-                client->recv_line_buf[client->recv_line_len - 1] = '\0';
-                if (resp->buf_len + client->recv_line_len < resp->buf_size)
-                {
-                    /* copy response lines, separated by '\0' */
-                    rt_memcpy(resp->buf + resp->buf_len, client->recv_line_buf, client->recv_line_len);
-
-                    /* update the current response information */
-                    resp->buf_len += client->recv_line_len;
-                    resp->line_counts++;
-                }
-                else
+                /* current receive is response of the oldest asynchronous command */
+                if (client_resp_line(client, req->resp, &req->status))
                 {
-                    client->resp_status = AT_RESP_BUFF_FULL;
-                    LOG_E("Read response buffer failed. The Response buffer size is out of buffer size(%d)!", resp->buf_size);
+                    client_req_done(client, req, req->status);
                 }
-                /* check response result */
-                if ((client->end_sign != 0) && (end_ch == client->end_sign) && (resp->line_num == 0))
-                {
-                    /* get the end sign, return response state END_OK.*/
-                    client->resp_status = AT_RESP_OK;
-                }
-                else if (rt_memcmp(client->recv_line_buf, AT_RESP_END_OK, rt_strlen(AT_RESP_END_OK)) == 0
-                        && resp->line_num == 0)
-                {
-                    /* get the end data by response result, return response state END_OK. */
-                    client->resp_status = AT_RESP_OK;
-                }
-                else if (rt_strstr(client->recv_line_buf, AT_RESP_END_ERROR)
-                        || (rt_memcmp(client->recv_line_buf, AT_RESP_END_FAIL, rt_strlen(AT_RESP_END_FAIL)) == 0))
-                {
-                    client->resp_status = AT_RESP_ERROR;
-                }
-                else if (resp->line_counts == resp->line_num && resp->line_num)
-                {
-                    /* get the end data by response line, return response state END_OK.*/
-                    client->resp_status = AT_RESP_OK;
-                }
-                else
+            }
+            else if (client->resp != RT_NULL)
+            {
+                if (client_resp_line(client, client->resp, &client->resp_status))
                 {
-                    continue;
+                    client->resp = RT_NULL;
+                    rt_sem_release(client->resp_notice);
                 }
-
-                client->resp = RT_NULL;
-                rt_sem_release(client->resp_notice);
             }
             else
             {
@@ -817,6 +1142,7 @@ static int at_client_para_init(at_client_t client)
 #define AT_CLIENT_LOCK_NAME            "at_c"
 #define AT_CLIENT_SEM_NAME             "at_cs"
 #define AT_CLIENT_RESP_NAME            "at_cr"
+#define AT_CLIENT_REQ_NAME             "at_cq"
 #define AT_CLIENT_THREAD_NAME          "at_clnt"
 
     int result = RT_EOK;
@@ -861,8 +1187,23 @@ static int at_client_para_init(at_client_t client)
         goto __exit;
     }
 
+    rt_snprintf(name, RT_NAME_MAX, "%s%d", AT_CLIENT_REQ_NAME, at_client_num);
+    client->req_notice = rt_sem_create(name, 0, RT_IPC_FLAG_FIFO);
+    if (client->req_notice == RT_NULL)
+    {
+        LOG_E("AT client initialize failed! at_client_req semaphore create failed!");
+        result = -RT_ENOMEM;
+        goto __exit;
+    }
+    rt_list_init(&client->req_list);
+    client->req_count = 0;
+
     client->urc_table = RT_NULL;
     client->urc_table_size = 0;
+    client->urc_matcher = RT_NULL;
+    client->urc_matcher_new = RT_NULL;
+    client->recv_ahead_pos = 0;
+    client->recv_ahead_len = 0;
 
     rt_snprintf(name, RT_NAME_MAX, "%s%d", AT_CLIENT_THREAD_NAME, at_client_num);
     client->parser = rt_thread_create(name,
@@ -895,6 +1236,11 @@ __exit:
             rt_sem_delete(client->resp_notice);
         }
 
+        if (client->req_notice)
+        {
+            rt_sem_delete(client->req_notice);
+        }
+
         if (client->device)
         {
             rt_device_close(client->device);
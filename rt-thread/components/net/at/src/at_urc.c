@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <at.h>
+
+#ifdef AT_USING_CLIENT
+
+/*
+ * The URC tables of an AT client are compiled into a trie of the URC prefixes,
+ * walked from the start of the line, and an Aho-Corasick automaton of the URC
+ * suffixes, run over the whole line. The line parser then spends a constant
+ * time on each received byte, whatever the number of URCs, and only looks at
+ * the URCs when one of their suffixes ends at the byte.
+ */
+
+#define URC_NODE_MAX                   0xFFFF
+
+struct urc_node
+{
+    rt_uint16_t child;                 /* first child node, 0 if none */
+    rt_uint16_t sibling;               /* next node of the same parent, 0 if none */
+    rt_uint16_t fail;                  /* suffix automaton: node of the longest proper suffix */
+    rt_uint16_t report;                /* suffix automaton: next node on the fail chain with URCs, 0 if none */
+    rt_uint16_t urc;                   /* first URC ending at this node plus 1, 0 if none */
+    char ch;
+};
+
+struct urc_entry
+{
+    const struct at_urc *urc;
+    rt_uint16_t prefix_len;
+    rt_uint16_t suffix_len;
+    rt_uint16_t prefix_node;
+    rt_uint16_t next;                  /* next URC ending at the same node plus 1, 0 if none */
+};
+
+struct at_urc_matcher
+{
+    struct urc_entry *urcs;            /* in the order of the URC tables */
+    struct urc_node *prefix;           /* prefix trie, node 0 is the root */
+    struct urc_node *suffix;           /* suffix automaton, node 0 is the root */
+    rt_uint16_t *path;                 /* prefix trie nodes matched by the line, path[0] is the root */
+
+    /* state of the current line */
+    rt_size_t prefix_depth;
+    rt_bool_t prefix_alive;
+    rt_uint16_t suffix_state;
+};
+
+static rt_uint16_t urc_node_child(const struct urc_node *nodes, rt_uint16_t node, char ch)
+{
+    rt_uint16_t child;
+
+    for (child = nodes[node].child; child; child = nodes[child].sibling)
+    {
+        if (nodes[child].ch == ch)
+        {
+            break;
+        }
+    }
+
+    return child;
+}
+
+static rt_uint16_t urc_node_insert(struct urc_node *nodes, rt_uint16_t *node_num, const char *str)
+{
+    rt_uint16_t node = 0, child;
+
+    for (; *str; str++)
+    {
+        child = urc_node_child(nodes, node, *str);
+        if (child == 0)
+        {
+            child = (*node_num)++;
+            nodes[child].ch = *str;
+            nodes[child].sibling = nodes[node].child;
+            nodes[node].child = child;
+        }
+        node = child;
+    }
+
+    return node;
+}
+
+/* link the fail and report chains of the suffix automaton in breadth-first order */
+static void urc_suffix_link(struct urc_node *nodes, rt_uint16_t *queue)
+{
+    rt_size_t head = 0, tail = 0;
+    rt_uint16_t node, child, fail;
+
+    for (child = nodes[0].child; child; child = nodes[child].sibling)
+    {
+        queue[tail++] = child;
+    }
+
+    while (head < tail)
+    {
+        node = queue[head++];
+        for (child = nodes[node].child; child; child = nodes[child].sibling)
+        {
+            fail = nodes[node].fail;
+            while (fail && urc_node_child(nodes, fail, nodes[child].ch) == 0)
+            {
+                fail = nodes[fail].fail;
+            }
+            fail = urc_node_child(nodes, fail, nodes[child].ch);
+
+            nodes[child].fail = fail;
+            nodes[child].report = nodes[fail].urc ? fail : nodes[fail].report;
+            queue[tail++] = child;
+        }
+    }
+}
+
+/**
+ * compile the URC tables into a matcher.
+ *
+ * @param table the URC tables
+ * @param table_size the number of URC tables
+ *
+ * @return != RT_NULL: URC matcher object
+ *          = RT_NULL: no memory or too many URCs
+ */
+struct at_urc_matcher *at_urc_matcher_create(const struct at_urc_table *table, rt_size_t table_size)
+{
+    struct at_urc_matcher *matcher;
+    rt_size_t i, j, urc_num = 0, prefix_num = 1, suffix_num = 1, prefix_max = 0, len;
+    rt_uint16_t prefix_cnt = 1, suffix_cnt = 1, node, *queue;
+    const struct at_urc *urc;
+    struct urc_entry *entry;
+    rt_uint8_t *mem;
+
+    for (i = 0; i < table_size; i++)
+    {
+        for (j = 0; j < table[i].urc_size; j++)
+        {
+            urc = table[i].urc + j;
+            len = rt_strlen(urc->cmd_prefix);
+            prefix_num += len;
+            prefix_max = len > prefix_max ? len : prefix_max;
+            suffix_num += rt_strlen(urc->cmd_suffix);
+            urc_num++;
+        }
+    }
+
+    if (urc_num >= URC_NODE_MAX || prefix_num > URC_NODE_MAX || suffix_num > URC_NODE_MAX)
+    {
+        return RT_NULL;
+    }
+
+    mem = (rt_uint8_t *) rt_calloc(1, sizeof(struct at_urc_matcher) + urc_num * sizeof(struct urc_entry)
+                                   + (prefix_num + suffix_num) * sizeof(struct urc_node)
+                                   + (prefix_max + 1) * sizeof(rt_uint16_t));
+    if (mem == RT_NULL)
+    {
+        return RT_NULL;
+    }
+
+    matcher = (struct at_urc_matcher *) mem;
+    mem += sizeof(struct at_urc_matcher);
+    matcher->urcs = (struct urc_entry *) mem;
+    mem += urc_num * sizeof(struct urc_entry);
+    matcher->prefix = (struct urc_node *) mem;
+    mem += prefix_num * sizeof(struct urc_node);
+    matcher->suffix = (struct urc_node *) mem;
+    mem += suffix_num * sizeof(struct urc_node);
+    matcher->path = (rt_uint16_t *) mem;
+
+    /* build both tries, the URCs are linked backwards to keep the table order in the lists */
+    entry = matcher->urcs + urc_num;
+    for (i = table_size; i-- > 0;)
+    {
+        for (j = table[i].urc_size; j-- > 0;)
+        {
+            urc = table[i].urc + j;
+            entry--;
+            entry->urc = urc;
+            entry->prefix_len = rt_strlen(urc->cmd_prefix);
+            entry->suffix_len = rt_strlen(urc->cmd_suffix);
+            entry->prefix_node = urc_node_insert(matcher->prefix, &prefix_cnt, urc->cmd_prefix);
+
+            /* an URC without suffix is matched as soon as the prefix is */
+            if (entry->suffix_len == 0)
+            {
+                node = entry->prefix_node;
+                entry->next = matcher->prefix[node].urc;
+                matcher->prefix[node].urc = entry - matcher->urcs + 1;
+            }
+            else
+            {
+                node = urc_node_insert(matcher->suffix, &suffix_cnt, urc->cmd_suffix);
+                entry->next = matcher->suffix[node].urc;
+                matcher->suffix[node].urc = entry - matcher->urcs + 1;
+            }
+        }
+    }
+
+    queue = (rt_uint16_t *) rt_malloc(suffix_cnt * sizeof(rt_uint16_t));
+    if (queue == RT_NULL)
+    {
+        rt_free(matcher);
+        return RT_NULL;
+    }
+    urc_suffix_link(matcher->suffix, queue);
+    rt_free(queue);
+
+    return matcher;
+}
+
+/**
+ * delete the URC matcher.
+ *
+ * @param matcher URC matcher object
+ */
+void at_urc_matcher_delete(struct at_urc_matcher *matcher)
+{
+    rt_free(matcher);
+}
+
+/**
+ * reset the URC matcher at the start of a line.
+ *
+ * @param matcher URC matcher object
+ */
+void at_urc_matcher_reset(struct at_urc_matcher *matcher)
+{
+    matcher->prefix_depth = 0;
+    matcher->prefix_alive = RT_TRUE;
+    matcher->suffix_state = 0;
+    matcher->path[0] = 0;
+}
+
+/**
+ * feed the URC matcher with the next byte of the line.
+ *
+ * @param matcher URC matcher object
+ * @param ch the received byte
+ * @param line_len the length of the line including this byte
+ *
+ * @return != RT_NULL: the first URC in the table order the line matches
+ *          = RT_NULL: the line matches no URC
+ */
+const struct at_urc *at_urc_matcher_feed(struct at_urc_matcher *matcher, char ch, rt_size_t line_len)
+{
+    const struct urc_entry *entry;
+    rt_uint16_t node, best = 0, idx;
+
+    /* an URC without prefix and suffix is matched by the first byte */
+    if (line_len == 1)
+    {
+        best = matcher->prefix[0].urc;
+    }
+
+    /* walk the prefix trie while the line starts with some prefix */
+    if (matcher->prefix_alive)
+    {
+        node = urc_node_child(matcher->prefix, matcher->path[matcher->prefix_depth], ch);
+        if (node)
+        {
+            matcher->path[++matcher->prefix_depth] = node;
+            idx = matcher->prefix[node].urc;
+            if (idx && (best == 0 || idx < best))
+            {
+                best = idx;
+            }
+        }
+        else
+        {
+            matcher->prefix_alive = RT_FALSE;
+        }
+    }
+
+    /* step the suffix automaton */
+    node = matcher->suffix_state;
+    while (node && urc_node_child(matcher->suffix, node, ch) == 0)
+    {
+        node = matcher->suffix[node].fail;
+    }
+    node = urc_node_child(matcher->suffix, node, ch);
+    matcher->suffix_state = node;
+
+    /* check the prefix of the URCs whose suffix ends at this byte */
+    if (matcher->suffix[node].urc == 0)
+    {
+        node = matcher->suffix[node].report;
+    }
+    for (; node; node = matcher->suffix[node].report)
+    {
+        for (idx = matcher->suffix[node].urc; idx; idx = entry->next)
+        {
+            entry = matcher->urcs + idx - 1;
+            if (best && best < idx)
+            {
+                break;
+            }
+
+            if (entry->prefix_len <= matcher->prefix_depth
+                    && matcher->path[entry->prefix_len] == entry->prefix_node
+                    && line_len >= entry->prefix_len + entry->suffix_len)
+            {
+                best = idx;
+                break;
+            }
+        }
+    }
+
+    return best ? matcher->urcs[best - 1].urc : RT_NULL;
+}
+
+#endif /* AT_USING_CLIENT */
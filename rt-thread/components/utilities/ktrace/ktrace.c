@@ -0,0 +1,570 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <ktrace.h>
+
+#ifdef RT_USING_CPUTIME
+#include <drivers/cputime.h>
+#endif
+
+#ifdef RT_USING_DFS
+#include <dfs_file.h>
+#include <unistd.h>
+#endif
+
+#define DBG_TAG    "ktrace"
+#define DBG_LVL    DBG_INFO
+#include <rtdbg.h>
+
+#ifndef KTRACE_RECORD_NUM
+#define KTRACE_RECORD_NUM           256
+#endif
+
+#ifdef RT_USING_SMP
+#define _CPUS_NR                    RT_CPUS_NR
+#define _ktrace_cpu()               rt_hw_cpu_id()
+#define _ktrace_lock()              rt_hw_local_irq_disable()
+#define _ktrace_unlock(level)       rt_hw_local_irq_enable(level)
+#else
+#define _CPUS_NR                    1
+#define _ktrace_cpu()               0
+#define _ktrace_lock()              rt_hw_interrupt_disable()
+#define _ktrace_unlock(level)       rt_hw_interrupt_enable(level)
+#endif /* RT_USING_SMP */
+
+#define _ktrace_id(ptr)             ((rt_uint32_t)(rt_ubase_t)(ptr))
+
+struct _ktrace_buffer
+{
+    rt_uint32_t head;                       /* index of the next record */
+    rt_uint32_t count;                      /* valid records */
+    rt_uint32_t lost;                       /* overwritten records */
+    struct rt_ktrace_record record[KTRACE_RECORD_NUM];
+};
+
+static struct _ktrace_buffer _ktrace_buf[_CPUS_NR];
+static volatile rt_bool_t _ktrace_enable = RT_FALSE;
+
+/**
+ * @brief Get the timestamp of a record. It uses the CPU time when RT_USING_CPUTIME is enabled,
+ *        otherwise the OS tick. The BSP can provide a finer counter by implementing this function.
+ *
+ * @return Return the current timestamp.
+ */
+RT_WEAK rt_uint32_t rt_ktrace_timestamp(void)
+{
+#ifdef RT_USING_CPUTIME
+    return (rt_uint32_t)clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif
+}
+
+/**
+ * @brief Get the counts per second of rt_ktrace_timestamp().
+ *
+ * @return Return the frequency of the timestamp.
+ */
+RT_WEAK rt_uint32_t rt_ktrace_timestamp_frequency(void)
+{
+#ifdef RT_USING_CPUTIME
+    float res = clock_cpu_getres();
+
+    if (res > 0)
+        return (rt_uint32_t)(1000000000.0f / res);
+#endif
+    return RT_TICK_PER_SECOND;
+}
+
+/**
+ * @brief Write a record into the trace buffer of the current cpu. When the buffer is full,
+ *        the oldest record is overwritten.
+ *
+ * @param type is the event type, application events start from KTRACE_EVENT_USER.
+ * @param arg0 is the first argument of the event.
+ * @param arg1 is the second argument of the event.
+ * @param arg2 is the third argument of the event.
+ */
+void rt_ktrace_event(rt_uint16_t type, rt_uint16_t arg0, rt_uint32_t arg1, rt_uint32_t arg2)
+{
+    struct _ktrace_buffer *buf;
+    struct rt_ktrace_record *record;
+    rt_base_t level;
+
+    if (!_ktrace_enable)
+        return;
+
+    level = _ktrace_lock();
+
+    buf = &_ktrace_buf[_ktrace_cpu()];
+    record = &buf->record[buf->head];
+    record->timestamp = rt_ktrace_timestamp();
+    record->type = type;
+    record->arg0 = arg0;
+    record->arg1 = arg1;
+    record->arg2 = arg2;
+
+    if (++buf->head == KTRACE_RECORD_NUM)
+        buf->head = 0;
+    if (buf->count < KTRACE_RECORD_NUM)
+        buf->count ++;
+    else
+        buf->lost ++;
+
+    _ktrace_unlock(level);
+}
+RTM_EXPORT(rt_ktrace_event);
+
+static void _ktrace_name(struct rt_object *object)
+{
+    rt_uint32_t word;
+    rt_uint16_t offset;
+
+    for (offset = 0; offset < RT_NAME_MAX && object->name[offset]; offset += sizeof(word))
+    {
+        word = 0;
+        rt_memcpy(&word, &object->name[offset],
+                  (RT_NAME_MAX - offset < sizeof(word)) ? RT_NAME_MAX - offset : sizeof(word));
+        rt_ktrace_event(KTRACE_EVENT_NAME, offset, _ktrace_id(object), word);
+    }
+}
+
+static void _ktrace_scheduler_hook(struct rt_thread *from, struct rt_thread *to)
+{
+    rt_ktrace_event(KTRACE_EVENT_SWITCH, (from->current_priority << 8) | to->current_priority,
+                    _ktrace_id(from), _ktrace_id(to));
+}
+
+static void _ktrace_irq_enter_hook(void)
+{
+    rt_ktrace_event(KTRACE_EVENT_IRQ_ENTER, rt_interrupt_get_nest(), 0, 0);
+}
+
+static void _ktrace_irq_leave_hook(void)
+{
+    rt_ktrace_event(KTRACE_EVENT_IRQ_LEAVE, rt_interrupt_get_nest(), 0, 0);
+}
+
+static void _ktrace_timer_enter_hook(struct rt_timer *timer)
+{
+    rt_ktrace_event(KTRACE_EVENT_TIMER_ENTER, 0, _ktrace_id(timer), 0);
+}
+
+static void _ktrace_timer_exit_hook(struct rt_timer *timer)
+{
+    rt_ktrace_event(KTRACE_EVENT_TIMER_EXIT, 0, _ktrace_id(timer), 0);
+}
+
+static void _ktrace_object_trytake_hook(struct rt_object *object)
+{
+    rt_ktrace_event(KTRACE_EVENT_OBJECT_TRYTAKE, object->type & ~RT_Object_Class_Static,
+                    _ktrace_id(object), _ktrace_id(rt_thread_self()));
+}
+
+static void _ktrace_object_take_hook(struct rt_object *object)
+{
+    rt_ktrace_event(KTRACE_EVENT_OBJECT_TAKE, object->type & ~RT_Object_Class_Static,
+                    _ktrace_id(object), _ktrace_id(rt_thread_self()));
+}
+
+static void _ktrace_object_put_hook(struct rt_object *object)
+{
+    rt_ktrace_event(KTRACE_EVENT_OBJECT_PUT, object->type & ~RT_Object_Class_Static,
+                    _ktrace_id(object), _ktrace_id(rt_thread_self()));
+}
+
+static void _ktrace_thread_inited_hook(struct rt_thread *thread)
+{
+    /* keep the name of threads which may be gone at dump time */
+    _ktrace_name((struct rt_object *)thread);
+}
+
+#ifdef RT_USING_HEAP
+static void _ktrace_malloc_hook(void *ptr, rt_size_t size)
+{
+    rt_ktrace_event(KTRACE_EVENT_MALLOC, 0, _ktrace_id(ptr), (rt_uint32_t)size);
+}
+
+static void _ktrace_free_hook(void *ptr)
+{
+    rt_ktrace_event(KTRACE_EVENT_FREE, 0, _ktrace_id(ptr), 0);
+}
+#endif /* RT_USING_HEAP */
+
+/**
+ * @brief Start tracing. The kernel hooks are taken over by the tracer, so any other
+ *        user of these hooks is replaced until rt_ktrace_stop() is called.
+ */
+void rt_ktrace_start(void)
+{
+    if (_ktrace_enable)
+        return;
+
+    rt_scheduler_sethook(_ktrace_scheduler_hook);
+    rt_interrupt_enter_sethook(_ktrace_irq_enter_hook);
+    rt_interrupt_leave_sethook(_ktrace_irq_leave_hook);
+    rt_timer_enter_sethook(_ktrace_timer_enter_hook);
+    rt_timer_exit_sethook(_ktrace_timer_exit_hook);
+    rt_object_trytake_sethook(_ktrace_object_trytake_hook);
+    rt_object_take_sethook(_ktrace_object_take_hook);
+    rt_object_put_sethook(_ktrace_object_put_hook);
+    rt_thread_inited_sethook(_ktrace_thread_inited_hook);
+#ifdef RT_USING_HEAP
+    rt_malloc_sethook(_ktrace_malloc_hook);
+    rt_free_sethook(_ktrace_free_hook);
+#endif
+
+    _ktrace_enable = RT_TRUE;
+}
+RTM_EXPORT(rt_ktrace_start);
+
+/**
+ * @brief Stop tracing and release the kernel hooks. The recorded data is kept.
+ */
+void rt_ktrace_stop(void)
+{
+    _ktrace_enable = RT_FALSE;
+
+    rt_scheduler_sethook(RT_NULL);
+    rt_interrupt_enter_sethook(RT_NULL);
+    rt_interrupt_leave_sethook(RT_NULL);
+    rt_timer_enter_sethook(RT_NULL);
+    rt_timer_exit_sethook(RT_NULL);
+    rt_object_trytake_sethook(RT_NULL);
+    rt_object_take_sethook(RT_NULL);
+    rt_object_put_sethook(RT_NULL);
+    rt_thread_inited_sethook(RT_NULL);
+#ifdef RT_USING_HEAP
+    rt_malloc_sethook(RT_NULL);
+    rt_free_sethook(RT_NULL);
+#endif
+}
+RTM_EXPORT(rt_ktrace_stop);
+
+/**
+ * @brief Drop all records.
+ */
+void rt_ktrace_clear(void)
+{
+    rt_base_t level;
+    int cpu;
+
+    for (cpu = 0; cpu < _CPUS_NR; cpu++)
+    {
+        level = rt_hw_interrupt_disable();
+        _ktrace_buf[cpu].head = 0;
+        _ktrace_buf[cpu].count = 0;
+        _ktrace_buf[cpu].lost = 0;
+        rt_hw_interrupt_enable(level);
+    }
+}
+RTM_EXPORT(rt_ktrace_clear);
+
+static const rt_uint8_t _ktrace_name_class[] =
+{
+    RT_Object_Class_Thread,
+#ifdef RT_USING_SEMAPHORE
+    RT_Object_Class_Semaphore,
+#endif
+#ifdef RT_USING_MUTEX
+    RT_Object_Class_Mutex,
+#endif
+#ifdef RT_USING_EVENT
+    RT_Object_Class_Event,
+#endif
+#ifdef RT_USING_MAILBOX
+    RT_Object_Class_MailBox,
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    RT_Object_Class_MessageQueue,
+#endif
+    RT_Object_Class_Timer,
+};
+
+#define _KTRACE_NAME_SIZE           (sizeof(struct rt_ktrace_name) + RT_NAME_MAX)
+
+/* snapshot the names of living objects, the caller frees the table */
+static rt_uint8_t *_ktrace_name_table(rt_uint32_t *number)
+{
+    struct rt_object_information *info;
+    struct rt_ktrace_name *entry;
+    struct rt_object *object;
+    struct rt_list_node *node;
+    rt_uint8_t *table = RT_NULL;
+    rt_uint32_t total = 0, count = 0;
+    rt_base_t level;
+    int index;
+
+    *number = 0;
+
+#ifdef RT_USING_HEAP
+    for (index = 0; index < sizeof(_ktrace_name_class); index++)
+    {
+        /* leave room for objects created while allocating */
+        total += rt_object_get_length((enum rt_object_class_type)_ktrace_name_class[index]) + 4;
+    }
+
+    table = (rt_uint8_t *)rt_malloc(total * _KTRACE_NAME_SIZE);
+    if (table == RT_NULL)
+        return RT_NULL;
+
+    for (index = 0; index < sizeof(_ktrace_name_class); index++)
+    {
+        info = rt_object_get_information((enum rt_object_class_type)_ktrace_name_class[index]);
+        if (info == RT_NULL)
+            continue;
+
+        level = rt_hw_interrupt_disable();
+        rt_list_for_each(node, &info->object_list)
+        {
+            if (count == total)
+                break;
+
+            object = rt_list_entry(node, struct rt_object, list);
+            entry = (struct rt_ktrace_name *)(table + count * _KTRACE_NAME_SIZE);
+            entry->object = _ktrace_id(object);
+            entry->type = _ktrace_name_class[index];
+            entry->reserved[0] = entry->reserved[1] = entry->reserved[2] = 0;
+            rt_strncpy((char *)(entry + 1), object->name, RT_NAME_MAX);
+            count ++;
+        }
+        rt_hw_interrupt_enable(level);
+    }
+#endif /* RT_USING_HEAP */
+
+    *number = count;
+
+    return table;
+}
+
+/**
+ * @brief Dump all records through an output function. Tracing is paused while dumping.
+ *
+ * @param output is the function to write a piece of the dump, it returns the size written.
+ * @param parameter is the parameter of the output function.
+ *
+ * @return Return RT_EOK on success, -RT_EIO when the output function fails.
+ */
+rt_err_t rt_ktrace_dump(rt_ssize_t (*output)(void *parameter, const void *buffer, rt_size_t size), void *parameter)
+{
+    struct rt_ktrace_header header;
+    struct rt_ktrace_section section;
+    struct _ktrace_buffer *buf;
+    rt_uint8_t *names;
+    rt_uint32_t number, index, first;
+    rt_bool_t enable;
+    rt_err_t result = RT_EOK;
+    int cpu;
+
+    RT_ASSERT(output != RT_NULL);
+
+    enable = _ktrace_enable;
+    _ktrace_enable = RT_FALSE;
+
+    names = _ktrace_name_table(&number);
+
+    rt_memcpy(header.magic, KTRACE_MAGIC, sizeof(header.magic));
+    header.version = KTRACE_VERSION;
+    header.record_size = sizeof(struct rt_ktrace_record);
+    header.frequency = rt_ktrace_timestamp_frequency();
+    header.cpus = _CPUS_NR;
+    header.name_max = RT_NAME_MAX;
+    header.names = number;
+
+    if (output(parameter, &header, sizeof(header)) != sizeof(header) ||
+        (number && output(parameter, names, number * _KTRACE_NAME_SIZE) != number * _KTRACE_NAME_SIZE))
+    {
+        result = -RT_EIO;
+        goto _exit;
+    }
+
+    for (cpu = 0; cpu < _CPUS_NR; cpu++)
+    {
+        buf = &_ktrace_buf[cpu];
+
+        section.cpu = cpu;
+        section.reserved = 0;
+        section.count = buf->count;
+        section.lost = buf->lost;
+        if (output(parameter, &section, sizeof(section)) != sizeof(section))
+        {
+            result = -RT_EIO;
+            goto _exit;
+        }
+
+        /* the oldest record is at head once the buffer has wrapped */
+        first = (buf->count < KTRACE_RECORD_NUM) ? 0 : buf->head;
+        for (index = 0; index < buf->count; )
+        {
+            rt_uint32_t start = (first + index) % KTRACE_RECORD_NUM;
+            rt_uint32_t length = buf->count - index;
+            rt_size_t size;
+
+            if (length > KTRACE_RECORD_NUM - start)
+                length = KTRACE_RECORD_NUM - start;
+
+            size = length * sizeof(struct rt_ktrace_record);
+            if (output(parameter, &buf->record[start], size) != size)
+            {
+                result = -RT_EIO;
+                goto _exit;
+            }
+            index += length;
+        }
+    }
+
+_exit:
+#ifdef RT_USING_HEAP
+    if (names)
+        rt_free(names);
+#endif
+    _ktrace_enable = enable;
+
+    return result;
+}
+RTM_EXPORT(rt_ktrace_dump);
+
+static rt_ssize_t _ktrace_device_output(void *parameter, const void *buffer, rt_size_t size)
+{
+    return rt_device_write((rt_device_t)parameter, 0, buffer, size);
+}
+
+/**
+ * @brief Dump all records into a device, such as a spare serial port.
+ *
+ * @param name is the name of the device.
+ *
+ * @return Return RT_EOK on success, other values on failure.
+ */
+rt_err_t rt_ktrace_dump_device(const char *name)
+{
+    rt_device_t device;
+    rt_err_t result;
+
+    device = rt_device_find(name);
+    if (device == RT_NULL)
+        return -RT_ENOSYS;
+
+    result = rt_device_open(device, RT_DEVICE_OFLAG_WRONLY);
+    if (result != RT_EOK)
+        return result;
+
+    result = rt_ktrace_dump(_ktrace_device_output, device);
+    rt_device_close(device);
+
+    return result;
+}
+RTM_EXPORT(rt_ktrace_dump_device);
+
+#ifdef RT_USING_DFS
+static rt_ssize_t _ktrace_file_output(void *parameter, const void *buffer, rt_size_t size)
+{
+    return write((int)(rt_ubase_t)parameter, buffer, size);
+}
+
+/**
+ * @brief Dump all records into a file.
+ *
+ * @param path is the path of the file, it is truncated when it exists.
+ *
+ * @return Return RT_EOK on success, other values on failure.
+ */
+rt_err_t rt_ktrace_dump_file(const char *path)
+{
+    rt_err_t result;
+    int fd;
+
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC);
+    if (fd < 0)
+        return -RT_EIO;
+
+    result = rt_ktrace_dump(_ktrace_file_output, (void *)(rt_ubase_t)fd);
+    close(fd);
+
+    return result;
+}
+RTM_EXPORT(rt_ktrace_dump_file);
+#endif /* RT_USING_DFS */
+
+#ifdef RT_USING_FINSH
+static void _ktrace_usage(void)
+{
+    rt_kprintf("Usage:\n");
+    rt_kprintf("ktrace start              - start tracing\n");
+    rt_kprintf("ktrace stop               - stop tracing\n");
+    rt_kprintf("ktrace clear              - drop all records\n");
+    rt_kprintf("ktrace info               - show record count of each cpu\n");
+    rt_kprintf("ktrace device <name>      - dump records into a device\n");
+#ifdef RT_USING_DFS
+    rt_kprintf("ktrace file <path>        - dump records into a file\n");
+#endif
+}
+
+static int ktrace(int argc, char **argv)
+{
+    rt_err_t result = RT_EOK;
+
+    if (argc < 2)
+    {
+        _ktrace_usage();
+        return 0;
+    }
+
+    if (!rt_strcmp(argv[1], "start"))
+    {
+        rt_ktrace_start();
+    }
+    else if (!rt_strcmp(argv[1], "stop"))
+    {
+        rt_ktrace_stop();
+    }
+    else if (!rt_strcmp(argv[1], "clear"))
+    {
+        rt_ktrace_clear();
+    }
+    else if (!rt_strcmp(argv[1], "info"))
+    {
+        int cpu;
+
+        rt_kprintf("state: %s, frequency: %d Hz\n", _ktrace_enable ? "tracing" : "stopped",
+                   rt_ktrace_timestamp_frequency());
+        for (cpu = 0; cpu < _CPUS_NR; cpu++)
+        {
+            rt_kprintf("cpu%d: %d/%d records, %d lost\n", cpu, _ktrace_buf[cpu].count,
+                       KTRACE_RECORD_NUM, _ktrace_buf[cpu].lost);
+        }
+    }
+    else if (!rt_strcmp(argv[1], "device") && argc == 3)
+    {
+        result = rt_ktrace_dump_device(argv[2]);
+    }
+#ifdef RT_USING_DFS
+    else if (!rt_strcmp(argv[1], "file") && argc == 3)
+    {
+        result = rt_ktrace_dump_file(argv[2]);
+    }
+#endif
+    else
+    {
+        _ktrace_usage();
+    }
+
+    if (result != RT_EOK)
+    {
+        LOG_E("dump failed: %d", result);
+    }
+
+    return result;
+}
+MSH_CMD_EXPORT(ktrace, kernel event tracer);
+#endif /* RT_USING_FINSH */
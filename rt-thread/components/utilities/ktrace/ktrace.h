@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#ifndef __KTRACE_H__
+#define __KTRACE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KTRACE_MAGIC                "KTRC"
+#define KTRACE_VERSION              1
+
+/* event type of a trace record */
+enum rt_ktrace_event
+{
+    KTRACE_EVENT_NAME = 0,                  /**< arg0: offset of name, arg1: object, arg2: 4 bytes of name */
+    KTRACE_EVENT_SWITCH,                    /**< arg0: from/to priority, arg1: from thread, arg2: to thread */
+    KTRACE_EVENT_IRQ_ENTER,                 /**< arg0: interrupt nest */
+    KTRACE_EVENT_IRQ_LEAVE,                 /**< arg0: interrupt nest */
+    KTRACE_EVENT_TIMER_ENTER,               /**< arg1: timer */
+    KTRACE_EVENT_TIMER_EXIT,                /**< arg1: timer */
+    KTRACE_EVENT_OBJECT_TRYTAKE,            /**< arg0: object type, arg1: object, arg2: thread */
+    KTRACE_EVENT_OBJECT_TAKE,               /**< arg0: object type, arg1: object, arg2: thread */
+    KTRACE_EVENT_OBJECT_PUT,                /**< arg0: object type, arg1: object, arg2: thread */
+    KTRACE_EVENT_MALLOC,                    /**< arg1: pointer, arg2: size */
+    KTRACE_EVENT_FREE,                      /**< arg1: pointer */
+    KTRACE_EVENT_USER = 0x100,              /**< first event type for application defined events */
+};
+
+/* one trace record, 16 bytes */
+struct rt_ktrace_record
+{
+    rt_uint32_t timestamp;
+    rt_uint16_t type;
+    rt_uint16_t arg0;
+    rt_uint32_t arg1;
+    rt_uint32_t arg2;
+};
+
+/* head of a dump, followed by the name table and one section for each cpu */
+struct rt_ktrace_header
+{
+    char        magic[4];                   /**< "KTRC" */
+    rt_uint16_t version;
+    rt_uint16_t record_size;                /**< sizeof(struct rt_ktrace_record) */
+    rt_uint32_t frequency;                  /**< timestamp counts per second */
+    rt_uint16_t cpus;                       /**< number of cpu sections */
+    rt_uint16_t name_max;                   /**< RT_NAME_MAX */
+    rt_uint32_t names;                      /**< number of name table entries */
+};
+
+/* entry of the name table, which is followed by name_max bytes of name */
+struct rt_ktrace_name
+{
+    rt_uint32_t object;
+    rt_uint8_t  type;
+    rt_uint8_t  reserved[3];
+};
+
+/* head of a cpu section, followed by count records from the oldest one */
+struct rt_ktrace_section
+{
+    rt_uint16_t cpu;
+    rt_uint16_t reserved;
+    rt_uint32_t count;
+    rt_uint32_t lost;                       /**< records overwritten since the last clear */
+};
+
+void rt_ktrace_start(void);
+void rt_ktrace_stop(void);
+void rt_ktrace_clear(void);
+void rt_ktrace_event(rt_uint16_t type, rt_uint16_t arg0, rt_uint32_t arg1, rt_uint32_t arg2);
+
+rt_err_t rt_ktrace_dump(rt_ssize_t (*output)(void *parameter, const void *buffer, rt_size_t size), void *parameter);
+rt_err_t rt_ktrace_dump_device(const char *name);
+#ifdef RT_USING_DFS
+rt_err_t rt_ktrace_dump_file(const char *path);
+#endif
+
+/* the timestamp source, which can be replaced by the BSP */
+rt_uint32_t rt_ktrace_timestamp(void);
+rt_uint32_t rt_ktrace_timestamp_frequency(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __KTRACE_H__ */
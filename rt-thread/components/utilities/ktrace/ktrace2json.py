@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2022, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-16     RT-Thread    the first version
+#
+# Convert a ktrace dump into the Chrome trace event JSON format, which can be
+# opened by chrome://tracing or https://ui.perfetto.dev
+#
+# usage: ktrace2json.py [--endian little|big] dump.bin [trace.json]
+#
+
+import argparse
+import json
+import struct
+import sys
+
+EVENT_NAME = 0
+EVENT_SWITCH = 1
+EVENT_IRQ_ENTER = 2
+EVENT_IRQ_LEAVE = 3
+EVENT_TIMER_ENTER = 4
+EVENT_TIMER_EXIT = 5
+EVENT_OBJECT_TRYTAKE = 6
+EVENT_OBJECT_TAKE = 7
+EVENT_OBJECT_PUT = 8
+EVENT_MALLOC = 9
+EVENT_FREE = 10
+EVENT_USER = 0x100
+
+OBJECT_EVENTS = {
+    EVENT_OBJECT_TRYTAKE: 'trytake',
+    EVENT_OBJECT_TAKE: 'take',
+    EVENT_OBJECT_PUT: 'put',
+}
+
+# enum rt_object_class_type
+OBJECT_CLASS = {
+    0x01: 'thread', 0x02: 'semaphore', 0x03: 'mutex', 0x04: 'event',
+    0x05: 'mailbox', 0x06: 'messagequeue', 0x07: 'mempool', 0x08: 'device',
+    0x09: 'timer', 0x0a: 'module', 0x0b: 'memory', 0x0c: 'channel',
+    0x0d: 'custom',
+}
+
+# the tracks of interrupts, timers and heap use thread ids which never
+# collide with an object address
+TID_IRQ = 1
+TID_TIMER = 2
+TID_HEAP = 3
+
+
+class Dump(object):
+    def __init__(self, data, endian):
+        self.data = data
+        self.offset = 0
+        self.endian = '<' if endian == 'little' else '>'
+
+    def read(self, fmt):
+        fmt = self.endian + fmt
+        size = struct.calcsize(fmt)
+        if self.offset + size > len(self.data):
+            raise ValueError('truncated dump at offset %d' % self.offset)
+        value = struct.unpack_from(fmt, self.data, self.offset)
+        self.offset += size
+        return value
+
+    def read_bytes(self, size):
+        if self.offset + size > len(self.data):
+            raise ValueError('truncated dump at offset %d' % self.offset)
+        value = self.data[self.offset:self.offset + size]
+        self.offset += size
+        return value
+
+
+class Converter(object):
+    def __init__(self, frequency):
+        self.frequency = frequency
+        self.names = {}
+        self.pending_names = {}
+        self.events = []
+        self.heap = {}
+        self.heap_used = 0
+
+    def name(self, obj):
+        if obj == 0:
+            return 'null'
+        return self.names.get(obj, '0x%08x' % obj)
+
+    def add_name_word(self, obj, offset, word, endian):
+        chars = self.pending_names.setdefault(obj, {})
+        chars[offset] = struct.pack(endian + 'I', word)
+        text = b''.join(chars[k] for k in sorted(chars))
+        self.names[obj] = text.split(b'\0')[0].decode('ascii', 'replace')
+
+    def time(self, ts):
+        return ts * 1000000.0 / self.frequency
+
+    def emit(self, **kw):
+        self.events.append(kw)
+
+    def convert(self, cpu, records, endian):
+        pid = cpu
+        current = None
+        last = None
+        high = 0
+
+        for ts, type, arg0, arg1, arg2 in records:
+            # unwrap the 32 bit timestamp
+            if last is not None and ts < last:
+                high += 1 << 32
+            last = ts
+            us = self.time(high + ts)
+
+            if type == EVENT_NAME:
+                self.add_name_word(arg1, arg0, arg2, endian)
+            elif type == EVENT_SWITCH:
+                if current is not None:
+                    self.emit(name=self.name(current), ph='E', ts=us, pid=pid, tid=current)
+                current = arg2
+                self.emit(name=self.name(arg2), ph='B', ts=us, pid=pid, tid=arg2,
+                          args={'priority': arg0 & 0xff, 'from': self.name(arg1),
+                                'from priority': arg0 >> 8})
+            elif type == EVENT_IRQ_ENTER:
+                self.emit(name='irq', ph='B', ts=us, pid=pid, tid=TID_IRQ, args={'nest': arg0})
+            elif type == EVENT_IRQ_LEAVE:
+                self.emit(name='irq', ph='E', ts=us, pid=pid, tid=TID_IRQ)
+            elif type == EVENT_TIMER_ENTER:
+                self.emit(name=self.name(arg1), ph='B', ts=us, pid=pid, tid=TID_TIMER)
+            elif type == EVENT_TIMER_EXIT:
+                self.emit(name=self.name(arg1), ph='E', ts=us, pid=pid, tid=TID_TIMER)
+            elif type in OBJECT_EVENTS:
+                self.emit(name='%s %s' % (OBJECT_EVENTS[type], self.name(arg1)), ph='i', s='t',
+                          ts=us, pid=pid, tid=arg2,
+                          args={'class': OBJECT_CLASS.get(arg0, arg0), 'object': '0x%08x' % arg1})
+            elif type == EVENT_MALLOC:
+                self.heap[arg1] = arg2
+                self.heap_used += arg2
+                self.emit(name='heap', ph='C', ts=us, pid=pid, tid=TID_HEAP,
+                          args={'used': self.heap_used})
+            elif type == EVENT_FREE:
+                self.heap_used -= self.heap.pop(arg1, 0)
+                self.emit(name='heap', ph='C', ts=us, pid=pid, tid=TID_HEAP,
+                          args={'used': self.heap_used})
+            else:
+                self.emit(name='user %d' % (type - EVENT_USER), ph='i', s='t', ts=us, pid=pid,
+                          tid=current or 0,
+                          args={'arg0': arg0, 'arg1': arg1, 'arg2': arg2})
+
+        # close the running thread at the end of the trace
+        if current is not None and last is not None:
+            self.emit(name=self.name(current), ph='E', ts=self.time(high + last), pid=pid, tid=current)
+
+    def metadata(self, cpus):
+        tids = set(e['tid'] for e in self.events)
+        for cpu in range(cpus):
+            self.emit(name='process_name', ph='M', pid=cpu, args={'name': 'cpu%d' % cpu})
+            for tid in tids:
+                name = {TID_IRQ: 'interrupt', TID_TIMER: 'timer', TID_HEAP: 'heap'}.get(tid)
+                self.emit(name='thread_name', ph='M', pid=cpu, tid=tid,
+                          args={'name': name or self.name(tid)})
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a ktrace dump into Chrome trace JSON')
+    parser.add_argument('--endian', choices=['little', 'big'], default='little')
+    parser.add_argument('input')
+    parser.add_argument('output', nargs='?')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        dump = Dump(f.read(), args.endian)
+
+    magic = dump.read_bytes(4)
+    if magic != b'KTRC':
+        sys.exit('%s: not a ktrace dump' % args.input)
+    version, record_size, frequency, cpus, name_max, names = dump.read('HHIHHI')
+    if version != 1 or record_size != 16:
+        sys.exit('%s: unsupported version %d or record size %d' % (args.input, version, record_size))
+
+    conv = Converter(frequency or 1)
+    for i in range(names):
+        obj, _ = dump.read('IB3x')
+        conv.names[obj] = dump.read_bytes(name_max).split(b'\0')[0].decode('ascii', 'replace')
+
+    for i in range(cpus):
+        cpu, count, lost = dump.read('H2xII')
+        if lost:
+            sys.stderr.write('cpu%d: %d records lost\n' % (cpu, lost))
+        records = [dump.read('IHHII') for n in range(count)]
+        conv.convert(cpu, records, dump.endian)
+
+    conv.metadata(cpus)
+
+    out = open(args.output, 'w') if args.output else sys.stdout
+    json.dump({'traceEvents': conv.events, 'displayTimeUnit': 'ns'}, out)
+    if args.output:
+        out.close()
+
+
+if __name__ == '__main__':
+    main()
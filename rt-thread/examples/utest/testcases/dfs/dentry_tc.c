@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <cputime.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "utest.h"
+
+/*
+ * The cache of the path lookups must follow the files created, written and
+ * removed, and the directories which hold them. The time of a stat() found in
+ * the cache is reported against one which misses it, on twice as many files
+ * as the cache holds, and the time of an open() of a missing file against the
+ * one of an existing file. The files are created in UTEST_DFS_DENTRY_TC_DIR,
+ * which must be on a writable file system with the cache, elm or ram.
+ */
+
+#ifndef DFS_DENTRY_CACHE_SIZE
+#define DFS_DENTRY_CACHE_SIZE   16
+#endif
+
+#define DENTRY_TC_FILES         (DFS_DENTRY_CACHE_SIZE * 2)
+#define DENTRY_BENCH_LOOPS      256
+#define DENTRY_TC_PATH_MAX      64
+
+static char _dir[DENTRY_TC_PATH_MAX];
+static char _path[DENTRY_TC_PATH_MAX];
+
+static const char *dentry_tc_path(const char *name)
+{
+    rt_snprintf(_path, sizeof(_path), "%s/%s", _dir, name);
+    return _path;
+}
+
+static void dentry_tc_write(const char *name, int flags, int len)
+{
+    int fd;
+
+    fd = open(dentry_tc_path(name), O_WRONLY | O_CREAT | flags, 0);
+    uassert_true(fd >= 0);
+    uassert_int_equal(write(fd, "0123456789abcdef", len), len);
+    close(fd);
+}
+
+static void test_dentry_file(void)
+{
+    struct stat st;
+
+    /* the missing file is cached */
+    uassert_int_equal(stat(dentry_tc_path("f"), &st), -1);
+    uassert_int_equal(stat(dentry_tc_path("f"), &st), -1);
+    uassert_int_equal(open(dentry_tc_path("f"), O_RDONLY, 0), -1);
+    uassert_int_equal(access(dentry_tc_path("f"), F_OK), -1);
+
+    /* created */
+    dentry_tc_write("f", O_TRUNC, 10);
+    uassert_int_equal(stat(dentry_tc_path("f"), &st), 0);
+    uassert_int_equal(st.st_size, 10);
+    uassert_int_equal(access(dentry_tc_path("f"), F_OK), 0);
+
+    /* written */
+    dentry_tc_write("f", O_APPEND, 6);
+    uassert_int_equal(stat(dentry_tc_path("f"), &st), 0);
+    uassert_int_equal(st.st_size, 16);
+
+    /* removed */
+    uassert_int_equal(unlink(dentry_tc_path("f")), 0);
+    uassert_int_equal(stat(dentry_tc_path("f"), &st), -1);
+    uassert_int_equal(open(dentry_tc_path("f"), O_RDONLY, 0), -1);
+}
+
+static void test_dentry_dir(void)
+{
+    struct stat st;
+
+    /* the directory and a file in it, cached as missing */
+    uassert_int_equal(stat(dentry_tc_path("d"), &st), -1);
+    uassert_int_equal(stat(dentry_tc_path("d/f"), &st), -1);
+
+    uassert_int_equal(mkdir(dentry_tc_path("d"), 0), 0);
+    uassert_int_equal(stat(dentry_tc_path("d"), &st), 0);
+    uassert_true(S_ISDIR(st.st_mode));
+
+    dentry_tc_write("d/f", O_TRUNC, 4);
+    uassert_int_equal(stat(dentry_tc_path("d/f"), &st), 0);
+    uassert_int_equal(st.st_size, 4);
+    /* the directory is asked again after the file is created in it */
+    uassert_int_equal(stat(dentry_tc_path("d"), &st), 0);
+    uassert_true(S_ISDIR(st.st_mode));
+
+    uassert_int_equal(unlink(dentry_tc_path("d/f")), 0);
+    uassert_int_equal(stat(dentry_tc_path("d/f"), &st), -1);
+    uassert_int_equal(unlink(dentry_tc_path("d")), 0);
+    uassert_int_equal(stat(dentry_tc_path("d"), &st), -1);
+}
+
+/* stat() the files from the first one, the count of them in turn */
+static rt_uint64_t dentry_bench_stat(int count)
+{
+    struct stat st;
+    rt_uint64_t start;
+    char name[8];
+    int loop, errors = 0;
+
+    start = clock_cpu_gettime();
+    for (loop = 0; loop < DENTRY_BENCH_LOOPS; loop++)
+    {
+        rt_snprintf(name, sizeof(name), "b%d", loop % count);
+        if (stat(dentry_tc_path(name), &st) != 0)
+            errors++;
+    }
+    start = clock_cpu_gettime() - start;
+    uassert_int_equal(errors, 0);
+
+    return start / DENTRY_BENCH_LOOPS;
+}
+
+static rt_uint64_t dentry_bench_open(const char *name, rt_bool_t exist)
+{
+    rt_uint64_t start;
+    int loop, fd, errors = 0;
+
+    dentry_tc_path(name);
+    start = clock_cpu_gettime();
+    for (loop = 0; loop < DENTRY_BENCH_LOOPS; loop++)
+    {
+        fd = open(_path, O_RDONLY, 0);
+        if ((fd >= 0) != exist)
+            errors++;
+        if (fd >= 0)
+            close(fd);
+    }
+    start = clock_cpu_gettime() - start;
+    uassert_int_equal(errors, 0);
+
+    return start / DENTRY_BENCH_LOOPS;
+}
+
+static void test_dentry_bench(void)
+{
+    char name[8];
+    int index;
+
+    for (index = 0; index < DENTRY_TC_FILES; index++)
+    {
+        rt_snprintf(name, sizeof(name), "b%d", index);
+        dentry_tc_write(name, O_TRUNC, 1);
+    }
+
+    LOG_I("stat: cached %d ns, %d files in turn %d ns",
+          clock_cpu_microsecond((uint32_t)(dentry_bench_stat(1) * 1000)), DENTRY_TC_FILES,
+          clock_cpu_microsecond((uint32_t)(dentry_bench_stat(DENTRY_TC_FILES) * 1000)));
+    LOG_I("open: missing file %d ns, existing file %d ns",
+          clock_cpu_microsecond((uint32_t)(dentry_bench_open("none", RT_FALSE) * 1000)),
+          clock_cpu_microsecond((uint32_t)(dentry_bench_open("b0", RT_TRUE) * 1000)));
+
+    for (index = 0; index < DENTRY_TC_FILES; index++)
+    {
+        rt_snprintf(name, sizeof(name), "b%d", index);
+        unlink(dentry_tc_path(name));
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_snprintf(_dir, sizeof(_dir), "%s/dentry_tc", UTEST_DFS_DENTRY_TC_DIR);
+
+    return mkdir(_dir, 0) == 0 ? RT_EOK : -RT_ERROR;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    unlink(dentry_tc_path("d/f"));
+    unlink(dentry_tc_path("d"));
+    unlink(dentry_tc_path("f"));
+    unlink(_dir);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_dentry_file);
+    UTEST_UNIT_RUN(test_dentry_dir);
+    UTEST_UNIT_RUN(test_dentry_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.dfs.dentry_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <cputime.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <dfs_fs.h>
+#include <dfs_ramfs.h>
+#include "utest.h"
+
+/*
+ * A ram file system of its own is mounted on UTEST_DFS_RAMFS_TC_DIR/ramfs_tc
+ * and a log is written to it as a logger does: short lines of different
+ * lengths appended one by one, the file opened again now and then, and
+ * rotated to a second file when it grows too large. The log must read back
+ * line by line, and the memory of the file system must all be free again
+ * once the files are removed. The time of an append is reported at the start
+ * and at the end of a large log, it must not grow with the file.
+ */
+
+#define RAMFS_TC_POOL_SIZE      (32 * 1024)
+#define RAMFS_TC_LINES          1024
+#define RAMFS_TC_REOPEN         64
+#define RAMFS_TC_ROTATE         4096
+#define RAMFS_TC_LINE_MAX       48
+#define RAMFS_TC_PATH_MAX       64
+/* the log fills about 40% of the file system */
+#define RAMFS_BENCH_LINES       512
+
+static rt_uint8_t *_pool;
+static rt_bool_t _mounted;
+static char _dir[RAMFS_TC_PATH_MAX];
+static char _log[RAMFS_TC_PATH_MAX];
+static char _old[RAMFS_TC_PATH_MAX];
+
+/* the lines are of 12 to 39 bytes, so that they cross the chunks anywhere */
+static int ramfs_tc_line(char *buf, int index)
+{
+    static const char fill[] = "abcdefghijklmnopqrstuvwxyz012345";
+
+    return rt_snprintf(buf, RAMFS_TC_LINE_MAX, "%05d %.*s\n", index, (index * 7) % 28 + 5, fill);
+}
+
+static rt_uint32_t ramfs_tc_free(void)
+{
+    struct statfs buf;
+
+    if (statfs(_dir, &buf) != 0)
+        return 0;
+
+    return buf.f_bfree;
+}
+
+/* the lines of [first, last) must be in the file, in order */
+static int ramfs_tc_verify(const char *path, int first, int last)
+{
+    char expect[RAMFS_TC_LINE_MAX], buf[RAMFS_TC_LINE_MAX];
+    int fd, index, len, errors = 0;
+
+    fd = open(path, O_RDONLY, 0);
+    if (fd < 0)
+        return -1;
+
+    for (index = first; index < last; index++)
+    {
+        len = ramfs_tc_line(expect, index);
+        if (read(fd, buf, len) != len || rt_memcmp(buf, expect, len) != 0)
+            errors++;
+    }
+    /* and nothing after them */
+    if (read(fd, buf, 1) != 0)
+        errors++;
+    close(fd);
+
+    return errors;
+}
+
+static void test_ramfs_log_append(void)
+{
+    char line[RAMFS_TC_LINE_MAX];
+    struct stat st;
+    rt_size_t size = 0;
+    int fd = -1, index, len, errors = 0;
+
+    for (index = 0; index < RAMFS_TC_LINES; index++)
+    {
+        if (index % RAMFS_TC_REOPEN == 0)
+        {
+            if (fd >= 0)
+                close(fd);
+            fd = open(_log, O_WRONLY | O_CREAT | O_APPEND, 0);
+            uassert_true(fd >= 0);
+        }
+
+        len = ramfs_tc_line(line, index);
+        if (write(fd, line, len) != len)
+            errors++;
+        size += len;
+    }
+    close(fd);
+    uassert_int_equal(errors, 0);
+
+    uassert_int_equal(stat(_log, &st), 0);
+    uassert_int_equal(st.st_size, size);
+    uassert_int_equal(ramfs_tc_verify(_log, 0, RAMFS_TC_LINES), 0);
+
+    uassert_int_equal(unlink(_log), 0);
+}
+
+static void test_ramfs_log_rotate(void)
+{
+    char line[RAMFS_TC_LINE_MAX];
+    rt_uint32_t bfree;
+    rt_size_t size = 0;
+    int fd, index, len, first = 0, old = -1, errors = 0;
+
+    bfree = ramfs_tc_free();
+    uassert_true(bfree > 0);
+
+    fd = open(_log, O_WRONLY | O_CREAT | O_APPEND, 0);
+    uassert_true(fd >= 0);
+    for (index = 0; index < RAMFS_TC_LINES; index++)
+    {
+        len = ramfs_tc_line(line, index);
+        if (size + len > RAMFS_TC_ROTATE)
+        {
+            close(fd);
+            unlink(_old);
+            uassert_int_equal(rename(_log, _old), 0);
+            old = first;
+            first = index;
+            size = 0;
+
+            fd = open(_log, O_WRONLY | O_CREAT | O_APPEND, 0);
+            uassert_true(fd >= 0);
+        }
+
+        if (write(fd, line, len) != len)
+            errors++;
+        size += len;
+    }
+    close(fd);
+    uassert_int_equal(errors, 0);
+
+    /* the last two parts of the log are kept */
+    uassert_true(old >= 0);
+    uassert_int_equal(ramfs_tc_verify(_old, old, first), 0);
+    uassert_int_equal(ramfs_tc_verify(_log, first, RAMFS_TC_LINES), 0);
+
+    uassert_int_equal(unlink(_old), 0);
+    uassert_int_equal(unlink(_log), 0);
+    uassert_int_equal(ramfs_tc_free(), bfree);
+}
+
+/* the time of an append of each line of [first, last) */
+static rt_uint64_t ramfs_bench_append(int fd, int first, int last)
+{
+    char line[RAMFS_TC_LINE_MAX];
+    rt_uint64_t start, total = 0;
+    int index, len, errors = 0;
+
+    for (index = first; index < last; index++)
+    {
+        len = ramfs_tc_line(line, index);
+        start = clock_cpu_gettime();
+        if (write(fd, line, len) != len)
+            errors++;
+        total += clock_cpu_gettime() - start;
+    }
+    uassert_int_equal(errors, 0);
+
+    return total / (last - first);
+}
+
+static void test_ramfs_log_bench(void)
+{
+    rt_uint64_t head, tail;
+    int fd, lines = RAMFS_BENCH_LINES;
+
+    fd = open(_log, O_WRONLY | O_CREAT | O_APPEND, 0);
+    uassert_true(fd >= 0);
+    head = ramfs_bench_append(fd, 0, lines / 4);
+    ramfs_bench_append(fd, lines / 4, lines - lines / 4);
+    tail = ramfs_bench_append(fd, lines - lines / 4, lines);
+    close(fd);
+
+    LOG_I("append of %d lines: %d ns per line at the start, %d ns at the end", lines,
+          clock_cpu_microsecond((uint32_t)(head * 1000)), clock_cpu_microsecond((uint32_t)(tail * 1000)));
+    uassert_int_equal(ramfs_tc_verify(_log, 0, lines), 0);
+
+    unlink(_log);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    struct dfs_ramfs *ramfs;
+
+    rt_snprintf(_dir, sizeof(_dir), "%s/ramfs_tc", UTEST_DFS_RAMFS_TC_DIR);
+    rt_snprintf(_log, sizeof(_log), "%s/log", _dir);
+    rt_snprintf(_old, sizeof(_old), "%s/log.1", _dir);
+
+    _pool = (rt_uint8_t *)rt_malloc(RAMFS_TC_POOL_SIZE);
+    if (_pool == RT_NULL)
+        return -RT_ENOMEM;
+
+    ramfs = dfs_ramfs_create(_pool, RAMFS_TC_POOL_SIZE);
+    if (ramfs == RT_NULL || mkdir(_dir, 0) != 0)
+        return -RT_ERROR;
+    if (dfs_mount(RT_NULL, _dir, "ram", 0, ramfs) != 0)
+        return -RT_ERROR;
+    _mounted = RT_TRUE;
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    if (_mounted)
+    {
+        unlink(_log);
+        unlink(_old);
+        dfs_unmount(_dir);
+        _mounted = RT_FALSE;
+    }
+    unlink(_dir);
+
+    rt_free(_pool);
+    _pool = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_ramfs_log_append);
+    UTEST_UNIT_RUN(test_ramfs_log_rotate);
+    UTEST_UNIT_RUN(test_ramfs_log_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.dfs.ramfs_log_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "utest.h"
+
+/*
+ * A cache device runs on a block device in RAM, whose writes can be made to
+ * fail. The written sectors must reach the RAM device on a sync, a delayed
+ * write back which fails must be tried again, an erase must drop the dirty
+ * sectors in its range, and the cache device must be unregistered only when
+ * it is closed, with its dirty sectors written back.
+ */
+
+#ifndef RT_BLK_CACHE_WRITE_DELAY
+#define RT_BLK_CACHE_WRITE_DELAY    1000
+#endif
+
+#define BC_TC_RAM           "utram"
+#define BC_TC_CACHE         "utbc"
+#define BC_TC_SECTOR_SIZE   128
+#define BC_TC_SECTORS       64
+
+static struct rt_device _ram;
+static rt_uint8_t _ram_data[BC_TC_SECTORS * BC_TC_SECTOR_SIZE];
+static rt_bool_t _ram_fail;
+static rt_uint32_t _ram_writes;
+static rt_device_t _cache;
+static rt_uint8_t _buf[4 * BC_TC_SECTOR_SIZE];
+
+static rt_size_t ram_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    if (pos + size > BC_TC_SECTORS)
+        return 0;
+
+    rt_memcpy(buffer, _ram_data + pos * BC_TC_SECTOR_SIZE, size * BC_TC_SECTOR_SIZE);
+    return size;
+}
+
+static rt_size_t ram_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    _ram_writes++;
+    if (_ram_fail || pos + size > BC_TC_SECTORS)
+        return 0;
+
+    rt_memcpy(_ram_data + pos * BC_TC_SECTOR_SIZE, buffer, size * BC_TC_SECTOR_SIZE);
+    return size;
+}
+
+static rt_err_t ram_control(rt_device_t dev, int cmd, void *args)
+{
+    struct rt_device_blk_geometry *geometry;
+    rt_uint32_t *addrs;
+
+    if (cmd == RT_DEVICE_CTRL_BLK_GETGEOME)
+    {
+        geometry = (struct rt_device_blk_geometry *)args;
+        geometry->bytes_per_sector = BC_TC_SECTOR_SIZE;
+        geometry->block_size = BC_TC_SECTOR_SIZE;
+        geometry->sector_count = BC_TC_SECTORS;
+    }
+    else if (cmd == RT_DEVICE_CTRL_BLK_ERASE)
+    {
+        addrs = (rt_uint32_t *)args;
+        rt_memset(_ram_data + addrs[0] * BC_TC_SECTOR_SIZE, 0xff,
+                  (addrs[1] - addrs[0] + 1) * BC_TC_SECTOR_SIZE);
+    }
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+static const struct rt_device_ops _ram_ops =
+{
+    RT_NULL,
+    RT_NULL,
+    RT_NULL,
+    ram_read,
+    ram_write,
+    ram_control,
+};
+#endif
+
+static void bc_tc_fill(rt_uint8_t value, rt_size_t count)
+{
+    rt_memset(_buf, value, count * BC_TC_SECTOR_SIZE);
+}
+
+static rt_bool_t bc_tc_ram_equal(rt_uint32_t sector, rt_uint8_t value)
+{
+    rt_uint8_t *data = _ram_data + sector * BC_TC_SECTOR_SIZE;
+    int index;
+
+    for (index = 0; index < BC_TC_SECTOR_SIZE; index++)
+    {
+        if (data[index] != value)
+            return RT_FALSE;
+    }
+
+    return RT_TRUE;
+}
+
+static void test_blk_cache_rw(void)
+{
+    struct rt_blk_cache_stat stat;
+
+    bc_tc_fill(0x11, 4);
+    uassert_int_equal(rt_device_write(_cache, 0, _buf, 4), 4);
+    rt_memset(_buf, 0, sizeof(_buf));
+    uassert_int_equal(rt_device_read(_cache, 0, _buf, 4), 4);
+    uassert_true(_buf[0] == 0x11 && _buf[sizeof(_buf) - 1] == 0x11);
+
+    uassert_int_equal(rt_device_control(_cache, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL), RT_EOK);
+    uassert_true(bc_tc_ram_equal(0, 0x11));
+    uassert_true(bc_tc_ram_equal(3, 0x11));
+
+    uassert_int_equal(rt_blk_cache_get_stat(_cache, &stat), RT_EOK);
+    uassert_true(stat.write_back >= 4);
+}
+
+#if defined(RT_USING_SYSTEM_WORKQUEUE) && (RT_BLK_CACHE_WRITE_DELAY > 0)
+static void test_blk_cache_retry(void)
+{
+    rt_uint32_t writes;
+
+    _ram_fail = RT_TRUE;
+    writes = _ram_writes;
+    bc_tc_fill(0x22, 1);
+    uassert_int_equal(rt_device_write(_cache, 5, _buf, 1), 1);
+
+    /* the delayed write back fails */
+    rt_thread_mdelay(RT_BLK_CACHE_WRITE_DELAY + 100);
+    uassert_true(_ram_writes > writes);
+    uassert_false(bc_tc_ram_equal(5, 0x22));
+
+    /* and is tried again */
+    _ram_fail = RT_FALSE;
+    rt_thread_mdelay(RT_BLK_CACHE_WRITE_DELAY + 100);
+    uassert_true(bc_tc_ram_equal(5, 0x22));
+}
+#endif
+
+static void test_blk_cache_erase(void)
+{
+    rt_uint32_t addrs[2] = {8, 8};
+
+    bc_tc_fill(0x33, 1);
+    uassert_int_equal(rt_device_write(_cache, 8, _buf, 1), 1);
+    uassert_int_equal(rt_device_control(_cache, RT_DEVICE_CTRL_BLK_ERASE, addrs), RT_EOK);
+
+    /* the dirty sector is dropped, not written back over the erased one */
+    uassert_int_equal(rt_device_control(_cache, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL), RT_EOK);
+    uassert_true(bc_tc_ram_equal(8, 0xff));
+    uassert_int_equal(rt_device_read(_cache, 8, _buf, 1), 1);
+    uassert_int_equal(_buf[0], 0xff);
+}
+
+static void test_blk_cache_unregister(void)
+{
+    uassert_int_equal(rt_blk_cache_unregister(BC_TC_RAM), -RT_EINVAL);
+
+    /* still opened */
+    bc_tc_fill(0x44, 1);
+    uassert_int_equal(rt_device_write(_cache, 10, _buf, 1), 1);
+    uassert_int_equal(rt_blk_cache_unregister(BC_TC_CACHE), -RT_EBUSY);
+
+    rt_device_close(_cache);
+    uassert_int_equal(rt_blk_cache_unregister(BC_TC_CACHE), RT_EOK);
+    _cache = RT_NULL;
+    uassert_null(rt_device_find(BC_TC_CACHE));
+    uassert_true(bc_tc_ram_equal(10, 0x44));
+
+    /* the name can be used again */
+    uassert_int_equal(rt_blk_cache_register(BC_TC_CACHE, BC_TC_RAM), RT_EOK);
+    uassert_int_equal(rt_blk_cache_unregister(BC_TC_CACHE), RT_EOK);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_err_t ret;
+
+    rt_memset(_ram_data, 0, sizeof(_ram_data));
+    _ram_fail = RT_FALSE;
+
+    if (rt_device_find(BC_TC_RAM) == RT_NULL)
+    {
+        _ram.type = RT_Device_Class_Block;
+#ifdef RT_USING_DEVICE_OPS
+        _ram.ops = &_ram_ops;
+#else
+        _ram.read = ram_read;
+        _ram.write = ram_write;
+        _ram.control = ram_control;
+#endif
+        ret = rt_device_register(&_ram, BC_TC_RAM, RT_DEVICE_FLAG_RDWR);
+        if (ret != RT_EOK)
+            return ret;
+    }
+
+    ret = rt_blk_cache_register(BC_TC_CACHE, BC_TC_RAM);
+    if (ret != RT_EOK)
+        return ret;
+
+    _cache = rt_device_find(BC_TC_CACHE);
+    return rt_device_open(_cache, RT_DEVICE_OFLAG_RDWR);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    _ram_fail = RT_FALSE;
+    if (_cache)
+    {
+        rt_device_close(_cache);
+        rt_blk_cache_unregister(BC_TC_CACHE);
+        _cache = RT_NULL;
+    }
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_blk_cache_rw);
+#if defined(RT_USING_SYSTEM_WORKQUEUE) && (RT_BLK_CACHE_WRITE_DELAY > 0)
+    UTEST_UNIT_RUN(test_blk_cache_retry);
+#endif
+    UTEST_UNIT_RUN(test_blk_cache_erase);
+    UTEST_UNIT_RUN(test_blk_cache_unregister);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.blk_cache_tc", utest_tc_init, utest_tc_cleanup, 30);
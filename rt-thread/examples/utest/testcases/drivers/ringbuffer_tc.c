@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "utest.h"
+
+/*
+ * Check the zero-copy interface of the ring buffer: the reserved space and
+ * the peeked data stop at the end of the buffer and go on after the wrap,
+ * a commit or a consume of part of them moves the position by that part
+ * only, and both are limited by the space and the data. A producer thread
+ * then moves a byte sequence to the test thread through a small buffer with
+ * chunks of changing sizes and partial commits and consumes, the sequence
+ * must come out whole and in order, across many wraps.
+ */
+
+#define RB_TC_SIZE          16
+#define RB_TC_THREAD_SIZE   64
+#define RB_TC_BYTES         (32 * 1024)
+
+static rt_uint8_t _pool[RB_TC_THREAD_SIZE];
+static struct rt_ringbuffer _rb;
+static struct rt_semaphore _done;
+
+static void test_ringbuffer_wrap(void)
+{
+    rt_uint8_t *ptr;
+    int index;
+
+    rt_ringbuffer_init(&_rb, _pool, RB_TC_SIZE);
+
+    /* a part of the reserved space is committed */
+    uassert_int_equal(rt_ringbuffer_reserve(&_rb, &ptr, 10), 10);
+    uassert_true(ptr == &_pool[0]);
+    for (index = 0; index < 10; index++)
+        ptr[index] = index;
+    uassert_int_equal(rt_ringbuffer_commit(&_rb, 6), 6);
+    uassert_int_equal(rt_ringbuffer_data_len(&_rb), 6);
+
+    /* a part of the peeked data is consumed, the rest stays */
+    uassert_int_equal(rt_ringbuffer_peek_contiguous(&_rb, &ptr), 6);
+    uassert_true(ptr == &_pool[0]);
+    uassert_int_equal(ptr[5], 5);
+    uassert_int_equal(rt_ringbuffer_consume(&_rb, 4), 4);
+    uassert_int_equal(rt_ringbuffer_peek_contiguous(&_rb, &ptr), 2);
+    uassert_int_equal(ptr[0], 4);
+
+    /* the reserved space stops at the end, the next one is after the wrap */
+    uassert_int_equal(rt_ringbuffer_reserve(&_rb, &ptr, RB_TC_SIZE), RB_TC_SIZE - 6);
+    uassert_true(ptr == &_pool[6]);
+    uassert_int_equal(rt_ringbuffer_commit(&_rb, RB_TC_SIZE - 6), RB_TC_SIZE - 6);
+    uassert_int_equal(rt_ringbuffer_reserve(&_rb, &ptr, RB_TC_SIZE), 4);
+    uassert_true(ptr == &_pool[0]);
+    uassert_int_equal(rt_ringbuffer_commit(&_rb, 4), 4);
+
+    /* full */
+    uassert_int_equal(rt_ringbuffer_data_len(&_rb), RB_TC_SIZE);
+    uassert_int_equal(rt_ringbuffer_reserve(&_rb, &ptr, 1), 0);
+    uassert_true(ptr == RT_NULL);
+    uassert_int_equal(rt_ringbuffer_commit(&_rb, 1), 0);
+
+    /* the peeked data stops at the end too */
+    uassert_int_equal(rt_ringbuffer_peek_contiguous(&_rb, &ptr), RB_TC_SIZE - 4);
+    uassert_true(ptr == &_pool[4]);
+    uassert_int_equal(rt_ringbuffer_consume(&_rb, RB_TC_SIZE - 4), RB_TC_SIZE - 4);
+    uassert_int_equal(rt_ringbuffer_peek_contiguous(&_rb, &ptr), 4);
+    uassert_true(ptr == &_pool[0]);
+
+    /* a consume is limited by the data */
+    uassert_int_equal(rt_ringbuffer_consume(&_rb, RB_TC_SIZE), 4);
+    uassert_int_equal(rt_ringbuffer_data_len(&_rb), 0);
+    uassert_int_equal(rt_ringbuffer_peek_contiguous(&_rb, &ptr), 0);
+    uassert_true(ptr == RT_NULL);
+
+    /* the copying calls see the same positions */
+    uassert_int_equal(rt_ringbuffer_put(&_rb, (const rt_uint8_t *)"abcdefgh", 8), 8);
+    uassert_int_equal(rt_ringbuffer_peek_contiguous(&_rb, &ptr), 8);
+    uassert_true(ptr == &_pool[4]);
+    uassert_int_equal(ptr[7], 'h');
+    rt_ringbuffer_consume(&_rb, 8);
+}
+
+/* write the sequence with chunks of 1 to 13 bytes, a third of them half committed */
+static void rb_producer(void *parameter)
+{
+    rt_uint32_t sent = 0, chunk = 0;
+    rt_size_t size, index;
+    rt_uint8_t *ptr;
+
+    while (sent < RB_TC_BYTES)
+    {
+        size = 1 + chunk % 13;
+        if (size > RB_TC_BYTES - sent)
+            size = RB_TC_BYTES - sent;
+
+        size = rt_ringbuffer_reserve(&_rb, &ptr, size);
+        if (size == 0)
+        {
+            rt_thread_yield();
+            continue;
+        }
+
+        for (index = 0; index < size; index++)
+            ptr[index] = (rt_uint8_t)(sent + index);
+        if (chunk % 3 == 0 && size > 1)
+            size /= 2;
+        sent += rt_ringbuffer_commit(&_rb, size);
+        chunk++;
+    }
+    rt_sem_release(&_done);
+}
+
+static void test_ringbuffer_threads(void)
+{
+    rt_uint32_t received = 0, chunk = 0, wraps = 0;
+    rt_size_t size, index;
+    rt_thread_t thread;
+    rt_uint8_t *ptr;
+    int errors = 0;
+
+    rt_ringbuffer_init(&_rb, _pool, RB_TC_THREAD_SIZE);
+    thread = rt_thread_create("rbtc", rb_producer, RT_NULL, 1024, UTEST_THR_PRIORITY, 10);
+    uassert_not_null(thread);
+    rt_thread_startup(thread);
+
+    while (received < RB_TC_BYTES)
+    {
+        size = rt_ringbuffer_peek_contiguous(&_rb, &ptr);
+        if (size == 0)
+        {
+            rt_thread_yield();
+            continue;
+        }
+
+        /* consume a part of the data now and then, the rest is peeked again */
+        if (chunk++ % 4 == 0 && size > 1)
+            size = size * 2 / 3;
+        for (index = 0; index < size; index++)
+        {
+            if (ptr[index] != (rt_uint8_t)(received + index))
+                errors++;
+        }
+        if (ptr + size == &_pool[RB_TC_THREAD_SIZE])
+            wraps++;
+        received += rt_ringbuffer_consume(&_rb, size);
+    }
+
+    uassert_int_equal(rt_sem_take(&_done, rt_tick_from_millisecond(1000)), RT_EOK);
+    uassert_int_equal(errors, 0);
+    uassert_int_equal(rt_ringbuffer_data_len(&_rb), 0);
+    uassert_true(wraps > 0);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return rt_sem_init(&_done, "rbtc", 0, RT_IPC_FLAG_PRIO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_ringbuffer_wrap);
+    UTEST_UNIT_RUN(test_ringbuffer_threads);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.ringbuffer_tc", utest_tc_init, utest_tc_cleanup, 10);
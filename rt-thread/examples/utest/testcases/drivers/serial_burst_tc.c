@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <cputime.h>
+#include "utest.h"
+
+/*
+ * A serial device with a software rx fifo drives rt_hw_serial_isr the way
+ * a uart interrupt does. The byte path (getc) and the burst path (getbuf)
+ * must leave the same data in the rx buffer, including on overflow, and
+ * the isr time of both is reported for a few fifo depths.
+ */
+
+#ifndef RT_SERIAL_RX_INDICATE_THRESHOLD
+#define RT_SERIAL_RX_INDICATE_THRESHOLD     1
+#endif
+
+#define SERIAL_TC_BUFSZ         64
+#define SERIAL_TC_HW_FIFO       256
+#define SERIAL_BENCH_LOOPS      200
+
+static struct rt_serial_device _serial;
+static rt_uint8_t _hw_fifo[SERIAL_TC_HW_FIFO];
+static rt_size_t _hw_len, _hw_pos;
+static rt_size_t _indicated;
+
+static rt_err_t fake_configure(struct rt_serial_device *serial, struct serial_configure *cfg)
+{
+    return RT_EOK;
+}
+
+static rt_err_t fake_control(struct rt_serial_device *serial, int cmd, void *arg)
+{
+    return RT_EOK;
+}
+
+static int fake_putc(struct rt_serial_device *serial, char c)
+{
+    return 1;
+}
+
+static int fake_getc(struct rt_serial_device *serial)
+{
+    if (_hw_pos == _hw_len)
+        return -1;
+    return _hw_fifo[_hw_pos++];
+}
+
+static rt_size_t fake_getbuf(struct rt_serial_device *serial, rt_uint8_t *buf, rt_size_t size)
+{
+    rt_size_t length = _hw_len - _hw_pos;
+
+    if (length > size)
+        length = size;
+    rt_memcpy(buf, &_hw_fifo[_hw_pos], length);
+    _hw_pos += length;
+
+    return length;
+}
+
+static const struct rt_uart_ops _byte_ops =
+{
+    fake_configure,
+    fake_control,
+    fake_putc,
+    fake_getc,
+    RT_NULL,
+    RT_NULL,
+};
+
+static const struct rt_uart_ops _burst_ops =
+{
+    fake_configure,
+    fake_control,
+    fake_putc,
+    fake_getc,
+    RT_NULL,
+    fake_getbuf,
+};
+
+static rt_err_t serial_rx_ind(rt_device_t dev, rt_size_t size)
+{
+    _indicated = size;
+    return RT_EOK;
+}
+
+/* load the hardware fifo with a pattern starting at seed */
+static void serial_hw_feed(rt_size_t length, rt_uint8_t seed)
+{
+    rt_size_t index;
+
+    for (index = 0; index < length; index++)
+        _hw_fifo[index] = (rt_uint8_t)(seed + index);
+    _hw_len = length;
+    _hw_pos = 0;
+}
+
+static void serial_drain(void)
+{
+    rt_uint8_t buf[SERIAL_TC_BUFSZ];
+
+    while (rt_device_read(&_serial.parent, 0, buf, sizeof(buf)) > 0);
+}
+
+static void serial_check(const struct rt_uart_ops *ops)
+{
+    rt_uint8_t buf[SERIAL_TC_BUFSZ];
+    rt_size_t length, index, feed;
+
+    _serial.ops = ops;
+    for (feed = 1; feed <= SERIAL_TC_HW_FIFO; feed += 13)
+    {
+        /* start at a different position of the ring every round */
+        serial_hw_feed(feed % 7, 0);
+        rt_hw_serial_isr(&_serial, RT_SERIAL_EVENT_RX_TIMEOUT);
+        serial_drain();
+
+        _indicated = 0;
+        serial_hw_feed(feed, (rt_uint8_t)feed);
+        rt_hw_serial_isr(&_serial, RT_SERIAL_EVENT_RX_TIMEOUT);
+        uassert_int_equal(_hw_pos, feed);
+
+        /* the latest (bufsz - 1) bytes are kept on overflow */
+        length = rt_device_read(&_serial.parent, 0, buf, sizeof(buf));
+        if (feed < SERIAL_TC_BUFSZ)
+            uassert_int_equal(length, feed);
+        else
+            uassert_int_equal(length, SERIAL_TC_BUFSZ - 1);
+        uassert_int_equal(_indicated, length);
+
+        for (index = 0; index < length; index++)
+        {
+            if (buf[index] != (rt_uint8_t)(feed + feed - length + index))
+                break;
+        }
+        uassert_int_equal(index, length);
+    }
+}
+
+static void test_serial_byte(void)
+{
+    serial_check(&_byte_ops);
+}
+
+static void test_serial_burst(void)
+{
+    serial_check(&_burst_ops);
+}
+
+static void test_serial_threshold(void)
+{
+    _serial.ops = &_burst_ops;
+    serial_drain();
+
+    /* a short burst waits for the threshold or the idle line */
+    _indicated = 0;
+    serial_hw_feed(1, 0);
+    rt_hw_serial_isr(&_serial, RT_SERIAL_EVENT_RX_IND);
+    if (RT_SERIAL_RX_INDICATE_THRESHOLD > 1)
+        uassert_int_equal(_indicated, 0);
+    else
+        uassert_int_equal(_indicated, 1);
+
+    serial_hw_feed(0, 0);
+    rt_hw_serial_isr(&_serial, RT_SERIAL_EVENT_RX_TIMEOUT);
+    uassert_int_equal(_indicated, 1);
+    serial_drain();
+}
+
+static rt_uint64_t serial_isr_bench(const struct rt_uart_ops *ops, rt_size_t feed)
+{
+    rt_uint64_t start, total = 0;
+    int loop;
+
+    _serial.ops = ops;
+    for (loop = 0; loop < SERIAL_BENCH_LOOPS; loop++)
+    {
+        serial_hw_feed(feed, 0);
+        start = clock_cpu_gettime();
+        rt_hw_serial_isr(&_serial, RT_SERIAL_EVENT_RX_IND);
+        total += clock_cpu_gettime() - start;
+        serial_drain();
+    }
+
+    return total / SERIAL_BENCH_LOOPS;
+}
+
+static void test_serial_bench(void)
+{
+    static const rt_size_t feeds[] = {1, 8, 16, 32};
+    int index;
+
+    for (index = 0; index < sizeof(feeds) / sizeof(feeds[0]); index++)
+    {
+        LOG_I("%2d byte fifo: isr getc %d ns, getbuf %d ns", (int)feeds[index],
+              clock_cpu_microsecond((uint32_t)(serial_isr_bench(&_byte_ops, feeds[index]) * 1000)),
+              clock_cpu_microsecond((uint32_t)(serial_isr_bench(&_burst_ops, feeds[index]) * 1000)));
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    struct serial_configure config = RT_SERIAL_CONFIG_DEFAULT;
+    rt_err_t ret;
+
+    config.bufsz = SERIAL_TC_BUFSZ;
+    _serial.ops = &_burst_ops;
+    _serial.config = config;
+
+    ret = rt_hw_serial_register(&_serial, "utsr", RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX, RT_NULL);
+    if (ret != RT_EOK)
+        return ret;
+
+    rt_device_set_rx_indicate(&_serial.parent, serial_rx_ind);
+    return rt_device_open(&_serial.parent, RT_DEVICE_OFLAG_RDWR | RT_DEVICE_FLAG_INT_RX);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_device_close(&_serial.parent);
+    rt_device_unregister(&_serial.parent);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_serial_byte);
+    UTEST_UNIT_RUN(test_serial_burst);
+    UTEST_UNIT_RUN(test_serial_threshold);
+    UTEST_UNIT_RUN(test_serial_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.serial_burst_tc", utest_tc_init, utest_tc_cleanup, 10);
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include "utest.h"
+
+/*
+ * Work items are submitted to both lanes of a pool with fewer workers than
+ * lanes. The urgent items must run before the normal ones, each lane in the
+ * order of submission. With max_active below the number of workers, a normal
+ * item blocked on its worker must not hold back an urgent item, and must hold
+ * back the other normal items. The statistics must count what was run.
+ */
+
+#define WQ_TC_ITEMS         8
+#define WQ_TC_HOLD          20
+
+static struct rt_work _works[WQ_TC_ITEMS];
+static int _order[WQ_TC_ITEMS];
+static int _order_count;
+static struct rt_semaphore _done;
+static struct rt_semaphore _gate;
+
+static void wq_tc_func(struct rt_work *work, void *work_data)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (_order_count < WQ_TC_ITEMS)
+        _order[_order_count++] = (int)(rt_ubase_t)work_data;
+    rt_hw_interrupt_enable(level);
+
+    rt_sem_release(&_done);
+}
+
+/* a normal item which holds its worker until the gate opens */
+static void wq_tc_hold(struct rt_work *work, void *work_data)
+{
+    rt_sem_take(&_gate, RT_WAITING_FOREVER);
+    wq_tc_func(work, work_data);
+}
+
+static void wq_tc_reset(void)
+{
+    int index;
+
+    _order_count = 0;
+    for (index = 0; index < WQ_TC_ITEMS; index++)
+    {
+        _order[index] = -1;
+        rt_work_init(&_works[index], wq_tc_func, (void *)(rt_ubase_t)index);
+    }
+}
+
+static void wq_tc_wait(int count)
+{
+    while (count--)
+    {
+        uassert_int_equal(rt_sem_take(&_done, rt_tick_from_millisecond(1000)), RT_EOK);
+    }
+}
+
+static void test_workqueue_lanes(void)
+{
+    static const int urgent[WQ_TC_ITEMS] = {0, 1, 0, 0, 1, 0, 1, 0};
+    static const int expect[WQ_TC_ITEMS] = {1, 4, 6, 0, 2, 3, 5, 7};
+    struct rt_workqueue_stat stat;
+    struct rt_workqueue *queue;
+    int index;
+
+    /* one worker for two lanes, it runs after the test thread submits all */
+    queue = rt_workqueue_create_pool("wqtc", 1024, UTEST_THR_PRIORITY + 1, 1, 0);
+    uassert_not_null(queue);
+    wq_tc_reset();
+
+    for (index = 0; index < WQ_TC_ITEMS; index++)
+    {
+        if (urgent[index])
+            uassert_int_equal(rt_workqueue_urgent_work(queue, &_works[index]), RT_EOK);
+        else
+            uassert_int_equal(rt_workqueue_dowork(queue, &_works[index]), RT_EOK);
+    }
+    uassert_int_equal(_order_count, 0);
+    wq_tc_wait(WQ_TC_ITEMS);
+    /* the worker counts the last item once it returns */
+    rt_workqueue_cancel_work_sync(queue, &_works[expect[WQ_TC_ITEMS - 1]]);
+
+    for (index = 0; index < WQ_TC_ITEMS; index++)
+    {
+        uassert_int_equal(_order[index], expect[index]);
+    }
+
+    rt_workqueue_get_stat(queue, &stat);
+    uassert_int_equal(stat.done, WQ_TC_ITEMS);
+    uassert_int_equal(stat.urgent_done, 3);
+
+    rt_workqueue_reset_stat(queue);
+    rt_workqueue_get_stat(queue, &stat);
+    uassert_int_equal(stat.done, 0);
+
+    rt_workqueue_destroy(queue);
+}
+
+static void test_workqueue_max_active(void)
+{
+    struct rt_workqueue_stat stat;
+    struct rt_workqueue *queue;
+
+    /* two workers, only one of them for the normal items */
+    queue = rt_workqueue_create_pool("wqtc", 1024, UTEST_THR_PRIORITY - 1, 2, 1);
+    uassert_not_null(queue);
+    wq_tc_reset();
+    rt_work_init(&_works[0], wq_tc_hold, (void *)0);
+
+    /* the worker of the item 0 holds until the gate opens */
+    uassert_int_equal(rt_workqueue_dowork(queue, &_works[0]), RT_EOK);
+    uassert_int_equal(rt_workqueue_dowork(queue, &_works[0]), -RT_EBUSY);
+    uassert_int_equal(rt_workqueue_dowork(queue, &_works[1]), RT_EOK);
+    uassert_int_equal(rt_workqueue_urgent_work(queue, &_works[2]), RT_EOK);
+
+    /* the urgent item runs on the other worker, the normal one waits */
+    wq_tc_wait(1);
+    uassert_int_equal(_order[0], 2);
+    rt_thread_delay(WQ_TC_HOLD);
+    uassert_int_equal(_order_count, 1);
+
+    rt_sem_release(&_gate);
+    wq_tc_wait(2);
+    uassert_int_equal(_order[1], 0);
+    uassert_int_equal(_order[2], 1);
+
+    rt_workqueue_get_stat(queue, &stat);
+    uassert_int_equal(stat.done, 3);
+    uassert_int_equal(stat.urgent_done, 1);
+    /* the item 0 held its worker, the item 1 waited for it */
+    uassert_true(stat.run_max >= WQ_TC_HOLD);
+    uassert_true(stat.latency_max >= WQ_TC_HOLD);
+
+    rt_workqueue_destroy(queue);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_gate, "wqgate", 0, RT_IPC_FLAG_PRIO);
+
+    return rt_sem_init(&_done, "wqdone", 0, RT_IPC_FLAG_PRIO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_gate);
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_workqueue_lanes);
+    UTEST_UNIT_RUN(test_workqueue_max_active);
+}
+UTEST_TC_EXPORT(testcase, "testcases.drivers.workqueue_tc", utest_tc_init, utest_tc_cleanup, 10);
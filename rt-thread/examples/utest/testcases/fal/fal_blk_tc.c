@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <fal.h>
+#include "utest.h"
+
+/*
+ * The block device of UTEST_FAL_BLK_TC_PARTITION is filled over three erase
+ * blocks, then a range which starts and ends in the middle of an erase block
+ * is erased. The erased sectors must read back as 0xFF and the sectors out of
+ * the range must keep their data, from the cache and, after a sync, from the
+ * flash. The data of the partition is lost.
+ */
+
+#define FAL_TC_BLOCKS           3
+
+static const struct fal_partition *_part;
+static rt_device_t _dev;
+static struct rt_device_blk_geometry _geo;
+static rt_uint32_t _spb;
+static rt_uint8_t *_data;
+static rt_uint8_t *_check;
+
+static rt_uint8_t fal_tc_byte(rt_uint32_t sector, rt_uint32_t index)
+{
+    return (rt_uint8_t)(sector * 7 + index);
+}
+
+/* the sectors in [start, end) are erased, the others hold their pattern */
+static int fal_tc_verify(const rt_uint8_t *buf, rt_uint32_t start, rt_uint32_t end)
+{
+    rt_uint32_t sector, index;
+    rt_uint8_t expect;
+    int errors = 0;
+
+    for (sector = 0; sector < FAL_TC_BLOCKS * _spb; sector++)
+    {
+        for (index = 0; index < _geo.bytes_per_sector; index++)
+        {
+            expect = (sector >= start && sector < end) ? 0xFF : fal_tc_byte(sector, index);
+            if (buf[sector * _geo.bytes_per_sector + index] != expect)
+                errors++;
+        }
+    }
+
+    return errors;
+}
+
+static void fal_tc_fill(void)
+{
+    rt_uint32_t sector, index;
+
+    for (sector = 0; sector < FAL_TC_BLOCKS * _spb; sector++)
+    {
+        for (index = 0; index < _geo.bytes_per_sector; index++)
+            _data[sector * _geo.bytes_per_sector + index] = fal_tc_byte(sector, index);
+    }
+    uassert_int_equal(rt_device_write(_dev, 0, _data, FAL_TC_BLOCKS * _spb), FAL_TC_BLOCKS * _spb);
+    uassert_int_equal(rt_device_control(_dev, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL), RT_EOK);
+}
+
+static void fal_tc_erase(rt_uint32_t start, rt_uint32_t end)
+{
+    rt_uint32_t addrs[2] = {start, end};
+    rt_size_t size = FAL_TC_BLOCKS * _geo.block_size;
+
+    fal_tc_fill();
+    uassert_int_equal(rt_device_control(_dev, RT_DEVICE_CTRL_BLK_ERASE, addrs), RT_EOK);
+
+    /* through the cache */
+    rt_memset(_check, 0, size);
+    uassert_int_equal(rt_device_read(_dev, 0, _check, FAL_TC_BLOCKS * _spb), FAL_TC_BLOCKS * _spb);
+    uassert_int_equal(fal_tc_verify(_check, start, end), 0);
+
+    /* on the flash */
+    uassert_int_equal(rt_device_control(_dev, RT_DEVICE_CTRL_BLK_SYNC, RT_NULL), RT_EOK);
+    rt_memset(_check, 0, size);
+    uassert_int_equal(fal_partition_read(_part, 0, _check, size), size);
+    uassert_int_equal(fal_tc_verify(_check, start, end), 0);
+}
+
+static void test_fal_blk_erase_blocks(void)
+{
+    /* the whole second block */
+    fal_tc_erase(_spb, 2 * _spb);
+}
+
+static void test_fal_blk_erase_partial(void)
+{
+    if (_spb < 2)
+    {
+        LOG_I("one sector per erase block, no partial erase");
+        return;
+    }
+
+    /* the end of the first block, the second block and the start of the third */
+    fal_tc_erase(_spb / 2, 2 * _spb + _spb / 2);
+    /* inside the first block */
+    fal_tc_erase(1, _spb - 1);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _part = fal_partition_find(UTEST_FAL_BLK_TC_PARTITION);
+    if (_part == RT_NULL)
+        return -RT_ERROR;
+
+    _dev = rt_device_find(UTEST_FAL_BLK_TC_PARTITION);
+    if (_dev == RT_NULL)
+        _dev = fal_blk_device_create(UTEST_FAL_BLK_TC_PARTITION);
+    if (_dev == RT_NULL || _dev->type != RT_Device_Class_Block)
+        return -RT_ERROR;
+
+    rt_device_control(_dev, RT_DEVICE_CTRL_BLK_GETGEOME, &_geo);
+    _spb = _geo.block_size / _geo.bytes_per_sector;
+    if (_part->len < FAL_TC_BLOCKS * _geo.block_size)
+        return -RT_ERROR;
+
+    _data = (rt_uint8_t *)rt_malloc(FAL_TC_BLOCKS * _geo.block_size);
+    _check = (rt_uint8_t *)rt_malloc(FAL_TC_BLOCKS * _geo.block_size);
+    if (_data == RT_NULL || _check == RT_NULL)
+        return -RT_ENOMEM;
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(_data);
+    rt_free(_check);
+    _data = _check = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_fal_blk_erase_blocks);
+    UTEST_UNIT_RUN(test_fal_blk_erase_partial);
+}
+UTEST_TC_EXPORT(testcase, "testcases.fal.fal_blk_tc", utest_tc_init, utest_tc_cleanup, 30);
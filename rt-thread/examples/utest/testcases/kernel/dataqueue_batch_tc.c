@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <cputime.h>
+#include "utest.h"
+
+/*
+ * Check the order, the partial moves and the water mark events of the batch
+ * calls of the data queue, and report the cost per item of a producer and a
+ * consumer thread moving the items one by one and in batches.
+ */
+
+#define DQ_SIZE             32
+#define DQ_BENCH_ITEMS      3200
+#define DQ_BATCH_MAX        16
+
+static struct rt_data_queue _dq;
+static struct rt_semaphore _done;
+static rt_uint32_t _events[5];
+static rt_size_t _batch;
+
+static void dq_notify(struct rt_data_queue *queue, rt_uint32_t event)
+{
+    if (event < sizeof(_events) / sizeof(_events[0]))
+        _events[event]++;
+}
+
+static void test_dq_batch_order(void)
+{
+    struct rt_data_item items[DQ_SIZE + 4];
+    int index;
+
+    uassert_int_equal(rt_data_queue_init(&_dq, 8, 2, dq_notify), RT_EOK);
+    rt_data_queue_set_watermark(&_dq, 2, 6);
+    rt_memset(_events, 0, sizeof(_events));
+
+    for (index = 0; index < 10; index++)
+    {
+        items[index].data_ptr = (void *)(rt_ubase_t)index;
+        items[index].data_size = index;
+    }
+
+    /* a batch larger than the free space moves what fits */
+    uassert_int_equal(rt_data_queue_push_batch(&_dq, items, 5, 0), 5);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_HWM], 0);
+    uassert_int_equal(rt_data_queue_push_batch(&_dq, items + 5, 5, 0), 3);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_HWM], 1);
+    uassert_int_equal(rt_data_queue_len(&_dq), 8);
+    uassert_int_equal(rt_data_queue_push_batch(&_dq, items, 1, 0), 0);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_PUSH], 2);
+
+    /* the items come out in order, across the batches */
+    rt_memset(items, 0, sizeof(items));
+    uassert_int_equal(rt_data_queue_pop_batch(&_dq, items, 3, 0), 3);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_POP], 1);
+    uassert_int_equal(rt_data_queue_pop_batch(&_dq, items + 3, DQ_SIZE, 0), 5);
+    uassert_int_equal(_events[RT_DATAQUEUE_EVENT_LWM], 1);
+    for (index = 0; index < 8; index++)
+    {
+        uassert_int_equal((rt_ubase_t)items[index].data_ptr, index);
+        uassert_int_equal(items[index].data_size, index);
+    }
+    uassert_int_equal(rt_data_queue_pop_batch(&_dq, items, 1, 0), 0);
+
+    /* the single calls see the batches */
+    uassert_int_equal(rt_data_queue_push_batch(&_dq, items, 2, 0), 2);
+    uassert_int_equal(rt_data_queue_push(&_dq, (void *)9, 9, 0), RT_EOK);
+    uassert_int_equal(rt_data_queue_pop_batch(&_dq, items, 3, 0), 3);
+    uassert_int_equal((rt_ubase_t)items[2].data_ptr, 9);
+
+    rt_data_queue_deinit(&_dq);
+}
+
+static void dq_producer(void *parameter)
+{
+    struct rt_data_item items[DQ_BATCH_MAX];
+    rt_size_t sent = 0, count, index;
+
+    while (sent < DQ_BENCH_ITEMS)
+    {
+        count = DQ_BENCH_ITEMS - sent < _batch ? DQ_BENCH_ITEMS - sent : _batch;
+        if (_batch == 1)
+        {
+            rt_data_queue_push(&_dq, (void *)(rt_ubase_t)sent, sizeof(rt_ubase_t), RT_WAITING_FOREVER);
+            sent++;
+            continue;
+        }
+
+        for (index = 0; index < count; index++)
+        {
+            items[index].data_ptr = (void *)(rt_ubase_t)(sent + index);
+            items[index].data_size = sizeof(rt_ubase_t);
+        }
+        for (index = 0; index < count; )
+        {
+            index += rt_data_queue_push_batch(&_dq, items + index, count - index, RT_WAITING_FOREVER);
+        }
+        sent += count;
+    }
+    rt_sem_release(&_done);
+}
+
+/* the cost per item of moving DQ_BENCH_ITEMS items between two threads */
+static rt_uint64_t dq_bench(rt_size_t batch)
+{
+    struct rt_data_item items[DQ_BATCH_MAX];
+    rt_size_t received = 0, count, index;
+    rt_uint64_t start;
+    rt_thread_t thread;
+    const void *data;
+    rt_size_t size;
+    int errors = 0;
+
+    _batch = batch;
+    rt_data_queue_init(&_dq, DQ_SIZE, DQ_SIZE / 2, RT_NULL);
+    thread = rt_thread_create("dqbp", dq_producer, RT_NULL, 1024, UTEST_THR_PRIORITY + 1, 10);
+    uassert_not_null(thread);
+
+    start = clock_cpu_gettime();
+    rt_thread_startup(thread);
+    while (received < DQ_BENCH_ITEMS)
+    {
+        if (batch == 1)
+        {
+            rt_data_queue_pop(&_dq, &data, &size, RT_WAITING_FOREVER);
+            if ((rt_ubase_t)data != received)
+                errors++;
+            received++;
+            continue;
+        }
+
+        count = rt_data_queue_pop_batch(&_dq, items, batch, RT_WAITING_FOREVER);
+        for (index = 0; index < count; index++)
+        {
+            if ((rt_ubase_t)items[index].data_ptr != received + index)
+                errors++;
+        }
+        received += count;
+    }
+    start = clock_cpu_gettime() - start;
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+
+    uassert_int_equal(errors, 0);
+    rt_data_queue_deinit(&_dq);
+
+    return start / DQ_BENCH_ITEMS;
+}
+
+static void test_dq_batch_bench(void)
+{
+    static const rt_size_t batches[] = {1, 4, DQ_BATCH_MAX};
+    int index;
+
+    for (index = 0; index < sizeof(batches) / sizeof(batches[0]); index++)
+    {
+        LOG_I("batch of %2d: %d ns per item", (int)batches[index],
+              clock_cpu_microsecond((uint32_t)(dq_bench(batches[index]) * 1000)));
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return rt_sem_init(&_done, "dqbd", 0, RT_IPC_FLAG_PRIO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_dq_batch_order);
+    UTEST_UNIT_RUN(test_dq_batch_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.dataqueue_batch_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+#define HEAP_BENCH_ROUNDS       20000
+#define HEAP_BENCH_BURST        8
+#define HEAP_BENCH_THREADS      2
+
+static struct rt_semaphore _done;
+
+static void heap_cache_stat(rt_uint32_t *hit, rt_uint32_t *miss, rt_size_t *cached)
+{
+    rt_uint32_t index, class_hit, class_miss;
+    rt_size_t class_cached;
+
+    *hit = *miss = 0;
+    *cached = 0;
+    for (index = 0; rt_heap_cache_info(index, RT_NULL, &class_cached, &class_hit, &class_miss) == RT_EOK; index++)
+    {
+        *hit += class_hit;
+        *miss += class_miss;
+        *cached += class_cached;
+    }
+}
+
+static void heap_bench_loop(void)
+{
+    void *ptr[HEAP_BENCH_BURST];
+    int round, index;
+
+    for (round = 0; round < HEAP_BENCH_ROUNDS; round++)
+    {
+        /* the small blocks of pbufs, responses and descriptors */
+        for (index = 0; index < HEAP_BENCH_BURST; index++)
+        {
+            ptr[index] = rt_malloc(16 + ((round + index) % 7) * 16);
+        }
+        for (index = 0; index < HEAP_BENCH_BURST; index++)
+        {
+            rt_free(ptr[index]);
+        }
+    }
+}
+
+static void heap_bench_entry(void *parameter)
+{
+    heap_bench_loop();
+    rt_sem_release(&_done);
+}
+
+static void test_heap_cache_data(void)
+{
+    rt_uint8_t *ptr, *nptr;
+    rt_size_t size, index;
+
+    for (size = 1; size <= 256; size += 7)
+    {
+        ptr = (rt_uint8_t *)rt_malloc(size);
+        uassert_not_null(ptr);
+        for (index = 0; index < size; index++)
+            ptr[index] = (rt_uint8_t)(index + size);
+
+        /* a block leaves its size class when it is resized */
+        nptr = (rt_uint8_t *)rt_realloc(ptr, size + 100);
+        uassert_not_null(nptr);
+        for (index = 0; index < size; index++)
+        {
+            if (nptr[index] != (rt_uint8_t)(index + size))
+                break;
+        }
+        uassert_int_equal(index, size);
+        rt_free(nptr);
+    }
+}
+
+static void test_heap_cache_flush(void)
+{
+    rt_uint32_t hit, miss;
+    rt_size_t cached;
+
+    heap_bench_loop();
+    heap_cache_stat(&hit, &miss, &cached);
+    uassert_true(cached > 0);
+
+    rt_heap_cache_flush();
+    heap_cache_stat(&hit, &miss, &cached);
+    uassert_int_equal(cached, 0);
+}
+
+static void test_heap_cache_bench(void)
+{
+    rt_uint32_t hit, miss, hit0, miss0;
+    rt_size_t cached;
+    rt_thread_t thread;
+    rt_tick_t tick;
+    int index;
+
+    heap_cache_stat(&hit0, &miss0, &cached);
+
+    tick = rt_tick_get();
+    heap_bench_loop();
+    tick = rt_tick_get() - tick;
+    LOG_I("1 thread : %d alloc/free pairs in %d ms", HEAP_BENCH_ROUNDS * HEAP_BENCH_BURST,
+          tick * 1000 / RT_TICK_PER_SECOND);
+
+    tick = rt_tick_get();
+    for (index = 0; index < HEAP_BENCH_THREADS; index++)
+    {
+        thread = rt_thread_create("heapb", heap_bench_entry, RT_NULL, 1024,
+                                  UTEST_THR_PRIORITY + 1, 2);
+        uassert_not_null(thread);
+        rt_thread_startup(thread);
+    }
+    for (index = 0; index < HEAP_BENCH_THREADS; index++)
+    {
+        rt_sem_take(&_done, RT_WAITING_FOREVER);
+    }
+    tick = rt_tick_get() - tick;
+    LOG_I("%d threads: %d alloc/free pairs in %d ms", HEAP_BENCH_THREADS,
+          HEAP_BENCH_THREADS * HEAP_BENCH_ROUNDS * HEAP_BENCH_BURST,
+          tick * 1000 / RT_TICK_PER_SECOND);
+
+    heap_cache_stat(&hit, &miss, &cached);
+    hit -= hit0;
+    miss -= miss0;
+    LOG_I("cache hit %d, miss %d, hit rate %d%%", hit, miss,
+          (hit + miss) ? hit * 100 / (hit + miss) : 0);
+    uassert_true(hit > miss);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    return rt_sem_init(&_done, "heapb", 0, RT_IPC_FLAG_PRIO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_done);
+    rt_heap_cache_flush();
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_heap_cache_data);
+    UTEST_UNIT_RUN(test_heap_cache_flush);
+    UTEST_UNIT_RUN(test_heap_cache_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.heap_cache_tc", utest_tc_init, utest_tc_cleanup, 60);
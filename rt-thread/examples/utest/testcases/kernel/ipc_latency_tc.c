@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <cputime.h>
+#include "utest.h"
+
+/*
+ * Measure uncontended take/release of a semaphore and a mutex, and check
+ * that contention and priority inheritance still work. Build it with and
+ * without RT_USING_IPC_FAST_PATH to compare the two paths.
+ */
+
+#define IPC_BENCH_LOOPS     10000
+#define IPC_CONTEND_LOOPS   1000
+
+static struct rt_semaphore _sem;
+static struct rt_mutex _mutex;
+static struct rt_semaphore _done;
+static volatile rt_uint32_t _counter;
+static volatile rt_uint8_t _owner_priority;
+
+static void ipc_bench_report(const char *name, rt_uint64_t total, rt_uint64_t best)
+{
+    LOG_I("%-20s average %d ns, best %d ns", name,
+          clock_cpu_microsecond((uint32_t)(total * 1000 / IPC_BENCH_LOOPS)),
+          clock_cpu_microsecond((uint32_t)(best * 1000)));
+}
+
+static void test_sem_latency(void)
+{
+    rt_uint64_t start, cost, total = 0, best = ~0ULL;
+    int index;
+
+    for (index = 0; index < IPC_BENCH_LOOPS; index++)
+    {
+        start = clock_cpu_gettime();
+        rt_sem_take(&_sem, RT_WAITING_FOREVER);
+        rt_sem_release(&_sem);
+        cost = clock_cpu_gettime() - start;
+
+        total += cost;
+        if (cost < best)
+            best = cost;
+    }
+    uassert_int_equal(_sem.value, 1);
+    ipc_bench_report("sem take+release", total, best);
+}
+
+static void test_mutex_latency(void)
+{
+    rt_uint64_t start, cost, total = 0, best = ~0ULL;
+    int index;
+
+    for (index = 0; index < IPC_BENCH_LOOPS; index++)
+    {
+        start = clock_cpu_gettime();
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+        rt_mutex_release(&_mutex);
+        cost = clock_cpu_gettime() - start;
+
+        total += cost;
+        if (cost < best)
+            best = cost;
+    }
+    uassert_null(_mutex.owner);
+    ipc_bench_report("mutex take+release", total, best);
+}
+
+static void ipc_contend_entry(void *parameter)
+{
+    rt_uint32_t value;
+    int index;
+
+    for (index = 0; index < IPC_CONTEND_LOOPS; index++)
+    {
+        rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+        value = _counter;
+        /* give the other thread a chance to contend */
+        if ((index & 0x3f) == 0)
+            rt_thread_yield();
+        _counter = value + 1;
+        rt_mutex_release(&_mutex);
+    }
+    rt_sem_release(&_done);
+}
+
+static void test_mutex_contend(void)
+{
+    rt_thread_t thread;
+    int index;
+
+    _counter = 0;
+    for (index = 0; index < 2; index++)
+    {
+        thread = rt_thread_create("ipcc", ipc_contend_entry, RT_NULL, 1024,
+                                  UTEST_THR_PRIORITY + 1, 1);
+        uassert_not_null(thread);
+        rt_thread_startup(thread);
+    }
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+
+    uassert_int_equal(_counter, 2 * IPC_CONTEND_LOOPS);
+}
+
+static void ipc_low_entry(void *parameter)
+{
+    rt_thread_t self = rt_thread_self();
+
+    rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+    /* the high priority thread blocks on the mutex meanwhile */
+    rt_thread_delay(5);
+    _owner_priority = self->current_priority;
+    rt_mutex_release(&_mutex);
+    rt_sem_release(&_done);
+}
+
+static void ipc_high_entry(void *parameter)
+{
+    rt_mutex_take(&_mutex, RT_WAITING_FOREVER);
+    rt_mutex_release(&_mutex);
+    rt_sem_release(&_done);
+}
+
+static void test_mutex_inherit(void)
+{
+    rt_thread_t low, high;
+
+    low = rt_thread_create("ipcl", ipc_low_entry, RT_NULL, 1024, UTEST_THR_PRIORITY + 2, 10);
+    high = rt_thread_create("ipch", ipc_high_entry, RT_NULL, 1024, UTEST_THR_PRIORITY + 1, 10);
+    uassert_not_null(low);
+    uassert_not_null(high);
+
+    _owner_priority = 0;
+    rt_thread_startup(low);
+    rt_thread_delay(1);
+    rt_thread_startup(high);
+
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+
+    /* the owner ran at the priority of the waiter */
+    uassert_int_equal(_owner_priority, UTEST_THR_PRIORITY + 1);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_sem, "ipcb", 1, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_done, "ipcd", 0, RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&_mutex, "ipcb", RT_IPC_FLAG_PRIO);
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_sem);
+    rt_sem_detach(&_done);
+    rt_mutex_detach(&_mutex);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+#ifdef RT_USING_IPC_FAST_PATH
+    LOG_I("ipc path: exclusive access fast path");
+#else
+    LOG_I("ipc path: interrupt disabled");
+#endif
+    UTEST_UNIT_RUN(test_sem_latency);
+    UTEST_UNIT_RUN(test_mutex_latency);
+    UTEST_UNIT_RUN(test_mutex_contend);
+    UTEST_UNIT_RUN(test_mutex_inherit);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.ipc_latency_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include "utest.h"
+
+/*
+ * Check rt_ipc_wait_any() on two semaphores and an event: the index of the
+ * object which fires, without waiting and woken by another thread, the
+ * timeout, an object deleted while it is waited on, and a semaphore reset
+ * to a value while it is waited on.
+ */
+
+#define WAIT_ANY_DELAY      10
+#define WAIT_ANY_TIMEOUT    20
+
+enum wait_any_action
+{
+    WAIT_ANY_RELEASE,
+    WAIT_ANY_DELETE,
+    WAIT_ANY_RESET,
+};
+
+static struct rt_semaphore _sem[2];
+static struct rt_event _event;
+static struct rt_semaphore _done;
+static rt_sem_t _dynamic;
+static enum wait_any_action _action;
+
+/* the helper runs once the test thread waits, and acts on the objects */
+static void wait_any_helper(void *parameter)
+{
+    rt_thread_delay(WAIT_ANY_DELAY);
+
+    switch (_action)
+    {
+    case WAIT_ANY_RELEASE:
+        rt_sem_release(&_sem[1]);
+        break;
+    case WAIT_ANY_DELETE:
+        rt_sem_delete(_dynamic);
+        break;
+    case WAIT_ANY_RESET:
+        rt_sem_control(&_sem[0], RT_IPC_CMD_RESET, (void *)1);
+        break;
+    }
+    rt_sem_release(&_done);
+}
+
+static void wait_any_start(enum wait_any_action action)
+{
+    rt_thread_t thread;
+
+    _action = action;
+    thread = rt_thread_create("wany", wait_any_helper, RT_NULL, 1024, UTEST_THR_PRIORITY + 1, 10);
+    uassert_not_null(thread);
+    rt_thread_startup(thread);
+}
+
+static void wait_any_items(struct rt_ipc_wait_item *items)
+{
+    rt_memset(items, 0, sizeof(struct rt_ipc_wait_item) * 3);
+    items[0].object = &_sem[0].parent;
+    items[1].object = &_sem[1].parent;
+    items[2].object = &_event.parent;
+    items[2].set = 0x3;
+    items[2].option = RT_EVENT_FLAG_AND;
+}
+
+static void test_wait_any_index(void)
+{
+    struct rt_ipc_wait_item items[3];
+    rt_size_t index = 3;
+    rt_uint32_t recved;
+
+    wait_any_items(items);
+
+    /* nothing is available */
+    uassert_int_equal(rt_ipc_wait_any(items, 3, RT_WAITING_NO, &index), -RT_ETIMEOUT);
+
+    /* the object which is available is reported, not taken */
+    rt_sem_release(&_sem[1]);
+    uassert_int_equal(rt_ipc_wait_any(items, 3, RT_WAITING_NO, &index), RT_EOK);
+    uassert_int_equal(index, 1);
+    uassert_int_equal(rt_sem_take(&_sem[1], RT_WAITING_NO), RT_EOK);
+
+    /* the event fires only once all of its set is sent */
+    rt_event_send(&_event, 0x1);
+    uassert_int_equal(rt_ipc_wait_any(items, 3, RT_WAITING_NO, &index), -RT_ETIMEOUT);
+    rt_event_send(&_event, 0x2);
+    uassert_int_equal(rt_ipc_wait_any(items, 3, RT_WAITING_NO, &index), RT_EOK);
+    uassert_int_equal(index, 2);
+    uassert_int_equal(rt_event_recv(&_event, 0x3, RT_EVENT_FLAG_AND | RT_EVENT_FLAG_CLEAR,
+                                    RT_WAITING_NO, &recved), RT_EOK);
+
+    /* the first of several available objects is reported */
+    rt_sem_release(&_sem[0]);
+    rt_sem_release(&_sem[1]);
+    uassert_int_equal(rt_ipc_wait_any(items, 3, RT_WAITING_NO, &index), RT_EOK);
+    uassert_int_equal(index, 0);
+    rt_sem_take(&_sem[0], RT_WAITING_NO);
+    rt_sem_take(&_sem[1], RT_WAITING_NO);
+
+    /* another thread releases an object while the set is waited on */
+    index = 3;
+    wait_any_start(WAIT_ANY_RELEASE);
+    uassert_int_equal(rt_ipc_wait_any(items, 3, RT_WAITING_FOREVER, &index), RT_EOK);
+    uassert_int_equal(index, 1);
+    uassert_int_equal(rt_sem_take(&_sem[1], RT_WAITING_NO), RT_EOK);
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+}
+
+static void test_wait_any_timeout(void)
+{
+    struct rt_ipc_wait_item items[3];
+    rt_size_t index;
+    rt_tick_t start;
+
+    wait_any_items(items);
+
+    start = rt_tick_get();
+    uassert_int_equal(rt_ipc_wait_any(items, 3, WAIT_ANY_TIMEOUT, &index), -RT_ETIMEOUT);
+    uassert_true(rt_tick_get() - start >= WAIT_ANY_TIMEOUT);
+
+    /* the objects are unlinked from the set after the waiting */
+    uassert_true(rt_list_isempty(&_sem[0].parent.wait_any_list));
+    uassert_true(rt_list_isempty(&_event.parent.wait_any_list));
+}
+
+static void test_wait_any_delete(void)
+{
+    struct rt_ipc_wait_item items[2];
+    rt_size_t index;
+
+    _dynamic = rt_sem_create("wanyx", 0, RT_IPC_FLAG_PRIO);
+    uassert_not_null(_dynamic);
+
+    rt_memset(items, 0, sizeof(items));
+    items[0].object = &_sem[0].parent;
+    items[1].object = &_dynamic->parent;
+
+    wait_any_start(WAIT_ANY_DELETE);
+    uassert_int_equal(rt_ipc_wait_any(items, 2, RT_WAITING_FOREVER, &index), -RT_ERROR);
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+
+    /* the object left in the set is unlinked too */
+    uassert_true(rt_list_isempty(&_sem[0].parent.wait_any_list));
+}
+
+static void test_wait_any_reset(void)
+{
+    struct rt_ipc_wait_item items[3];
+    rt_size_t index = 3;
+
+    wait_any_items(items);
+
+    /* a reset to a value makes the semaphore available to the set */
+    wait_any_start(WAIT_ANY_RESET);
+    uassert_int_equal(rt_ipc_wait_any(items, 3, WAIT_ANY_DELAY * 10, &index), RT_EOK);
+    uassert_int_equal(index, 0);
+    uassert_int_equal(rt_sem_take(&_sem[0], RT_WAITING_NO), RT_EOK);
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_sem_init(&_sem[0], "wany0", 0, RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_sem[1], "wany1", 0, RT_IPC_FLAG_PRIO);
+    rt_event_init(&_event, "wanye", RT_IPC_FLAG_PRIO);
+
+    return rt_sem_init(&_done, "wanyd", 0, RT_IPC_FLAG_PRIO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_sem[0]);
+    rt_sem_detach(&_sem[1]);
+    rt_event_detach(&_event);
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_wait_any_index);
+    UTEST_UNIT_RUN(test_wait_any_timeout);
+    UTEST_UNIT_RUN(test_wait_any_delete);
+    UTEST_UNIT_RUN(test_wait_any_reset);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.ipc_wait_any_tc", utest_tc_init, utest_tc_cleanup, 30);
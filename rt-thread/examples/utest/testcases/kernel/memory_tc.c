@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <cputime.h>
+#include "utest.h"
+
+/*
+ * Check rt_memcpy, rt_memset and rt_memmove against a byte loop over all
+ * head alignments, and report their throughput. On Cortex-M the cputime
+ * counter is the DWT cycle counter, so the figures are bytes per cycle.
+ * Build it with and without RT_KSERVICE_USING_CPU_MEMORY to compare the
+ * port functions with the generic ones.
+ */
+
+#define MEM_TEST_MAX_SIZE       4096
+#define MEM_BENCH_LOOPS         64
+
+static rt_uint8_t *_src, *_dst;
+
+static void mem_fill(rt_uint8_t *buf, rt_size_t size, rt_uint8_t seed)
+{
+    rt_size_t index;
+
+    for (index = 0; index < size; index++)
+        buf[index] = (rt_uint8_t)(index * 7 + seed);
+}
+
+static rt_bool_t mem_check(const rt_uint8_t *buf, rt_size_t size, rt_uint8_t seed)
+{
+    rt_size_t index;
+
+    for (index = 0; index < size; index++)
+    {
+        if (buf[index] != (rt_uint8_t)(index * 7 + seed))
+            return RT_FALSE;
+    }
+    return RT_TRUE;
+}
+
+static void test_memcpy(void)
+{
+    rt_size_t size;
+    int soff, doff;
+
+    for (soff = 0; soff < 4; soff++)
+    {
+        for (doff = 0; doff < 4; doff++)
+        {
+            for (size = 0; size <= 128; size++)
+            {
+                mem_fill(_src + soff, size, (rt_uint8_t)size);
+                rt_memset(_dst, 0xa5, size + 8);
+
+                rt_memcpy(_dst + doff, _src + soff, size);
+                uassert_true(mem_check(_dst + doff, size, (rt_uint8_t)size));
+                /* the bytes around the destination are untouched */
+                uassert_true(doff == 0 || _dst[doff - 1] == 0xa5);
+                uassert_int_equal(_dst[doff + size], 0xa5);
+            }
+        }
+    }
+}
+
+static void test_memset(void)
+{
+    rt_size_t size, index;
+    int doff;
+
+    for (doff = 0; doff < 4; doff++)
+    {
+        for (size = 0; size <= 128; size++)
+        {
+            rt_memset(_dst, 0xa5, size + 8);
+            rt_memset(_dst + doff, 0x3c, size);
+
+            for (index = 0; index < size; index++)
+            {
+                if (_dst[doff + index] != 0x3c)
+                    break;
+            }
+            uassert_int_equal(index, size);
+            uassert_true(doff == 0 || _dst[doff - 1] == 0xa5);
+            uassert_int_equal(_dst[doff + size], 0xa5);
+        }
+    }
+}
+
+static void test_memmove(void)
+{
+    rt_size_t size;
+    int shift;
+
+    /* overlap in both directions, with every relative alignment */
+    for (shift = -9; shift <= 9; shift++)
+    {
+        for (size = 0; size <= 128; size++)
+        {
+            mem_fill(_dst + 16, size, (rt_uint8_t)size);
+            rt_memmove(_dst + 16 + shift, _dst + 16, size);
+            uassert_true(mem_check(_dst + 16 + shift, size, (rt_uint8_t)size));
+        }
+    }
+}
+
+static void mem_bench_report(const char *name, rt_size_t size, int align, rt_uint64_t cost)
+{
+    rt_uint64_t rate = cost ? (rt_uint64_t)size * MEM_BENCH_LOOPS * 100 / cost : 0;
+
+    LOG_I("%-8s %4d bytes, offset %d: %d.%02d bytes/cycle", name, (int)size, align,
+          (int)(rate / 100), (int)(rate % 100));
+}
+
+static void test_memory_bench(void)
+{
+    static const rt_size_t sizes[] = {16, 64, 256, 1024, MEM_TEST_MAX_SIZE};
+    rt_uint64_t start;
+    int index, loop, align;
+
+    for (index = 0; index < sizeof(sizes) / sizeof(sizes[0]); index++)
+    {
+        for (align = 0; align < 4; align += 3)
+        {
+            start = clock_cpu_gettime();
+            for (loop = 0; loop < MEM_BENCH_LOOPS; loop++)
+                rt_memcpy(_dst + align, _src, sizes[index]);
+            mem_bench_report("memcpy", sizes[index], align, clock_cpu_gettime() - start);
+
+            start = clock_cpu_gettime();
+            for (loop = 0; loop < MEM_BENCH_LOOPS; loop++)
+                rt_memset(_dst + align, loop, sizes[index]);
+            mem_bench_report("memset", sizes[index], align, clock_cpu_gettime() - start);
+
+            start = clock_cpu_gettime();
+            for (loop = 0; loop < MEM_BENCH_LOOPS; loop++)
+                rt_memmove(_dst + align + 4, _dst, sizes[index]);
+            mem_bench_report("memmove", sizes[index], align, clock_cpu_gettime() - start);
+        }
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    /* room for the offsets and the guard bytes around the test area */
+    _src = (rt_uint8_t *)rt_malloc(MEM_TEST_MAX_SIZE + 32);
+    _dst = (rt_uint8_t *)rt_malloc(MEM_TEST_MAX_SIZE + 32);
+    if (_src == RT_NULL || _dst == RT_NULL)
+    {
+        rt_free(_src);
+        rt_free(_dst);
+        return -RT_ENOMEM;
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(_src);
+    rt_free(_dst);
+    _src = _dst = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+#ifdef RT_KSERVICE_USING_CPU_MEMORY
+    LOG_I("memory functions: cpu port");
+#else
+    LOG_I("memory functions: generic");
+#endif
+    UTEST_UNIT_RUN(test_memcpy);
+    UTEST_UNIT_RUN(test_memset);
+    UTEST_UNIT_RUN(test_memmove);
+    UTEST_UNIT_RUN(test_memory_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.memory_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <cputime.h>
+#include "utest.h"
+
+/*
+ * Check the ordering and slot accounting of the loan API of the message
+ * queue, and compare the throughput of a producer and a consumer thread
+ * that copy their messages with one that fills and reads them in place.
+ */
+
+#define MQ_MSG_NR           8
+#define MQ_BENCH_MSGS       2000
+#define MQ_MAX_SIZE         512
+/* each message of the pool is preceded by a next pointer */
+#define MQ_POOL_SIZE(size)  (MQ_MSG_NR * (RT_ALIGN(size, RT_ALIGN_SIZE) + sizeof(void *)))
+
+static struct rt_messagequeue _mq;
+static rt_uint8_t *_pool;
+static rt_size_t _msg_size;
+static struct rt_semaphore _done;
+
+static void test_mq_loan_order(void)
+{
+    void *buffer;
+    rt_uint8_t value;
+    int index;
+
+    _msg_size = 16;
+    uassert_int_equal(rt_mq_init(&_mq, "mqlt", _pool, _msg_size,
+                                 MQ_POOL_SIZE(_msg_size),
+                                 RT_IPC_FLAG_PRIO), RT_EOK);
+
+    /* copied and lent messages keep the send order, urgent ones go first */
+    value = 1;
+    rt_mq_send(&_mq, &value, 1);
+    uassert_int_equal(rt_mq_loan(&_mq, &buffer, RT_WAITING_NO), RT_EOK);
+    *(rt_uint8_t *)buffer = 2;
+    rt_mq_send_loan(&_mq, buffer);
+    uassert_int_equal(rt_mq_loan(&_mq, &buffer, RT_WAITING_NO), RT_EOK);
+    *(rt_uint8_t *)buffer = 0;
+    rt_mq_urgent_loan(&_mq, buffer);
+
+    for (index = 0; index < 3; index++)
+    {
+        uassert_int_equal(rt_mq_recv_loan(&_mq, &buffer, RT_WAITING_NO), RT_EOK);
+        uassert_int_equal(*(rt_uint8_t *)buffer, index);
+        rt_mq_release(&_mq, buffer);
+    }
+    uassert_int_not_equal(rt_mq_recv_loan(&_mq, &buffer, RT_WAITING_NO), RT_EOK);
+
+    /* every slot can be lent, and a lent slot that is not sent comes back */
+    for (index = 0; index < MQ_MSG_NR; index++)
+    {
+        uassert_int_equal(rt_mq_loan(&_mq, &buffer, RT_WAITING_NO), RT_EOK);
+    }
+    uassert_int_equal(rt_mq_loan(&_mq, &buffer, RT_WAITING_NO), -RT_EFULL);
+    uassert_int_equal(rt_mq_send(&_mq, &value, 1), -RT_EFULL);
+    rt_mq_detach(&_mq);
+
+    uassert_int_equal(rt_mq_init(&_mq, "mqlt", _pool, _msg_size,
+                                 MQ_POOL_SIZE(_msg_size),
+                                 RT_IPC_FLAG_PRIO), RT_EOK);
+    uassert_int_equal(rt_mq_loan(&_mq, &buffer, RT_WAITING_NO), RT_EOK);
+    rt_mq_release(&_mq, buffer);
+    for (index = 0; index < MQ_MSG_NR; index++)
+    {
+        uassert_int_equal(rt_mq_send(&_mq, &value, 1), RT_EOK);
+    }
+    rt_mq_detach(&_mq);
+}
+
+static void mq_copy_producer(void *parameter)
+{
+    rt_uint8_t *msg = (rt_uint8_t *)parameter;
+    int index;
+
+    for (index = 0; index < MQ_BENCH_MSGS; index++)
+    {
+        rt_memset(msg, (rt_uint8_t)index, _msg_size);
+        rt_mq_send_wait(&_mq, msg, _msg_size, RT_WAITING_FOREVER);
+    }
+    rt_sem_release(&_done);
+}
+
+static void mq_loan_producer(void *parameter)
+{
+    void *buffer;
+    int index;
+
+    for (index = 0; index < MQ_BENCH_MSGS; index++)
+    {
+        rt_mq_loan(&_mq, &buffer, RT_WAITING_FOREVER);
+        rt_memset(buffer, (rt_uint8_t)index, _msg_size);
+        rt_mq_send_loan(&_mq, buffer);
+    }
+    rt_sem_release(&_done);
+}
+
+static rt_uint64_t mq_bench(rt_size_t size, rt_bool_t loan)
+{
+    rt_uint8_t *msg, *recv;
+    rt_thread_t thread;
+    rt_uint64_t start;
+    void *buffer;
+    int index, errors = 0;
+
+    _msg_size = size;
+    rt_mq_init(&_mq, "mqlb", _pool, _msg_size,
+               MQ_POOL_SIZE(_msg_size), RT_IPC_FLAG_PRIO);
+    msg = (rt_uint8_t *)rt_malloc(size);
+    recv = (rt_uint8_t *)rt_malloc(size);
+    uassert_not_null(msg);
+    uassert_not_null(recv);
+
+    thread = rt_thread_create("mqlb", loan ? mq_loan_producer : mq_copy_producer, msg, 1024,
+                              UTEST_THR_PRIORITY + 1, 10);
+    uassert_not_null(thread);
+
+    start = clock_cpu_gettime();
+    rt_thread_startup(thread);
+    for (index = 0; index < MQ_BENCH_MSGS; index++)
+    {
+        if (loan)
+        {
+            rt_mq_recv_loan(&_mq, &buffer, RT_WAITING_FOREVER);
+            if (((rt_uint8_t *)buffer)[size - 1] != (rt_uint8_t)index)
+                errors++;
+            rt_mq_release(&_mq, buffer);
+        }
+        else
+        {
+            rt_mq_recv(&_mq, recv, size, RT_WAITING_FOREVER);
+            if (recv[size - 1] != (rt_uint8_t)index)
+                errors++;
+        }
+    }
+    start = clock_cpu_gettime() - start;
+    rt_sem_take(&_done, RT_WAITING_FOREVER);
+
+    uassert_int_equal(errors, 0);
+    rt_free(msg);
+    rt_free(recv);
+    rt_mq_detach(&_mq);
+
+    return start / MQ_BENCH_MSGS;
+}
+
+static void test_mq_loan_bench(void)
+{
+    static const rt_size_t sizes[] = {16, 128, MQ_MAX_SIZE};
+    int index;
+
+    for (index = 0; index < sizeof(sizes) / sizeof(sizes[0]); index++)
+    {
+        LOG_I("%3d byte messages: copy %d ns, loan %d ns per message", (int)sizes[index],
+              clock_cpu_microsecond((uint32_t)(mq_bench(sizes[index], RT_FALSE) * 1000)),
+              clock_cpu_microsecond((uint32_t)(mq_bench(sizes[index], RT_TRUE) * 1000)));
+    }
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _pool = (rt_uint8_t *)rt_malloc(MQ_POOL_SIZE(MQ_MAX_SIZE));
+    if (_pool == RT_NULL)
+        return -RT_ENOMEM;
+
+    return rt_sem_init(&_done, "mqld", 0, RT_IPC_FLAG_PRIO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_done);
+    rt_free(_pool);
+    _pool = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_mq_loan_order);
+    UTEST_UNIT_RUN(test_mq_loan_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.mq_loan_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <cputime.h>
+#include "utest.h"
+
+/*
+ * Register a number of devices and time rt_device_find for the first and
+ * the last registered one and for a missing name. Build it with and
+ * without RT_USING_OBJECT_HASH to compare the hashed lookup with the list
+ * scan.
+ */
+
+#define FIND_DEVICE_NR          64
+#define FIND_BENCH_LOOPS        1000
+
+static struct rt_device *_devices;
+static char _names[FIND_DEVICE_NR][RT_NAME_MAX];
+
+static rt_uint64_t find_bench(const char *name, rt_device_t expect)
+{
+    rt_uint64_t start, total = 0;
+    rt_device_t device = RT_NULL;
+    int index;
+
+    for (index = 0; index < FIND_BENCH_LOOPS; index++)
+    {
+        start = clock_cpu_gettime();
+        device = rt_device_find(name);
+        total += clock_cpu_gettime() - start;
+    }
+    uassert_true(device == expect);
+
+    return total / FIND_BENCH_LOOPS;
+}
+
+static void test_object_find(void)
+{
+    int index;
+
+    for (index = 0; index < FIND_DEVICE_NR; index++)
+    {
+        uassert_true(rt_device_find(_names[index]) == &_devices[index]);
+    }
+    uassert_null(rt_device_find("fnd_none"));
+
+    /* an unregistered device leaves the index */
+    rt_device_unregister(&_devices[0]);
+    uassert_null(rt_device_find(_names[0]));
+    rt_device_register(&_devices[0], _names[0], RT_DEVICE_FLAG_RDWR);
+    uassert_true(rt_device_find(_names[0]) == &_devices[0]);
+}
+
+static void test_object_find_bench(void)
+{
+    LOG_I("%d devices: find first %d ns, last %d ns, missing %d ns", FIND_DEVICE_NR,
+          clock_cpu_microsecond((uint32_t)(find_bench(_names[0], &_devices[0]) * 1000)),
+          clock_cpu_microsecond((uint32_t)(find_bench(_names[FIND_DEVICE_NR - 1],
+                                           &_devices[FIND_DEVICE_NR - 1]) * 1000)),
+          clock_cpu_microsecond((uint32_t)(find_bench("fnd_none", RT_NULL) * 1000)));
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    int index;
+
+    _devices = (struct rt_device *)rt_calloc(FIND_DEVICE_NR, sizeof(struct rt_device));
+    if (_devices == RT_NULL)
+        return -RT_ENOMEM;
+
+    for (index = 0; index < FIND_DEVICE_NR; index++)
+    {
+        rt_snprintf(_names[index], RT_NAME_MAX, "fnd%d", index);
+        _devices[index].type = RT_Device_Class_Miscellaneous;
+        rt_device_register(&_devices[index], _names[index], RT_DEVICE_FLAG_RDWR);
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    int index;
+
+    for (index = 0; index < FIND_DEVICE_NR; index++)
+    {
+        rt_device_unregister(&_devices[index]);
+    }
+    rt_free(_devices);
+    _devices = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+#ifdef RT_USING_OBJECT_HASH
+    LOG_I("object find: hash index, %d buckets", RT_OBJECT_HASH_SIZE);
+#else
+    LOG_I("object find: list scan");
+#endif
+    UTEST_UNIT_RUN(test_object_find);
+    UTEST_UNIT_RUN(test_object_find_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.object_find_tc", utest_tc_init, utest_tc_cleanup, 10);
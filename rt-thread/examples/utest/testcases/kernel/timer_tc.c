@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rthw.h>
+#include <stdlib.h>
+#include <cputime.h>
+#include "utest.h"
+
+/*
+ * The timer functions keep interrupts disabled while they insert or remove
+ * a timer, so the time of a rt_timer_start/rt_timer_stop pair with a number
+ * of other timers armed is an upper bound of the interrupt-off time. Build it
+ * with and without RT_TIMER_USING_WHEEL to compare the two backends.
+ *
+ * The time of rt_timer_check() is also reported on the tick where the first
+ * level of the wheel wraps and the armed timers are brought down from the
+ * upper level, next to the time on the tick after it. The test runs both
+ * ticks itself with interrupts disabled, as the tick interrupt does, so the
+ * system tick moves two ticks early.
+ */
+
+#define TIMER_BENCH_PROBES      200
+#define TIMER_BENCH_MAX_TIMEOUT (RT_TICK_MAX / 4)
+
+/* the first level of the wheel wraps every TIMER_WRAP_SIZE ticks */
+#ifndef RT_TIMER_WHEEL_ROOT_BITS
+#define RT_TIMER_WHEEL_ROOT_BITS 5
+#endif
+#define TIMER_WRAP_SIZE         (1UL << RT_TIMER_WHEEL_ROOT_BITS)
+#define TIMER_WRAP_MASK         (TIMER_WRAP_SIZE - 1)
+
+static struct rt_timer *_timers;
+static volatile rt_uint32_t _fired;
+
+static void timer_timeout(void *parameter)
+{
+    _fired ++;
+}
+
+static rt_tick_t timer_random_timeout(void)
+{
+    /* spread the timeouts over all the levels of a wheel */
+    return 1 + ((rt_tick_t)rand() << 8 | (rand() & 0xff)) % TIMER_BENCH_MAX_TIMEOUT;
+}
+
+static void timer_bench(int count)
+{
+    struct rt_timer probe;
+    rt_uint64_t start, cost, worst = 0, total = 0;
+    rt_tick_t timeout;
+    int index;
+
+    for (index = 0; index < count; index ++)
+    {
+        timeout = timer_random_timeout();
+        rt_timer_init(&_timers[index], "bench", timer_timeout, RT_NULL, timeout,
+                      RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+        rt_timer_start(&_timers[index]);
+    }
+
+    rt_timer_init(&probe, "probe", timer_timeout, RT_NULL, 1,
+                  RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+    for (index = 0; index < TIMER_BENCH_PROBES; index ++)
+    {
+        timeout = timer_random_timeout();
+        rt_timer_control(&probe, RT_TIMER_CTRL_SET_TIME, &timeout);
+
+        start = clock_cpu_gettime();
+        rt_timer_start(&probe);
+        rt_timer_stop(&probe);
+        cost = clock_cpu_gettime() - start;
+
+        total += cost;
+        if (cost > worst)
+            worst = cost;
+    }
+    rt_timer_detach(&probe);
+
+    for (index = 0; index < count; index ++)
+    {
+        rt_timer_detach(&_timers[index]);
+    }
+
+    LOG_I("%4d armed timers: start+stop worst %d us, average %d us", count,
+          clock_cpu_microsecond((uint32_t)worst),
+          clock_cpu_microsecond((uint32_t)(total / TIMER_BENCH_PROBES)));
+}
+
+/* run the timers of a tick as the tick interrupt does */
+static rt_uint64_t timer_check_at(rt_tick_t tick)
+{
+    rt_uint64_t start;
+
+    rt_tick_set(tick);
+    start = clock_cpu_gettime();
+    rt_interrupt_enter();
+    rt_timer_check();
+    rt_interrupt_leave();
+
+    return clock_cpu_gettime() - start;
+}
+
+static void timer_wrap_bench(int count)
+{
+    rt_uint64_t wrap_cost = 0, plain_cost = 0;
+    rt_tick_t wrap, timeout;
+    rt_base_t level;
+    rt_bool_t done = RT_FALSE;
+    int index;
+
+    /* all the timers wait in the upper level slot of a wrap, none fire at it */
+    wrap = (rt_tick_get() | TIMER_WRAP_MASK) + 1 + TIMER_WRAP_SIZE;
+    _fired = 0;
+    for (index = 0; index < count; index ++)
+    {
+        timeout = wrap + 1 + index % (TIMER_WRAP_SIZE - 1) - rt_tick_get();
+        rt_timer_init(&_timers[index], "wrap", timer_timeout, RT_NULL, timeout,
+                      RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+        rt_timer_start(&_timers[index]);
+    }
+
+    timeout = wrap - 1 - rt_tick_get();
+    if (timeout < RT_TICK_MAX / 2)
+        rt_thread_delay(timeout);
+    level = rt_hw_interrupt_disable();
+    if (rt_tick_get() + 1 == wrap)
+    {
+        wrap_cost = timer_check_at(wrap);
+        plain_cost = timer_check_at(wrap + 1);
+        done = RT_TRUE;
+    }
+    rt_hw_interrupt_enable(level);
+    uassert_true(done);
+    uassert_int_equal(_fired, 0);
+
+    for (index = 0; index < count; index ++)
+    {
+        rt_timer_detach(&_timers[index]);
+    }
+
+    LOG_I("%4d armed timers: check at a level wrap %d us, at the next tick %d us", count,
+          clock_cpu_microsecond((uint32_t)wrap_cost),
+          clock_cpu_microsecond((uint32_t)plain_cost));
+}
+
+static void test_timer_order(void)
+{
+    struct rt_timer timer[3];
+    rt_tick_t timeout[3] = {30, 10, 20};
+    int index;
+
+    _fired = 0;
+    for (index = 0; index < 3; index ++)
+    {
+        rt_timer_init(&timer[index], "order", timer_timeout, RT_NULL, timeout[index],
+                      RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+        rt_timer_start(&timer[index]);
+    }
+
+    /* the next timeout is the earliest one */
+    uassert_in_range(rt_timer_next_timeout_tick() - rt_tick_get(), 1, 10);
+
+    rt_thread_delay(15);
+    uassert_int_equal(_fired, 1);
+    rt_thread_delay(20);
+    uassert_int_equal(_fired, 3);
+
+    for (index = 0; index < 3; index ++)
+    {
+        rt_timer_detach(&timer[index]);
+    }
+}
+
+static void test_timer_bench(void)
+{
+    timer_bench(10);
+    timer_bench(100);
+    timer_bench(1000);
+
+    timer_wrap_bench(10);
+    timer_wrap_bench(100);
+    timer_wrap_bench(1000);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _timers = (struct rt_timer *)rt_malloc(sizeof(struct rt_timer) * 1000);
+    if (_timers == RT_NULL)
+        return -RT_ENOMEM;
+
+    srand(rt_tick_get());
+
+    return RT_EOK;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_free(_timers);
+    _timers = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+#ifdef RT_TIMER_USING_WHEEL
+    LOG_I("timer backend: timing wheel");
+#else
+    LOG_I("timer backend: skip list");
+#endif
+    UTEST_UNIT_RUN(test_timer_order);
+    UTEST_UNIT_RUN(test_timer_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.kernel.timer_tc", utest_tc_init, utest_tc_cleanup, 60);
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <at.h>
+#include "utest.h"
+
+/*
+ * An AT client runs on a fake modem device, which answers every command
+ * line after a think time of a few ticks: "AT+ECHO=<n>" with "+ECHO: <n>"
+ * and "OK", anything else with "OK". The responses of synchronous,
+ * asynchronous and batch commands must reach the right callers in order,
+ * and the time of a run of commands sent one by one and in batches is
+ * reported.
+ *
+ * The AT client can not be released, so this needs a free client slot
+ * (AT_CLIENT_NUM_MAX) and the fake device stays registered after the test.
+ */
+
+#define AT_TC_DEVICE            "utat"
+#define AT_TC_LATENCY           2
+#define AT_TC_PENDING_NR        16
+#define AT_TC_BENCH_CMDS        32
+
+struct at_tc_pending
+{
+    char text[32];
+    rt_tick_t due;
+};
+
+static struct rt_device _modem;
+static struct rt_ringbuffer _modem_rx;
+static rt_uint8_t _modem_rx_pool[512];
+static struct rt_timer _modem_timer;
+static char _modem_line[64];
+static rt_size_t _modem_line_len;
+static struct at_tc_pending _pending[AT_TC_PENDING_NR];
+static rt_size_t _pending_head, _pending_tail;
+static at_client_t _client;
+
+static struct rt_semaphore _done;
+static int _order[AT_TC_BENCH_CMDS];
+static volatile int _finished;
+
+/* the modem answers the commands in order, once their think time is over */
+static void modem_timeout(void *parameter)
+{
+    rt_size_t length = 0;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    while (_pending_head != _pending_tail &&
+           (rt_int32_t)(rt_tick_get() - _pending[_pending_head % AT_TC_PENDING_NR].due) >= 0)
+    {
+        struct at_tc_pending *pending = &_pending[_pending_head % AT_TC_PENDING_NR];
+
+        length += rt_ringbuffer_put(&_modem_rx, (rt_uint8_t *)pending->text, rt_strlen(pending->text));
+        _pending_head++;
+    }
+    rt_hw_interrupt_enable(level);
+
+    if (length && _modem.rx_indicate)
+    {
+        _modem.rx_indicate(&_modem, rt_ringbuffer_data_len(&_modem_rx));
+    }
+}
+
+static void modem_command(const char *line)
+{
+    struct at_tc_pending *pending;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (_pending_tail - _pending_head < AT_TC_PENDING_NR)
+    {
+        pending = &_pending[_pending_tail % AT_TC_PENDING_NR];
+        if (rt_strncmp(line, "AT+ECHO=", 8) == 0)
+            rt_snprintf(pending->text, sizeof(pending->text), "+ECHO: %s\r\nOK\r\n", line + 8);
+        else
+            rt_strncpy(pending->text, "OK\r\n", sizeof(pending->text));
+        pending->due = rt_tick_get() + AT_TC_LATENCY;
+        _pending_tail++;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+static rt_err_t modem_open(rt_device_t dev, rt_uint16_t oflag)
+{
+    /* no dma, the client falls back to the interrupt mode */
+    if (oflag & RT_DEVICE_FLAG_DMA_RX)
+        return -RT_EIO;
+    return RT_EOK;
+}
+
+static rt_size_t modem_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    size = rt_ringbuffer_get(&_modem_rx, (rt_uint8_t *)buffer, size);
+    rt_hw_interrupt_enable(level);
+
+    return size;
+}
+
+static rt_size_t modem_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    const char *data = (const char *)buffer;
+    rt_size_t index;
+
+    for (index = 0; index < size; index++)
+    {
+        if (data[index] == '\r' || data[index] == '\n')
+        {
+            _modem_line[_modem_line_len] = '\0';
+            if (_modem_line_len)
+                modem_command(_modem_line);
+            _modem_line_len = 0;
+        }
+        else if (_modem_line_len < sizeof(_modem_line) - 1)
+        {
+            _modem_line[_modem_line_len++] = data[index];
+        }
+    }
+
+    return size;
+}
+
+#ifdef RT_USING_DEVICE_OPS
+static const struct rt_device_ops _modem_ops =
+{
+    RT_NULL,
+    modem_open,
+    RT_NULL,
+    modem_read,
+    modem_write,
+    RT_NULL,
+};
+#endif
+
+static int echo_value(at_response_t resp)
+{
+    int value = -1;
+
+    at_resp_parse_line_args_by_kw(resp, "+ECHO:", "+ECHO: %d", &value);
+    return value;
+}
+
+static void test_at_sync(void)
+{
+    at_response_t resp;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(1000));
+    uassert_not_null(resp);
+
+    uassert_int_equal(at_obj_exec_cmd(_client, resp, "AT+ECHO=%d", 7), RT_EOK);
+    uassert_int_equal(echo_value(resp), 7);
+    uassert_int_equal(at_obj_exec_cmd(_client, resp, "AT"), RT_EOK);
+
+    at_delete_resp(resp);
+}
+
+static void at_tc_cb(struct at_client *client, at_response_t resp, at_resp_status_t status, void *user_data)
+{
+    /* the callbacks run in the sending order on the parser thread */
+    _order[_finished++] = (status == AT_RESP_OK) ? echo_value(resp) : -1;
+    if (_finished == (int)(rt_ubase_t)user_data)
+        rt_sem_release(&_done);
+}
+
+static void at_tc_run(int count, rt_bool_t batch)
+{
+    at_response_t resp[AT_TC_BENCH_CMDS];
+    int index;
+
+    _finished = 0;
+    for (index = 0; index < count; index++)
+    {
+        resp[index] = at_create_resp(64, 0, rt_tick_from_millisecond(1000));
+        uassert_not_null(resp[index]);
+    }
+
+    for (index = 0; index < count; index++)
+    {
+        if (batch)
+            at_obj_exec_cmd_batch(_client, resp[index], at_tc_cb, (void *)(rt_ubase_t)count, "AT+ECHO=%d", index);
+        else
+            at_obj_exec_cmd_async(_client, resp[index], at_tc_cb, (void *)(rt_ubase_t)count, "AT+ECHO=%d", index);
+    }
+    uassert_int_equal(rt_sem_take(&_done, rt_tick_from_millisecond(5000)), RT_EOK);
+
+    for (index = 0; index < count; index++)
+    {
+        uassert_int_equal(_order[index], index);
+        at_delete_resp(resp[index]);
+    }
+}
+
+static void test_at_async(void)
+{
+    at_tc_run(4, RT_FALSE);
+    /* a synchronous command after them gets its own response */
+    test_at_sync();
+}
+
+static void test_at_batch(void)
+{
+    at_tc_run(AT_TC_BENCH_CMDS, RT_TRUE);
+    test_at_sync();
+}
+
+static void test_at_bench(void)
+{
+    at_response_t resp;
+    rt_tick_t tick, sync_tick;
+    int index;
+
+    resp = at_create_resp(64, 0, rt_tick_from_millisecond(1000));
+    uassert_not_null(resp);
+
+    tick = rt_tick_get();
+    for (index = 0; index < AT_TC_BENCH_CMDS; index++)
+    {
+        at_obj_exec_cmd(_client, resp, "AT+ECHO=%d", index);
+    }
+    sync_tick = rt_tick_get() - tick;
+    at_delete_resp(resp);
+
+    tick = rt_tick_get();
+    at_tc_run(AT_TC_BENCH_CMDS, RT_TRUE);
+    tick = rt_tick_get() - tick;
+
+    LOG_I("%d commands, %d ticks modem latency: one by one %d ms, batch of %d %d ms",
+          AT_TC_BENCH_CMDS, AT_TC_LATENCY, sync_tick * 1000 / RT_TICK_PER_SECOND,
+          AT_CLIENT_BATCH_MAX, tick * 1000 / RT_TICK_PER_SECOND);
+    uassert_true(AT_CLIENT_BATCH_MAX == 1 || tick < sync_tick);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    rt_err_t ret;
+
+    rt_sem_init(&_done, "atcd", 0, RT_IPC_FLAG_PRIO);
+
+    /* the client of an earlier run is still there */
+    if (rt_device_find(AT_TC_DEVICE) != RT_NULL)
+    {
+        _client = at_client_get(AT_TC_DEVICE);
+        return _client ? RT_EOK : -RT_ERROR;
+    }
+
+    rt_ringbuffer_init(&_modem_rx, _modem_rx_pool, sizeof(_modem_rx_pool));
+    rt_timer_init(&_modem_timer, "atcm", modem_timeout, RT_NULL, 1, RT_TIMER_FLAG_PERIODIC);
+    rt_timer_start(&_modem_timer);
+
+    _modem.type = RT_Device_Class_Char;
+#ifdef RT_USING_DEVICE_OPS
+    _modem.ops = &_modem_ops;
+#else
+    _modem.open = modem_open;
+    _modem.read = modem_read;
+    _modem.write = modem_write;
+#endif
+    ret = rt_device_register(&_modem, AT_TC_DEVICE, RT_DEVICE_FLAG_RDWR | RT_DEVICE_FLAG_INT_RX);
+    if (ret != RT_EOK)
+        return ret;
+
+    ret = at_client_init(AT_TC_DEVICE, 128);
+    if (ret != RT_EOK)
+        return ret;
+
+    _client = at_client_get(AT_TC_DEVICE);
+    return _client ? RT_EOK : -RT_ERROR;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_done);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_at_sync);
+    UTEST_UNIT_RUN(test_at_async);
+    UTEST_UNIT_RUN(test_at_batch);
+    UTEST_UNIT_RUN(test_at_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.net.at_client_tc", utest_tc_init, utest_tc_cleanup, 30);
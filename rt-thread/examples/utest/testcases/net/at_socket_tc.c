@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <rtdevice.h>
+#include <at_device.h>
+#include <arpa/inet.h>
+#include <netdev.h>
+#include <af_inet.h>
+#include "utest.h"
+
+/*
+ * An AT socket runs on a fake AT device, whose network interface is made the
+ * default one for the test. The device pushes more data than the receive
+ * buffer and its overflow queue hold: the data beyond them must be dropped
+ * and counted while the heap stays flat, the data kept must be read in order,
+ * and the device must be told to resume once the buffer has space again.
+ *
+ * The AT device can not be released, so it stays registered after the test,
+ * its network interface is removed.
+ */
+
+#define AT_SKT_TC_NAME          "utskt"
+#define AT_SKT_TC_CLASS         0xFEU
+#define AT_SKT_TC_CHUNK         64
+#define AT_SKT_TC_EXTRA         (10 * AT_SKT_TC_CHUNK)
+
+static struct at_device_class _class;
+static struct at_device _device;
+static struct netdev _netdev;
+static struct netdev *_default;
+static rt_bool_t _registered;
+static int _socket = -1;
+static rt_uint32_t _resumed;
+static rt_size_t _resume_space;
+static rt_uint32_t _pushed;
+
+static int skt_init(struct at_device *device)
+{
+    device->client = at_client_get_first();
+    return RT_EOK;
+}
+
+static int skt_connect(struct at_socket *socket, char *ip, int32_t port, enum at_socket_type type, rt_bool_t is_client)
+{
+    return RT_EOK;
+}
+
+static int skt_close(struct at_socket *socket)
+{
+    return RT_EOK;
+}
+
+static int skt_send(struct at_socket *socket, const char *buff, size_t bfsz, enum at_socket_type type)
+{
+    return bfsz;
+}
+
+static void skt_set_event_cb(at_socket_evt_t event, at_evt_cb_t cb)
+{
+}
+
+static void skt_recv_resume(struct at_socket *socket, size_t space)
+{
+    _resumed++;
+    _resume_space = space;
+}
+
+static const struct at_device_ops _device_ops =
+{
+    skt_init,
+    RT_NULL,
+    RT_NULL,
+};
+
+static const struct at_socket_ops _socket_ops =
+{
+    skt_connect,
+    skt_close,
+    skt_send,
+    RT_NULL,
+    skt_set_event_cb,
+    RT_NULL,
+#ifdef AT_USING_SOCKET_SERVER
+    RT_NULL,
+#endif
+    skt_recv_resume,
+};
+
+static const struct netdev_ops _netdev_ops;
+
+/* push the next size bytes of the pattern as the device does */
+static size_t skt_push(struct at_socket *sock, rt_size_t size)
+{
+    char buf[AT_SKT_TC_CHUNK];
+    rt_size_t index;
+
+    for (index = 0; index < size; index++)
+        buf[index] = (char)((_pushed + index) * 7);
+    _pushed += size;
+
+    return at_socket_recv_data(sock, buf, size);
+}
+
+static void test_at_socket_overrun(void)
+{
+    struct at_socket *sock;
+    rt_size_t total, used, used_full, max_used, stored = 0, dropped = 0;
+    char buf[AT_SKT_TC_CHUNK];
+    int index, len, errors = 0;
+    rt_uint32_t pos = 0;
+
+    sock = at_get_socket(_socket);
+    uassert_not_null(sock);
+    _pushed = 0;
+    _resumed = 0;
+
+    /* the receive buffer and the overflow queue are filled */
+    while (at_socket_recv_space(sock) > 0 || sock->recv_overflow_len < AT_SOCKET_RECV_OVERFLOW_MAX)
+    {
+        len = skt_push(sock, AT_SKT_TC_CHUNK);
+        stored += len;
+        if (len < AT_SKT_TC_CHUNK)
+        {
+            dropped += AT_SKT_TC_CHUNK - len;
+            break;
+        }
+    }
+    uassert_int_equal(stored, AT_SOCKET_RECV_BFSZ + AT_SOCKET_RECV_OVERFLOW_MAX);
+    uassert_int_equal(at_socket_recv_space(sock), 0);
+
+    /* the data beyond them is dropped, without taking more memory */
+    rt_memory_info(&total, &used_full, &max_used);
+    for (index = 0; index < AT_SKT_TC_EXTRA / AT_SKT_TC_CHUNK; index++)
+    {
+        dropped += AT_SKT_TC_CHUNK - skt_push(sock, AT_SKT_TC_CHUNK);
+    }
+    rt_memory_info(&total, &used, &max_used);
+    uassert_int_equal(used, used_full);
+    uassert_int_equal(dropped, AT_SKT_TC_EXTRA);
+    uassert_int_equal(sock->recv_drop, dropped);
+    uassert_int_equal(_resumed, 0);
+
+    /* the data kept is read in order */
+    while (stored > 0)
+    {
+        len = at_recv(_socket, buf, sizeof(buf), 0);
+        if (len <= 0)
+            break;
+        for (index = 0; index < len; index++)
+        {
+            if (buf[index] != (char)((pos + index) * 7))
+                errors++;
+        }
+        pos += len;
+        stored -= len;
+    }
+    uassert_int_equal(stored, 0);
+    uassert_int_equal(errors, 0);
+
+    /* the device is told once the buffer has space again */
+    uassert_int_equal(_resumed, 1);
+    uassert_true(_resume_space >= AT_SOCKET_RECV_BFSZ / 2);
+    uassert_int_equal(at_socket_recv_space(sock), AT_SOCKET_RECV_BFSZ);
+
+    /* the overflow queue is released */
+    rt_memory_info(&total, &used, &max_used);
+    uassert_true(used < used_full);
+}
+
+/* a device which requests no more than the space never queues data */
+static void test_at_socket_flow(void)
+{
+    struct at_socket *sock;
+    rt_size_t space, total, used, used_start, max_used;
+    char buf[AT_SKT_TC_CHUNK];
+    int round, len, read_len;
+
+    sock = at_get_socket(_socket);
+    uassert_not_null(sock);
+    _pushed = 0;
+
+    rt_memory_info(&total, &used_start, &max_used);
+    for (round = 0; round < 8; round++)
+    {
+        while ((space = at_socket_recv_space(sock)) > 0)
+        {
+            len = space < AT_SKT_TC_CHUNK ? space : AT_SKT_TC_CHUNK;
+            uassert_int_equal(skt_push(sock, len), len);
+        }
+        uassert_int_equal(sock->recv_overflow_len, 0);
+
+        for (read_len = 0; read_len < AT_SOCKET_RECV_BFSZ; read_len += len)
+        {
+            len = at_recv(_socket, buf, sizeof(buf), 0);
+            if (len <= 0)
+                break;
+        }
+        uassert_int_equal(read_len, AT_SOCKET_RECV_BFSZ);
+    }
+    rt_memory_info(&total, &used, &max_used);
+    uassert_int_equal(used, used_start);
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    struct sockaddr_in addr;
+
+    if (_registered == RT_FALSE)
+    {
+        /* the device must have a client, the lookups by a client name use it */
+        if (at_client_get_first() == RT_NULL)
+            return -RT_ERROR;
+
+        _class.device_ops = &_device_ops;
+        _class.socket_num = 1;
+        _class.socket_ops = &_socket_ops;
+        at_device_class_register(&_class, AT_SKT_TC_CLASS);
+        if (at_device_register(&_device, AT_SKT_TC_NAME, AT_SKT_TC_NAME, AT_SKT_TC_CLASS, RT_NULL) != RT_EOK)
+            return -RT_ERROR;
+        _registered = RT_TRUE;
+    }
+
+    /* the network interface of the device is the default one for the test */
+    rt_memset(&_netdev, 0, sizeof(_netdev));
+    _netdev.ops = &_netdev_ops;
+    sal_at_netdev_set_pf_info(&_netdev);
+    if (netdev_register(&_netdev, AT_SKT_TC_NAME, RT_NULL) != RT_EOK)
+        return -RT_ERROR;
+    netdev_low_level_set_status(&_netdev, RT_TRUE);
+    _default = netdev_default;
+    netdev_default = &_netdev;
+
+    _socket = at_socket(AF_AT, SOCK_STREAM, 0);
+    if (_socket < 0)
+        return -RT_ERROR;
+
+    rt_memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(80);
+    addr.sin_addr.s_addr = inet_addr("192.168.1.1");
+
+    return at_connect(_socket, (struct sockaddr *)&addr, sizeof(addr)) == 0 ? RT_EOK : -RT_ERROR;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    if (_socket >= 0)
+    {
+        at_closesocket(_socket);
+        _socket = -1;
+    }
+
+    netdev_default = _default;
+    netdev_unregister(&_netdev);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_at_socket_overrun);
+    UTEST_UNIT_RUN(test_at_socket_flow);
+}
+UTEST_TC_EXPORT(testcase, "testcases.net.at_socket_tc", utest_tc_init, utest_tc_cleanup, 30);
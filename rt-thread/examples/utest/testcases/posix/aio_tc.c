@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/errno.h>
+#include <aio.h>
+#include "utest.h"
+
+/*
+ * The requests run on a pipe, a read of the empty pipe keeps the aio thread
+ * busy until the test writes to it. A SIGEV_THREAD notification must run on
+ * a thread of its own, a signal must not be sent to a thread which exited
+ * after its submission, and a long aio_suspend() timeout must not wrap to a
+ * short or negative one.
+ */
+
+static int _fds[2] = {-1, -1};
+static struct rt_semaphore _notified;
+static rt_thread_t _notify_thread;
+static struct aiocb _cb;
+static char _buf[16];
+
+static void aio_tc_notify(union sigval value)
+{
+    _notify_thread = rt_thread_self();
+    rt_sem_release((rt_sem_t)value.sival_ptr);
+}
+
+static void aio_tc_read(struct sigevent *sig)
+{
+    rt_memset(&_cb, 0, sizeof(_cb));
+    _cb.aio_fildes = _fds[0];
+    _cb.aio_buf = _buf;
+    _cb.aio_nbytes = 1;
+    if (sig)
+        _cb.aio_sigevent = *sig;
+}
+
+static void aio_tc_wait(void)
+{
+    int loop;
+
+    for (loop = 0; loop < 100 && aio_error(&_cb) == -EINPROGRESS; loop++)
+    {
+        rt_thread_mdelay(10);
+    }
+}
+
+static void test_aio_sigev_thread(void)
+{
+    struct sigevent sig;
+
+    rt_memset(&sig, 0, sizeof(sig));
+    sig.sigev_notify = SIGEV_THREAD;
+    sig.sigev_notify_function = aio_tc_notify;
+    sig.sigev_value.sival_ptr = &_notified;
+
+    aio_tc_read(&sig);
+    _notify_thread = RT_NULL;
+    uassert_int_equal(aio_read(&_cb), 0);
+    uassert_int_equal(write(_fds[1], "x", 1), 1);
+
+    uassert_int_equal(rt_sem_take(&_notified, rt_tick_from_millisecond(1000)), RT_EOK);
+    uassert_int_equal(aio_return(&_cb), 1);
+    uassert_not_null(_notify_thread);
+    uassert_true(_notify_thread != rt_thread_self());
+    uassert_true(_notify_thread != rt_thread_find("aio"));
+}
+
+static void aio_tc_writer(void *parameter)
+{
+    rt_thread_mdelay(20);
+    write(_fds[1], "x", 1);
+}
+
+static void test_aio_suspend_timeout(void)
+{
+    const struct aiocb *list[1] = {&_cb};
+    struct timespec timeout;
+    rt_thread_t writer;
+    rt_tick_t tick;
+
+    aio_tc_read(RT_NULL);
+    uassert_int_equal(aio_read(&_cb), 0);
+
+    /* a short timeout expires */
+    timeout.tv_sec = 0;
+    timeout.tv_nsec = 50 * 1000000;
+    tick = rt_tick_get();
+    uassert_int_not_equal(aio_suspend(list, 1, &timeout), 0);
+    uassert_true(rt_tick_get() - tick >= rt_tick_from_millisecond(50));
+
+    timeout.tv_nsec = 1000000000;
+    uassert_int_equal(aio_suspend(list, 1, &timeout), -EINVAL);
+
+    /* tv_sec * 1000 does not fit in 32 bits, the wait lasts until the read is done */
+    writer = rt_thread_create("aiow", aio_tc_writer, RT_NULL, 1024, UTEST_THR_PRIORITY, 10);
+    uassert_not_null(writer);
+    rt_thread_startup(writer);
+
+    timeout.tv_sec = 2147484;
+    timeout.tv_nsec = 0;
+    uassert_int_equal(aio_suspend(list, 1, &timeout), 0);
+    uassert_int_equal(aio_return(&_cb), 1);
+}
+
+#ifdef RT_USING_SIGNALS
+static void aio_tc_submitter(void *parameter)
+{
+    struct sigevent sig;
+
+    rt_memset(&sig, 0, sizeof(sig));
+    sig.sigev_notify = SIGEV_SIGNAL;
+    sig.sigev_signo = SIGUSR1;
+
+    aio_tc_read(&sig);
+    aio_read(&_cb);
+    rt_sem_release(&_notified);
+}
+
+static void test_aio_signal_exited(void)
+{
+    rt_thread_t submitter;
+
+    submitter = rt_thread_create("aios", aio_tc_submitter, RT_NULL, 1024, UTEST_THR_PRIORITY, 10);
+    uassert_not_null(submitter);
+    rt_thread_startup(submitter);
+    uassert_int_equal(rt_sem_take(&_notified, rt_tick_from_millisecond(1000)), RT_EOK);
+
+    /* let the idle thread clean the submitter up */
+    rt_thread_mdelay(50);
+
+    uassert_int_equal(write(_fds[1], "x", 1), 1);
+    aio_tc_wait();
+    uassert_int_equal(aio_return(&_cb), 1);
+}
+#endif
+
+static rt_err_t utest_tc_init(void)
+{
+    if (pipe(_fds) < 0)
+        return -RT_ENOMEM;
+
+    return rt_sem_init(&_notified, "aiot", 0, RT_IPC_FLAG_PRIO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    rt_sem_detach(&_notified);
+    if (_fds[0] >= 0)
+    {
+        close(_fds[0]);
+        close(_fds[1]);
+    }
+    _fds[0] = _fds[1] = -1;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_aio_sigev_thread);
+    UTEST_UNIT_RUN(test_aio_suspend_timeout);
+#ifdef RT_USING_SIGNALS
+    UTEST_UNIT_RUN(test_aio_signal_exited);
+#endif
+}
+UTEST_TC_EXPORT(testcase, "testcases.posix.aio_tc", utest_tc_init, utest_tc_cleanup, 10);
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <cputime.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <dfs.h>
+#include "utest.h"
+
+/*
+ * A pipe closed while it is watched by an epoll instance must be detached
+ * from it, the instance must not touch the pipe after that.
+ *
+ * The time to find the one ready descriptor in sets of 8, 32 and 128 is
+ * reported for epoll_wait() and poll(). A set of N descriptors is made of
+ * N / 2 pipes with both ends watched for input, a set which does not fit in
+ * DFS_FD_MAX is skipped. The time from a write of another thread to the
+ * return of a blocking epoll_wait() and poll() is reported too.
+ */
+
+#define EPOLL_BENCH_LOOPS       500
+#define EPOLL_BENCH_SET_MAX     128
+#define EPOLL_WAKE_LOOPS        100
+
+static int _pipes[EPOLL_BENCH_SET_MAX / 2][2];
+static int _pipe_count;
+static int _epfd = -1;
+static struct rt_semaphore _go;
+static volatile rt_uint64_t _stamp;
+
+static void test_epoll_close(void)
+{
+    struct epoll_event event;
+    int fds[2];
+
+    uassert_int_equal(pipe(fds), 0);
+    event.events = EPOLLIN;
+    event.data.fd = fds[0];
+    uassert_int_equal(epoll_ctl(_epfd, EPOLL_CTL_ADD, fds[0], &event), 0);
+
+    /* ready, then closed without EPOLL_CTL_DEL, the pipe goes away */
+    uassert_int_equal(write(fds[1], "x", 1), 1);
+    close(fds[0]);
+    close(fds[1]);
+
+    uassert_int_equal(epoll_wait(_epfd, &event, 1, 0), 0);
+    uassert_int_equal(epoll_ctl(_epfd, EPOLL_CTL_DEL, fds[0], RT_NULL), -1);
+
+    /* the descriptor numbers come back, they are not in the set any more */
+    uassert_int_equal(pipe(fds), 0);
+    event.events = EPOLLIN;
+    event.data.fd = fds[0];
+    uassert_int_equal(epoll_ctl(_epfd, EPOLL_CTL_ADD, fds[0], &event), 0);
+    uassert_int_equal(write(fds[1], "x", 1), 1);
+    uassert_int_equal(epoll_wait(_epfd, &event, 1, 0), 1);
+    uassert_int_equal(event.data.fd, fds[0]);
+    uassert_int_equal(epoll_ctl(_epfd, EPOLL_CTL_DEL, fds[0], RT_NULL), 0);
+    close(fds[0]);
+    close(fds[1]);
+}
+
+static void epoll_bench_close(void)
+{
+    while (_pipe_count > 0)
+    {
+        _pipe_count--;
+        close(_pipes[_pipe_count][0]);
+        close(_pipes[_pipe_count][1]);
+    }
+}
+
+/* the time to find the one ready descriptor of a set */
+static void epoll_bench_set(int size)
+{
+    struct pollfd pfds[EPOLL_BENCH_SET_MAX];
+    struct epoll_event event;
+    rt_uint64_t start, epoll_time = 0, poll_time = 0;
+    int index, loop, errors = 0;
+    char ch;
+
+    for (_pipe_count = 0; _pipe_count < size / 2; _pipe_count++)
+    {
+        if (pipe(_pipes[_pipe_count]) < 0)
+        {
+            epoll_bench_close();
+            LOG_I("%3d descriptors: skipped, out of DFS_FD_MAX %d", size, DFS_FD_MAX);
+            return;
+        }
+    }
+
+    for (index = 0; index < size; index++)
+    {
+        event.events = EPOLLIN;
+        event.data.u32 = index;
+        uassert_int_equal(epoll_ctl(_epfd, EPOLL_CTL_ADD, _pipes[index / 2][index % 2], &event), 0);
+        pfds[index].fd = _pipes[index / 2][index % 2];
+        pfds[index].events = POLLIN;
+    }
+
+    for (loop = 0; loop < EPOLL_BENCH_LOOPS; loop++)
+    {
+        /* the read end of a pipe */
+        index = loop % (size / 2);
+
+        write(_pipes[index][1], "x", 1);
+        start = clock_cpu_gettime();
+        if (epoll_wait(_epfd, &event, 1, 0) != 1 || event.data.u32 != index * 2)
+            errors++;
+        epoll_time += clock_cpu_gettime() - start;
+        read(_pipes[index][0], &ch, 1);
+
+        write(_pipes[index][1], "x", 1);
+        start = clock_cpu_gettime();
+        if (poll(pfds, size, 0) != 1 || !(pfds[index * 2].revents & POLLIN))
+            errors++;
+        poll_time += clock_cpu_gettime() - start;
+        read(_pipes[index][0], &ch, 1);
+    }
+    uassert_int_equal(errors, 0);
+
+    for (index = 0; index < size; index++)
+    {
+        epoll_ctl(_epfd, EPOLL_CTL_DEL, _pipes[index / 2][index % 2], RT_NULL);
+    }
+    epoll_bench_close();
+
+    LOG_I("%3d descriptors, one ready: epoll_wait %d ns, poll %d ns", size,
+          clock_cpu_microsecond((uint32_t)(epoll_time * 1000 / EPOLL_BENCH_LOOPS)),
+          clock_cpu_microsecond((uint32_t)(poll_time * 1000 / EPOLL_BENCH_LOOPS)));
+}
+
+static void test_epoll_bench(void)
+{
+    epoll_bench_set(8);
+    epoll_bench_set(32);
+    epoll_bench_set(EPOLL_BENCH_SET_MAX);
+}
+
+/* runs once the test thread blocks, and wakes it with a write */
+static void epoll_writer(void *parameter)
+{
+    int loop;
+
+    for (loop = 0; loop < EPOLL_WAKE_LOOPS; loop++)
+    {
+        rt_sem_take(&_go, RT_WAITING_FOREVER);
+        _stamp = clock_cpu_gettime();
+        write(_pipes[0][1], "x", 1);
+    }
+}
+
+/* the time from the write to the return of a blocking wait */
+static rt_uint64_t epoll_bench_wake(rt_bool_t use_poll)
+{
+    struct epoll_event event;
+    struct pollfd pfd;
+    rt_thread_t thread;
+    rt_uint64_t total = 0;
+    int loop, result, errors = 0;
+    char ch;
+
+    thread = rt_thread_create("epwr", epoll_writer, RT_NULL, 1024, UTEST_THR_PRIORITY + 1, 10);
+    uassert_not_null(thread);
+    rt_thread_startup(thread);
+
+    pfd.fd = _pipes[0][0];
+    pfd.events = POLLIN;
+    for (loop = 0; loop < EPOLL_WAKE_LOOPS; loop++)
+    {
+        rt_sem_release(&_go);
+        if (use_poll)
+            result = poll(&pfd, 1, -1);
+        else
+            result = epoll_wait(_epfd, &event, 1, -1);
+        total += clock_cpu_gettime() - _stamp;
+        if (result != 1)
+            errors++;
+        read(_pipes[0][0], &ch, 1);
+    }
+    uassert_int_equal(errors, 0);
+
+    return total / EPOLL_WAKE_LOOPS;
+}
+
+static void test_epoll_wake(void)
+{
+    struct epoll_event event;
+    rt_uint64_t epoll_time, poll_time;
+
+    uassert_int_equal(pipe(_pipes[0]), 0);
+    _pipe_count = 1;
+
+    event.events = EPOLLIN;
+    event.data.u32 = 0;
+    uassert_int_equal(epoll_ctl(_epfd, EPOLL_CTL_ADD, _pipes[0][0], &event), 0);
+    epoll_time = epoll_bench_wake(RT_FALSE);
+    epoll_ctl(_epfd, EPOLL_CTL_DEL, _pipes[0][0], RT_NULL);
+    poll_time = epoll_bench_wake(RT_TRUE);
+    epoll_bench_close();
+
+    LOG_I("blocking wait woken by a write: epoll_wait %d ns, poll %d ns",
+          clock_cpu_microsecond((uint32_t)(epoll_time * 1000)),
+          clock_cpu_microsecond((uint32_t)(poll_time * 1000)));
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    _pipe_count = 0;
+    _epfd = epoll_create(1);
+    if (_epfd < 0)
+        return -RT_ERROR;
+
+    return rt_sem_init(&_go, "epgo", 0, RT_IPC_FLAG_PRIO);
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    epoll_bench_close();
+    if (_epfd >= 0)
+        close(_epfd);
+    _epfd = -1;
+    rt_sem_detach(&_go);
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_epoll_close);
+    UTEST_UNIT_RUN(test_epoll_bench);
+    UTEST_UNIT_RUN(test_epoll_wake);
+}
+UTEST_TC_EXPORT(testcase, "testcases.posix.epoll_tc", utest_tc_init, utest_tc_cleanup, 10);
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+#include <cputime.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include "utest.h"
+
+/*
+ * Copy a file with sendfile() and through a pipe with splice(), and check
+ * the data, the offsets and the file positions. The time to copy the file
+ * with sendfile() is reported against a read()/write() loop with a user
+ * buffer of the same size as the kernel one. The files are created in
+ * UTEST_SENDFILE_TC_DIR, which must be on a writable file system.
+ */
+
+#ifndef SENDFILE_CHUNK_SIZE
+#define SENDFILE_CHUNK_SIZE     1024
+#endif
+
+#define SENDFILE_TC_SIZE        4096
+#define SENDFILE_BENCH_LOOPS    8
+#define SENDFILE_TC_PATH_MAX    64
+
+static char _in_path[SENDFILE_TC_PATH_MAX];
+static char _out_path[SENDFILE_TC_PATH_MAX];
+static rt_uint8_t *_data;
+static rt_uint8_t *_check;
+
+/* the output file must hold the whole test data */
+static void sendfile_tc_verify(void)
+{
+    int fd;
+
+    rt_memset(_check, 0, SENDFILE_TC_SIZE);
+    fd = open(_out_path, O_RDONLY, 0);
+    uassert_true(fd >= 0);
+    uassert_int_equal(read(fd, _check, SENDFILE_TC_SIZE), SENDFILE_TC_SIZE);
+    close(fd);
+    uassert_buf_equal(_check, _data, SENDFILE_TC_SIZE);
+}
+
+static void test_sendfile_file(void)
+{
+    off_t offset;
+    int in, out;
+
+    in = open(_in_path, O_RDONLY, 0);
+    out = open(_out_path, O_WRONLY | O_CREAT | O_TRUNC, 0);
+    uassert_true(in >= 0 && out >= 0);
+
+    /* from the file position */
+    uassert_int_equal(sendfile(out, in, RT_NULL, 100), 100);
+    uassert_int_equal(lseek(in, 0, SEEK_CUR), 100);
+
+    /* from an offset, the file position is left alone */
+    offset = 100;
+    uassert_int_equal(sendfile(out, in, &offset, SENDFILE_TC_SIZE), SENDFILE_TC_SIZE - 100);
+    uassert_int_equal(offset, SENDFILE_TC_SIZE);
+    uassert_int_equal(lseek(in, 0, SEEK_CUR), 100);
+
+    /* at the end of the file */
+    uassert_int_equal(sendfile(out, in, &offset, 16), 0);
+
+    /* splice() needs a pipe at one end */
+    uassert_int_equal(splice(in, RT_NULL, out, RT_NULL, 16, 0), -1);
+
+    close(in);
+    close(out);
+    sendfile_tc_verify();
+}
+
+static void test_splice_pipe(void)
+{
+    int in, out, fds[2];
+    size_t moved = 0;
+    ssize_t len;
+
+    in = open(_in_path, O_RDONLY, 0);
+    out = open(_out_path, O_WRONLY | O_CREAT | O_TRUNC, 0);
+    uassert_true(in >= 0 && out >= 0);
+    uassert_int_equal(pipe(fds), 0);
+
+    /* a pipe can not be spliced to itself */
+    uassert_int_equal(splice(fds[0], RT_NULL, fds[1], RT_NULL, 16, SPLICE_F_NONBLOCK), -1);
+
+    /* the file goes through the pipe in pieces of the pipe size */
+    while (moved < SENDFILE_TC_SIZE)
+    {
+        len = splice(in, RT_NULL, fds[1], RT_NULL, SENDFILE_TC_SIZE - moved, SPLICE_F_NONBLOCK);
+        if (len <= 0)
+            break;
+        uassert_int_equal(splice(fds[0], RT_NULL, out, RT_NULL, len, SPLICE_F_NONBLOCK), len);
+        moved += len;
+    }
+    uassert_int_equal(moved, SENDFILE_TC_SIZE);
+
+    /* nothing left in the pipe */
+    uassert_int_equal(splice(fds[0], RT_NULL, out, RT_NULL, 16, SPLICE_F_NONBLOCK), -1);
+
+    close(fds[0]);
+    close(fds[1]);
+    close(in);
+    close(out);
+    sendfile_tc_verify();
+}
+
+static rt_uint64_t sendfile_bench(rt_bool_t kernel)
+{
+    rt_uint8_t *buf = _check;
+    rt_uint64_t start, total = 0;
+    int in, out, loop, len;
+
+    for (loop = 0; loop < SENDFILE_BENCH_LOOPS; loop++)
+    {
+        in = open(_in_path, O_RDONLY, 0);
+        out = open(_out_path, O_WRONLY | O_CREAT | O_TRUNC, 0);
+
+        start = clock_cpu_gettime();
+        if (kernel)
+        {
+            sendfile(out, in, RT_NULL, SENDFILE_TC_SIZE);
+        }
+        else
+        {
+            while ((len = read(in, buf, SENDFILE_CHUNK_SIZE)) > 0)
+                write(out, buf, len);
+        }
+        total += clock_cpu_gettime() - start;
+
+        close(in);
+        close(out);
+    }
+
+    return total / SENDFILE_BENCH_LOOPS;
+}
+
+static void test_sendfile_bench(void)
+{
+    LOG_I("copy %d bytes: read/write %d us, sendfile %d us", SENDFILE_TC_SIZE,
+          clock_cpu_microsecond((uint32_t)sendfile_bench(RT_FALSE)),
+          clock_cpu_microsecond((uint32_t)sendfile_bench(RT_TRUE)));
+    sendfile_tc_verify();
+}
+
+static rt_err_t utest_tc_init(void)
+{
+    int fd, index;
+
+    rt_snprintf(_in_path, sizeof(_in_path), "%s/sf_in.tmp", UTEST_SENDFILE_TC_DIR);
+    rt_snprintf(_out_path, sizeof(_out_path), "%s/sf_out.tmp", UTEST_SENDFILE_TC_DIR);
+
+    _data = (rt_uint8_t *)rt_malloc(SENDFILE_TC_SIZE);
+    _check = (rt_uint8_t *)rt_malloc(SENDFILE_TC_SIZE);
+    if (_data == RT_NULL || _check == RT_NULL)
+        return -RT_ENOMEM;
+
+    for (index = 0; index < SENDFILE_TC_SIZE; index++)
+        _data[index] = (rt_uint8_t)(index * 7 + (index >> 8));
+
+    fd = open(_in_path, O_WRONLY | O_CREAT | O_TRUNC, 0);
+    if (fd < 0)
+        return -RT_ERROR;
+    index = write(fd, _data, SENDFILE_TC_SIZE);
+    close(fd);
+
+    return index == SENDFILE_TC_SIZE ? RT_EOK : -RT_ERROR;
+}
+
+static rt_err_t utest_tc_cleanup(void)
+{
+    unlink(_in_path);
+    unlink(_out_path);
+    rt_free(_data);
+    rt_free(_check);
+    _data = _check = RT_NULL;
+
+    return RT_EOK;
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_sendfile_file);
+    UTEST_UNIT_RUN(test_splice_pipe);
+    UTEST_UNIT_RUN(test_sendfile_bench);
+}
+UTEST_TC_EXPORT(testcase, "testcases.posix.sendfile_tc", utest_tc_init, utest_tc_cleanup, 30);
@@ -415,6 +415,9 @@ struct rt_object
     void      *module_id;                               /**< id of application module */
 #endif /* RT_USING_MODULE */
     rt_list_t  list;                                    /**< list node of kernel object */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object *hash_next;                        /**< next object in the same hash bucket */
+#endif /* RT_USING_OBJECT_HASH */
 };
 typedef struct rt_object *rt_object_t;                  /**< Type for kernel objects. */
 
@@ -634,6 +637,25 @@ struct rt_cpu
 
 #endif /* RT_USING_SMP */
 
+#ifdef RT_USING_THREAD_STAT
+#define RT_THREAD_STAT_HIST_NUM         32                  /**< buckets of latency histogram */
+
+/**
+ * Thread run time and scheduling latency statistics, in CPU time counts
+ */
+struct rt_thread_stat
+{
+    rt_uint64_t run_time;                               /**< accumulated running time */
+    rt_uint64_t ready_time;                             /**< time of becoming ready, 0 when not waiting */
+    rt_uint64_t latency_sum;                            /**< sum of ready-to-run latency */
+    rt_uint32_t latency_max;                            /**< maximal ready-to-run latency */
+    rt_uint32_t latency_count;                          /**< number of latency samples */
+    rt_uint32_t run_count;                              /**< times of being switched in */
+    rt_uint32_t id;                                     /**< serial number of the thread, kept across reset */
+    rt_uint16_t latency_hist[RT_THREAD_STAT_HIST_NUM];  /**< bucket n counts latency in [2^n, 2^(n+1)) */
+};
+#endif /* RT_USING_THREAD_STAT */
+
 /**
  * Thread structure
  */
@@ -711,6 +733,10 @@ struct rt_thread
     rt_uint64_t  duration_tick;                         /**< cpu usage tick */
 #endif /* RT_USING_CPU_USAGE */
 
+#ifdef RT_USING_THREAD_STAT
+    struct rt_thread_stat sched_stat;                   /**< run time and latency statistics */
+#endif /* RT_USING_THREAD_STAT */
+
 #ifdef RT_USING_PTHREADS
     void  *pthread_data;                                /**< the handle of pthread data, adapt 32/64bit */
 #endif /* RT_USING_PTHREADS */
@@ -756,8 +782,26 @@ struct rt_ipc_object
     struct rt_object parent;                            /**< inherit from rt_object */
 
     rt_list_t        suspend_thread;                    /**< threads pended on this resource */
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_list_t        wait_any_list;                     /**< items of threads waiting for a set of objects */
+#endif /* RT_USING_IPC_WAIT_ANY */
 };
 
+#ifdef RT_USING_IPC_WAIT_ANY
+/**
+ * An IPC object in the set waited by rt_ipc_wait_any()
+ */
+struct rt_ipc_wait_item
+{
+    struct rt_ipc_object *object;                       /**< semaphore, event, mailbox or messagequeue */
+    rt_uint32_t          set;                           /**< event set, for event only */
+    rt_uint8_t           option;                        /**< RT_EVENT_FLAG_AND or RT_EVENT_FLAG_OR, for event only */
+
+    rt_list_t            node;                          /**< node in the wait_any_list of object, used by kernel */
+    struct rt_thread    *thread;                        /**< waiting thread, used by kernel */
+};
+#endif /* RT_USING_IPC_WAIT_ANY */
+
 #ifdef RT_USING_SEMAPHORE
 /**
  * Semaphore structure
@@ -893,6 +937,10 @@ typedef rt_mem_t rt_smem_t;
 typedef rt_mem_t rt_slab_t;
 #endif /* RT_USING_SLAB */
 
+#ifdef RT_USING_TLSF
+typedef rt_mem_t rt_tlsf_t;
+#endif /* RT_USING_TLSF */
+
 #ifdef RT_USING_MEMHEAP
 /**
  * memory item on the heap
@@ -109,6 +109,33 @@ rt_base_t rt_hw_interrupt_disable(void);
 void rt_hw_interrupt_enable(rt_base_t level);
 #endif /*RT_USING_SMP*/
 
+#ifdef RT_USING_IPC_FAST_PATH
+/*
+ * Exclusive access interfaces, the store returns 0 when it succeeded
+ */
+rt_uint32_t rt_hw_exclusive_load(volatile rt_uint32_t *addr);
+rt_uint32_t rt_hw_exclusive_store(volatile rt_uint32_t *addr, rt_uint32_t value);
+rt_uint16_t rt_hw_exclusive_load16(volatile rt_uint16_t *addr);
+rt_uint32_t rt_hw_exclusive_store16(volatile rt_uint16_t *addr, rt_uint16_t value);
+#endif /* RT_USING_IPC_FAST_PATH */
+
+/*
+ * Memory barrier interface, which orders the memory accesses before it
+ * against those after it. A port may define its own rt_hw_dmb().
+ */
+#ifndef rt_hw_dmb
+#if defined(__CC_ARM)
+#define rt_hw_dmb()     __dmb(0xf)
+#elif defined(__ICCARM__)
+#include <intrinsics.h>
+#define rt_hw_dmb()     __DMB()
+#elif defined(__GNUC__)
+#define rt_hw_dmb()     __sync_synchronize()
+#else
+#define rt_hw_dmb()
+#endif
+#endif /* rt_hw_dmb */
+
 /*
  * Context interfaces
  */
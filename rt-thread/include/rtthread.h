@@ -157,6 +157,10 @@ rt_err_t rt_thread_delay(rt_tick_t tick);
 rt_err_t rt_thread_delay_until(rt_tick_t *tick, rt_tick_t inc_tick);
 rt_err_t rt_thread_mdelay(rt_int32_t ms);
 rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg);
+#ifdef RT_USING_THREAD_STAT
+rt_err_t rt_thread_stat_get(rt_thread_t thread, struct rt_thread_stat *stat);
+void rt_thread_stat_reset(rt_thread_t thread);
+#endif /* RT_USING_THREAD_STAT */
 rt_err_t rt_thread_suspend(rt_thread_t thread);
 rt_err_t rt_thread_resume(rt_thread_t thread);
 
@@ -279,6 +283,16 @@ void *rt_page_alloc(rt_size_t npages);
 void rt_page_free(void *addr, rt_size_t npages);
 #endif
 
+#if defined(RT_USING_TLSF) && defined(RT_USING_TLSF_AS_HEAP)
+void rt_memory_frag_info(rt_size_t *free_blocks, rt_size_t *max_free);
+#endif
+
+#ifdef RT_USING_HEAP_CACHE
+void rt_heap_cache_flush(void);
+rt_err_t rt_heap_cache_info(rt_uint32_t index, rt_size_t *size, rt_size_t *cached,
+                            rt_uint32_t *hit, rt_uint32_t *miss);
+#endif
+
 #ifdef RT_USING_HOOK
 void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
 void rt_free_sethook(void (*hook)(void *ptr));
@@ -330,6 +344,18 @@ void *rt_slab_realloc(rt_slab_t m, void *ptr, rt_size_t size);
 void rt_slab_free(rt_slab_t m, void *ptr);
 #endif
 
+#ifdef RT_USING_TLSF
+/**
+ * TLSF memory object interface
+ */
+rt_tlsf_t rt_tlsf_init(const char *name, void *begin_addr, rt_size_t size);
+rt_err_t rt_tlsf_detach(rt_tlsf_t m);
+void *rt_tlsf_alloc(rt_tlsf_t m, rt_size_t size);
+void *rt_tlsf_realloc(rt_tlsf_t m, void *rmem, rt_size_t newsize);
+void rt_tlsf_free(rt_tlsf_t m, void *rmem);
+void rt_tlsf_frag_info(rt_tlsf_t m, rt_size_t *free_blocks, rt_size_t *max_free);
+#endif
+
 /**@}*/
 
 /**
@@ -338,6 +364,13 @@ void rt_slab_free(rt_slab_t m, void *ptr);
 
 /**@{*/
 
+#ifdef RT_USING_IPC_WAIT_ANY
+rt_err_t rt_ipc_wait_any(struct rt_ipc_wait_item *items,
+                         rt_size_t                count,
+                         rt_int32_t               timeout,
+                         rt_size_t               *index);
+#endif
+
 #ifdef RT_USING_SEMAPHORE
 /*
  * semaphore interface
@@ -451,6 +484,11 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                     void      *buffer,
                     rt_size_t  size,
                     rt_int32_t timeout);
+rt_err_t rt_mq_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_send_loan(rt_mq_t mq, void *buffer);
+rt_err_t rt_mq_urgent_loan(rt_mq_t mq, void *buffer);
+rt_err_t rt_mq_recv_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout);
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer);
 rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg);
 #endif
 
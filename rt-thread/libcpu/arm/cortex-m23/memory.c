@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+
+/*
+ * Memory functions for ARMv8-M Baseline, which replace the weak ones in
+ * kservice.c. The destination is aligned with a byte head, then the body is
+ * moved by 16 bytes LDM/STM bursts. Baseline has no unaligned access, so a
+ * source with a different alignment is merged from two aligned words.
+ *
+ * The bursts use GNU inline assembly, which is understood by GCC and armclang,
+ * the other toolchains keep the generic functions.
+ */
+#if defined(RT_KSERVICE_USING_CPU_MEMORY) && defined(__GNUC__)
+
+#define MEM_BURST_SIZE      16
+
+/* move the bytes of a word towards the lower or the upper address */
+#ifdef ARCH_CPU_BIG_ENDIAN
+#define MEM_TO_LOWER(w, shift)  ((w) << (shift))
+#define MEM_TO_UPPER(w, shift)  ((w) >> (shift))
+#else
+#define MEM_TO_LOWER(w, shift)  ((w) >> (shift))
+#define MEM_TO_UPPER(w, shift)  ((w) << (shift))
+#endif
+
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)s;
+    rt_uint32_t pattern;
+    rt_ubase_t blocks;
+
+    if (count >= MEM_BURST_SIZE)
+    {
+        pattern = (rt_uint8_t)c;
+        pattern |= pattern << 8;
+        pattern |= pattern << 16;
+
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *d++ = (rt_uint8_t)c;
+            count--;
+        }
+
+        blocks = count / MEM_BURST_SIZE;
+        count %= MEM_BURST_SIZE;
+        if (blocks)
+        {
+            __asm volatile(
+                "   mov     r3, %2              \n"
+                "   mov     r4, %2              \n"
+                "   mov     r5, %2              \n"
+                "   mov     r6, %2              \n"
+                "1: stmia   %0!, {r3-r6}        \n"
+                "   subs    %1, %1, #1          \n"
+                "   bne     1b                  \n"
+                : "+l"(d), "+l"(blocks)
+                : "l"(pattern)
+                : "r3", "r4", "r5", "r6", "cc", "memory");
+        }
+
+        while (count >= sizeof(rt_uint32_t))
+        {
+            *(rt_uint32_t *)d = pattern;
+            d += sizeof(rt_uint32_t);
+            count -= sizeof(rt_uint32_t);
+        }
+    }
+
+    while (count--)
+        *d++ = (rt_uint8_t)c;
+
+    return s;
+}
+RTM_EXPORT(rt_memset);
+
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    rt_ubase_t blocks, shift;
+    const rt_uint32_t *ws;
+    rt_uint32_t w0, w1;
+
+    if (count >= MEM_BURST_SIZE)
+    {
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *d++ = *s++;
+            count--;
+        }
+
+        shift = ((rt_ubase_t)s & 0x03) << 3;
+        if (shift == 0)
+        {
+            blocks = count / MEM_BURST_SIZE;
+            count %= MEM_BURST_SIZE;
+            if (blocks)
+            {
+                __asm volatile(
+                    "1: ldmia   %1!, {r3-r6}        \n"
+                    "   stmia   %0!, {r3-r6}        \n"
+                    "   subs    %2, %2, #1          \n"
+                    "   bne     1b                  \n"
+                    : "+l"(d), "+l"(s), "+l"(blocks)
+                    :
+                    : "r3", "r4", "r5", "r6", "cc", "memory");
+            }
+
+            while (count >= sizeof(rt_uint32_t))
+            {
+                *(rt_uint32_t *)d = *(const rt_uint32_t *)s;
+                d += sizeof(rt_uint32_t);
+                s += sizeof(rt_uint32_t);
+                count -= sizeof(rt_uint32_t);
+            }
+        }
+        else
+        {
+            /* only the aligned words holding source bytes are read */
+            ws = (const rt_uint32_t *)((rt_ubase_t)s & ~0x03);
+            w0 = *ws++;
+            while (count >= sizeof(rt_uint32_t))
+            {
+                w1 = *ws++;
+                *(rt_uint32_t *)d = MEM_TO_LOWER(w0, shift) | MEM_TO_UPPER(w1, 32 - shift);
+                w0 = w1;
+                d += sizeof(rt_uint32_t);
+                s += sizeof(rt_uint32_t);
+                count -= sizeof(rt_uint32_t);
+            }
+        }
+    }
+
+    while (count--)
+        *d++ = *s++;
+
+    return dst;
+}
+RTM_EXPORT(rt_memcpy);
+
+void *rt_memmove(void *dest, const void *src, rt_size_t n)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dest;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    rt_ubase_t shift;
+    const rt_uint32_t *ws;
+    rt_uint32_t w0, w1;
+
+    /* rt_memcpy reads ahead of what it writes, so it can move downwards */
+    if (d <= s || s + n <= d)
+        return rt_memcpy(dest, src, n);
+
+    d += n;
+    s += n;
+    if (n >= MEM_BURST_SIZE)
+    {
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *--d = *--s;
+            n--;
+        }
+
+        shift = ((rt_ubase_t)s & 0x03) << 3;
+        if (shift == 0)
+        {
+            /* no decrementing LDM/STM on Baseline */
+            while (n >= sizeof(rt_uint32_t))
+            {
+                d -= sizeof(rt_uint32_t);
+                s -= sizeof(rt_uint32_t);
+                *(rt_uint32_t *)d = *(const rt_uint32_t *)s;
+                n -= sizeof(rt_uint32_t);
+            }
+        }
+        else
+        {
+            ws = (const rt_uint32_t *)((rt_ubase_t)s & ~0x03);
+            w1 = *ws;
+            while (n >= sizeof(rt_uint32_t))
+            {
+                w0 = *--ws;
+                d -= sizeof(rt_uint32_t);
+                s -= sizeof(rt_uint32_t);
+                *(rt_uint32_t *)d = MEM_TO_LOWER(w0, shift) | MEM_TO_UPPER(w1, 32 - shift);
+                w1 = w0;
+                n -= sizeof(rt_uint32_t);
+            }
+        }
+    }
+
+    while (n--)
+        *--d = *--s;
+
+    return dest;
+}
+RTM_EXPORT(rt_memmove);
+
+#endif /* RT_KSERVICE_USING_CPU_MEMORY && __GNUC__ */
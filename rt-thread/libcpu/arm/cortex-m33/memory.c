@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+#include <rtthread.h>
+
+/*
+ * Memory functions for ARMv8-M Mainline, which replace the weak ones in
+ * kservice.c. The destination is aligned with a byte head, then the body is
+ * moved by 32 bytes LDM/STM bursts. A source with a different alignment is
+ * read by single LDR, which can access unaligned normal memory as long as
+ * SCB->CCR.UNALIGN_TRP is left cleared.
+ *
+ * The bursts use GNU inline assembly, which is understood by GCC and armclang,
+ * the other toolchains keep the generic functions.
+ */
+#if defined(RT_KSERVICE_USING_CPU_MEMORY) && defined(__GNUC__)
+
+#define MEM_BURST_SIZE      32
+
+void *rt_memset(void *s, int c, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)s;
+    rt_uint32_t pattern;
+    rt_ubase_t blocks;
+
+    if (count >= MEM_BURST_SIZE)
+    {
+        pattern = (rt_uint8_t)c;
+        pattern |= pattern << 8;
+        pattern |= pattern << 16;
+
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *d++ = (rt_uint8_t)c;
+            count--;
+        }
+
+        blocks = count / MEM_BURST_SIZE;
+        count %= MEM_BURST_SIZE;
+        if (blocks)
+        {
+            __asm volatile(
+                "   mov     r3, %2                          \n"
+                "   mov     r4, %2                          \n"
+                "   mov     r5, %2                          \n"
+                "   mov     r6, %2                          \n"
+                "   mov     r8, %2                          \n"
+                "   mov     r9, %2                          \n"
+                "   mov     r10, %2                         \n"
+                "   mov     r12, %2                         \n"
+                "1: stmia   %0!, {r3-r6, r8-r10, r12}       \n"
+                "   subs    %1, %1, #1                      \n"
+                "   bne     1b                              \n"
+                : "+r"(d), "+r"(blocks)
+                : "r"(pattern)
+                : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+        }
+
+        while (count >= sizeof(rt_uint32_t))
+        {
+            *(rt_uint32_t *)d = pattern;
+            d += sizeof(rt_uint32_t);
+            count -= sizeof(rt_uint32_t);
+        }
+    }
+
+    while (count--)
+        *d++ = (rt_uint8_t)c;
+
+    return s;
+}
+RTM_EXPORT(rt_memset);
+
+void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dst;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    rt_ubase_t blocks;
+
+    if (count >= MEM_BURST_SIZE)
+    {
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *d++ = *s++;
+            count--;
+        }
+
+        blocks = count / MEM_BURST_SIZE;
+        count %= MEM_BURST_SIZE;
+        if (blocks && ((rt_ubase_t)s & 0x03) == 0)
+        {
+            __asm volatile(
+                "1: ldmia   %1!, {r3-r6, r8-r10, r12}       \n"
+                "   stmia   %0!, {r3-r6, r8-r10, r12}       \n"
+                "   subs    %2, %2, #1                      \n"
+                "   bne     1b                              \n"
+                : "+r"(d), "+r"(s), "+r"(blocks)
+                :
+                : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+        }
+        else if (blocks)
+        {
+            __asm volatile(
+                "1: ldr     r3, [%1]                        \n"
+                "   ldr     r4, [%1, #4]                    \n"
+                "   ldr     r5, [%1, #8]                    \n"
+                "   ldr     r6, [%1, #12]                   \n"
+                "   ldr     r8, [%1, #16]                   \n"
+                "   ldr     r9, [%1, #20]                   \n"
+                "   ldr     r10, [%1, #24]                  \n"
+                "   ldr     r12, [%1, #28]                  \n"
+                "   adds    %1, %1, #32                     \n"
+                "   stmia   %0!, {r3-r6, r8-r10, r12}       \n"
+                "   subs    %2, %2, #1                      \n"
+                "   bne     1b                              \n"
+                : "+r"(d), "+r"(s), "+r"(blocks)
+                :
+                : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+        }
+    }
+
+    while (count--)
+        *d++ = *s++;
+
+    return dst;
+}
+RTM_EXPORT(rt_memcpy);
+
+void *rt_memmove(void *dest, const void *src, rt_size_t n)
+{
+    rt_uint8_t *d = (rt_uint8_t *)dest;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+    rt_ubase_t blocks;
+
+    /* rt_memcpy reads ahead of what it writes, so it can move downwards */
+    if (d <= s || s + n <= d)
+        return rt_memcpy(dest, src, n);
+
+    d += n;
+    s += n;
+    if (n >= MEM_BURST_SIZE)
+    {
+        while ((rt_ubase_t)d & 0x03)
+        {
+            *--d = *--s;
+            n--;
+        }
+
+        blocks = n / MEM_BURST_SIZE;
+        n %= MEM_BURST_SIZE;
+        if (blocks && ((rt_ubase_t)s & 0x03) == 0)
+        {
+            __asm volatile(
+                "1: ldmdb   %1!, {r3-r6, r8-r10, r12}       \n"
+                "   stmdb   %0!, {r3-r6, r8-r10, r12}       \n"
+                "   subs    %2, %2, #1                      \n"
+                "   bne     1b                              \n"
+                : "+r"(d), "+r"(s), "+r"(blocks)
+                :
+                : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+        }
+        else if (blocks)
+        {
+            __asm volatile(
+                "1: ldr     r3, [%1, #-32]                  \n"
+                "   ldr     r4, [%1, #-28]                  \n"
+                "   ldr     r5, [%1, #-24]                  \n"
+                "   ldr     r6, [%1, #-20]                  \n"
+                "   ldr     r8, [%1, #-16]                  \n"
+                "   ldr     r9, [%1, #-12]                  \n"
+                "   ldr     r10, [%1, #-8]                  \n"
+                "   ldr     r12, [%1, #-4]                  \n"
+                "   subs    %1, %1, #32                     \n"
+                "   stmdb   %0!, {r3-r6, r8-r10, r12}       \n"
+                "   subs    %2, %2, #1                      \n"
+                "   bne     1b                              \n"
+                : "+r"(d), "+r"(s), "+r"(blocks)
+                :
+                : "r3", "r4", "r5", "r6", "r8", "r9", "r10", "r12", "cc", "memory");
+        }
+    }
+
+    while (n--)
+        *--d = *--s;
+
+    return dest;
+}
+RTM_EXPORT(rt_memmove);
+
+#endif /* RT_KSERVICE_USING_CPU_MEMORY && __GNUC__ */
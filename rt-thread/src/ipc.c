@@ -87,6 +87,9 @@ rt_inline rt_err_t _ipc_object_init(struct rt_ipc_object *ipc)
 {
     /* initialize ipc object */
     rt_list_init(&(ipc->suspend_thread));
+#ifdef RT_USING_IPC_WAIT_ANY
+    rt_list_init(&(ipc->wait_any_list));
+#endif /* RT_USING_IPC_WAIT_ANY */
 
     return RT_EOK;
 }
@@ -249,6 +252,70 @@ rt_inline rt_err_t _ipc_list_resume_all(rt_list_t *list)
     return RT_EOK;
 }
 
+#ifdef RT_USING_IPC_WAIT_ANY
+/**
+ * @brief   This function will resume the threads waiting for any of a set of IPC objects by
+ *          rt_ipc_wait_any(), which include this IPC object.
+ *
+ * @note    The resumed threads check the objects again, so a thread may be resumed for an
+ *          object which is taken by another thread before it runs.
+ *
+ * @param   ipc is a pointer to the IPC object which becomes available.
+ *
+ * @return  Return RT_TRUE if any thread is resumed and a schedule is needed.
+ *
+ * @warning This function shall be called with interrupt disabled.
+ */
+static rt_bool_t _ipc_wait_any_resume(struct rt_ipc_object *ipc)
+{
+    struct rt_list_node *node;
+    struct rt_ipc_wait_item *item;
+    rt_bool_t need_schedule = RT_FALSE;
+
+    rt_list_for_each(node, &(ipc->wait_any_list))
+    {
+        item = rt_list_entry(node, struct rt_ipc_wait_item, node);
+        if ((item->thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+        {
+            rt_thread_resume(item->thread);
+            need_schedule = RT_TRUE;
+        }
+    }
+
+    return need_schedule;
+}
+
+/**
+ * @brief   This function will resume the threads waiting for any of a set of IPC objects,
+ *          which include this IPC object to be detached or deleted, with an error code.
+ *
+ * @param   ipc is a pointer to the IPC object.
+ */
+static void _ipc_wait_any_abort(struct rt_ipc_object *ipc)
+{
+    struct rt_ipc_wait_item *item;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    while (!rt_list_isempty(&(ipc->wait_any_list)))
+    {
+        item = rt_list_first_entry(&(ipc->wait_any_list), struct rt_ipc_wait_item, node);
+        /* the object is going away, unlink the item for the waiting thread */
+        rt_list_remove(&(item->node));
+
+        if ((item->thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_SUSPEND)
+        {
+            item->thread->error = -RT_ERROR;
+            rt_thread_resume(item->thread);
+        }
+    }
+    rt_hw_interrupt_enable(level);
+}
+#else
+#define _ipc_wait_any_resume(ipc)   RT_FALSE
+#define _ipc_wait_any_abort(ipc)
+#endif /* RT_USING_IPC_WAIT_ANY */
+
 /**@}*/
 
 #ifdef RT_USING_SEMAPHORE
@@ -348,6 +415,7 @@ rt_err_t rt_sem_detach(rt_sem_t sem)
 
     /* wakeup all suspended threads */
     _ipc_list_resume_all(&(sem->parent.suspend_thread));
+    _ipc_wait_any_abort(&(sem->parent));
 
     /* detach semaphore object */
     rt_object_detach(&(sem->parent.parent));
@@ -446,6 +514,7 @@ rt_err_t rt_sem_delete(rt_sem_t sem)
 
     /* wakeup all suspended threads */
     _ipc_list_resume_all(&(sem->parent.suspend_thread));
+    _ipc_wait_any_abort(&(sem->parent));
 
     /* delete semaphore object */
     rt_object_delete(&(sem->parent.parent));
@@ -456,6 +525,58 @@ RTM_EXPORT(rt_sem_delete);
 #endif /* RT_USING_HEAP */
 
 
+#ifdef RT_USING_IPC_FAST_PATH
+/**
+ * @brief    This function will take an available semaphore without disabling interrupt.
+ *
+ * @note     Any interrupt or thread switch between the exclusive load and store clears the
+ *           exclusive monitor, so the store fails and the value is loaded again.
+ *
+ * @param    sem is a pointer to a semaphore object.
+ *
+ * @return   Return RT_TRUE when the value has been decreased, RT_FALSE when the semaphore is unavailable.
+ */
+rt_inline rt_bool_t _sem_fast_take(rt_sem_t sem)
+{
+    rt_uint16_t value;
+
+    do
+    {
+        value = rt_hw_exclusive_load16(&sem->value);
+        if (value == 0)
+            return RT_FALSE;
+    } while (rt_hw_exclusive_store16(&sem->value, value - 1) != 0);
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief    This function will release a semaphore without disabling interrupt when no thread is waiting.
+ *
+ * @param    sem is a pointer to a semaphore object.
+ *
+ * @return   Return RT_TRUE when the value has been increased, RT_FALSE when the suspend list path is needed.
+ */
+rt_inline rt_bool_t _sem_fast_release(rt_sem_t sem)
+{
+    rt_uint16_t value;
+
+    do
+    {
+        value = rt_hw_exclusive_load16(&sem->value);
+        /* resuming a waiter and value overflow are left to the slow path */
+        if (!rt_list_isempty(&sem->parent.suspend_thread) || value >= RT_SEM_VALUE_MAX)
+            return RT_FALSE;
+#ifdef RT_USING_IPC_WAIT_ANY
+        if (!rt_list_isempty(&sem->parent.wait_any_list))
+            return RT_FALSE;
+#endif /* RT_USING_IPC_WAIT_ANY */
+    } while (rt_hw_exclusive_store16(&sem->value, value + 1) != 0);
+
+    return RT_TRUE;
+}
+#endif /* RT_USING_IPC_FAST_PATH */
+
 /**
  * @brief    This function will take a semaphore, if the semaphore is unavailable, the thread shall wait for
  *           the semaphore up to a specified time.
@@ -494,6 +615,15 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t timeout)
 
     RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(sem->parent.parent)));
 
+#ifdef RT_USING_IPC_FAST_PATH
+    if (_sem_fast_take(sem))
+    {
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(sem->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif /* RT_USING_IPC_FAST_PATH */
+
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
@@ -616,6 +746,11 @@ rt_err_t rt_sem_release(rt_sem_t sem)
 
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(sem->parent.parent)));
 
+#ifdef RT_USING_IPC_FAST_PATH
+    if (_sem_fast_release(sem))
+        return RT_EOK;
+#endif /* RT_USING_IPC_FAST_PATH */
+
     need_schedule = RT_FALSE;
 
     /* disable interrupt */
@@ -643,6 +778,10 @@ rt_err_t rt_sem_release(rt_sem_t sem)
             rt_hw_interrupt_enable(level); /* enable interrupt */
             return -RT_EFULL; /* value overflowed */
         }
+
+        /* resume the threads waiting for a set of objects */
+        if (_ipc_wait_any_resume(&(sem->parent)))
+            need_schedule = RT_TRUE;
     }
 
     /* enable interrupt */
@@ -694,6 +833,10 @@ rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
         /* set new value */
         sem->value = (rt_uint16_t)value;
 
+        /* resume the threads waiting for a set of objects */
+        if (sem->value > 0)
+            _ipc_wait_any_resume(&(sem->parent));
+
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
 
@@ -787,6 +930,96 @@ rt_inline void _thread_update_priority(struct rt_thread *thread, rt_uint8_t prio
     }
 }
 
+#ifdef RT_USING_IPC_FAST_PATH
+/**
+ * @brief    This function will take a free mutex without disabling interrupt.
+ *
+ * @note     The owner field is the lock word: it is claimed with one exclusive load/store pair.
+ *           A free mutex always keeps hold 0 and priority 0xff and only the owner changes hold,
+ *           so nothing else has to be written while the claim can still fail.
+ *           The mutex is not put into the taken object list of the owner here. A thread which
+ *           has to wait for it links it in before raising the owner priority, see rt_mutex_take().
+ *
+ * @param    mutex is a pointer to a mutex object.
+ *
+ * @param    thread is the current thread.
+ *
+ * @return   Return RT_TRUE when the mutex has been taken, RT_FALSE when the suspend list path is needed.
+ */
+rt_inline rt_bool_t _mutex_fast_take(struct rt_mutex *mutex, struct rt_thread *thread)
+{
+    volatile rt_uint32_t *lock = (volatile rt_uint32_t *)&mutex->owner;
+
+    if (mutex->owner == thread)
+    {
+        if (mutex->hold >= RT_MUTEX_HOLD_MAX)
+            return RT_FALSE;
+
+        /* it's the same thread */
+        mutex->hold ++;
+        return RT_TRUE;
+    }
+
+    /* the priority ceiling changes the owner priority, leave it to the slow path */
+    if (mutex->ceiling_priority != 0xFF)
+        return RT_FALSE;
+
+    do
+    {
+        if (rt_hw_exclusive_load(lock) != 0)
+            return RT_FALSE;
+    } while (rt_hw_exclusive_store(lock, (rt_uint32_t)(rt_ubase_t)thread) != 0);
+
+    mutex->hold = 1;
+
+    return RT_TRUE;
+}
+
+/**
+ * @brief    This function will release a mutex without disabling interrupt when nobody waits for it.
+ *
+ * @note     Only a mutex taken by _mutex_fast_take() and never waited for is released here; anything
+ *           which may have changed a thread priority is left to the slow path.
+ *
+ * @param    mutex is a pointer to a mutex object.
+ *
+ * @param    thread is the current thread.
+ *
+ * @return   Return RT_TRUE when the mutex has been released, RT_FALSE when the suspend list path is needed.
+ */
+rt_inline rt_bool_t _mutex_fast_release(struct rt_mutex *mutex, struct rt_thread *thread)
+{
+    volatile rt_uint32_t *lock = (volatile rt_uint32_t *)&mutex->owner;
+
+    if (mutex->owner != thread)
+        return RT_FALSE;
+
+    if (mutex->hold > 1)
+    {
+        /* only the owner changes hold */
+        mutex->hold --;
+        return RT_TRUE;
+    }
+
+    while (1)
+    {
+        rt_hw_exclusive_load(lock);
+        if (!rt_list_isempty(&mutex->parent.suspend_thread) ||
+            !rt_list_isempty(&mutex->taken_list) ||
+            mutex->ceiling_priority != 0xFF)
+            return RT_FALSE;
+
+        /* a free mutex has hold 0, restore it if the store fails */
+        mutex->hold = 0;
+        if (rt_hw_exclusive_store(lock, 0) == 0)
+            break;
+        mutex->hold = 1;
+    }
+
+    return RT_TRUE;
+}
+#endif /* RT_USING_IPC_FAST_PATH */
+
 /**
  * @addtogroup mutex
  */
@@ -1118,6 +1351,18 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
     /* get current thread */
     thread = rt_thread_self();
 
+#ifdef RT_USING_IPC_FAST_PATH
+    if (_mutex_fast_take(mutex, thread))
+    {
+        thread->error = RT_EOK;
+
+        RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif /* RT_USING_IPC_FAST_PATH */
+
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
@@ -1193,6 +1438,12 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t timeout)
                 /* set pending object in thread to this mutex */
                 thread->pending_object = &(mutex->parent.parent);
 
+#ifdef RT_USING_IPC_FAST_PATH
+                /* a mutex from the fast path is not in the taken list of its owner yet */
+                if (mutex->ceiling_priority == 0xFF && rt_list_isempty(&mutex->taken_list))
+                    rt_list_insert_after(&mutex->owner->taken_object_list, &mutex->taken_list);
+#endif /* RT_USING_IPC_FAST_PATH */
+
                 /* update the priority level of mutex */
                 if (priority < mutex->priority)
                 {
@@ -1341,6 +1592,15 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* get current thread */
     thread = rt_thread_self();
 
+#ifdef RT_USING_IPC_FAST_PATH
+    if (_mutex_fast_release(mutex, thread))
+    {
+        RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+#endif /* RT_USING_IPC_FAST_PATH */
+
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
@@ -1563,6 +1823,7 @@ rt_err_t rt_event_detach(rt_event_t event)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(event->parent.suspend_thread));
+    _ipc_wait_any_abort(&(event->parent));
 
     /* detach event object */
     rt_object_detach(&(event->parent.parent));
@@ -1656,6 +1917,7 @@ rt_err_t rt_event_delete(rt_event_t event)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(event->parent.suspend_thread));
+    _ipc_wait_any_abort(&(event->parent));
 
     /* delete event object */
     rt_object_delete(&(event->parent.parent));
@@ -1764,6 +2026,10 @@ rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
         }
     }
 
+    /* resume the threads waiting for a set of objects */
+    if (event->set != 0 && _ipc_wait_any_resume(&(event->parent)))
+        need_schedule = RT_TRUE;
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
@@ -2083,6 +2349,7 @@ rt_err_t rt_mb_detach(rt_mailbox_t mb)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(mb->parent.suspend_thread));
+    _ipc_wait_any_abort(&(mb->parent));
     /* also resume all mailbox private suspended thread */
     _ipc_list_resume_all(&(mb->suspend_sender_thread));
 
@@ -2195,6 +2462,7 @@ rt_err_t rt_mb_delete(rt_mailbox_t mb)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(mb->parent.suspend_thread));
+    _ipc_wait_any_abort(&(mb->parent));
 
     /* also resume all mailbox private suspended thread */
     _ipc_list_resume_all(&(mb->suspend_sender_thread));
@@ -2359,6 +2627,17 @@ rt_err_t rt_mb_send_wait(rt_mailbox_t mb,
         return RT_EOK;
     }
 
+    /* resume the threads waiting for a set of objects */
+    if (_ipc_wait_any_resume(&(mb->parent)))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
@@ -2455,6 +2734,17 @@ rt_err_t rt_mb_urgent(rt_mailbox_t mb, rt_ubase_t value)
         return RT_EOK;
     }
 
+    /* resume the threads waiting for a set of objects */
+    if (_ipc_wait_any_resume(&(mb->parent)))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
 
@@ -2686,106 +2976,478 @@ struct rt_mq_message
     struct rt_mq_message *next;
 };
 
+#define _MQ_MSG_OF(buffer)      ((struct rt_mq_message *)(buffer) - 1)
 
 /**
- * @brief    Initialize a static messagequeue object.
- *
- * @note     For the static messagequeue object, its memory space is allocated by the compiler during compiling,
- *           and shall placed on the read-write data segment or on the uninitialized data segment.
- *           By contrast, the rt_mq_create() function will allocate memory space automatically
- *           and initialize the messagequeue.
- *
- * @see      rt_mq_create()
- *
- * @param    mq is a pointer to the messagequeue to initialize. It is assumed that storage for
- *           the messagequeue will be allocated in your application.
- *
- * @param    name is a pointer to the name that given to the messagequeue.
- *
- * @param    msgpool is a pointer to the starting address of the memory space you allocated for
- *           the messagequeue in advance.
- *           In other words, msgpool is a pointer to the messagequeue buffer of the starting address.
- *
- * @param    msg_size is the maximum length of a message in the messagequeue (Unit: Byte).
- *
- * @param    pool_size is the size of the memory space allocated for the messagequeue in advance.
- *
- * @param    flag is the messagequeue flag, which determines the queuing way of how multiple threads wait
- *           when the messagequeue is not available.
- *           The messagequeue flag can be ONE of the following values:
- *
- *               RT_IPC_FLAG_PRIO          The pending threads will queue in order of priority.
+ * @brief    Take a message from the free list. If there is no free message, the current
+ *           thread will wait for a timeout. The message is not linked to any list on return.
  *
- *               RT_IPC_FLAG_FIFO          The pending threads will queue in the first-in-first-out method
- *                                         (also known as first-come-first-served (FCFS) scheduling strategy).
+ * @param    mq is a pointer to the messagequeue object.
  *
- *               NOTE: RT_IPC_FLAG_FIFO is a non-real-time scheduling mode. It is strongly recommended to
- *               use RT_IPC_FLAG_PRIO to ensure the thread is real-time UNLESS your applications concern about
- *               the first-in-first-out principle, and you clearly understand that all threads involved in
- *               this messagequeue will become non-real-time threads.
+ * @param    msg_ptr is the pointer to save the free message.
  *
- * @return   Return the operation status. When the return value is RT_EOK, the initialization is successful.
- *           If the return value is any other values, it represents the initialization failed.
+ * @param    timeout is a timeout period (unit: an OS tick).
  *
- * @warning  This function can ONLY be called from threads.
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
  */
-rt_err_t rt_mq_init(rt_mq_t     mq,
-                    const char *name,
-                    void       *msgpool,
-                    rt_size_t   msg_size,
-                    rt_size_t   pool_size,
-                    rt_uint8_t  flag)
+static rt_err_t _mq_take_free(rt_mq_t mq, struct rt_mq_message **msg_ptr, rt_int32_t timeout)
 {
-    struct rt_mq_message *head;
-    rt_base_t temp;
-
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
-    RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
-
-    /* initialize object */
-    rt_object_init(&(mq->parent.parent), RT_Object_Class_MessageQueue, name);
-
-    /* set parent flag */
-    mq->parent.parent.flag = flag;
+    rt_base_t level;
+    struct rt_mq_message *msg;
+    rt_uint32_t tick_delta;
+    struct rt_thread *thread;
 
-    /* initialize ipc object */
-    _ipc_object_init(&(mq->parent));
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
 
-    /* set message pool */
-    mq->msg_pool = msgpool;
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
 
-    /* get correct message size */
-    mq->msg_size = RT_ALIGN(msg_size, RT_ALIGN_SIZE);
-    mq->max_msgs = (rt_uint16_t)(pool_size / (mq->msg_size + sizeof(struct rt_mq_message)));
+    /* get a free list, there must be an empty item */
+    msg = (struct rt_mq_message *)mq->msg_queue_free;
+    /* for non-blocking call */
+    if (msg == RT_NULL && timeout == 0)
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
 
-    /* initialize message list */
-    mq->msg_queue_head = RT_NULL;
-    mq->msg_queue_tail = RT_NULL;
+        return -RT_EFULL;
+    }
 
-    /* initialize message empty list */
-    mq->msg_queue_free = RT_NULL;
-    for (temp = 0; temp < mq->max_msgs; temp ++)
+    /* message queue is full */
+    while ((msg = (struct rt_mq_message *)mq->msg_queue_free) == RT_NULL)
     {
-        head = (struct rt_mq_message *)((rt_uint8_t *)mq->msg_pool +
-                                        temp * (mq->msg_size + sizeof(struct rt_mq_message)));
-        head->next = (struct rt_mq_message *)mq->msg_queue_free;
-        mq->msg_queue_free = head;
-    }
+        /* reset error number in thread */
+        thread->error = RT_EOK;
 
-    /* the initial entry is zero */
-    mq->entry = 0;
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(level);
 
-    /* initialize an additional list of sender suspend thread */
-    rt_list_init(&(mq->suspend_sender_thread));
+            return -RT_EFULL;
+        }
 
-    return RT_EOK;
-}
-RTM_EXPORT(rt_mq_init);
+        /* suspend current thread */
+        _ipc_list_suspend(&(mq->suspend_sender_thread),
+                            thread,
+                            mq->parent.parent.flag);
 
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
 
-/**
- * @brief    This function will detach a static messagequeue object.
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("mq_send_wait: start timer of thread:%s\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* resume from suspend state */
+        if (thread->error != RT_EOK)
+        {
+            /* return error */
+            return thread->error;
+        }
+
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    /* move free list pointer */
+    mq->msg_queue_free = msg->next;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    *msg_ptr = msg;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief    Link a filled message to the tail, or the head for an urgent one, of the
+ *           messagequeue and resume a receiving thread.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg is the message taken by _mq_take_free().
+ *
+ * @param    urgent is RT_TRUE to put the message at the head of the messagequeue.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+static rt_err_t _mq_put_message(rt_mq_t mq, struct rt_mq_message *msg, rt_bool_t urgent)
+{
+    rt_base_t level;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    if (urgent)
+    {
+        /* link msg to the beginning of message queue */
+        msg->next = (struct rt_mq_message *)mq->msg_queue_head;
+        mq->msg_queue_head = msg;
+
+        /* if there is no tail */
+        if (mq->msg_queue_tail == RT_NULL)
+            mq->msg_queue_tail = msg;
+    }
+    else
+    {
+        /* the msg is the new tailer of list, the next shall be NULL */
+        msg->next = RT_NULL;
+
+        /* link msg to message queue */
+        if (mq->msg_queue_tail != RT_NULL)
+        {
+            /* if the tail exists, */
+            ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
+        }
+
+        /* set new tail */
+        mq->msg_queue_tail = msg;
+        /* if the head is empty, set head */
+        if (mq->msg_queue_head == RT_NULL)
+            mq->msg_queue_head = msg;
+    }
+
+    if(mq->entry < RT_MQ_ENTRY_MAX)
+    {
+        /* increase message entry */
+        mq->entry ++;
+    }
+    else
+    {
+        rt_hw_interrupt_enable(level); /* enable interrupt */
+        return -RT_EFULL; /* value overflowed */
+    }
+
+    /* resume suspended thread */
+    if (!rt_list_isempty(&mq->parent.suspend_thread))
+    {
+        _ipc_list_resume(&(mq->parent.suspend_thread));
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    /* resume the threads waiting for a set of objects */
+    if (_ipc_wait_any_resume(&(mq->parent)))
+    {
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * @brief    Take the message at the head of the messagequeue. If the messagequeue is empty,
+ *           the current thread will wait for a timeout. The message is not linked to any
+ *           list on return.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg_ptr is the pointer to save the message.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+static rt_err_t _mq_take_message(rt_mq_t mq, struct rt_mq_message **msg_ptr, rt_int32_t timeout)
+{
+    struct rt_thread *thread;
+    rt_base_t level;
+    struct rt_mq_message *msg;
+    rt_uint32_t tick_delta;
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    /* for non-blocking call */
+    if (mq->entry == 0 && timeout == 0)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_ETIMEOUT;
+    }
+
+    /* message queue is empty */
+    while (mq->entry == 0)
+    {
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(level);
+
+            thread->error = -RT_ETIMEOUT;
+
+            return -RT_ETIMEOUT;
+        }
+
+        /* suspend current thread */
+        _ipc_list_suspend(&(mq->parent.suspend_thread),
+                            thread,
+                            mq->parent.parent.flag);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("set thread:%s to timer list\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* recv message */
+        if (thread->error != RT_EOK)
+        {
+            /* return error */
+            return thread->error;
+        }
+
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    /* get message from queue */
+    msg = (struct rt_mq_message *)mq->msg_queue_head;
+
+    /* move message queue head */
+    mq->msg_queue_head = msg->next;
+    /* reach queue tail, set to NULL */
+    if (mq->msg_queue_tail == msg)
+        mq->msg_queue_tail = RT_NULL;
+
+    /* decrease message entry */
+    if(mq->entry > 0)
+    {
+        mq->entry --;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    *msg_ptr = msg;
+
+    return RT_EOK;
+}
+
+/**
+ * @brief    Put a message back to the free list and resume a sending thread.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    msg is the message to be freed.
+ *
+ * @return   Return RT_TRUE if a sending thread is resumed and a schedule is needed.
+ */
+static rt_bool_t _mq_put_free(rt_mq_t mq, struct rt_mq_message *msg)
+{
+    rt_base_t level;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+    /* put message to free list */
+    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
+    mq->msg_queue_free = msg;
+
+    /* resume suspended thread */
+    if (!rt_list_isempty(&(mq->suspend_sender_thread)))
+    {
+        _ipc_list_resume(&(mq->suspend_sender_thread));
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        return RT_TRUE;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return RT_FALSE;
+}
+
+/* check the buffer is the payload of a message in the pool */
+rt_inline void _mq_check_buffer(rt_mq_t mq, void *buffer)
+{
+    rt_ubase_t offset;
+
+    offset = (rt_ubase_t)_MQ_MSG_OF(buffer) - (rt_ubase_t)mq->msg_pool;
+    RT_ASSERT(offset < (rt_ubase_t)mq->max_msgs * (mq->msg_size + sizeof(struct rt_mq_message)));
+    RT_ASSERT(offset % (mq->msg_size + sizeof(struct rt_mq_message)) == 0);
+    RT_UNUSED(offset);
+}
+
+
+/**
+ * @brief    Initialize a static messagequeue object.
+ *
+ * @note     For the static messagequeue object, its memory space is allocated by the compiler during compiling,
+ *           and shall placed on the read-write data segment or on the uninitialized data segment.
+ *           By contrast, the rt_mq_create() function will allocate memory space automatically
+ *           and initialize the messagequeue.
+ *
+ * @see      rt_mq_create()
+ *
+ * @param    mq is a pointer to the messagequeue to initialize. It is assumed that storage for
+ *           the messagequeue will be allocated in your application.
+ *
+ * @param    name is a pointer to the name that given to the messagequeue.
+ *
+ * @param    msgpool is a pointer to the starting address of the memory space you allocated for
+ *           the messagequeue in advance.
+ *           In other words, msgpool is a pointer to the messagequeue buffer of the starting address.
+ *
+ * @param    msg_size is the maximum length of a message in the messagequeue (Unit: Byte).
+ *
+ * @param    pool_size is the size of the memory space allocated for the messagequeue in advance.
+ *
+ * @param    flag is the messagequeue flag, which determines the queuing way of how multiple threads wait
+ *           when the messagequeue is not available.
+ *           The messagequeue flag can be ONE of the following values:
+ *
+ *               RT_IPC_FLAG_PRIO          The pending threads will queue in order of priority.
+ *
+ *               RT_IPC_FLAG_FIFO          The pending threads will queue in the first-in-first-out method
+ *                                         (also known as first-come-first-served (FCFS) scheduling strategy).
+ *
+ *               NOTE: RT_IPC_FLAG_FIFO is a non-real-time scheduling mode. It is strongly recommended to
+ *               use RT_IPC_FLAG_PRIO to ensure the thread is real-time UNLESS your applications concern about
+ *               the first-in-first-out principle, and you clearly understand that all threads involved in
+ *               this messagequeue will become non-real-time threads.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the initialization is successful.
+ *           If the return value is any other values, it represents the initialization failed.
+ *
+ * @warning  This function can ONLY be called from threads.
+ */
+rt_err_t rt_mq_init(rt_mq_t     mq,
+                    const char *name,
+                    void       *msgpool,
+                    rt_size_t   msg_size,
+                    rt_size_t   pool_size,
+                    rt_uint8_t  flag)
+{
+    struct rt_mq_message *head;
+    rt_base_t temp;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT((flag == RT_IPC_FLAG_FIFO) || (flag == RT_IPC_FLAG_PRIO));
+
+    /* initialize object */
+    rt_object_init(&(mq->parent.parent), RT_Object_Class_MessageQueue, name);
+
+    /* set parent flag */
+    mq->parent.parent.flag = flag;
+
+    /* initialize ipc object */
+    _ipc_object_init(&(mq->parent));
+
+    /* set message pool */
+    mq->msg_pool = msgpool;
+
+    /* get correct message size */
+    mq->msg_size = RT_ALIGN(msg_size, RT_ALIGN_SIZE);
+    mq->max_msgs = (rt_uint16_t)(pool_size / (mq->msg_size + sizeof(struct rt_mq_message)));
+
+    /* initialize message list */
+    mq->msg_queue_head = RT_NULL;
+    mq->msg_queue_tail = RT_NULL;
+
+    /* initialize message empty list */
+    mq->msg_queue_free = RT_NULL;
+    for (temp = 0; temp < mq->max_msgs; temp ++)
+    {
+        head = (struct rt_mq_message *)((rt_uint8_t *)mq->msg_pool +
+                                        temp * (mq->msg_size + sizeof(struct rt_mq_message)));
+        head->next = (struct rt_mq_message *)mq->msg_queue_free;
+        mq->msg_queue_free = head;
+    }
+
+    /* the initial entry is zero */
+    mq->entry = 0;
+
+    /* initialize an additional list of sender suspend thread */
+    rt_list_init(&(mq->suspend_sender_thread));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_init);
+
+
+/**
+ * @brief    This function will detach a static messagequeue object.
  *
  * @note     This function is used to detach a static messagequeue object which is initialized by rt_mq_init() function.
  *           By contrast, the rt_mq_delete() function will delete a messagequeue object.
@@ -2811,6 +3473,7 @@ rt_err_t rt_mq_detach(rt_mq_t mq)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&mq->parent.suspend_thread);
+    _ipc_wait_any_abort(&(mq->parent));
     /* also resume all message queue private suspended thread */
     _ipc_list_resume_all(&(mq->suspend_sender_thread));
 
@@ -2948,6 +3611,7 @@ rt_err_t rt_mq_delete(rt_mq_t mq)
 
     /* resume all suspended thread */
     _ipc_list_resume_all(&(mq->parent.suspend_thread));
+    _ipc_wait_any_abort(&(mq->parent));
     /* also resume all message queue private suspended thread */
     _ipc_list_resume_all(&(mq->suspend_sender_thread));
 
@@ -2997,10 +3661,8 @@ rt_err_t rt_mq_send_wait(rt_mq_t     mq,
                          rt_size_t   size,
                          rt_int32_t  timeout)
 {
-    rt_base_t level;
     struct rt_mq_message *msg;
-    rt_uint32_t tick_delta;
-    struct rt_thread *thread;
+    rt_err_t result;
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
@@ -3015,143 +3677,16 @@ rt_err_t rt_mq_send_wait(rt_mq_t     mq,
     if (size > mq->msg_size)
         return -RT_ERROR;
 
-    /* initialize delta tick */
-    tick_delta = 0;
-    /* get current thread */
-    thread = rt_thread_self();
-
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
 
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
-
-    /* get a free list, there must be an empty item */
-    msg = (struct rt_mq_message *)mq->msg_queue_free;
-    /* for non-blocking call */
-    if (msg == RT_NULL && timeout == 0)
-    {
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
-
-        return -RT_EFULL;
-    }
-
-    /* message queue is full */
-    while ((msg = (struct rt_mq_message *)mq->msg_queue_free) == RT_NULL)
-    {
-        /* reset error number in thread */
-        thread->error = RT_EOK;
-
-        /* no waiting, return timeout */
-        if (timeout == 0)
-        {
-            /* enable interrupt */
-            rt_hw_interrupt_enable(level);
-
-            return -RT_EFULL;
-        }
-
-        /* suspend current thread */
-        _ipc_list_suspend(&(mq->suspend_sender_thread),
-                            thread,
-                            mq->parent.parent.flag);
-
-        /* has waiting time, start thread timer */
-        if (timeout > 0)
-        {
-            /* get the start tick of timer */
-            tick_delta = rt_tick_get();
-
-            RT_DEBUG_LOG(RT_DEBUG_IPC, ("mq_send_wait: start timer of thread:%s\n",
-                                        thread->name));
-
-            /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
-        }
-
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
-
-        /* re-schedule */
-        rt_schedule();
-
-        /* resume from suspend state */
-        if (thread->error != RT_EOK)
-        {
-            /* return error */
-            return thread->error;
-        }
-
-        /* disable interrupt */
-        level = rt_hw_interrupt_disable();
-
-        /* if it's not waiting forever and then re-calculate timeout tick */
-        if (timeout > 0)
-        {
-            tick_delta = rt_tick_get() - tick_delta;
-            timeout -= tick_delta;
-            if (timeout < 0)
-                timeout = 0;
-        }
-    }
-
-    /* move free list pointer */
-    mq->msg_queue_free = msg->next;
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    result = _mq_take_free(mq, &msg, timeout);
+    if (result != RT_EOK)
+        return result;
 
-    /* the msg is the new tailer of list, the next shall be NULL */
-    msg->next = RT_NULL;
     /* copy buffer */
     rt_memcpy(msg + 1, buffer, size);
 
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
-    /* link msg to message queue */
-    if (mq->msg_queue_tail != RT_NULL)
-    {
-        /* if the tail exists, */
-        ((struct rt_mq_message *)mq->msg_queue_tail)->next = msg;
-    }
-
-    /* set new tail */
-    mq->msg_queue_tail = msg;
-    /* if the head is empty, set head */
-    if (mq->msg_queue_head == RT_NULL)
-        mq->msg_queue_head = msg;
-
-    if(mq->entry < RT_MQ_ENTRY_MAX)
-    {
-        /* increase message entry */
-        mq->entry ++;
-    }
-    else
-    {
-        rt_hw_interrupt_enable(level); /* enable interrupt */
-        return -RT_EFULL; /* value overflowed */
-    }
-
-    /* resume suspended thread */
-    if (!rt_list_isempty(&mq->parent.suspend_thread))
-    {
-        _ipc_list_resume(&(mq->parent.suspend_thread));
-
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
-
-        rt_schedule();
-
-        return RT_EOK;
-    }
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
-
-    return RT_EOK;
+    return _mq_put_message(mq, msg, RT_FALSE);
 }
 RTM_EXPORT(rt_mq_send_wait)
 
@@ -3205,8 +3740,8 @@ RTM_EXPORT(rt_mq_send);
  */
 rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
 {
-    rt_base_t level;
     struct rt_mq_message *msg;
+    rt_err_t result;
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
@@ -3220,67 +3755,14 @@ rt_err_t rt_mq_urgent(rt_mq_t mq, const void *buffer, rt_size_t size)
 
     RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
 
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
-
-    /* get a free list, there must be an empty item */
-    msg = (struct rt_mq_message *)mq->msg_queue_free;
-    /* message queue is full */
-    if (msg == RT_NULL)
-    {
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
-
-        return -RT_EFULL;
-    }
-    /* move free list pointer */
-    mq->msg_queue_free = msg->next;
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    result = _mq_take_free(mq, &msg, 0);
+    if (result != RT_EOK)
+        return result;
 
     /* copy buffer */
     rt_memcpy(msg + 1, buffer, size);
 
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
-
-    /* link msg to the beginning of message queue */
-    msg->next = (struct rt_mq_message *)mq->msg_queue_head;
-    mq->msg_queue_head = msg;
-
-    /* if there is no tail */
-    if (mq->msg_queue_tail == RT_NULL)
-        mq->msg_queue_tail = msg;
-
-    if(mq->entry < RT_MQ_ENTRY_MAX)
-    {
-        /* increase message entry */
-        mq->entry ++;
-    }
-    else
-    {
-        rt_hw_interrupt_enable(level); /* enable interrupt */
-        return -RT_EFULL; /* value overflowed */
-    }
-
-    /* resume suspended thread */
-    if (!rt_list_isempty(&mq->parent.suspend_thread))
-    {
-        _ipc_list_resume(&(mq->parent.suspend_thread));
-
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
-
-        rt_schedule();
-
-        return RT_EOK;
-    }
-
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
-
-    return RT_EOK;
+    return _mq_put_message(mq, msg, RT_TRUE);
 }
 RTM_EXPORT(rt_mq_urgent);
 
@@ -3316,10 +3798,8 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                     rt_size_t  size,
                     rt_int32_t timeout)
 {
-    struct rt_thread *thread;
-    rt_base_t level;
     struct rt_mq_message *msg;
-    rt_uint32_t tick_delta;
+    rt_err_t result;
 
     /* parameter check */
     RT_ASSERT(mq != RT_NULL);
@@ -3330,137 +3810,204 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
     /* current context checking */
     RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
 
-    /* initialize delta tick */
-    tick_delta = 0;
-    /* get current thread */
-    thread = rt_thread_self();
     RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
 
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
+    result = _mq_take_message(mq, &msg, timeout);
+    if (result != RT_EOK)
+        return result;
 
-    /* for non-blocking call */
-    if (mq->entry == 0 && timeout == 0)
+    /* copy message */
+    rt_memcpy(buffer, msg + 1, size > mq->msg_size ? mq->msg_size : size);
+
+    if (_mq_put_free(mq, msg))
     {
-        rt_hw_interrupt_enable(level);
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
 
-        return -RT_ETIMEOUT;
+        rt_schedule();
+
+        return RT_EOK;
     }
 
-    /* message queue is empty */
-    while (mq->entry == 0)
-    {
-        /* reset error number in thread */
-        thread->error = RT_EOK;
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
 
-        /* no waiting, return timeout */
-        if (timeout == 0)
-        {
-            /* enable interrupt */
-            rt_hw_interrupt_enable(level);
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_recv);
 
-            thread->error = -RT_ETIMEOUT;
 
-            return -RT_ETIMEOUT;
-        }
+/**
+ * @brief    This function will lend a free message of the messagequeue object to the caller,
+ *           which fills the message in place and sends it by rt_mq_send_loan() or
+ *           rt_mq_urgent_loan(), without copying the content.
+ *
+ * @note     The lent message is out of the messagequeue until it is sent, or given back by
+ *           rt_mq_release(). The messages are received in the order they are sent, not
+ *           in the order they are lent.
+ *
+ * @see      rt_mq_send_wait()
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the pointer to save the message buffer, which holds msg_size bytes.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick) to wait for a free message.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is -RT_EFULL, there is no free message.
+ *
+ * @warning  This function can be called in interrupt context with a zero timeout.
+ */
+rt_err_t rt_mq_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t result;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    result = _mq_take_free(mq, &msg, timeout);
+    if (result != RT_EOK)
+        return result;
 
-        /* suspend current thread */
-        _ipc_list_suspend(&(mq->parent.suspend_thread),
-                            thread,
-                            mq->parent.parent.flag);
+    *buffer = msg + 1;
 
-        /* has waiting time, start thread timer */
-        if (timeout > 0)
-        {
-            /* get the start tick of timer */
-            tick_delta = rt_tick_get();
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_loan);
 
-            RT_DEBUG_LOG(RT_DEBUG_IPC, ("set thread:%s to timer list\n",
-                                        thread->name));
 
-            /* reset the timeout of thread timer and start it */
-            rt_timer_control(&(thread->thread_timer),
-                             RT_TIMER_CTRL_SET_TIME,
-                             &timeout);
-            rt_timer_start(&(thread->thread_timer));
-        }
+/**
+ * @brief    This function will send a message lent by rt_mq_loan() to the messagequeue object.
+ *           If there is a thread suspended on the messagequeue, the thread will be resumed.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the message buffer got from rt_mq_loan().
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_send_loan(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    _mq_check_buffer(mq, buffer);
 
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
 
-        /* re-schedule */
-        rt_schedule();
+    return _mq_put_message(mq, _MQ_MSG_OF(buffer), RT_FALSE);
+}
+RTM_EXPORT(rt_mq_send_loan);
 
-        /* recv message */
-        if (thread->error != RT_EOK)
-        {
-            /* return error */
-            return thread->error;
-        }
 
-        /* disable interrupt */
-        level = rt_hw_interrupt_disable();
+/**
+ * @brief    This function will send a message lent by rt_mq_loan() to the head of the
+ *           messagequeue object, so that the recipient can receive it first.
+ *
+ * @see      rt_mq_urgent()
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the message buffer got from rt_mq_loan().
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_urgent_loan(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    _mq_check_buffer(mq, buffer);
 
-        /* if it's not waiting forever and then re-calculate timeout tick */
-        if (timeout > 0)
-        {
-            tick_delta = rt_tick_get() - tick_delta;
-            timeout -= tick_delta;
-            if (timeout < 0)
-                timeout = 0;
-        }
-    }
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
 
-    /* get message from queue */
-    msg = (struct rt_mq_message *)mq->msg_queue_head;
+    return _mq_put_message(mq, _MQ_MSG_OF(buffer), RT_TRUE);
+}
+RTM_EXPORT(rt_mq_urgent_loan);
 
-    /* move message queue head */
-    mq->msg_queue_head = msg->next;
-    /* reach queue tail, set to NULL */
-    if (mq->msg_queue_tail == msg)
-        mq->msg_queue_tail = RT_NULL;
 
-    /* decrease message entry */
-    if(mq->entry > 0)
-    {
-        mq->entry --;
-    }
+/**
+ * @brief    This function will receive a message from the messagequeue object in place,
+ *           if there is no message in the messagequeue object, the thread shall wait for a
+ *           specified time. The message shall be given back by rt_mq_release() when it is done.
+ *
+ * @see      rt_mq_recv()
+ *
+ * @param    mq is a pointer to the messagequeue object to be received.
+ *
+ * @param    buffer is the pointer to save the message buffer, which holds msg_size bytes.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is -RT_ETIMEOUT, there is no message within the timeout.
+ */
+rt_err_t rt_mq_recv_loan(rt_mq_t mq, void **buffer, rt_int32_t timeout)
+{
+    struct rt_mq_message *msg;
+    rt_err_t result;
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
 
-    /* copy message */
-    rt_memcpy(buffer, msg + 1, size > mq->msg_size ? mq->msg_size : size);
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
 
-    /* disable interrupt */
-    level = rt_hw_interrupt_disable();
-    /* put message to free list */
-    msg->next = (struct rt_mq_message *)mq->msg_queue_free;
-    mq->msg_queue_free = msg;
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
 
-    /* resume suspended thread */
-    if (!rt_list_isempty(&(mq->suspend_sender_thread)))
-    {
-        _ipc_list_resume(&(mq->suspend_sender_thread));
+    result = _mq_take_message(mq, &msg, timeout);
+    if (result != RT_EOK)
+        return result;
 
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
+    *buffer = msg + 1;
 
-        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
 
-        rt_schedule();
+    return RT_EOK;
+}
+RTM_EXPORT(rt_mq_recv_loan);
 
-        return RT_EOK;
-    }
 
-    /* enable interrupt */
-    rt_hw_interrupt_enable(level);
+/**
+ * @brief    This function will give a message buffer back to the messagequeue object, which is
+ *           received by rt_mq_recv_loan(), or lent by rt_mq_loan() but not sent.
+ *           If there is a thread suspended on sending, the thread will be resumed.
+ *
+ * @param    mq is a pointer to the messagequeue object.
+ *
+ * @param    buffer is the message buffer.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *
+ * @warning  This function can be called in interrupt context and thread context.
+ */
+rt_err_t rt_mq_release(rt_mq_t mq, void *buffer)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    _mq_check_buffer(mq, buffer);
 
-    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+    if (_mq_put_free(mq, _MQ_MSG_OF(buffer)))
+        rt_schedule();
 
     return RT_EOK;
 }
-RTM_EXPORT(rt_mq_recv);
+RTM_EXPORT(rt_mq_release);
 
 
 /**
@@ -3531,4 +4078,185 @@ RTM_EXPORT(rt_mq_control);
 /**@}*/
 #endif /* RT_USING_MESSAGEQUEUE */
 
+#ifdef RT_USING_IPC_WAIT_ANY
+/**
+ * @brief    This function will check whether the IPC object of an item is available.
+ *
+ * @param    item is a pointer to the item.
+ *
+ * @return   Return RT_TRUE if the object is available.
+ */
+static rt_bool_t _ipc_wait_any_ready(struct rt_ipc_wait_item *item)
+{
+    switch (rt_object_get_type(&(item->object->parent)))
+    {
+#ifdef RT_USING_SEMAPHORE
+    case RT_Object_Class_Semaphore:
+        return ((rt_sem_t)item->object)->value > 0;
+#endif /* RT_USING_SEMAPHORE */
+#ifdef RT_USING_EVENT
+    case RT_Object_Class_Event:
+        if (item->option & RT_EVENT_FLAG_AND)
+            return (((rt_event_t)item->object)->set & item->set) == item->set;
+        return (((rt_event_t)item->object)->set & item->set) != 0;
+#endif /* RT_USING_EVENT */
+#ifdef RT_USING_MAILBOX
+    case RT_Object_Class_MailBox:
+        return ((rt_mailbox_t)item->object)->entry > 0;
+#endif /* RT_USING_MAILBOX */
+#ifdef RT_USING_MESSAGEQUEUE
+    case RT_Object_Class_MessageQueue:
+        return ((rt_mq_t)item->object)->entry > 0;
+#endif /* RT_USING_MESSAGEQUEUE */
+    default:
+        RT_ASSERT(0);
+        break;
+    }
+
+    return RT_FALSE;
+}
+
+/**
+ * @brief    This function will wait for any of a set of IPC objects, which can be semaphores, events,
+ *           mailboxes and messagequeues, to become available up to a specified time.
+ *
+ * @note     This function only reports the object, which is not taken. Take it by rt_sem_take(),
+ *           rt_event_recv(), rt_mb_recv() or rt_mq_recv() with RT_WAITING_NO afterwards. If another
+ *           thread takes the object first, that call returns -RT_ETIMEOUT and the set can be waited again.
+ *           A thread suspended directly on an object is served before the threads waiting for a set.
+ *
+ * @param    items is an array of items, the object of each item shall be set. For an event object,
+ *           the set and the option (RT_EVENT_FLAG_AND or RT_EVENT_FLAG_OR) shall be set too.
+ *           The array is used by the kernel during the waiting.
+ *
+ * @param    count is the number of items.
+ *
+ * @param    timeout is a timeout period (unit: an OS tick).
+ *
+ * @param    index is a pointer to save the index of the available item. If there are several available
+ *           items, the first one is reported.
+ *
+ * @return   Return the operation status. When the return value is RT_EOK, the operation is successful.
+ *           If the return value is -RT_ETIMEOUT, no object is available within the timeout.
+ *           If the return value is -RT_ERROR, an object is detached or deleted during the waiting.
+ *           If the return value is -RT_EINTR, the waiting is interrupted by a signal.
+ *
+ * @warning  This function can only be called in thread context, or with RT_WAITING_NO.
+ */
+rt_err_t rt_ipc_wait_any(struct rt_ipc_wait_item *items,
+                         rt_size_t                count,
+                         rt_int32_t               timeout,
+                         rt_size_t               *index)
+{
+    struct rt_thread *thread;
+    rt_base_t level;
+    rt_uint32_t tick_delta;
+    rt_size_t i;
+    rt_err_t result;
+
+    /* parameter check */
+    RT_ASSERT(items != RT_NULL);
+    RT_ASSERT(count > 0);
+
+    /* current context checking */
+    RT_DEBUG_SCHEDULER_AVAILABLE(timeout != 0);
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    for (i = 0; i < count; i ++)
+    {
+        RT_ASSERT(items[i].object != RT_NULL);
+        rt_list_init(&(items[i].node));
+        items[i].thread = thread;
+    }
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    while (1)
+    {
+        /* find the first available object */
+        for (i = 0; i < count; i ++)
+        {
+            if (_ipc_wait_any_ready(&items[i]))
+                break;
+        }
+
+        if (i < count)
+        {
+            if (index != RT_NULL)
+                *index = i;
+            result = RT_EOK;
+            break;
+        }
+
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            result = -RT_ETIMEOUT;
+            break;
+        }
+
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        /* suspend current thread on all the objects */
+        rt_thread_suspend(thread);
+        for (i = 0; i < count; i ++)
+            rt_list_insert_before(&(items[i].object->wait_any_list), &(items[i].node));
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        for (i = 0; i < count; i ++)
+            rt_list_remove(&(items[i].node));
+
+        /* an object is detached or deleted, or the thread is interrupted */
+        if (thread->error != RT_EOK && thread->error != -RT_ETIMEOUT)
+        {
+            result = thread->error;
+            break;
+        }
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            /* check the objects for the last time */
+            if (timeout < 0 || thread->error == -RT_ETIMEOUT)
+                timeout = 0;
+        }
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+RTM_EXPORT(rt_ipc_wait_any);
+#endif /* RT_USING_IPC_WAIT_ANY */
+
 /**@}*/
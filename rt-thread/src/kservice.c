@@ -340,7 +340,7 @@ RTM_EXPORT(rt_memcpy);
  *
  * @return The address of destination memory.
  */
-void *rt_memmove(void *dest, const void *src, rt_size_t n)
+RT_WEAK void *rt_memmove(void *dest, const void *src, rt_size_t n)
 {
     char *tmp = (char *)dest, *s = (char *)src;
 
@@ -1465,6 +1465,27 @@ rt_inline void _slab_info(rt_size_t *total,
 #define _MEM_FREE(_ptr) \
     rt_slab_free(system_heap, _ptr)
 #define _MEM_INFO       _slab_info
+#elif defined(RT_USING_TLSF_AS_HEAP)
+static rt_tlsf_t system_heap;
+rt_inline void _tlsf_info(rt_size_t *total,
+    rt_size_t *used, rt_size_t *max_used)
+{
+    if (total)
+        *total = system_heap->total;
+    if (used)
+        *used = system_heap->used;
+    if (max_used)
+        *max_used = system_heap->max;
+}
+#define _MEM_INIT(_name, _start, _size) \
+    system_heap = rt_tlsf_init(_name, _start, _size)
+#define _MEM_MALLOC(_size)  \
+    rt_tlsf_alloc(system_heap, _size)
+#define _MEM_REALLOC(_ptr, _newsize)    \
+    rt_tlsf_realloc(system_heap, _ptr, _newsize)
+#define _MEM_FREE(_ptr) \
+    rt_tlsf_free(system_heap, _ptr)
+#define _MEM_INFO       _tlsf_info
 #else
 #define _MEM_INIT(...)
 #define _MEM_MALLOC(...)     RT_NULL
@@ -1473,6 +1494,306 @@ rt_inline void _slab_info(rt_size_t *total,
 #define _MEM_INFO(...)
 #endif
 
+#ifdef RT_USING_HEAP_CACHE
+#ifndef RT_HEAP_CACHE_MAX_SIZE
+#define RT_HEAP_CACHE_MAX_SIZE      128
+#endif /* RT_HEAP_CACHE_MAX_SIZE */
+
+#ifndef RT_HEAP_CACHE_DEPTH
+#define RT_HEAP_CACHE_DEPTH         8
+#endif /* RT_HEAP_CACHE_DEPTH */
+
+#define HEAP_CACHE_GRANULE          16
+#define HEAP_CACHE_CLASSES          (RT_ALIGN(RT_HEAP_CACHE_MAX_SIZE, HEAP_CACHE_GRANULE) / HEAP_CACHE_GRANULE)
+/* every block carries a tag with its size class in front of the user data */
+#define HEAP_CACHE_HDR_SIZE         RT_ALIGN(sizeof(rt_ubase_t), RT_ALIGN_SIZE)
+#define HEAP_CACHE_MAGIC            0xca000000UL
+#define HEAP_CACHE_LARGE            0xff
+#define HEAP_CACHE_TAG(_ptr)        (*(rt_ubase_t *)((rt_uint8_t *)(_ptr) - HEAP_CACHE_HDR_SIZE))
+#define HEAP_CACHE_BLOCK(_ptr)      ((void *)((rt_uint8_t *)(_ptr) - HEAP_CACHE_HDR_SIZE))
+
+/*
+ * A magazine keeps the recently freed blocks of one size class. It is
+ * refilled from and drained to the heap RT_HEAP_CACHE_DEPTH blocks at a
+ * time, and it holds up to two batches so that an alloc/free pattern
+ * around the boundary does not bounce blocks between cache and heap.
+ *
+ * Each cpu has its own set of magazines. The cpu only masks its own
+ * interrupts to use them, and takes an uncontended spinlock on SMP, which
+ * the other cpus only take to flush them. The threads running on the same
+ * cpu never run at the same time, so magazines per thread would not save
+ * more locking, and a block freed by another thread than the one which
+ * allocated it simply goes to the magazine of the cpu freeing it.
+ */
+struct _heap_magazine
+{
+    rt_uint16_t rounds;                             /* the number of cached blocks */
+    rt_uint32_t hit;                                /* allocations served by the cache */
+    rt_uint32_t miss;                               /* allocations refilled from the heap */
+    rt_uint32_t drain;                              /* batches returned to the heap */
+    void       *round[2 * RT_HEAP_CACHE_DEPTH];     /* cached blocks */
+};
+
+struct _heap_cpu_cache
+{
+#ifdef RT_USING_SMP
+    struct rt_spinlock lock;
+#endif /* RT_USING_SMP */
+    struct _heap_magazine mag[HEAP_CACHE_CLASSES];
+};
+
+#ifdef RT_USING_SMP
+#define HEAP_CACHE_CPUS                     RT_CPUS_NR
+#define _heap_cache_self()                  (&_heap_cache[rt_hw_cpu_id()])
+#define _heap_cache_lock(cache)             rt_spin_lock_irqsave(&(cache)->lock)
+#define _heap_cache_unlock(cache, level)    rt_spin_unlock_irqrestore(&(cache)->lock, level)
+#else
+#define HEAP_CACHE_CPUS                     1
+#define _heap_cache_self()                  (&_heap_cache[0])
+#define _heap_cache_lock(cache)             rt_hw_interrupt_disable()
+#define _heap_cache_unlock(cache, level)    rt_hw_interrupt_enable(level)
+#endif /* RT_USING_SMP */
+
+static struct _heap_cpu_cache _heap_cache[HEAP_CACHE_CPUS];
+
+rt_inline void *_heap_cache_tag(void *block, rt_ubase_t index)
+{
+    *(rt_ubase_t *)block = HEAP_CACHE_MAGIC | index;
+    return (rt_uint8_t *)block + HEAP_CACHE_HDR_SIZE;
+}
+
+/**
+ * @brief Return the cached blocks of all size classes to the heap.
+ */
+void rt_heap_cache_flush(void)
+{
+    void *blocks[RT_HEAP_CACHE_DEPTH];
+    struct _heap_cpu_cache *cache;
+    struct _heap_magazine *mag;
+    rt_base_t level;
+    rt_uint32_t index, count, i;
+
+    /* go through the size classes of each cpu */
+    for (index = 0; index < HEAP_CACHE_CPUS * HEAP_CACHE_CLASSES; index++)
+    {
+        cache = &_heap_cache[index / HEAP_CACHE_CLASSES];
+        mag = &cache->mag[index % HEAP_CACHE_CLASSES];
+        do
+        {
+            level = _heap_cache_lock(cache);
+            for (count = 0; count < RT_HEAP_CACHE_DEPTH && mag->rounds; count++)
+            {
+                blocks[count] = mag->round[--mag->rounds];
+            }
+            _heap_cache_unlock(cache, level);
+
+            if (count)
+            {
+                level = _heap_lock();
+                for (i = 0; i < count; i++)
+                {
+                    _MEM_FREE(HEAP_CACHE_BLOCK(blocks[i]));
+                }
+                _heap_unlock(level);
+            }
+        } while (count == RT_HEAP_CACHE_DEPTH);
+    }
+}
+RTM_EXPORT(rt_heap_cache_flush);
+
+/**
+ * @brief Get the statistics of a size class of the heap cache, summed over
+ *        the cpus.
+ *
+ * @param index is the size class index, starting from 0.
+ *
+ * @param size is a pointer to get the block size of the class.
+ *
+ * @param cached is a pointer to get the number of cached blocks.
+ *
+ * @param hit is a pointer to get the number of allocations served by the cache.
+ *
+ * @param miss is a pointer to get the number of allocations refilled from heap.
+ *
+ * @return RT_EOK on success, -RT_EINVAL if the index is out of range.
+ */
+rt_err_t rt_heap_cache_info(rt_uint32_t index, rt_size_t *size, rt_size_t *cached,
+                            rt_uint32_t *hit, rt_uint32_t *miss)
+{
+    struct _heap_cpu_cache *cache;
+    rt_size_t total_cached = 0;
+    rt_uint32_t total_hit = 0, total_miss = 0, cpu;
+    rt_base_t level;
+
+    if (index >= HEAP_CACHE_CLASSES)
+        return -RT_EINVAL;
+
+    for (cpu = 0; cpu < HEAP_CACHE_CPUS; cpu++)
+    {
+        cache = &_heap_cache[cpu];
+        level = _heap_cache_lock(cache);
+        total_cached += cache->mag[index].rounds;
+        total_hit += cache->mag[index].hit;
+        total_miss += cache->mag[index].miss;
+        _heap_cache_unlock(cache, level);
+    }
+
+    if (size)
+        *size = (index + 1) * HEAP_CACHE_GRANULE;
+    if (cached)
+        *cached = total_cached;
+    if (hit)
+        *hit = total_hit;
+    if (miss)
+        *miss = total_miss;
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_heap_cache_info);
+
+static void *_heap_cache_malloc(rt_size_t size)
+{
+    void *blocks[RT_HEAP_CACHE_DEPTH];
+    struct _heap_cpu_cache *cache;
+    struct _heap_magazine *mag;
+    rt_ubase_t index, block_size;
+    rt_uint32_t count, i;
+    rt_base_t level;
+    void *ptr;
+
+    if (size == 0)
+        return RT_NULL;
+
+    if (size > RT_HEAP_CACHE_MAX_SIZE)
+    {
+        level = _heap_lock();
+        ptr = _MEM_MALLOC(size + HEAP_CACHE_HDR_SIZE);
+        _heap_unlock(level);
+        if (ptr == RT_NULL)
+        {
+            /* the cached blocks may be what the heap is short of */
+            rt_heap_cache_flush();
+            level = _heap_lock();
+            ptr = _MEM_MALLOC(size + HEAP_CACHE_HDR_SIZE);
+            _heap_unlock(level);
+        }
+
+        return ptr ? _heap_cache_tag(ptr, HEAP_CACHE_LARGE) : RT_NULL;
+    }
+
+    index = (size - 1) / HEAP_CACHE_GRANULE;
+    cache = _heap_cache_self();
+    mag = &cache->mag[index];
+
+    level = _heap_cache_lock(cache);
+    if (mag->rounds)
+    {
+        ptr = mag->round[--mag->rounds];
+        mag->hit++;
+        _heap_cache_unlock(cache, level);
+
+        return ptr;
+    }
+    mag->miss++;
+    _heap_cache_unlock(cache, level);
+
+    /* the magazine is empty, refill a batch under one heap lock */
+    block_size = (index + 1) * HEAP_CACHE_GRANULE + HEAP_CACHE_HDR_SIZE;
+    level = _heap_lock();
+    for (count = 0; count < RT_HEAP_CACHE_DEPTH; count++)
+    {
+        ptr = _MEM_MALLOC(block_size);
+        if (ptr == RT_NULL)
+            break;
+        blocks[count] = _heap_cache_tag(ptr, index);
+    }
+    _heap_unlock(level);
+
+    if (count == 0)
+    {
+        rt_heap_cache_flush();
+        level = _heap_lock();
+        ptr = _MEM_MALLOC(block_size);
+        _heap_unlock(level);
+
+        return ptr ? _heap_cache_tag(ptr, index) : RT_NULL;
+    }
+
+    ptr = blocks[--count];
+    if (count)
+    {
+        level = _heap_cache_lock(cache);
+        while (count && mag->rounds < 2 * RT_HEAP_CACHE_DEPTH)
+        {
+            mag->round[mag->rounds++] = blocks[--count];
+        }
+        _heap_cache_unlock(cache, level);
+
+        /* others have filled the magazine meanwhile */
+        if (count)
+        {
+            level = _heap_lock();
+            for (i = 0; i < count; i++)
+            {
+                _MEM_FREE(HEAP_CACHE_BLOCK(blocks[i]));
+            }
+            _heap_unlock(level);
+        }
+    }
+
+    return ptr;
+}
+
+static void _heap_cache_free(void *rmem)
+{
+    void *blocks[RT_HEAP_CACHE_DEPTH];
+    struct _heap_cpu_cache *cache;
+    struct _heap_magazine *mag;
+    rt_ubase_t tag, index;
+    rt_uint32_t count = 0, i;
+    rt_base_t level;
+
+    tag = HEAP_CACHE_TAG(rmem);
+    RT_ASSERT((tag & ~0xffUL) == HEAP_CACHE_MAGIC);
+    index = tag & 0xff;
+
+    if (index == HEAP_CACHE_LARGE)
+    {
+        level = _heap_lock();
+        _MEM_FREE(HEAP_CACHE_BLOCK(rmem));
+        _heap_unlock(level);
+        return;
+    }
+
+    RT_ASSERT(index < HEAP_CACHE_CLASSES);
+    cache = _heap_cache_self();
+    mag = &cache->mag[index];
+
+    level = _heap_cache_lock(cache);
+    if (mag->rounds == 2 * RT_HEAP_CACHE_DEPTH)
+    {
+        /* the magazine is full, hand a batch back to the heap */
+        for (count = 0; count < RT_HEAP_CACHE_DEPTH; count++)
+        {
+            blocks[count] = mag->round[--mag->rounds];
+        }
+        mag->drain++;
+    }
+    mag->round[mag->rounds++] = rmem;
+    _heap_cache_unlock(cache, level);
+
+    if (count)
+    {
+        level = _heap_lock();
+        for (i = 0; i < count; i++)
+        {
+            _MEM_FREE(HEAP_CACHE_BLOCK(blocks[i]));
+        }
+        _heap_unlock(level);
+    }
+}
+#endif /* RT_USING_HEAP_CACHE */
+
 /**
  * @brief This function will init system heap.
  *
@@ -1502,8 +1823,12 @@ RT_WEAK void rt_system_heap_init(void *begin_addr, void *end_addr)
  */
 RT_WEAK void *rt_malloc(rt_size_t size)
 {
-    rt_base_t level;
     void *ptr;
+#ifdef RT_USING_HEAP_CACHE
+    /* small blocks come from the cache, the others from system heap */
+    ptr = _heap_cache_malloc(size);
+#else
+    rt_base_t level;
 
     /* Enter critical zone */
     level = _heap_lock();
@@ -1511,6 +1836,7 @@ RT_WEAK void *rt_malloc(rt_size_t size)
     ptr = _MEM_MALLOC(size);
     /* Exit critical zone */
     _heap_unlock(level);
+#endif /* RT_USING_HEAP_CACHE */
     /* call 'rt_malloc' hook */
     RT_OBJECT_HOOK_CALL(rt_malloc_hook, (ptr, size));
     return ptr;
@@ -1531,12 +1857,39 @@ RT_WEAK void *rt_realloc(void *rmem, rt_size_t newsize)
     rt_base_t level;
     void *nptr;
 
+#ifdef RT_USING_HEAP_CACHE
+    if (rmem == RT_NULL)
+        return rt_malloc(newsize);
+    if (newsize == 0)
+    {
+        rt_free(rmem);
+        return RT_NULL;
+    }
+
+    /* Enter critical zone */
+    level = _heap_lock();
+    /* the resized block no longer fits its size class */
+    nptr = _MEM_REALLOC(HEAP_CACHE_BLOCK(rmem), newsize + HEAP_CACHE_HDR_SIZE);
+    /* Exit critical zone */
+    _heap_unlock(level);
+    if (nptr == RT_NULL)
+    {
+        /* the cached blocks may be what the heap is short of */
+        rt_heap_cache_flush();
+        level = _heap_lock();
+        nptr = _MEM_REALLOC(HEAP_CACHE_BLOCK(rmem), newsize + HEAP_CACHE_HDR_SIZE);
+        _heap_unlock(level);
+    }
+    if (nptr != RT_NULL)
+        nptr = _heap_cache_tag(nptr, HEAP_CACHE_LARGE);
+#else
     /* Enter critical zone */
     level = _heap_lock();
     /* Change the size of previously allocated memory block */
     nptr = _MEM_REALLOC(rmem, newsize);
     /* Exit critical zone */
     _heap_unlock(level);
+#endif /* RT_USING_HEAP_CACHE */
     return nptr;
 }
 RTM_EXPORT(rt_realloc);
@@ -1577,17 +1930,23 @@ RTM_EXPORT(rt_calloc);
  */
 RT_WEAK void rt_free(void *rmem)
 {
+#ifndef RT_USING_HEAP_CACHE
     rt_base_t level;
+#endif /* RT_USING_HEAP_CACHE */
 
     /* call 'rt_free' hook */
     RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
     /* NULL check */
     if (rmem == RT_NULL) return;
+#ifdef RT_USING_HEAP_CACHE
+    _heap_cache_free(rmem);
+#else
     /* Enter critical zone */
     level = _heap_lock();
     _MEM_FREE(rmem);
     /* Exit critical zone */
     _heap_unlock(level);
+#endif /* RT_USING_HEAP_CACHE */
 }
 RTM_EXPORT(rt_free);
 
@@ -1643,6 +2002,27 @@ void rt_page_free(void *addr, rt_size_t npages)
 }
 #endif
 
+#if defined(RT_USING_TLSF) && defined(RT_USING_TLSF_AS_HEAP)
+/**
+ * @brief This function will get the fragmentation information of system heap.
+ *
+ * @param free_blocks is a pointer to get the number of free blocks.
+ *
+ * @param max_free is a pointer to get the size of the largest free block.
+ */
+void rt_memory_frag_info(rt_size_t *free_blocks, rt_size_t *max_free)
+{
+    rt_base_t level;
+
+    /* Enter critical zone */
+    level = _heap_lock();
+    rt_tlsf_frag_info(system_heap, free_blocks, max_free);
+    /* Exit critical zone */
+    _heap_unlock(level);
+}
+RTM_EXPORT(rt_memory_frag_info);
+#endif
+
 /**
  * This function allocates a memory block, which address is aligned to the
  * specified alignment size.
@@ -222,6 +222,61 @@ void rt_object_put_sethook(void (*hook)(struct rt_object *object))
 
 /**@{*/
 
+#ifdef RT_USING_OBJECT_HASH
+#if (RT_OBJECT_HASH_SIZE & (RT_OBJECT_HASH_SIZE - 1)) != 0
+#error "RT_OBJECT_HASH_SIZE must be a power of 2"
+#endif
+
+/*
+ * The name index of the objects in the object containers. Buckets are single
+ * linked through object->hash_next and only hashed by name, the class type is
+ * compared on lookup. Objects of application modules are not indexed, just like
+ * they are not in the object containers.
+ */
+static struct rt_object *_object_hash[RT_OBJECT_HASH_SIZE];
+
+static struct rt_object **_object_hash_bucket(const char *name)
+{
+    rt_uint32_t hash = 2166136261u;
+    int index;
+
+    /* FNV-1a over the part of name which is compared by rt_object_find */
+    for (index = 0; index < RT_NAME_MAX && name[index] != '\0'; index ++)
+    {
+        hash ^= (rt_uint8_t)name[index];
+        hash *= 16777619u;
+    }
+    hash ^= hash >> 16;
+
+    return &_object_hash[hash & (RT_OBJECT_HASH_SIZE - 1)];
+}
+
+/* must be called with interrupt disabled */
+static void _object_hash_insert(struct rt_object *object)
+{
+    struct rt_object **bucket = _object_hash_bucket(object->name);
+
+    object->hash_next = *bucket;
+    *bucket = object;
+}
+
+/* must be called with interrupt disabled */
+static void _object_hash_remove(struct rt_object *object)
+{
+    struct rt_object **prev;
+
+    for (prev = _object_hash_bucket(object->name); *prev != RT_NULL; prev = &((*prev)->hash_next))
+    {
+        if (*prev == object)
+        {
+            *prev = object->hash_next;
+            break;
+        }
+    }
+    object->hash_next = RT_NULL;
+}
+#endif /* RT_USING_OBJECT_HASH */
+
 /**
  * @brief This function will return the specified type of object information.
  *
@@ -384,6 +439,9 @@ void rt_object_init(struct rt_object         *object,
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        _object_hash_insert(object);
+#endif /* RT_USING_OBJECT_HASH */
     }
 
     /* unlock interrupt */
@@ -413,6 +471,9 @@ void rt_object_detach(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(object);
+#endif /* RT_USING_OBJECT_HASH */
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(level);
@@ -480,6 +541,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
     {
         /* insert object into information object list */
         rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+        _object_hash_insert(object);
+#endif /* RT_USING_OBJECT_HASH */
     }
 
     /* unlock interrupt */
@@ -512,6 +576,9 @@ void rt_object_delete(rt_object_t object)
 
     /* remove from old list */
     rt_list_remove(&(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(object);
+#endif /* RT_USING_OBJECT_HASH */
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(level);
@@ -588,6 +655,23 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     /* enter critical */
     rt_enter_critical();
 
+#ifdef RT_USING_OBJECT_HASH
+    /* look up the name index */
+    for (object = *_object_hash_bucket(name); object != RT_NULL; object = object->hash_next)
+    {
+        if ((object->type & ~RT_Object_Class_Static) == type &&
+            rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            break;
+        }
+    }
+
+    /* leave critical */
+    rt_exit_critical();
+
+    RT_UNUSED(node);
+    return object;
+#else
     /* try to find object */
     rt_list_for_each(node, &(information->object_list))
     {
@@ -605,6 +689,7 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     rt_exit_critical();
 
     return RT_NULL;
+#endif /* RT_USING_OBJECT_HASH */
 }
 
 /**@}*/
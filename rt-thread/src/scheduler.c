@@ -89,6 +89,69 @@ void rt_scheduler_switch_sethook(void (*hook)(struct rt_thread *tid))
 /**@}*/
 #endif /* RT_USING_HOOK */
 
+#ifdef RT_USING_THREAD_STAT
+extern rt_uint64_t clock_cpu_gettime(void);
+
+#ifdef RT_USING_SMP
+static rt_uint64_t _thread_stat_switch_time[RT_CPUS_NR];
+#define _thread_stat_last           _thread_stat_switch_time[rt_hw_cpu_id()]
+#else
+static rt_uint64_t _thread_stat_switch_time;
+#define _thread_stat_last           _thread_stat_switch_time
+#endif /* RT_USING_SMP */
+
+rt_inline rt_uint8_t _thread_stat_log2(rt_uint32_t value)
+{
+    rt_uint8_t n = 0;
+
+    if (value >= (1UL << 16)) { value >>= 16; n += 16; }
+    if (value >= (1UL << 8))  { value >>= 8;  n += 8; }
+    if (value >= (1UL << 4))  { value >>= 4;  n += 4; }
+    if (value >= (1UL << 2))  { value >>= 2;  n += 2; }
+    if (value >= (1UL << 1))  { n += 1; }
+
+    return n;
+}
+
+/* mark the time a thread becomes ready, keep the first one if it is re-inserted */
+rt_inline void _thread_stat_ready(struct rt_thread *thread)
+{
+    if (thread->sched_stat.ready_time == 0)
+    {
+        rt_uint64_t now = clock_cpu_gettime();
+
+        thread->sched_stat.ready_time = now ? now : 1;
+    }
+}
+
+/* account the running time of from thread and the latency of to thread */
+static void _thread_stat_switch(struct rt_thread *from, struct rt_thread *to)
+{
+    struct rt_thread_stat *stat = &to->sched_stat;
+    rt_uint64_t now = clock_cpu_gettime();
+
+    if (from != RT_NULL)
+        from->sched_stat.run_time += now - _thread_stat_last;
+    _thread_stat_last = now;
+
+    stat->run_count ++;
+    if (stat->ready_time != 0)
+    {
+        rt_uint64_t delta = now - stat->ready_time;
+        rt_uint32_t latency = (delta > 0xFFFFFFFFUL) ? 0xFFFFFFFFUL : (rt_uint32_t)delta;
+        rt_uint8_t bucket = _thread_stat_log2(latency);
+
+        stat->latency_sum += delta;
+        stat->latency_count ++;
+        if (latency > stat->latency_max)
+            stat->latency_max = latency;
+        if (stat->latency_hist[bucket] != 0xFFFF)
+            stat->latency_hist[bucket] ++;
+        stat->ready_time = 0;
+    }
+}
+#endif /* RT_USING_THREAD_STAT */
+
 #ifdef RT_USING_OVERFLOW_CHECK
 static void _scheduler_stack_check(struct rt_thread *thread)
 {
@@ -261,6 +324,10 @@ void rt_system_scheduler_start(void)
     rt_schedule_remove_thread(to_thread);
     to_thread->stat = RT_THREAD_RUNNING;
 
+#ifdef RT_USING_THREAD_STAT
+    _thread_stat_switch(RT_NULL, to_thread);
+#endif /* RT_USING_THREAD_STAT */
+
     /* switch to new thread */
 #ifdef RT_USING_SMP
     rt_hw_context_switch_to((rt_ubase_t)&to_thread->sp, to_thread);
@@ -365,6 +432,10 @@ void rt_schedule(void)
 
                 RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (current_thread, to_thread));
 
+#ifdef RT_USING_THREAD_STAT
+                _thread_stat_switch(current_thread, to_thread);
+#endif /* RT_USING_THREAD_STAT */
+
                 rt_schedule_remove_thread(to_thread);
                 to_thread->stat = RT_THREAD_RUNNING | (to_thread->stat & ~RT_THREAD_STAT_MASK);
 
@@ -467,6 +538,10 @@ void rt_schedule(void)
 
                 RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (from_thread, to_thread));
 
+#ifdef RT_USING_THREAD_STAT
+                _thread_stat_switch(from_thread, to_thread);
+#endif /* RT_USING_THREAD_STAT */
+
                 if (need_insert_from_thread)
                 {
                     rt_schedule_insert_thread(from_thread);
@@ -533,6 +608,9 @@ void rt_schedule(void)
             {
                 rt_schedule_remove_thread(rt_current_thread);
                 rt_current_thread->stat = RT_THREAD_RUNNING | (rt_current_thread->stat & ~RT_THREAD_STAT_MASK);
+#ifdef RT_USING_THREAD_STAT
+                rt_current_thread->sched_stat.ready_time = 0;
+#endif /* RT_USING_THREAD_STAT */
             }
         }
     }
@@ -619,6 +697,10 @@ void rt_scheduler_do_irq_switch(void *context)
 
                 RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (current_thread, to_thread));
 
+#ifdef RT_USING_THREAD_STAT
+                _thread_stat_switch(current_thread, to_thread);
+#endif /* RT_USING_THREAD_STAT */
+
                 rt_schedule_remove_thread(to_thread);
                 to_thread->stat = RT_THREAD_RUNNING | (to_thread->stat & ~RT_THREAD_STAT_MASK);
 
@@ -672,6 +754,10 @@ void rt_schedule_insert_thread(struct rt_thread *thread)
     /* READY thread, insert to ready queue */
     thread->stat = RT_THREAD_READY | (thread->stat & ~RT_THREAD_STAT_MASK);
 
+#ifdef RT_USING_THREAD_STAT
+    _thread_stat_ready(thread);
+#endif /* RT_USING_THREAD_STAT */
+
     cpu_id   = rt_hw_cpu_id();
     bind_cpu = thread->bind_cpu ;
 
@@ -754,6 +840,10 @@ void rt_schedule_insert_thread(struct rt_thread *thread)
 
     /* READY thread, insert to ready queue */
     thread->stat = RT_THREAD_READY | (thread->stat & ~RT_THREAD_STAT_MASK);
+
+#ifdef RT_USING_THREAD_STAT
+    _thread_stat_ready(thread);
+#endif /* RT_USING_THREAD_STAT */
     /* there is no time slices left(YIELD), inserting thread before ready list*/
     if((thread->stat & RT_THREAD_STAT_YIELD_MASK) != 0)
     {
@@ -1028,4 +1118,100 @@ rt_uint16_t rt_critical_level(void)
 }
 RTM_EXPORT(rt_critical_level);
 
+#ifdef RT_USING_THREAD_STAT
+/**
+ * @brief This function will get the run time and scheduling latency statistics of a thread.
+ *
+ * @note  The times are CPU time counts, which can be converted by clock_cpu_microsecond().
+ *        The run time includes the slice the thread is running now.
+ *
+ * @param thread is the thread to get the statistics of.
+ *
+ * @param stat is the buffer to return the statistics.
+ *
+ * @return Return the operation status. When the return value is RT_EOK, the operation is successful.
+ */
+rt_err_t rt_thread_stat_get(rt_thread_t thread, struct rt_thread_stat *stat)
+{
+    rt_base_t level;
+
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(stat != RT_NULL);
+    RT_ASSERT(rt_object_get_type((rt_object_t)thread) == RT_Object_Class_Thread);
+
+    level = rt_hw_interrupt_disable();
+
+    rt_memcpy(stat, &thread->sched_stat, sizeof(struct rt_thread_stat));
+#ifdef RT_USING_SMP
+    if (thread->oncpu != RT_CPU_DETACHED)
+        stat->run_time += clock_cpu_gettime() - _thread_stat_switch_time[thread->oncpu];
+#else
+    if (thread == rt_current_thread)
+        stat->run_time += clock_cpu_gettime() - _thread_stat_switch_time;
+#endif /* RT_USING_SMP */
+
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_thread_stat_get);
+
+/**
+ * @brief This function will clear the statistics of a thread, or of all threads when thread is RT_NULL.
+ *
+ * @param thread is the thread to clear the statistics of.
+ */
+void rt_thread_stat_reset(rt_thread_t thread)
+{
+    struct rt_object_information *info;
+    struct rt_list_node *node;
+    struct rt_thread_stat *stat;
+    rt_uint64_t ready_time;
+    rt_uint32_t id;
+    rt_base_t level;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+
+    level = rt_hw_interrupt_disable();
+
+    rt_list_for_each(node, &(info->object_list))
+    {
+        struct rt_thread *th = (struct rt_thread *)rt_list_entry(node, struct rt_object, list);
+
+        if (thread != RT_NULL && th != thread)
+            continue;
+
+        /* a thread waiting to run keeps its ready time */
+        stat = &th->sched_stat;
+        ready_time = stat->ready_time;
+        id = stat->id;
+        rt_memset(stat, 0, sizeof(struct rt_thread_stat));
+        stat->ready_time = ready_time;
+        stat->id = id;
+    }
+
+    /* restart the slice of a running thread whose run time is cleared */
+#ifdef RT_USING_SMP
+    if (thread == RT_NULL)
+    {
+        int cpu;
+        rt_uint64_t now = clock_cpu_gettime();
+
+        for (cpu = 0; cpu < RT_CPUS_NR; cpu++)
+            _thread_stat_switch_time[cpu] = now;
+    }
+    else if (thread->oncpu != RT_CPU_DETACHED)
+    {
+        _thread_stat_switch_time[thread->oncpu] = clock_cpu_gettime();
+    }
+#else
+    if (thread == RT_NULL || thread == rt_current_thread)
+        _thread_stat_switch_time = clock_cpu_gettime();
+#endif /* RT_USING_SMP */
+
+    rt_hw_interrupt_enable(level);
+}
+RTM_EXPORT(rt_thread_stat_reset);
+#endif /* RT_USING_THREAD_STAT */
+
 /**@}*/
@@ -259,6 +259,19 @@ static rt_err_t _thread_init(struct rt_thread *thread,
     thread->duration_tick = 0;
 #endif /* RT_USING_CPU_USAGE */
 
+#ifdef RT_USING_THREAD_STAT
+    rt_memset(&thread->sched_stat, 0, sizeof(thread->sched_stat));
+    {
+        static rt_uint32_t stat_id = 0;
+        rt_base_t level;
+
+        /* tells a new thread from a deleted one at the same address */
+        level = rt_hw_interrupt_disable();
+        thread->sched_stat.id = ++ stat_id;
+        rt_hw_interrupt_enable(level);
+    }
+#endif /* RT_USING_THREAD_STAT */
+
 #ifdef RT_USING_PTHREADS
     thread->pthread_data = RT_NULL;
 #endif /* RT_USING_PTHREADS */
@@ -897,6 +910,10 @@ rt_err_t rt_thread_suspend(rt_thread_t thread)
     /* change thread stat */
     rt_schedule_remove_thread(thread);
     thread->stat = RT_THREAD_SUSPEND | (thread->stat & ~RT_THREAD_STAT_MASK);
+#ifdef RT_USING_THREAD_STAT
+    /* it is not waiting to run any more */
+    thread->sched_stat.ready_time = 0;
+#endif /* RT_USING_THREAD_STAT */
 
     /* stop thread timer anyway */
     rt_timer_stop(&(thread->thread_timer));
@@ -24,8 +24,45 @@
 #include <rtthread.h>
 #include <rthw.h>
 
+#ifdef RT_TIMER_USING_WHEEL
+
+#ifndef RT_TIMER_WHEEL_ROOT_BITS
+#define RT_TIMER_WHEEL_ROOT_BITS        5
+#endif /* RT_TIMER_WHEEL_ROOT_BITS */
+
+#ifndef RT_TIMER_WHEEL_LEVEL_BITS
+#define RT_TIMER_WHEEL_LEVEL_BITS       4
+#endif /* RT_TIMER_WHEEL_LEVEL_BITS */
+
+#if (RT_TIMER_WHEEL_ROOT_BITS > 5) || (RT_TIMER_WHEEL_LEVEL_BITS > 5)
+#error "each timer wheel level must fit in a 32 bits pending map"
+#endif
+
+#define _WHEEL_ROOT_SIZE    (1UL << RT_TIMER_WHEEL_ROOT_BITS)
+#define _WHEEL_ROOT_MASK    (_WHEEL_ROOT_SIZE - 1)
+#define _WHEEL_LEVEL_SIZE   (1UL << RT_TIMER_WHEEL_LEVEL_BITS)
+#define _WHEEL_LEVEL_MASK   (_WHEEL_LEVEL_SIZE - 1)
+/* enough levels to cover the whole 32 bits tick range */
+#define _WHEEL_LEVELS       (1 + (32 - RT_TIMER_WHEEL_ROOT_BITS + RT_TIMER_WHEEL_LEVEL_BITS - 1) / RT_TIMER_WHEEL_LEVEL_BITS)
+#define _WHEEL_SLOTS        (_WHEEL_ROOT_SIZE + (_WHEEL_LEVELS - 1) * _WHEEL_LEVEL_SIZE)
+/* tick bits consumed below an upper level (lvl >= 1) */
+#define _WHEEL_SHIFT(lvl)   (RT_TIMER_WHEEL_ROOT_BITS + ((lvl) - 1) * RT_TIMER_WHEEL_LEVEL_BITS)
+/* index of the first slot of an upper level (lvl >= 1) */
+#define _WHEEL_OFFSET(lvl)  (_WHEEL_ROOT_SIZE + ((lvl) - 1) * _WHEEL_LEVEL_SIZE)
+
+struct _timer_wheel
+{
+    rt_tick_t   base;                       /**< the next tick to be processed */
+    rt_uint32_t pending[_WHEEL_LEVELS];     /**< non-empty slots map of each level */
+    rt_list_t   slot[_WHEEL_SLOTS];         /**< timer lists of all levels */
+};
+
+/* hard timer wheel */
+static struct _timer_wheel _timer_wheel;
+#else
 /* hard timer list */
 static rt_list_t _timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif /* RT_TIMER_USING_WHEEL */
 
 #ifdef RT_USING_TIMER_SOFT
 
@@ -42,8 +79,13 @@ static rt_list_t _timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 
 /* soft timer status */
 static rt_uint8_t _soft_timer_status = RT_SOFT_TIMER_IDLE;
+#ifdef RT_TIMER_USING_WHEEL
+/* soft timer wheel */
+static struct _timer_wheel _soft_timer_wheel;
+#else
 /* soft timer list */
 static rt_list_t _soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#endif /* RT_TIMER_USING_WHEEL */
 static struct rt_thread _timer_thread;
 ALIGN(RT_ALIGN_SIZE)
 static rt_uint8_t _timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
@@ -144,6 +186,335 @@ static void _timer_init(rt_timer_t timer,
     }
 }
 
+#ifdef RT_TIMER_USING_WHEEL
+/**
+ * @brief Find the first pending slot of a wheel level in circular order
+ *
+ * @param map is the pending map of the level
+ *
+ * @param bits is the number of slot bits of the level
+ *
+ * @param start is the slot where the search begins
+ *
+ * @return the distance from start to the first pending slot
+ */
+rt_inline rt_ubase_t _timer_wheel_search(rt_uint32_t map, rt_ubase_t bits, rt_ubase_t start)
+{
+    rt_uint32_t size = 1UL << bits;
+
+    if (start != 0)
+    {
+        /* rotate the map so that bit 0 is the start slot */
+        map = ((map >> start) | (map << (size - start))) & (0xFFFFFFFFUL >> (32 - size));
+    }
+
+    return __rt_ffs(map) - 1;
+}
+
+/**
+ * @brief Clear the pending bit of a wheel slot
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param head is the slot list head which became empty
+ */
+rt_inline void _timer_wheel_slot_clear(struct _timer_wheel *wheel, rt_list_t *head)
+{
+    rt_ubase_t index;
+
+    if (head < &wheel->slot[0] || head >= &wheel->slot[_WHEEL_SLOTS])
+        return;
+
+    index = head - &wheel->slot[0];
+    if (index < _WHEEL_ROOT_SIZE)
+    {
+        wheel->pending[0] &= ~(1UL << index);
+    }
+    else
+    {
+        index -= _WHEEL_ROOT_SIZE;
+        wheel->pending[1 + (index >> RT_TIMER_WHEEL_LEVEL_BITS)] &= ~(1UL << (index & _WHEEL_LEVEL_MASK));
+    }
+}
+
+/**
+ * @brief Remove the timer
+ *
+ * @param timer the point of the timer
+ */
+rt_inline void _timer_remove(rt_timer_t timer)
+{
+    rt_list_t *node = &timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1];
+
+    /* the last timer leaves its slot, the only neighbour is the list head */
+    if (node->next != node && node->next == node->prev)
+    {
+        _timer_wheel_slot_clear(&_timer_wheel, node->next);
+#ifdef RT_USING_TIMER_SOFT
+        _timer_wheel_slot_clear(&_soft_timer_wheel, node->next);
+#endif /* RT_USING_TIMER_SOFT */
+    }
+    rt_list_remove(node);
+}
+
+/**
+ * @brief Put the timer into the slot of its timeout tick
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param timer is the timer to be inserted
+ */
+static void _timer_wheel_insert(struct _timer_wheel *wheel, rt_timer_t timer)
+{
+    rt_tick_t timeout_tick = timer->timeout_tick;
+    rt_tick_t delta = timeout_tick - wheel->base;
+    rt_ubase_t lvl, index;
+
+    if (delta >= RT_TICK_MAX / 2)
+    {
+        /* already timeout, fire it on the next processed tick */
+        lvl = 0;
+        index = wheel->base & _WHEEL_ROOT_MASK;
+    }
+    else if (delta < _WHEEL_ROOT_SIZE)
+    {
+        lvl = 0;
+        index = timeout_tick & _WHEEL_ROOT_MASK;
+    }
+    else
+    {
+        for (lvl = 1; lvl < _WHEEL_LEVELS - 1; lvl++)
+        {
+            if (delta < (1UL << _WHEEL_SHIFT(lvl + 1)))
+                break;
+        }
+        index = (timeout_tick >> _WHEEL_SHIFT(lvl)) & _WHEEL_LEVEL_MASK;
+    }
+
+    wheel->pending[lvl] |= 1UL << index;
+    if (lvl != 0)
+        index += _WHEEL_OFFSET(lvl);
+
+    /* insert to the tail, the timer inserted early gets called early */
+    rt_list_insert_before(&wheel->slot[index], &timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+}
+
+/**
+ * @brief Move the base of an empty wheel to the current tick
+ *
+ * @note The base of the soft timer wheel does not move while the timer thread
+ *       is suspended, and neither does the hard one over a tick compensation.
+ *       A stale base would make the next expire walk all of the idle ticks,
+ *       and put a timer started past RT_TICK_MAX / 2 of it in the past.
+ *
+ * @param wheel is the timer wheel
+ */
+rt_inline void _timer_wheel_resync(struct _timer_wheel *wheel)
+{
+    rt_ubase_t lvl;
+
+    for (lvl = 0; lvl < _WHEEL_LEVELS; lvl++)
+    {
+        if (wheel->pending[lvl] != 0)
+            return;
+    }
+
+    wheel->base = rt_tick_get();
+}
+
+/**
+ * @brief Redistribute the timers of an upper level slot to the lower levels
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param lvl is the upper level
+ *
+ * @param index is the slot index in the level
+ */
+static void _timer_wheel_cascade(struct _timer_wheel *wheel, rt_ubase_t lvl, rt_ubase_t index)
+{
+    rt_list_t *head = &wheel->slot[_WHEEL_OFFSET(lvl) + index];
+    rt_list_t list;
+
+    if (rt_list_isempty(head))
+        return;
+
+    /* take the whole slot away before inserting again */
+    list.next = head->next;
+    list.prev = head->prev;
+    list.next->prev = &list;
+    list.prev->next = &list;
+    rt_list_init(head);
+    wheel->pending[lvl] &= ~(1UL << index);
+
+    while (!rt_list_isempty(&list))
+    {
+        struct rt_timer *t = rt_list_entry(list.next, struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+
+        rt_list_remove(&(t->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+        _timer_wheel_insert(wheel, t);
+    }
+}
+
+/**
+ * @brief Advance the wheel to the current tick and collect the timeout timers
+ *
+ * @note This function shall be invoked with interrupt disabled.
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param current_tick is the current tick
+ *
+ * @param list is the list which the timeout timers are appended to
+ */
+static void _timer_wheel_expire(struct _timer_wheel *wheel, rt_tick_t current_tick, rt_list_t *list)
+{
+    rt_ubase_t lvl, index;
+
+    while ((current_tick - wheel->base) < RT_TICK_MAX / 2)
+    {
+        index = wheel->base & _WHEEL_ROOT_MASK;
+        if (index == 0)
+        {
+            /* the first level wraps, bring down the timers of the upper levels */
+            for (lvl = 1; lvl < _WHEEL_LEVELS; lvl++)
+            {
+                rt_ubase_t lvl_index = (wheel->base >> _WHEEL_SHIFT(lvl)) & _WHEEL_LEVEL_MASK;
+
+                _timer_wheel_cascade(wheel, lvl, lvl_index);
+                if (lvl_index != 0)
+                    break;
+            }
+        }
+
+        if (wheel->pending[0] == 0)
+        {
+            rt_tick_t next_tick = (wheel->base | _WHEEL_ROOT_MASK) + 1;
+
+            for (lvl = 1; lvl < _WHEEL_LEVELS; lvl++)
+            {
+                if (wheel->pending[lvl] != 0)
+                    break;
+            }
+
+            /* nothing timeout before the next cascade, skip the empty slots */
+            if (lvl == _WHEEL_LEVELS || (next_tick - current_tick - 1) < RT_TICK_MAX / 2)
+            {
+                wheel->base = current_tick + 1;
+                break;
+            }
+            wheel->base = next_tick;
+            continue;
+        }
+
+        if (wheel->pending[0] & (1UL << index))
+        {
+            rt_list_t *head = &wheel->slot[index];
+
+            while (!rt_list_isempty(head))
+            {
+                rt_list_t *node = head->next;
+
+                rt_list_remove(node);
+                rt_list_insert_before(list, node);
+            }
+            wheel->pending[0] &= ~(1UL << index);
+        }
+        wheel->base++;
+    }
+}
+
+/**
+ * @brief  Find the next emtpy timer ticks
+ *
+ * @param wheel is the timer wheel
+ *
+ * @param timeout_tick is the next timer's ticks
+ *
+ * @return  Return the operation status. If the return value is RT_EOK, the function is successfully executed.
+ *          If the return value is any other values, it means this operation failed.
+ */
+static rt_err_t _timer_list_next_timeout(struct _timer_wheel *wheel, rt_tick_t *timeout_tick)
+{
+    rt_ubase_t lvl, index;
+    rt_tick_t delta, min_delta = RT_TICK_MAX;
+    rt_base_t level;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    /* the slots of the first level map to one tick each */
+    if (wheel->pending[0] != 0)
+    {
+        min_delta = _timer_wheel_search(wheel->pending[0], RT_TIMER_WHEEL_ROOT_BITS,
+                                        wheel->base & _WHEEL_ROOT_MASK);
+    }
+
+    /* an upper level slot holds a range of ticks, look into its first pending slot */
+    for (lvl = 1; lvl < _WHEEL_LEVELS; lvl++)
+    {
+        rt_list_t *head, *node;
+
+        if (wheel->pending[lvl] == 0)
+            continue;
+
+        /*
+         * the current slot is not cascaded yet when the base sits on its
+         * boundary, otherwise it holds the timers of the next round.
+         */
+        index = wheel->base >> _WHEEL_SHIFT(lvl);
+        if (wheel->base & ((1UL << _WHEEL_SHIFT(lvl)) - 1))
+            index++;
+        index &= _WHEEL_LEVEL_MASK;
+        index = (index + _timer_wheel_search(wheel->pending[lvl], RT_TIMER_WHEEL_LEVEL_BITS, index)) & _WHEEL_LEVEL_MASK;
+
+        head = &wheel->slot[_WHEEL_OFFSET(lvl) + index];
+        for (node = head->next; node != head; node = node->next)
+        {
+            struct rt_timer *t = rt_list_entry(node, struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
+
+            delta = t->timeout_tick - wheel->base;
+            if (delta < min_delta)
+                min_delta = delta;
+        }
+    }
+
+    if (min_delta != RT_TICK_MAX)
+    {
+        *timeout_tick = wheel->base + min_delta;
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        return RT_EOK;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return -RT_ERROR;
+}
+
+/**
+ * @brief Initialize the timer wheel
+ *
+ * @param wheel is the timer wheel
+ */
+static void _timer_wheel_init(struct _timer_wheel *wheel)
+{
+    rt_size_t i;
+
+    wheel->base = rt_tick_get();
+    for (i = 0; i < _WHEEL_LEVELS; i++)
+    {
+        wheel->pending[i] = 0;
+    }
+    for (i = 0; i < _WHEEL_SLOTS; i++)
+    {
+        rt_list_init(&wheel->slot[i]);
+    }
+}
+#else
 /**
  * @brief  Find the next emtpy timer ticks
  *
@@ -235,6 +606,7 @@ void rt_timer_dump(rt_list_t timer_heads[])
     rt_kprintf("\n");
 }
 #endif /* RT_DEBUG_TIMER */
+#endif /* RT_TIMER_USING_WHEEL */
 
 /**
  * @addtogroup Clock
@@ -406,13 +778,17 @@ RTM_EXPORT(rt_timer_delete);
  */
 rt_err_t rt_timer_start(rt_timer_t timer)
 {
-    unsigned int row_lvl;
-    rt_list_t *timer_list;
     rt_base_t level;
     rt_bool_t need_schedule;
+#ifdef RT_TIMER_USING_WHEEL
+    struct _timer_wheel *wheel;
+#else
+    unsigned int row_lvl;
+    rt_list_t *timer_list;
     rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
     unsigned int tst_nr;
     static unsigned int random_nr;
+#endif /* RT_TIMER_USING_WHEEL */
 
     /* parameter check */
     RT_ASSERT(timer != RT_NULL);
@@ -431,6 +807,24 @@ rt_err_t rt_timer_start(rt_timer_t timer)
 
     timer->timeout_tick = rt_tick_get() + timer->init_tick;
 
+#ifdef RT_TIMER_USING_WHEEL
+#ifdef RT_USING_TIMER_SOFT
+    if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
+    {
+        /* insert timer to soft timer wheel */
+        wheel = &_soft_timer_wheel;
+    }
+    else
+#endif /* RT_USING_TIMER_SOFT */
+    {
+        /* insert timer to system timer wheel */
+        wheel = &_timer_wheel;
+    }
+
+    /* no timer pending, the base may be left behind by an idle time */
+    _timer_wheel_resync(wheel);
+    _timer_wheel_insert(wheel, timer);
+#else
 #ifdef RT_USING_TIMER_SOFT
     if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
     {
@@ -494,6 +888,7 @@ rt_err_t rt_timer_start(rt_timer_t timer)
          * bits. */
         tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
     }
+#endif /* RT_TIMER_USING_WHEEL */
 
     timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
 
@@ -632,6 +1027,12 @@ void rt_timer_check(void)
     rt_tick_t current_tick;
     rt_base_t level;
     rt_list_t list;
+    rt_list_t *timer_head;
+#ifdef RT_TIMER_USING_WHEEL
+    rt_list_t expired;
+
+    rt_list_init(&expired);
+#endif /* RT_TIMER_USING_WHEEL */
 
     rt_list_init(&list);
 
@@ -642,9 +1043,17 @@ void rt_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (!rt_list_isempty(&_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+#ifdef RT_TIMER_USING_WHEEL
+    /* move all of the timeout timers out of the wheel */
+    _timer_wheel_expire(&_timer_wheel, current_tick, &expired);
+    timer_head = &expired;
+#else
+    timer_head = &_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1];
+#endif /* RT_TIMER_USING_WHEEL */
+
+    while (!rt_list_isempty(timer_head))
     {
-        t = rt_list_entry(_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
+        t = rt_list_entry(timer_head->next,
                           struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
 
         /*
@@ -703,7 +1112,11 @@ void rt_timer_check(void)
 rt_tick_t rt_timer_next_timeout_tick(void)
 {
     rt_tick_t next_timeout = RT_TICK_MAX;
+#ifdef RT_TIMER_USING_WHEEL
+    _timer_list_next_timeout(&_timer_wheel, &next_timeout);
+#else
     _timer_list_next_timeout(_timer_list, &next_timeout);
+#endif /* RT_TIMER_USING_WHEEL */
     return next_timeout;
 }
 
@@ -718,6 +1131,12 @@ void rt_soft_timer_check(void)
     struct rt_timer *t;
     rt_base_t level;
     rt_list_t list;
+    rt_list_t *timer_head;
+#ifdef RT_TIMER_USING_WHEEL
+    rt_list_t expired;
+
+    rt_list_init(&expired);
+#endif /* RT_TIMER_USING_WHEEL */
 
     rt_list_init(&list);
 
@@ -726,9 +1145,17 @@ void rt_soft_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
-    while (!rt_list_isempty(&_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
+#ifdef RT_TIMER_USING_WHEEL
+    /* move all of the timeout timers out of the wheel */
+    _timer_wheel_expire(&_soft_timer_wheel, rt_tick_get(), &expired);
+    timer_head = &expired;
+#else
+    timer_head = &_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1];
+#endif /* RT_TIMER_USING_WHEEL */
+
+    while (!rt_list_isempty(timer_head))
     {
-        t = rt_list_entry(_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
+        t = rt_list_entry(timer_head->next,
                             struct rt_timer, row[RT_TIMER_SKIP_LIST_LEVEL - 1]);
 
         current_tick = rt_tick_get();
@@ -798,7 +1225,11 @@ static void _timer_thread_entry(void *parameter)
     while (1)
     {
         /* get the next timeout tick */
+#ifdef RT_TIMER_USING_WHEEL
+        if (_timer_list_next_timeout(&_soft_timer_wheel, &next_timeout) != RT_EOK)
+#else
         if (_timer_list_next_timeout(_soft_timer_list, &next_timeout) != RT_EOK)
+#endif /* RT_TIMER_USING_WHEEL */
         {
             /* no software timer exist, suspend self. */
             rt_thread_suspend(rt_thread_self());
@@ -832,12 +1263,16 @@ static void _timer_thread_entry(void *parameter)
  */
 void rt_system_timer_init(void)
 {
+#ifdef RT_TIMER_USING_WHEEL
+    _timer_wheel_init(&_timer_wheel);
+#else
     rt_size_t i;
 
     for (i = 0; i < sizeof(_timer_list) / sizeof(_timer_list[0]); i++)
     {
         rt_list_init(_timer_list + i);
     }
+#endif /* RT_TIMER_USING_WHEEL */
 }
 
 /**
@@ -848,6 +1283,9 @@ void rt_system_timer_init(void)
 void rt_system_timer_thread_init(void)
 {
 #ifdef RT_USING_TIMER_SOFT
+#ifdef RT_TIMER_USING_WHEEL
+    _timer_wheel_init(&_soft_timer_wheel);
+#else
     int i;
 
     for (i = 0;
@@ -856,6 +1294,7 @@ void rt_system_timer_thread_init(void)
     {
         rt_list_init(_soft_timer_list + i);
     }
+#endif /* RT_TIMER_USING_WHEEL */
 
     /* start software timer thread */
     rt_thread_init(&_timer_thread,
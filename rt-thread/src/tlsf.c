@@ -0,0 +1,730 @@
+/*
+ * Copyright (c) 2006-2022, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-16     RT-Thread    the first version
+ */
+
+/*
+ * Two-Level Segregated Fit memory allocator.
+ *
+ * The free blocks are kept in segregated lists indexed by a first level
+ * (power of two of the block size) and a second level (linear subdivision
+ * of that power of two). Two bitmaps record which lists are not empty, so
+ * both allocation and release finish in a bounded number of steps no matter
+ * how many blocks or how much fragmentation the heap has.
+ *
+ * The algorithm is described in "TLSF: a New Dynamic Memory Allocator for
+ * Real-Time Systems", M. Masmano, I. Ripoll, A. Crespo, J. Real, 2004.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined (RT_USING_TLSF)
+
+#ifdef ARCH_CPU_64BIT
+#define TLSF_ALIGN_SIZE_LOG2    3
+#else
+#define TLSF_ALIGN_SIZE_LOG2    2
+#endif /* ARCH_CPU_64BIT */
+#define TLSF_ALIGN_SIZE         (1UL << TLSF_ALIGN_SIZE_LOG2)
+
+#if RT_ALIGN_SIZE > (1 << TLSF_ALIGN_SIZE_LOG2)
+#error "TLSF memory algorithm does not support RT_ALIGN_SIZE larger than the pointer size"
+#endif
+
+#ifndef RT_TLSF_SL_INDEX_COUNT_LOG2
+#define RT_TLSF_SL_INDEX_COUNT_LOG2     4
+#endif /* RT_TLSF_SL_INDEX_COUNT_LOG2 */
+
+#ifndef RT_TLSF_FL_INDEX_MAX
+#define RT_TLSF_FL_INDEX_MAX            24
+#endif /* RT_TLSF_FL_INDEX_MAX */
+
+#define SL_INDEX_COUNT          (1UL << RT_TLSF_SL_INDEX_COUNT_LOG2)
+#define FL_INDEX_SHIFT          (RT_TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2)
+#define FL_INDEX_COUNT          (RT_TLSF_FL_INDEX_MAX - FL_INDEX_SHIFT + 1)
+#define SMALL_BLOCK_SIZE        (1UL << FL_INDEX_SHIFT)
+
+#if FL_INDEX_COUNT > 32
+#error "RT_TLSF_FL_INDEX_MAX is too large for a 32 bits first level bitmap"
+#endif
+
+/**
+ * block header of the TLSF memory
+ *
+ * prev_phys is stored in the last word of the previous block and is only
+ * valid when the previous block is free. next_free/prev_free are only valid
+ * when the block itself is free, otherwise they are part of the user data.
+ */
+struct rt_tlsf_block
+{
+    struct rt_tlsf_block   *prev_phys;          /**< previous physical block */
+    rt_size_t               size;               /**< block size and status bits */
+    struct rt_tlsf_block   *next_free;          /**< next free block */
+    struct rt_tlsf_block   *prev_free;          /**< prev free block */
+};
+
+/**
+ * Base structure of TLSF memory object
+ */
+struct rt_tlsf
+{
+    struct rt_memory        parent;                                 /**< inherit from rt_memory */
+    struct rt_tlsf_block    block_null;                             /**< the end of all free lists */
+    rt_size_t               free_count;                             /**< number of free blocks */
+    rt_uint32_t             fl_bitmap;                              /**< first level bitmap */
+    rt_uint32_t             sl_bitmap[FL_INDEX_COUNT];              /**< second level bitmaps */
+    struct rt_tlsf_block   *blocks[FL_INDEX_COUNT][SL_INDEX_COUNT]; /**< free lists */
+};
+
+#define BLOCK_FREE_BIT          0x1UL
+#define BLOCK_PREV_FREE_BIT     0x2UL
+
+/* the only overhead of a used block is its size field */
+#define BLOCK_OVERHEAD          (sizeof(rt_size_t))
+/* user data starts right after the size field */
+#define BLOCK_START_OFFSET      (sizeof(struct rt_tlsf_block *) + sizeof(rt_size_t))
+#define BLOCK_SIZE_MIN          (sizeof(struct rt_tlsf_block) - sizeof(struct rt_tlsf_block *))
+#define BLOCK_SIZE_MAX          (1UL << RT_TLSF_FL_INDEX_MAX)
+
+#define BLOCK_SIZE(_b)          ((_b)->size & ~(BLOCK_FREE_BIT | BLOCK_PREV_FREE_BIT))
+#define BLOCK_IS_FREE(_b)       ((_b)->size & BLOCK_FREE_BIT)
+#define BLOCK_IS_PREV_FREE(_b)  ((_b)->size & BLOCK_PREV_FREE_BIT)
+#define BLOCK_IS_LAST(_b)       (BLOCK_SIZE(_b) == 0)
+#define BLOCK_TO_PTR(_b)        ((void *)((rt_uint8_t *)(_b) + BLOCK_START_OFFSET))
+#define BLOCK_FROM_PTR(_p)      ((struct rt_tlsf_block *)((rt_uint8_t *)(_p) - BLOCK_START_OFFSET))
+#define BLOCK_NEXT(_b)          \
+    ((struct rt_tlsf_block *)((rt_uint8_t *)BLOCK_TO_PTR(_b) + BLOCK_SIZE(_b) - BLOCK_OVERHEAD))
+
+/* find last set bit, 0 based */
+rt_inline int _tlsf_fls(rt_size_t word)
+{
+    int bit = 0;
+
+#ifdef ARCH_CPU_64BIT
+    if (word & 0xffffffff00000000UL) { word >>= 32; bit += 32; }
+#endif /* ARCH_CPU_64BIT */
+    if (word & 0xffff0000UL) { word >>= 16; bit += 16; }
+    if (word & 0xff00) { word >>= 8; bit += 8; }
+    if (word & 0xf0) { word >>= 4; bit += 4; }
+    if (word & 0xc) { word >>= 2; bit += 2; }
+    if (word & 0x2) { bit += 1; }
+
+    return bit;
+}
+
+/* find first set bit, 0 based */
+rt_inline int _tlsf_ffs(rt_uint32_t word)
+{
+    return __rt_ffs((int)word) - 1;
+}
+
+rt_inline void _block_set_size(struct rt_tlsf_block *block, rt_size_t size)
+{
+    block->size = size | (block->size & (BLOCK_FREE_BIT | BLOCK_PREV_FREE_BIT));
+}
+
+rt_inline struct rt_tlsf_block *_block_link_next(struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *next = BLOCK_NEXT(block);
+
+    next->prev_phys = block;
+    return next;
+}
+
+rt_inline void _block_mark_as_free(struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *next = _block_link_next(block);
+
+    next->size |= BLOCK_PREV_FREE_BIT;
+    block->size |= BLOCK_FREE_BIT;
+}
+
+rt_inline void _block_mark_as_used(struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *next = BLOCK_NEXT(block);
+
+    next->size &= ~BLOCK_PREV_FREE_BIT;
+    block->size &= ~BLOCK_FREE_BIT;
+}
+
+/**
+ * @brief Calculate the list indexes where a block of the size is stored.
+ */
+rt_inline void _mapping_insert(rt_size_t size, int *fli, int *sli)
+{
+    int fl, sl;
+
+    if (size < SMALL_BLOCK_SIZE)
+    {
+        /* store small blocks in the first list */
+        fl = 0;
+        sl = (int)size / (SMALL_BLOCK_SIZE / SL_INDEX_COUNT);
+    }
+    else
+    {
+        fl = _tlsf_fls(size);
+        sl = (int)(size >> (fl - RT_TLSF_SL_INDEX_COUNT_LOG2)) ^ (1 << RT_TLSF_SL_INDEX_COUNT_LOG2);
+        fl -= (FL_INDEX_SHIFT - 1);
+    }
+    *fli = fl;
+    *sli = sl;
+}
+
+/**
+ * @brief Calculate the list indexes to search, round the size up to the next
+ *        list so that any block of that list is large enough.
+ */
+rt_inline void _mapping_search(rt_size_t size, int *fli, int *sli)
+{
+    if (size >= SMALL_BLOCK_SIZE)
+    {
+        size += (1UL << (_tlsf_fls(size) - RT_TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    _mapping_insert(size, fli, sli);
+}
+
+static struct rt_tlsf_block *_search_suitable_block(struct rt_tlsf *tlsf, int *fli, int *sli)
+{
+    int fl = *fli;
+    int sl = *sli;
+    rt_uint32_t sl_map, fl_map;
+
+    /* search for a non-empty list in the same first level */
+    sl_map = tlsf->sl_bitmap[fl] & (~0UL << sl);
+    if (!sl_map)
+    {
+        /* no block here, search in the larger first levels */
+        fl_map = (fl + 1 < 32) ? (tlsf->fl_bitmap & (~0UL << (fl + 1))) : 0;
+        if (!fl_map)
+        {
+            /* no free blocks available, memory has been exhausted */
+            return RT_NULL;
+        }
+
+        fl = _tlsf_ffs(fl_map);
+        *fli = fl;
+        sl_map = tlsf->sl_bitmap[fl];
+    }
+    RT_ASSERT(sl_map != 0);
+    sl = _tlsf_ffs(sl_map);
+    *sli = sl;
+
+    return tlsf->blocks[fl][sl];
+}
+
+static void _remove_free_block(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, int fl, int sl)
+{
+    struct rt_tlsf_block *prev = block->prev_free;
+    struct rt_tlsf_block *next = block->next_free;
+
+    next->prev_free = prev;
+    prev->next_free = next;
+
+    /* the block is the head of the free list, set new head */
+    if (tlsf->blocks[fl][sl] == block)
+    {
+        tlsf->blocks[fl][sl] = next;
+
+        /* the list is empty, clear the bits in the bitmaps */
+        if (next == &tlsf->block_null)
+        {
+            tlsf->sl_bitmap[fl] &= ~(1UL << sl);
+            if (!tlsf->sl_bitmap[fl])
+            {
+                tlsf->fl_bitmap &= ~(1UL << fl);
+            }
+        }
+    }
+    tlsf->free_count --;
+}
+
+static void _insert_free_block(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, int fl, int sl)
+{
+    struct rt_tlsf_block *current = tlsf->blocks[fl][sl];
+
+    block->next_free = current;
+    block->prev_free = &tlsf->block_null;
+    current->prev_free = block;
+
+    RT_ASSERT(((rt_ubase_t)BLOCK_TO_PTR(block) & (TLSF_ALIGN_SIZE - 1)) == 0);
+
+    /* insert the new block at the head of the list, and mark the bitmaps */
+    tlsf->blocks[fl][sl] = block;
+    tlsf->fl_bitmap |= (1UL << fl);
+    tlsf->sl_bitmap[fl] |= (1UL << sl);
+    tlsf->free_count ++;
+}
+
+rt_inline void _block_remove(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    int fl, sl;
+
+    _mapping_insert(BLOCK_SIZE(block), &fl, &sl);
+    _remove_free_block(tlsf, block, fl, sl);
+}
+
+rt_inline void _block_insert(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    int fl, sl;
+
+    _mapping_insert(BLOCK_SIZE(block), &fl, &sl);
+    _insert_free_block(tlsf, block, fl, sl);
+}
+
+rt_inline rt_bool_t _block_can_split(struct rt_tlsf_block *block, rt_size_t size)
+{
+    return BLOCK_SIZE(block) >= sizeof(struct rt_tlsf_block) + size;
+}
+
+/**
+ * @brief Split a block into two, the second of which is free.
+ */
+static struct rt_tlsf_block *_block_split(struct rt_tlsf_block *block, rt_size_t size)
+{
+    struct rt_tlsf_block *remaining;
+    rt_size_t remain_size;
+
+    remaining = (struct rt_tlsf_block *)((rt_uint8_t *)BLOCK_TO_PTR(block) + size - BLOCK_OVERHEAD);
+    remain_size = BLOCK_SIZE(block) - (size + BLOCK_OVERHEAD);
+
+    RT_ASSERT(((rt_ubase_t)BLOCK_TO_PTR(remaining) & (TLSF_ALIGN_SIZE - 1)) == 0);
+    RT_ASSERT(remain_size >= BLOCK_SIZE_MIN);
+
+    remaining->size = 0;
+    _block_set_size(remaining, remain_size);
+    _block_set_size(block, size);
+    _block_mark_as_free(remaining);
+
+    return remaining;
+}
+
+/**
+ * @brief Absorb a free block's storage into an adjacent previous free block.
+ */
+static struct rt_tlsf_block *_block_absorb(struct rt_tlsf_block *prev, struct rt_tlsf_block *block)
+{
+    RT_ASSERT(!BLOCK_IS_LAST(prev));
+
+    prev->size += BLOCK_SIZE(block) + BLOCK_OVERHEAD;
+    _block_link_next(prev);
+
+    return prev;
+}
+
+static struct rt_tlsf_block *_block_merge_prev(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    if (BLOCK_IS_PREV_FREE(block))
+    {
+        struct rt_tlsf_block *prev = block->prev_phys;
+
+        RT_ASSERT(prev != RT_NULL);
+        RT_ASSERT(BLOCK_IS_FREE(prev));
+        _block_remove(tlsf, prev);
+        block = _block_absorb(prev, block);
+    }
+
+    return block;
+}
+
+static struct rt_tlsf_block *_block_merge_next(struct rt_tlsf *tlsf, struct rt_tlsf_block *block)
+{
+    struct rt_tlsf_block *next = BLOCK_NEXT(block);
+
+    if (BLOCK_IS_FREE(next))
+    {
+        RT_ASSERT(!BLOCK_IS_LAST(block));
+        _block_remove(tlsf, next);
+        block = _block_absorb(block, next);
+    }
+
+    return block;
+}
+
+/**
+ * @brief Trim any trailing block space off the end of a free block, return
+ *        it to the pool.
+ */
+static void _block_trim_free(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, rt_size_t size)
+{
+    RT_ASSERT(BLOCK_IS_FREE(block));
+
+    if (_block_can_split(block, size))
+    {
+        struct rt_tlsf_block *remaining = _block_split(block, size);
+
+        _block_link_next(block);
+        remaining->size |= BLOCK_PREV_FREE_BIT;
+        _block_insert(tlsf, remaining);
+    }
+}
+
+/**
+ * @brief Trim any trailing block space off the end of a used block, return
+ *        it to the pool.
+ */
+static void _block_trim_used(struct rt_tlsf *tlsf, struct rt_tlsf_block *block, rt_size_t size)
+{
+    RT_ASSERT(!BLOCK_IS_FREE(block));
+
+    if (_block_can_split(block, size))
+    {
+        /* if the next block is free, we must coalesce */
+        struct rt_tlsf_block *remaining = _block_split(block, size);
+
+        remaining->size &= ~BLOCK_PREV_FREE_BIT;
+        remaining = _block_merge_next(tlsf, remaining);
+        _block_insert(tlsf, remaining);
+    }
+}
+
+static struct rt_tlsf_block *_block_locate_free(struct rt_tlsf *tlsf, rt_size_t size)
+{
+    int fl = 0, sl = 0;
+    struct rt_tlsf_block *block = RT_NULL;
+
+    _mapping_search(size, &fl, &sl);
+
+    /* the mapping may round up past the last list for the largest blocks */
+    if (fl < FL_INDEX_COUNT)
+    {
+        block = _search_suitable_block(tlsf, &fl, &sl);
+    }
+
+    if (block)
+    {
+        RT_ASSERT(BLOCK_SIZE(block) >= size);
+        _remove_free_block(tlsf, block, fl, sl);
+    }
+
+    return block;
+}
+
+rt_inline rt_size_t _adjust_request_size(rt_size_t size)
+{
+    rt_size_t adjust = 0;
+
+    if (size)
+    {
+        const rt_size_t aligned = RT_ALIGN(size, TLSF_ALIGN_SIZE);
+
+        /* aligned sized must not exceed block_size_max or we'll go out of bounds on sl_bitmap */
+        if (aligned < BLOCK_SIZE_MAX)
+        {
+            adjust = aligned > BLOCK_SIZE_MIN ? aligned : BLOCK_SIZE_MIN;
+        }
+    }
+
+    return adjust;
+}
+
+/**
+ * @brief This function will initialize TLSF memory management algorithm.
+ *
+ * @param name is the name of the TLSF memory management object.
+ *
+ * @param begin_addr the beginning address of memory.
+ *
+ * @param size is the size of the memory.
+ *
+ * @return Return a pointer to the memory object. When the return value is RT_NULL, it means the init failed.
+ */
+rt_tlsf_t rt_tlsf_init(const char *name, void *begin_addr, rt_size_t size)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block, *next;
+    rt_ubase_t begin_align, end_align;
+    rt_size_t pool_bytes;
+    int fl, sl;
+
+    tlsf = (struct rt_tlsf *)RT_ALIGN((rt_ubase_t)begin_addr, TLSF_ALIGN_SIZE);
+    begin_align = RT_ALIGN((rt_ubase_t)tlsf + sizeof(*tlsf), TLSF_ALIGN_SIZE);
+    end_align   = RT_ALIGN_DOWN((rt_ubase_t)begin_addr + size, TLSF_ALIGN_SIZE);
+
+    /* the pool keeps one header at the beginning and a sentinel at the end */
+    if ((end_align <= begin_align) ||
+        (end_align - begin_align < 2 * BLOCK_OVERHEAD + BLOCK_SIZE_MIN))
+    {
+        rt_kprintf("tlsf init, error begin address 0x%x, and end address 0x%x\n",
+                   (rt_ubase_t)begin_addr, (rt_ubase_t)begin_addr + size);
+
+        return RT_NULL;
+    }
+
+    pool_bytes = end_align - begin_align - 2 * BLOCK_OVERHEAD;
+    if (pool_bytes >= BLOCK_SIZE_MAX)
+    {
+        rt_kprintf("tlsf init, memory size %d is larger than the max block size, truncated\n",
+                   pool_bytes);
+        pool_bytes = RT_ALIGN_DOWN(BLOCK_SIZE_MAX - 1, TLSF_ALIGN_SIZE);
+    }
+
+    rt_memset(tlsf, 0, sizeof(*tlsf));
+    /* initialize TLSF memory object */
+    rt_object_init(&(tlsf->parent.parent), RT_Object_Class_Memory, name);
+    tlsf->parent.algorithm = "tlsf";
+    tlsf->parent.address = begin_align;
+    /* a block using the whole pool takes its size field too */
+    tlsf->parent.total = pool_bytes + BLOCK_OVERHEAD;
+
+    tlsf->block_null.next_free = &tlsf->block_null;
+    tlsf->block_null.prev_free = &tlsf->block_null;
+    for (fl = 0; fl < FL_INDEX_COUNT; fl++)
+    {
+        for (sl = 0; sl < SL_INDEX_COUNT; sl++)
+        {
+            tlsf->blocks[fl][sl] = &tlsf->block_null;
+        }
+    }
+
+    /*
+     * create the main free block, its prev_phys field lies before the pool
+     * but will never be used as the first block has no previous block.
+     */
+    block = (struct rt_tlsf_block *)(begin_align - sizeof(struct rt_tlsf_block *));
+    block->size = pool_bytes | BLOCK_FREE_BIT;
+    _block_insert(tlsf, block);
+
+    /* split the block to create a zero-size sentinel block */
+    next = _block_link_next(block);
+    next->size = 0 | BLOCK_PREV_FREE_BIT;
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("tlsf init, heap begin address 0x%x, size %d\n",
+                                begin_align, pool_bytes));
+
+    return &tlsf->parent;
+}
+RTM_EXPORT(rt_tlsf_init);
+
+/**
+ * @brief This function will remove a TLSF memory from the system.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_tlsf_detach(rt_tlsf_t m)
+{
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    rt_object_detach(&(m->parent));
+
+    return RT_EOK;
+}
+RTM_EXPORT(rt_tlsf_detach);
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * @brief Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return the pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_tlsf_alloc(rt_tlsf_t m, rt_size_t size)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block;
+    rt_size_t adjust;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT(rt_object_is_systemobject(&m->parent));
+
+    tlsf = (struct rt_tlsf *)m;
+    adjust = _adjust_request_size(size);
+    if (adjust == 0)
+        return RT_NULL;
+
+    block = _block_locate_free(tlsf, adjust);
+    if (block == RT_NULL)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("no memory\n"));
+
+        return RT_NULL;
+    }
+
+    _block_trim_free(tlsf, block, adjust);
+    _block_mark_as_used(block);
+
+    tlsf->parent.used += BLOCK_SIZE(block) + BLOCK_OVERHEAD;
+    if (tlsf->parent.max < tlsf->parent.used)
+        tlsf->parent.max = tlsf->parent.used;
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("allocate memory at 0x%x, size: %d\n",
+                                (rt_ubase_t)BLOCK_TO_PTR(block), BLOCK_SIZE(block)));
+
+    return BLOCK_TO_PTR(block);
+}
+RTM_EXPORT(rt_tlsf_alloc);
+
+/**
+ * @brief This function will release the previously allocated memory block by
+ *        rt_tlsf_alloc. The released memory block is taken back to the heap.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @param rmem the address of memory which will be released.
+ */
+void rt_tlsf_free(rt_tlsf_t m, void *rmem)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block;
+
+    if (rmem == RT_NULL)
+        return;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+    RT_ASSERT((((rt_ubase_t)rmem) & (TLSF_ALIGN_SIZE - 1)) == 0);
+    RT_ASSERT((rt_ubase_t)rmem >= m->address && (rt_ubase_t)rmem < m->address + m->total);
+
+    tlsf = (struct rt_tlsf *)m;
+    block = BLOCK_FROM_PTR(rmem);
+    /* block already marked as free */
+    RT_ASSERT(!BLOCK_IS_FREE(block));
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("release memory 0x%x, size: %d\n",
+                                (rt_ubase_t)rmem, BLOCK_SIZE(block)));
+
+    tlsf->parent.used -= BLOCK_SIZE(block) + BLOCK_OVERHEAD;
+
+    _block_mark_as_free(block);
+    block = _block_merge_prev(tlsf, block);
+    block = _block_merge_next(tlsf, block);
+    _block_insert(tlsf, block);
+}
+RTM_EXPORT(rt_tlsf_free);
+
+/**
+ * @brief This function will change the size of previously allocated memory block.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @param rmem is the pointer to memory allocated by rt_tlsf_alloc.
+ *
+ * @param newsize is the required new size.
+ *
+ * @return the changed memory block address.
+ */
+void *rt_tlsf_realloc(rt_tlsf_t m, void *rmem, rt_size_t newsize)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block, *next;
+    rt_size_t cursize, combined, adjust;
+    void *nmem;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+
+    tlsf = (struct rt_tlsf *)m;
+
+    if (newsize == 0)
+    {
+        rt_tlsf_free(m, rmem);
+        return RT_NULL;
+    }
+
+    /* allocate a new memory block */
+    if (rmem == RT_NULL)
+        return rt_tlsf_alloc(m, newsize);
+
+    block = BLOCK_FROM_PTR(rmem);
+    RT_ASSERT(!BLOCK_IS_FREE(block));
+
+    next = BLOCK_NEXT(block);
+    cursize = BLOCK_SIZE(block);
+    combined = cursize + BLOCK_SIZE(next) + BLOCK_OVERHEAD;
+    adjust = _adjust_request_size(newsize);
+    if (adjust == 0)
+        return RT_NULL;
+
+    /* the next block is not free or not large enough, move it */
+    if (adjust > cursize && (!BLOCK_IS_FREE(next) || adjust > combined))
+    {
+        nmem = rt_tlsf_alloc(m, newsize);
+        if (nmem != RT_NULL)
+        {
+            rt_memcpy(nmem, rmem, cursize < newsize ? cursize : newsize);
+            rt_tlsf_free(m, rmem);
+        }
+
+        return nmem;
+    }
+
+    /* do we need to expand to the next block? */
+    tlsf->parent.used -= cursize;
+    if (adjust > cursize)
+    {
+        _block_merge_next(tlsf, block);
+        _block_mark_as_used(block);
+    }
+
+    /* trim the resulting block and return the original pointer */
+    _block_trim_used(tlsf, block, adjust);
+    tlsf->parent.used += BLOCK_SIZE(block);
+    if (tlsf->parent.max < tlsf->parent.used)
+        tlsf->parent.max = tlsf->parent.used;
+
+    return rmem;
+}
+RTM_EXPORT(rt_tlsf_realloc);
+
+/**
+ * @brief This function will get the fragmentation information of the TLSF memory.
+ *
+ * @param m the TLSF memory management object.
+ *
+ * @param free_blocks is a pointer to get the number of free blocks.
+ *
+ * @param max_free is a pointer to get the size of the largest free block.
+ */
+void rt_tlsf_frag_info(rt_tlsf_t m, rt_size_t *free_blocks, rt_size_t *max_free)
+{
+    struct rt_tlsf *tlsf;
+    struct rt_tlsf_block *block;
+    rt_size_t max = 0;
+    int fl, sl;
+
+    RT_ASSERT(m != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&m->parent) == RT_Object_Class_Memory);
+
+    tlsf = (struct rt_tlsf *)m;
+    if (free_blocks)
+        *free_blocks = tlsf->free_count;
+
+    if (max_free == RT_NULL)
+        return;
+
+    /* the largest block is in the highest non-empty list */
+    if (tlsf->fl_bitmap)
+    {
+        fl = _tlsf_fls(tlsf->fl_bitmap);
+        sl = _tlsf_fls(tlsf->sl_bitmap[fl]);
+        for (block = tlsf->blocks[fl][sl]; block != &tlsf->block_null; block = block->next_free)
+        {
+            if (BLOCK_SIZE(block) > max)
+                max = BLOCK_SIZE(block);
+        }
+    }
+    *max_free = max;
+}
+RTM_EXPORT(rt_tlsf_frag_info);
+
+/**@}*/
+
+#endif /* defined (RT_USING_TLSF) */